@@ -28,6 +28,7 @@
 #include "base/logger.hpp"
 #include "base/arg_parser.hpp"
 #include "base/option_conf.hpp"
+#include "synth/wave_tables.hpp"
 #ifdef PSYNTH_HAVE_XML
 #include "base/conf_backend_xml.hpp"
 #endif
@@ -160,6 +161,8 @@ int psynth_app::run (int argc, const char* argv[])
 	    return ERR_GENERIC;
 
 	generate_paths();
+	synth::initialize_wave_tables (
+	    (get_config_path () / "wave_tables.cache").string ());
 
 	try {
 #ifdef PSYNTH_HAVE_XML
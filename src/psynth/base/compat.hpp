@@ -61,6 +61,19 @@
 #    define PSYNTH_NONWORD_POINTER_ALIGNMENT_SUPPORTED
 #endif
 
+/**
+   PSYNTH_IVDEP tells the compiler that the following loop has no
+   dependencies between iterations, so it can be vectorized without
+   checking at run-time whether its arrays overlap.
+*/
+#if   defined(__clang__)
+#    define PSYNTH_IVDEP _Pragma ("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__) && (__GNUC__ > 4 || __GNUC_MINOR__ >= 9)
+#    define PSYNTH_IVDEP _Pragma ("GCC ivdep")
+#else
+#    define PSYNTH_IVDEP
+#endif
+
 #ifdef NDEBUG
 #define PSYNTH_DEBUG 0
 #else
@@ -0,0 +1,137 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        cpu.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Run-time detection of the CPU instruction sets.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.base.cpu"
+
+#include <atomic>
+#include <cstdlib>
+
+#include "base/throw.hpp"
+#include "base/logger.hpp"
+#include "base/cpu.hpp"
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DEFINE_ERROR (cpu_isa_error);
+
+namespace
+{
+
+const char* const isa_names [] = {
+    "generic", "sse2", "avx2", "avx512"
+};
+
+cpu_isa detect ()
+{
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx512f"))
+        return cpu_isa::avx512;
+    if (__builtin_cpu_supports ("avx2"))
+        return cpu_isa::avx2;
+    if (__builtin_cpu_supports ("sse2"))
+        return cpu_isa::sse2;
+#endif
+    return cpu_isa::generic;
+}
+
+cpu_isa forced_from_env (cpu_isa detected)
+{
+    const char* name = std::getenv ("PSYNTH_FORCE_ISA");
+    if (!name)
+        return detected;
+
+    try
+    {
+        auto isa = isa_from_name (name);
+        if (isa <= detected)
+            return isa;
+        PSYNTH_LOG << log::warning
+                   << "Ignoring PSYNTH_FORCE_ISA, this CPU does not support: "
+                   << name;
+    }
+    catch (const cpu_isa_error& err)
+    {
+        err.log ();
+    }
+    return detected;
+}
+
+std::atomic<int>& forced_isa ()
+{
+    static std::atomic<int> forced (
+        int (forced_from_env (detected_isa ())));
+    return forced;
+}
+
+} /* anonymous namespace */
+
+cpu_isa detected_isa ()
+{
+    static const cpu_isa isa = detect ();
+    return isa;
+}
+
+cpu_isa current_isa ()
+{
+    return cpu_isa (forced_isa ().load ());
+}
+
+void force_isa (cpu_isa isa)
+{
+    if (isa > detected_isa ())
+        PSYNTH_THROW (cpu_isa_error)
+            << "This CPU does not support: " << isa_name (isa);
+    forced_isa () = int (isa);
+}
+
+void unforce_isa ()
+{
+    forced_isa () = int (detected_isa ());
+}
+
+const char* isa_name (cpu_isa isa)
+{
+    return isa_names [int (isa)];
+}
+
+cpu_isa isa_from_name (const std::string& name)
+{
+    for (int i = 0; i <= int (cpu_isa::avx512); ++i)
+        if (name == isa_names [i])
+            return cpu_isa (i);
+    PSYNTH_THROW (cpu_isa_error) << "Unknown instruction set: " << name;
+}
+
+} /* namespace base */
+} /* namespace psynth */
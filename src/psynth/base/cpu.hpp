@@ -0,0 +1,93 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        cpu.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Run-time detection of the CPU instruction sets.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_BASE_CPU_HPP_
+#define PSYNTH_BASE_CPU_HPP_
+
+#include <string>
+
+#include <psynth/base/exception.hpp>
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DECLARE_ERROR (error, cpu_isa_error);
+
+/**
+ * Instruction set levels that DSP kernels may be specialized for,
+ * each level implies the previous ones.
+ */
+enum class cpu_isa
+{
+    generic,
+    sse2,
+    avx2,
+    avx512
+};
+
+/**
+ * Returns the best instruction set supported by the machine. It is
+ * checked only once.
+ */
+cpu_isa detected_isa ();
+
+/**
+ * Returns the instruction set that kernels should use, which is the
+ * detected one unless a lower one was forced, either with
+ * force_isa () or with the PSYNTH_FORCE_ISA environment variable.
+ */
+cpu_isa current_isa ();
+
+/**
+ * Makes current_isa () return @a isa, mostly meant for testing all
+ * the kernel variants in the same machine. Throws cpu_isa_error if
+ * the machine does not support @a isa.
+ */
+void force_isa (cpu_isa isa);
+
+/**
+ * Undoes force_isa ().
+ */
+void unforce_isa ();
+
+const char* isa_name (cpu_isa isa);
+
+/**
+ * Throws cpu_isa_error if @a name is not the name of any instruction
+ * set level.
+ */
+cpu_isa isa_from_name (const std::string& name);
+
+} /* namespace base */
+} /* namespace psynth */
+
+#endif /* PSYNTH_BASE_CPU_HPP_ */
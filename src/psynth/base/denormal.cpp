@@ -0,0 +1,62 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        denormal.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Protection against denormal numbers in real-time code.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+
+#include "base/denormal.hpp"
+
+namespace psynth
+{
+namespace base
+{
+
+#if PSYNTH_DEBUG
+
+namespace
+{
+
+std::atomic<bool> g_subnormal_tracing (false);
+
+} /* anonymous namespace */
+
+void enable_subnormal_tracing (bool enabled)
+{
+    g_subnormal_tracing.store (enabled, std::memory_order_relaxed);
+}
+
+bool subnormal_tracing ()
+{
+    return g_subnormal_tracing.load (std::memory_order_relaxed);
+}
+
+#endif
+
+} /* namespace base */
+} /* namespace psynth */
@@ -0,0 +1,135 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        denormal.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Protection against denormal numbers in real-time code.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_BASE_DENORMAL_HPP_
+#define PSYNTH_BASE_DENORMAL_HPP_
+
+#include <cmath>
+
+#include <boost/utility.hpp>
+
+#include <psynth/base/compat.hpp>
+
+#if defined (__SSE__) || defined (__x86_64__) || defined (_M_X64)
+#include <xmmintrin.h>
+#define PSYNTH_HAVE_MXCSR 1
+#elif defined (__aarch64__)
+#define PSYNTH_HAVE_FPCR 1
+#endif
+
+namespace psynth
+{
+namespace base
+{
+
+/**
+ * Returns whether @a x is a subnormal number. The arithmetic of
+ * subnormals is many times slower than the one of normal numbers in
+ * most CPUs, and they easily appear in the feedback paths of
+ * filters and delays when the input goes silent.
+ */
+inline bool is_subnormal (float x)
+{
+    return std::fpclassify (x) == FP_SUBNORMAL;
+}
+
+#if PSYNTH_DEBUG
+
+/**
+ * While enabled, the graph counts the subnormal samples that each
+ * node outputs, and denormal_guard does not flush them to zero so
+ * they can be seen, even when nested in a guard that flushes them.
+ * Only available in debug builds.
+ */
+void enable_subnormal_tracing (bool enabled);
+
+bool subnormal_tracing ();
+
+#else
+
+inline void enable_subnormal_tracing (bool)
+{}
+
+inline constexpr bool subnormal_tracing ()
+{ return false; }
+
+#endif
+
+/**
+ * Makes the current thread flush subnormal results to zero, and
+ * treat subnormal operands as zero, during the lifetime of the
+ * guard. The previous floating point mode is restored on
+ * destruction. It must be used by every thread running real-time
+ * code.
+ */
+class denormal_guard : private boost::noncopyable
+{
+public:
+    denormal_guard ()
+    {
+#if PSYNTH_HAVE_MXCSR
+        _saved = _mm_getcsr ();
+        _mm_setcsr (subnormal_tracing () ?
+                    _saved & ~flush_mask :
+                    _saved | flush_mask);
+#elif PSYNTH_HAVE_FPCR
+        asm volatile ("mrs %0, fpcr" : "=r" (_saved));
+        auto mode = subnormal_tracing () ?
+            _saved & ~flush_mask :
+            _saved | flush_mask;
+        asm volatile ("msr fpcr, %0" : : "r" (mode));
+#endif
+    }
+
+    ~denormal_guard ()
+    {
+#if PSYNTH_HAVE_MXCSR
+        _mm_setcsr (_saved);
+#elif PSYNTH_HAVE_FPCR
+        asm volatile ("msr fpcr, %0" : : "r" (_saved));
+#endif
+    }
+
+private:
+#if PSYNTH_HAVE_MXCSR
+    // Flush to zero (FTZ) and denormals are zero (DAZ) bits.
+    static constexpr unsigned flush_mask = 0x8040;
+    unsigned _saved;
+#elif PSYNTH_HAVE_FPCR
+    // Flush to zero (FZ) bit.
+    static constexpr unsigned long flush_mask = 1ul << 24;
+    unsigned long _saved;
+#endif
+};
+
+} /* namespace base */
+} /* namespace psynth */
+
+#endif /* PSYNTH_BASE_DENORMAL_HPP_ */
@@ -32,6 +32,7 @@
 #define PSYNTH_BASE_HETERO_DEQUE_HPP_
 
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <boost/iterator/iterator_facade.hpp>
@@ -104,6 +105,10 @@ private:
  * Base is the common base of all the elements in the collection. Note
  * that, in the general case, Base should define a virtual destructor.
  *
+ * When Movable is true every element also keeps how to move it to
+ * another deque, at the cost of a pointer more per element, so the
+ * elements can be transferred with splice_back.
+ *
  * @todo Pushing an element invalidates the end iterator. Maybe it is
  * desirable to change this behaviour?
  *
@@ -112,7 +117,7 @@ private:
  *
  * @todo Parametrize allocator?
  */
-template <class Base>
+template <class Base, bool Movable = false>
 class hetero_deque : public boost::noncopyable
 {
 public:
@@ -167,6 +172,16 @@ public:
 
     void swap (hetero_deque& other);
 
+    /**
+     * Moves the elements of @a other to the back of this deque, in
+     * the same order. The ones that do not fit, or that can not be
+     * move constructed, are left in @a other with the ones following
+     * them.
+     *
+     * @return Whether @a other was left empty.
+     */
+    bool splice_back (hetero_deque& other);
+
     bool empty () const
     { return !_front->access; }
 
@@ -197,9 +212,25 @@ private:
     static_assert (std::is_pod<header>::value,
                    "hetero_header must be a POD");
 
+    typedef bool (*mover) (Base&, hetero_deque&);
+
+    static constexpr std::ptrdiff_t mover_size = Movable ? sizeof (mover) : 0;
+
     template <class Concrete, typename ...Args>
     void construct (header* data, Args&&... args);
 
+    template <class Concrete>
+    static bool move_element (Base& obj, hetero_deque& dst);
+
+    template <class Concrete>
+    static auto element_mover (int)
+        -> decltype ((void) Concrete (std::declval<Concrete&&> ()), mover ())
+    { return &hetero_deque::move_element<Concrete>; }
+
+    template <class Concrete>
+    static mover element_mover (long)
+    { return 0; }
+
     const Base& access (const header* data) const;
     Base& access (header* data) const;
 
@@ -216,9 +247,9 @@ private:
 namespace std
 {
 
-template <class B>
-void swap (psynth::base::hetero_deque<B>& a,
-           psynth::base::hetero_deque<B>& b)
+template <class B, bool M>
+void swap (psynth::base::hetero_deque<B, M>& a,
+           psynth::base::hetero_deque<B, M>& b)
 {
     a.swap (b);
 }
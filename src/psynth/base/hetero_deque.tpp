@@ -48,8 +48,8 @@ namespace psynth
 namespace base
 {
 
-template <class B>
-hetero_deque<B>::hetero_deque (std::size_t size)
+template <class B, bool M>
+hetero_deque<B, M>::hetero_deque (std::size_t size)
     : _memory (size + sizeof (header))
     , _front (reinterpret_cast<header*> (&_memory [0]))
     , _back (reinterpret_cast<header*> (&_memory [0]))
@@ -57,8 +57,8 @@ hetero_deque<B>::hetero_deque (std::size_t size)
     *_front = header { 0, 0, 0 };
 }
 
-template <class B>
-hetero_deque<B>::hetero_deque (hetero_deque&& other)
+template <class B, bool M>
+hetero_deque<B, M>::hetero_deque (hetero_deque&& other)
     : _memory (0)
     , _front (0)
     , _back (0)
@@ -66,8 +66,8 @@ hetero_deque<B>::hetero_deque (hetero_deque&& other)
     std::swap (*this, other);
 }
 
-template <class B>
-hetero_deque<B>& hetero_deque<B>::operator= (hetero_deque&& other)
+template <class B, bool M>
+hetero_deque<B, M>& hetero_deque<B, M>::operator= (hetero_deque&& other)
 {
     if (&other != this)
         std::swap (*this, other);
@@ -76,8 +76,8 @@ hetero_deque<B>& hetero_deque<B>::operator= (hetero_deque&& other)
 
 #if 0
 
-template <class B>
-hetero_deque<B>::hetero_deque (const hetero_deque& other)
+template <class B, bool M>
+hetero_deque<B, M>::hetero_deque (const hetero_deque& other)
     : _memory (other._memory)
     , _front (!other._front ? 0 :
               (header*) &_memory[0] +
@@ -88,8 +88,8 @@ hetero_deque<B>::hetero_deque (const hetero_deque& other)
 {
 }
 
-template <class B>
-hetero_deque<B>& hetero_deque<B>::operator= (const hetero_deque& other)
+template <class B, bool M>
+hetero_deque<B, M>& hetero_deque<B, M>::operator= (const hetero_deque& other)
 {
     if (&other != this)
     {
@@ -102,46 +102,46 @@ hetero_deque<B>& hetero_deque<B>::operator= (const hetero_deque& other)
 
 #endif
 
-template <class B>
-hetero_deque<B>::~hetero_deque ()
+template <class B, bool M>
+hetero_deque<B, M>::~hetero_deque ()
 {
     clear ();
 }
 
-template <class B>
-B& hetero_deque<B>::back ()
+template <class B, bool M>
+B& hetero_deque<B, M>::back ()
 {
     return this->access (_back);
 }
 
-template <class B>
-const B& hetero_deque<B>::back () const
+template <class B, bool M>
+const B& hetero_deque<B, M>::back () const
 {
     return this->access (_back);
 }
 
-template <class B>
-B& hetero_deque<B>::front ()
+template <class B, bool M>
+B& hetero_deque<B, M>::front ()
 {
     return this->access (_front);
 }
 
-template <class B>
-const B& hetero_deque<B>::front () const
+template <class B, bool M>
+const B& hetero_deque<B, M>::front () const
 {
     return this->access (_front);
 }
 
-template <class B>
-B& hetero_deque<B>::access (header* data) const
+template <class B, bool M>
+B& hetero_deque<B, M>::access (header* data) const
 {
     if (!data || !data->access)
         throw hetero_deque_empty ();
     return * data->access;
 }
 
-template <class B>
-const B& hetero_deque<B>::access (const header* data) const
+template <class B, bool M>
+const B& hetero_deque<B, M>::access (const header* data) const
 {
     if (!data || !data->access)
         throw hetero_deque_empty ();
@@ -151,25 +151,37 @@ const B& hetero_deque<B>::access (const header* data) const
 /**
  * Constructs a new object of type concrete in the given
  * address. The header 'next' will point to first memory address
- * after the object and the 'prev' to the previous one.
+ * after the object and the 'prev' to the previous one. In movable
+ * deques the mover of the object goes between the header and it.
  */
-template <class B>
+template <class B, bool M>
 template <class Concrete, typename ...Args>
-void hetero_deque<B>::construct (header* data, Args&&... args)
+void hetero_deque<B, M>::construct (header* data, Args&&... args)
 {
     static_assert (std::is_base_of<B, Concrete>::value,
                    "Elements should derived from Base.");
 
-    void* obj_data = data + 1;
+    void* obj_data = reinterpret_cast<char*> (data + 1) + mover_size;
     Concrete* obj  = new (obj_data) Concrete (std::forward<Args> (args) ...);
+    if (M)
+        *reinterpret_cast<mover*> (data + 1) = element_mover<Concrete> (0);
     *data = header { obj, reinterpret_cast<header*> (obj + 1), 0 };
 }
 
-template <class B>
+template <class B, bool M>
+template <class Concrete>
+bool hetero_deque<B, M>::move_element (B& obj, hetero_deque& dst)
+{
+    return dst.template push_back<Concrete> (
+        std::move (static_cast<Concrete&> (obj)));
+}
+
+template <class B, bool M>
 template <class Concrete, typename ...Args>
-bool hetero_deque<B>::push_back (Args&& ... args)
+bool hetero_deque<B, M>::push_back (Args&& ... args)
 {
-    std::ptrdiff_t req_size  = 2 * sizeof (header) + sizeof (Concrete);
+    std::ptrdiff_t req_size  =
+        2 * sizeof (header) + mover_size + sizeof (Concrete);
     header*        old_back  = _back;
 
     if (_back->next) // Non empty deque
@@ -180,7 +192,7 @@ bool hetero_deque<B>::push_back (Args&& ... args)
             req_size > &_memory[0] + _memory.size () - (char*) _back)
             _back   = reinterpret_cast<header*> (&_memory[0]);
 
-        if (_back < _front && (char*) _front - (char*) _back < req_size) {
+        if (_back <= _front && (char*) _front - (char*) _back < req_size) {
             _back  = old_back;
             return false;
         }
@@ -200,8 +212,8 @@ bool hetero_deque<B>::push_back (Args&& ... args)
     return true;
 }
 
-template <class B>
-bool hetero_deque<B>::pop_back ()
+template <class B, bool M>
+bool hetero_deque<B, M>::pop_back ()
 {
     if (_back->next) // Non empty deque
     {
@@ -218,11 +230,12 @@ bool hetero_deque<B>::pop_back ()
     return false;
 }
 
-template <class B>
+template <class B, bool M>
 template <class Concrete, typename ...Args>
-bool hetero_deque<B>::push_front (Args&& ... args)
+bool hetero_deque<B, M>::push_front (Args&& ... args)
 {
-    std::ptrdiff_t req_size  = sizeof (header) + sizeof (Concrete);
+    std::ptrdiff_t req_size  =
+        sizeof (header) + mover_size + sizeof (Concrete);
     header*        old_front = _front;
 
     if (_front->next) // Non empty deque
@@ -261,8 +274,8 @@ bool hetero_deque<B>::push_front (Args&& ... args)
     return true;
 }
 
-template <class B>
-bool hetero_deque<B>::pop_front ()
+template <class B, bool M>
+bool hetero_deque<B, M>::pop_front ()
 {
     if (_front->next) // Non empty deque
     {
@@ -279,8 +292,8 @@ bool hetero_deque<B>::pop_front ()
     return false;
 }
 
-template <class B>
-void hetero_deque<B>::clear ()
+template <class B, bool M>
+void hetero_deque<B, M>::clear ()
 {
     if (!_front) // Move constructor.
         return;
@@ -290,8 +303,24 @@ void hetero_deque<B>::clear ()
     *_front = header { 0, 0, 0 };
 }
 
-template <class B>
-void hetero_deque<B>::swap (hetero_deque& other)
+template <class B, bool M>
+bool hetero_deque<B, M>::splice_back (hetero_deque& other)
+{
+    static_assert (M, "Only movable deques can be spliced.");
+    assert (&other != this);
+
+    while (!other.empty ())
+    {
+        auto move_to = *reinterpret_cast<mover*> (other._front + 1);
+        if (!move_to || !move_to (*other._front->access, *this))
+            return false;
+        other.pop_front ();
+    }
+    return true;
+}
+
+template <class B, bool M>
+void hetero_deque<B, M>::swap (hetero_deque& other)
 {
     std::swap (_memory, other._memory);
     std::swap (_front, other._front);
@@ -0,0 +1,148 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        job_pool.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief A pool of threads running prioritized jobs.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.base.job_pool"
+
+#include "base/logger.hpp"
+#include "base/job_pool.hpp"
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DEFINE_ERROR_WHAT (job_pool_error, "Job pool already running.");
+
+job_pool::job_pool (std::size_t num_threads)
+    : _num_threads (num_threads ? num_threads : 1)
+    , _order (0)
+    , _busy (0)
+    , _is_running (false)
+{
+}
+
+job_pool::~job_pool ()
+{
+    if (is_running ())
+        stop ();
+}
+
+void job_pool::start ()
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    if (_is_running)
+        throw job_pool_error ();
+
+    _is_running = true;
+    for (std::size_t i = 0; i < _num_threads; ++i)
+        _threads.emplace_back (std::bind (&job_pool::_loop, this));
+}
+
+void job_pool::stop ()
+{
+    {
+        std::unique_lock<std::mutex> g (_mutex);
+        _is_running = false;
+        _cond.notify_all ();
+        _idle_cond.notify_all ();
+    }
+
+    for (auto& t : _threads)
+        if (t.joinable ())
+            t.join ();
+    _threads.clear ();
+}
+
+bool job_pool::is_running () const
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    return _is_running;
+}
+
+std::size_t job_pool::pending () const
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    return _queue.size ();
+}
+
+void job_pool::post (job fn, job_priority priority)
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    _queue.push (entry { priority, _order++, std::move (fn) });
+    _cond.notify_one ();
+}
+
+void job_pool::wait ()
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    while (_busy > 0 || (_is_running && !_queue.empty ()))
+        _idle_cond.wait (g);
+}
+
+void job_pool::_loop ()
+{
+    std::unique_lock<std::mutex> g (_mutex);
+
+    while (_is_running)
+    {
+        if (_queue.empty ())
+        {
+            _cond.wait (g);
+            continue;
+        }
+
+        auto fn = std::move (const_cast<entry&> (_queue.top ()).fn);
+        _queue.pop ();
+        ++_busy;
+
+        g.unlock ();
+        try
+        {
+            fn ();
+        }
+        catch (const base::exception& err)
+        {
+            err.log ();
+        }
+        catch (const std::exception& err)
+        {
+            PSYNTH_LOG << log::error << "Uncaught error in job: "
+                       << err.what ();
+        }
+        g.lock ();
+
+        --_busy;
+        if (_busy == 0 && _queue.empty ())
+            _idle_cond.notify_all ();
+    }
+}
+
+} /* namespace base */
+} /* namespace psynth */
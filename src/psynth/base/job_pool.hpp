@@ -0,0 +1,137 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        job_pool.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief A pool of threads running prioritized jobs.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_BASE_JOB_POOL_HPP_
+#define PSYNTH_BASE_JOB_POOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <boost/utility.hpp>
+
+#include <psynth/base/exception.hpp>
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DECLARE_ERROR (error, job_pool_error);
+
+constexpr std::size_t default_job_threads = 2;
+
+/**
+ * Jobs with higher priority are always picked before the ones with
+ * lower priority, jobs with the same priority run in the order they
+ * were posted.
+ */
+enum class job_priority
+{
+    low,
+    normal,
+    high
+};
+
+/**
+ * A fixed set of worker threads that run jobs taken from a priority
+ * queue. It is meant for heavy work that can not be done in the
+ * real-time thread, like decoding files or computing tables. Jobs
+ * are allowed to post new jobs.
+ *
+ * Jobs that are posted while the pool is stopped remain in the queue
+ * until it is started again.
+ */
+class job_pool : private boost::noncopyable
+{
+public:
+    typedef std::function<void ()> job;
+
+    explicit job_pool (std::size_t num_threads = default_job_threads);
+    ~job_pool ();
+
+    void start ();
+    void stop ();
+
+    bool is_running () const;
+
+    std::size_t size () const
+    { return _num_threads; }
+
+    /**
+     * Returns the number of jobs waiting to be run.
+     */
+    std::size_t pending () const;
+
+    void post (job fn, job_priority priority = job_priority::normal);
+
+    /**
+     * Blocks until there are no pending nor running jobs.
+     */
+    void wait ();
+
+private:
+    struct entry
+    {
+        job_priority priority;
+        std::size_t  order;
+        job          fn;
+
+        bool operator< (const entry& other) const
+        {
+            return priority != other.priority
+                ? priority < other.priority
+                : order > other.order;
+        }
+    };
+
+    void _loop ();
+
+    std::priority_queue<entry>  _queue;
+    std::vector<std::thread>    _threads;
+    mutable std::mutex          _mutex;
+    std::condition_variable     _cond;
+    std::condition_variable     _idle_cond;
+    std::size_t                 _num_threads;
+    std::size_t                 _order;
+    std::size_t                 _busy;
+    bool                        _is_running;
+};
+
+typedef std::shared_ptr<job_pool> job_pool_ptr;
+
+} /* namespace base */
+} /* namespace psynth */
+
+#endif /* PSYNTH_BASE_JOB_POOL_HPP_ */
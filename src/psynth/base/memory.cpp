@@ -0,0 +1,354 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        memory.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Virtual memory utilities.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.base.memory"
+
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "base/throw.hpp"
+#include "base/logger.hpp"
+#include "base/memory.hpp"
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DEFINE_ERROR (memory_error);
+
+namespace
+{
+
+#if defined (__linux__) && defined (SYS_memfd_create)
+
+/**
+ * Returns the mirrored mapping or 0 on failure.
+ */
+unsigned char* map_mirrored (std::size_t size, std::size_t count)
+{
+    const int fd = ::syscall (SYS_memfd_create, "psynth-mirror", 0);
+    if (fd < 0)
+        return 0;
+
+    unsigned char* base = 0;
+    if (::ftruncate (fd, size * count) == 0)
+    {
+        void* addr = ::mmap (0, 2 * size * count, PROT_NONE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr != MAP_FAILED)
+        {
+            base = static_cast<unsigned char*> (addr);
+            for (std::size_t i = 0; base && i < 2 * count; ++i)
+            {
+                void* region = ::mmap (base + i * size, size,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_FIXED,
+                                       fd, (i / 2) * size);
+                if (region == MAP_FAILED)
+                {
+                    ::munmap (base, 2 * size * count);
+                    base = 0;
+                }
+            }
+        }
+    }
+
+    ::close (fd);
+    return base;
+}
+
+#else
+
+unsigned char* map_mirrored (std::size_t, std::size_t)
+{
+    return 0;
+}
+
+#endif
+
+#ifdef __linux__
+
+/**
+ * Size of the huge pages on most Linux systems.
+ */
+constexpr std::size_t huge_page_size = 2 << 20;
+
+#endif
+
+} /* anonymous namespace */
+
+std::size_t page_size ()
+{
+#ifdef __linux__
+    static const std::size_t size = ::sysconf (_SC_PAGESIZE);
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+std::size_t round_to_page (std::size_t size)
+{
+    const std::size_t page = page_size ();
+    return (size + page - 1) / page * page;
+}
+
+mirrored_memory::mirrored_memory ()
+    : _base (0)
+    , _size (0)
+    , _count (0)
+    , _mapped (0)
+    , _mirrored (false)
+{
+}
+
+mirrored_memory::mirrored_memory (std::size_t size, std::size_t count)
+    : _base (0)
+    , _size (round_to_page (size))
+    , _count (count)
+    , _mapped (0)
+    , _mirrored (false)
+{
+    if (!_size || !_count)
+        return;
+
+    _base = map_mirrored (_size, _count);
+    if (_base)
+    {
+        _mapped   = 2 * _size * _count;
+        _mirrored = true;
+        return;
+    }
+
+    PSYNTH_LOG << log::warning
+               << "Could not map mirrored memory, using plain memory.";
+
+#ifdef __linux__
+    void* addr = ::mmap (0, _size * _count, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED)
+        PSYNTH_THROW (memory_error) << "Could not map " << _size * _count
+                                    << " bytes.";
+    _base   = static_cast<unsigned char*> (addr);
+    _mapped = _size * _count;
+#else
+    _base = new unsigned char [_size * _count] ();
+#endif
+}
+
+mirrored_memory::mirrored_memory (mirrored_memory&& other)
+    : mirrored_memory ()
+{
+    swap (other);
+}
+
+mirrored_memory& mirrored_memory::operator= (mirrored_memory&& other)
+{
+    mirrored_memory tmp (std::move (other));
+    swap (tmp);
+    return *this;
+}
+
+mirrored_memory::~mirrored_memory ()
+{
+    if (!_base)
+        return;
+#ifdef __linux__
+    ::munmap (_base, _mapped);
+#else
+    delete [] _base;
+#endif
+}
+
+void mirrored_memory::swap (mirrored_memory& other)
+{
+    std::swap (_base,     other._base);
+    std::swap (_size,     other._size);
+    std::swap (_count,    other._count);
+    std::swap (_mapped,   other._mapped);
+    std::swap (_mirrored, other._mirrored);
+}
+
+void* aligned_allocate (std::size_t size)
+{
+#ifdef __linux__
+    void* ptr = 0;
+    if (::posix_memalign (&ptr, cache_line_size, size ? size : 1))
+        throw std::bad_alloc ();
+    return ptr;
+#else
+    return ::operator new (size);
+#endif
+}
+
+void aligned_deallocate (void* ptr)
+{
+#ifdef __linux__
+    std::free (ptr);
+#else
+    ::operator delete (ptr);
+#endif
+}
+
+memory_arena::memory_arena (std::size_t size, bool huge_pages, bool lock)
+    : _base (0)
+    , _size (0)
+    , _used (0)
+    , _huge (false)
+    , _locked (false)
+{
+#ifdef __linux__
+# ifdef MAP_HUGETLB
+    if (huge_pages)
+    {
+        const std::size_t huge_size =
+            (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+        void* addr = ::mmap (0, huge_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                             -1, 0);
+        if (addr != MAP_FAILED)
+        {
+            _base = static_cast<unsigned char*> (addr);
+            _size = huge_size;
+            _huge = true;
+        }
+    }
+# endif
+
+    if (!_base)
+    {
+        _size = round_to_page (size);
+        void* addr = ::mmap (0, _size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED)
+            PSYNTH_THROW (memory_error) << "Could not map " << _size
+                                        << " bytes.";
+        _base = static_cast<unsigned char*> (addr);
+# ifdef MADV_HUGEPAGE
+        if (huge_pages)
+            ::madvise (_base, _size, MADV_HUGEPAGE);
+# endif
+    }
+
+    if (lock)
+    {
+        _locked = ::mlock (_base, _size) == 0;
+        if (!_locked)
+            PSYNTH_LOG << log::warning
+                       << "Could not lock the memory arena in RAM.";
+    }
+#else
+    _size = (size + cache_line_size - 1) & ~(cache_line_size - 1);
+    _base = static_cast<unsigned char*> (aligned_allocate (_size));
+#endif
+
+    if (_size)
+        _free [0] = _size;
+}
+
+memory_arena::~memory_arena ()
+{
+#ifdef __linux__
+    ::munmap (_base, _size);
+#else
+    aligned_deallocate (_base);
+#endif
+}
+
+void* memory_arena::allocate (std::size_t size)
+{
+    size = _round (size ? size : 1);
+
+    std::unique_lock<std::mutex> lock (_mutex);
+    for (auto it = _free.begin (); it != _free.end (); ++it)
+    {
+        if (it->second >= size)
+        {
+            const std::size_t offset = it->first;
+            const std::size_t rest   = it->second - size;
+            _free.erase (it);
+            if (rest)
+                _free [offset + size] = rest;
+            _used += size;
+            return _base + offset;
+        }
+    }
+
+    return 0;
+}
+
+void memory_arena::deallocate (void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    size = _round (size ? size : 1);
+    std::size_t offset = static_cast<unsigned char*> (ptr) - _base;
+
+    std::unique_lock<std::mutex> lock (_mutex);
+    _used -= size;
+
+    auto next = _free.lower_bound (offset);
+    if (next != _free.end () && offset + size == next->first)
+    {
+        size += next->second;
+        next = _free.erase (next);
+    }
+
+    if (next != _free.begin ())
+    {
+        auto prev = std::prev (next);
+        if (prev->first + prev->second == offset)
+        {
+            prev->second += size;
+            return;
+        }
+    }
+
+    _free [offset] = size;
+}
+
+std::size_t memory_arena::used () const
+{
+    std::unique_lock<std::mutex> lock (_mutex);
+    return _used;
+}
+
+} /* namespace base */
+} /* namespace psynth */
@@ -0,0 +1,281 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        memory.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Virtual memory utilities.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_BASE_MEMORY_HPP_
+#define PSYNTH_BASE_MEMORY_HPP_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <boost/utility.hpp>
+
+#include <psynth/base/exception.hpp>
+
+namespace psynth
+{
+namespace base
+{
+
+PSYNTH_DECLARE_ERROR (error, memory_error);
+
+/**
+ * Size of the cache lines we align to, so that data used by
+ * different threads, or different planes of a buffer, never share
+ * cache lines.
+ */
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Returns the size of the virtual memory pages.
+ */
+std::size_t page_size ();
+
+/**
+ * Rounds @a size up to a multiple of the page size.
+ */
+std::size_t round_to_page (std::size_t size);
+
+/**
+ * A set of @a count memory regions of @a size bytes. Each region is
+ * followed by a mirror of itself, this is, the same physical pages
+ * are mapped twice back to back, so reading or writing past the end
+ * of a region, up to @a size bytes, wraps around to its beginning.
+ * This allows treating any window of a ring buffer as contiguous
+ * memory.
+ *
+ * If the system does not support it, the regions are allocated
+ * without the mirrors and is_mirrored () returns false. The memory
+ * is always initialized to zero.
+ */
+class mirrored_memory : private boost::noncopyable
+{
+public:
+    mirrored_memory ();
+
+    /**
+     * Maps the regions, rounding @a size up to the page size. Throws
+     * memory_error if the memory can not be allocated at all.
+     */
+    explicit mirrored_memory (std::size_t size, std::size_t count = 1);
+
+    mirrored_memory (mirrored_memory&& other);
+    mirrored_memory& operator= (mirrored_memory&& other);
+
+    ~mirrored_memory ();
+
+    void swap (mirrored_memory& other);
+
+    /**
+     * Size in bytes of every region, not counting the mirror.
+     */
+    std::size_t size () const
+    { return _size; }
+
+    std::size_t count () const
+    { return _count; }
+
+    bool is_mirrored () const
+    { return _mirrored; }
+
+    /**
+     * Returns the beginning of the region @a i.
+     */
+    unsigned char* data (std::size_t i = 0) const
+    { return _base + i * (_mirrored ? 2 * _size : _size); }
+
+private:
+    unsigned char* _base;
+    std::size_t    _size;
+    std::size_t    _count;
+    std::size_t    _mapped;
+    bool           _mirrored;
+};
+
+/**
+ * A big block of memory from which smaller blocks are given, meant
+ * for buffers that are used in the real-time thread. The whole arena
+ * is mapped at once, on huge pages when possible, and optionally
+ * locked in RAM, so touching the buffers causes neither page faults
+ * nor many TLB misses.
+ *
+ * If huge pages are not available, normal pages are used and the
+ * kernel is advised to back them with transparent huge pages. If the
+ * memory can not be locked, for example because of RLIMIT_MEMLOCK,
+ * a warning is logged and the arena works unlocked.
+ *
+ * All blocks are aligned to cache_line_size. It is safe to allocate
+ * and deallocate from different threads.
+ */
+class memory_arena : private boost::noncopyable
+{
+public:
+    /**
+     * Maps an arena of at least @a size bytes. Throws memory_error
+     * if the memory can not be mapped at all.
+     */
+    explicit memory_arena (std::size_t size,
+                           bool huge_pages = true,
+                           bool lock = true);
+    ~memory_arena ();
+
+    /**
+     * Returns a block of @a size bytes or null if there is no room
+     * left for it.
+     */
+    void* allocate (std::size_t size);
+
+    /**
+     * Returns a block previously obtained from allocate ().
+     */
+    void deallocate (void* ptr, std::size_t size);
+
+    bool owns (const void* ptr) const
+    {
+        return static_cast<const unsigned char*> (ptr) >= _base &&
+            static_cast<const unsigned char*> (ptr) < _base + _size;
+    }
+
+    std::size_t size () const
+    { return _size; }
+
+    std::size_t used () const;
+
+    bool is_huge () const
+    { return _huge; }
+
+    bool is_locked () const
+    { return _locked; }
+
+private:
+    static std::size_t _round (std::size_t size)
+    { return (size + cache_line_size - 1) & ~(cache_line_size - 1); }
+
+    typedef std::map<std::size_t, std::size_t> free_map;
+
+    unsigned char*     _base;
+    std::size_t        _size;
+    std::size_t        _used;
+    bool               _huge;
+    bool               _locked;
+    free_map           _free; /**< Free blocks, offset to size. */
+    mutable std::mutex _mutex;
+};
+
+typedef std::shared_ptr<memory_arena> memory_arena_ptr;
+
+/**
+ * Allocates cache_line_size aligned memory from the heap.
+ */
+void* aligned_allocate (std::size_t size);
+void aligned_deallocate (void* ptr);
+
+/**
+ * Standard allocator that takes its memory from a memory_arena. When
+ * it has no arena, or the arena is full, it falls back to aligned
+ * heap memory, so it can always be used in place of
+ * std::allocator. Allocators compare equal when they share the
+ * arena.
+ */
+template <typename T>
+class arena_allocator
+{
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator (memory_arena_ptr arena = memory_arena_ptr ())
+        : _arena (arena)
+    {}
+
+    template <typename U>
+    arena_allocator (const arena_allocator<U>& other)
+        : _arena (other.arena ())
+    {}
+
+    const memory_arena_ptr& arena () const
+    { return _arena; }
+
+    pointer allocate (size_type n, const void* = 0)
+    {
+        void* ptr = _arena ? _arena->allocate (n * sizeof (T)) : 0;
+        if (!ptr)
+            ptr = aligned_allocate (n * sizeof (T));
+        return static_cast<pointer> (ptr);
+    }
+
+    void deallocate (pointer ptr, size_type n)
+    {
+        if (_arena && _arena->owns (ptr))
+            _arena->deallocate (ptr, n * sizeof (T));
+        else
+            aligned_deallocate (ptr);
+    }
+
+    size_type max_size () const
+    { return std::size_t (-1) / sizeof (T); }
+
+    template <typename U, typename... Args>
+    void construct (U* ptr, Args&&... args)
+    { ::new ((void*) ptr) U (std::forward<Args> (args)...); }
+
+    template <typename U>
+    void destroy (U* ptr)
+    { ptr->~U (); }
+
+private:
+    memory_arena_ptr _arena;
+};
+
+template <typename T, typename U>
+bool operator== (const arena_allocator<T>& a, const arena_allocator<U>& b)
+{ return a.arena () == b.arena (); }
+
+template <typename T, typename U>
+bool operator!= (const arena_allocator<T>& a, const arena_allocator<U>& b)
+{ return a.arena () != b.arena (); }
+
+} /* namespace base */
+} /* namespace psynth */
+
+#endif /* PSYNTH_BASE_MEMORY_HPP_ */
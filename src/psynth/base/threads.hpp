@@ -49,6 +49,14 @@
 #include <cassert>
 #include <psynth/base/util.hpp>
 
+#ifdef __linux__
+#include <cerrno>
+#include <semaphore.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
 #define PSYNTH_DEFAULT_THREADING         \
     psynth::base::default_object_lockable::type
 #define PSYNTH_DEFAULT_NONOBJ_THREADING  \
@@ -231,6 +239,61 @@ private:
 template<class T, class M>
 typename class_lockable<T, M>::initializer class_lockable<T, M>::s_init;
 
+/**
+ * A counting semaphore. On Linux it is a POSIX semaphore, whose post
+ * only takes a lock-free increment and, when someone is waiting, a
+ * system call, so the real-time thread can use it to wake up a
+ * worker without blocking.
+ */
+class semaphore : private boost::noncopyable
+{
+public:
+    explicit semaphore (unsigned value = 0)
+#ifdef __linux__
+    { ::sem_init (&_sem, 0, value); }
+#else
+        : _value (value)
+    {}
+#endif
+
+#ifdef __linux__
+    ~semaphore ()
+    { ::sem_destroy (&_sem); }
+#endif
+
+    void post ()
+    {
+#ifdef __linux__
+        ::sem_post (&_sem);
+#else
+        auto g = make_unique_lock (_mutex);
+        ++ _value;
+        _cond.notify_one ();
+#endif
+    }
+
+    void wait ()
+    {
+#ifdef __linux__
+        while (::sem_wait (&_sem) != 0 && errno == EINTR);
+#else
+        auto g = make_unique_lock (_mutex);
+        while (!_value)
+            _cond.wait (g);
+        -- _value;
+#endif
+    }
+
+private:
+#ifdef __linux__
+    sem_t                   _sem;
+#else
+    std::mutex              _mutex;
+    std::condition_variable _cond;
+    unsigned                _value;
+#endif
+};
+
 typedef
 tpl_bind_snd<object_lockable, PSYNTH_DEFAULT_MUTEX>
 default_object_lockable;
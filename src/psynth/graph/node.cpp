@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "graph/node.hpp"
+#include "base/memory.hpp"
 
 #include <cmath>
 
@@ -43,8 +44,10 @@ node0::node0(const audio_info& info, int type,
 	       int n_out_audio, int n_out_control,
 	       bool single_update) :
     m_audioinfo(info),
-    m_outdata_audio(n_out_audio, audio_buffer (info.block_size)),
-    m_outdata_control(n_out_control, sample_buffer (info.block_size)),
+    m_outdata_audio(n_out_audio, audio_buffer (info.block_size,
+					       base::cache_line_size)),
+    m_outdata_control(n_out_control, sample_buffer (info.block_size,
+						   base::cache_line_size)),
     m_nparam(0),
     m_id(NULL_ID),
     m_type(type),
@@ -241,12 +244,7 @@ void node0::in_socket::update_input (const node0* caller, int caller_port_type,
 void node0::blend_buffer (sample* buf, int n_elem,
 			 sample stable_value, link_envelope env)
 {
-    while (n_elem--)
-    {
-        auto env_val = (float) (link_envelope::sample_type) env.update();
-	*buf = (*buf * env_val) + (stable_value * (1 - env_val));
-        buf++;
-    }
+    synth::blend_envelope (env, buf, stable_value, buf, n_elem);
 }
 
 void node0::update_envelopes ()
@@ -341,11 +339,13 @@ void node0::set_info (const audio_info& info)
     size_t i;
 
     for (i = 0; i < m_outdata_audio.size(); ++i)
-	m_outdata_audio[i].recreate (info.block_size); //.set_info(info);
+	m_outdata_audio[i].recreate (info.block_size,
+				     base::cache_line_size);
 
     if (m_audioinfo.block_size != info.block_size)
 	for (i = 0; i < m_outdata_control.size(); ++i)
-	    m_outdata_control[i].recreate (info.block_size);
+	    m_outdata_control[i].recreate (info.block_size,
+					   base::cache_line_size);
 
     m_audioinfo = info;
 
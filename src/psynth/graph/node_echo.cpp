@@ -87,12 +87,18 @@ int node_echo::do_update_channel (int chan)
     int pos = m_pos;
     float val;
 
+    /* The enveloped input is put in the output, which is then
+     * overwritten as it is read. */
+    if (in_buf)
+	synth::apply_envelope (in_env, in_buf, out_buf,
+			       get_info ().block_size);
+
     delay = m_param_delay * get_info ().sample_rate;
     for (i = 0; i < get_info ().block_size; ++i) {
 	if (pos > delay)
 	    pos = 0;
 
-	in_val = in_buf ? *in_buf++ * (float)(audio_sample)in_env.update() : 0;
+	in_val = in_buf ? *out_buf : 0;
 	val = tmp_buf[pos];
 
 	//*out_buf++ = val;
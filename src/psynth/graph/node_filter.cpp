@@ -48,7 +48,11 @@ node_filter::node_filter(const audio_info& prop, int mode) :
 		    m_param_cutoff,
 		    m_param_resonance,
 		    prop.sample_rate),
-    m_filter (prop.num_channels, filter (&m_filter_values))
+    m_filter (prop.num_channels, filter (&m_filter_values)),
+    m_bank (std::min (prop.num_channels, synth::biquad_bank::max_lanes)),
+    m_planes (prop.num_channels),
+    m_frame (prop.num_channels),
+    m_cutoff (prop.block_size)
 {
     add_param ("type", node_param::INT, &m_param_type);
     add_param ("cutoff", node_param::FLOAT, &m_param_cutoff);
@@ -79,29 +83,62 @@ void node_filter::do_update (const node0* caller,
 				      m_param_resonance,
 				      get_info().sample_rate);
 
-	for (size_t i = 0; i < get_info().num_channels; ++i) {
+	const size_t nchan = get_info().num_channels;
+	const size_t nframes = output->size();
+	const bool use_bank = m_param_type != filter_values::MOOG &&
+	    nchan <= synth::biquad_bank::max_lanes;
+
+	/* The enveloped input goes to the output, then all the
+	 * channels are filtered at once in place. */
+	std::vector<float*>& planes = m_planes;
+	for (size_t i = 0; i < nchan; ++i) {
 	    sample* outbuf = (sample*) &range (*output) [0][i];
-	    const sample* inbuf = (sample*) &const_range (*input) [0][i];;
-	    filter& filter = m_filter[i];
+	    const sample* inbuf = (sample*) &const_range (*input) [0][i];
 	    link_envelope env = get_in_envelope (LINK_AUDIO, IN_A_INPUT);
-	    if (!cutoff)
-		for (size_t j = 0; j < (size_t) output->size(); ++j)
-		    *outbuf++ = filter.update(
-                        *inbuf++ * (float) (link_envelope::sample_type) env.update());
-	    else {
-		link_envelope mod_env = get_in_envelope (LINK_CONTROL,
-                                                         IN_C_CUTOFF);
-		const sample* cutoff_buf = (const sample*) &const_range (*cutoff) [0];
+	    synth::apply_envelope (env, inbuf, outbuf, nframes);
+	    planes [i] = outbuf;
+	}
+
+	if (!cutoff) {
+	    if (use_bank) {
+		m_bank.set_values (m_filter_values);
+		m_bank.update_planes (&planes [0], &planes [0], nframes);
+	    } else
+		for (size_t i = 0; i < nchan; ++i)
+		    for (size_t j = 0; j < nframes; ++j)
+			planes [i][j] = m_filter [i].update (planes [i][j]);
+	} else {
+	    link_envelope mod_env = get_in_envelope (LINK_CONTROL,
+						     IN_C_CUTOFF);
+	    std::vector<float*>& frame = m_frame;
+	    m_cutoff.resize (nframes);
+	    synth::apply_envelope (mod_env,
+				   (const sample*) &const_range (*cutoff) [0],
+				   &m_cutoff [0], nframes);
 
-		for (size_t j = 0; j < (size_t) output->size(); ++j) {
-		    /* FIXME: Slow */
+	    if (use_bank) {
+		/* The coefficients follow the cutoff at the end of every
+		 * control period, and the bank filters the whole period
+		 * with them at once. */
+		for (size_t j = 0; j < nframes; j += CONTROL_PERIOD) {
+		    const size_t len = std::min (nframes - j,
+						 size_t (CONTROL_PERIOD));
+		    m_filter_values.calculate(m_param_cutoff
+					      + m_cutoff [j + len - 1]
+					      * m_param_cutoff);
+		    for (size_t i = 0; i < nchan; ++i)
+			frame [i] = planes [i] + j;
+		    m_bank.set_values (m_filter_values);
+		    m_bank.update_planes (&frame [0], &frame [0], len);
+		}
+	    } else
+		for (size_t j = 0; j < nframes; ++j) {
+		    /* FIXME: Slow, see core::filter */
 		    m_filter_values.calculate(m_param_cutoff
-					      + *cutoff_buf++
-					      * m_param_cutoff
-					      * (float) (link_envelope::sample_type) mod_env.update());
-		    *outbuf++ = filter.update(*inbuf++ * (float) (link_envelope::sample_type) env.update());
+					      + m_cutoff [j] * m_param_cutoff);
+		    for (size_t i = 0; i < nchan; ++i)
+			planes [i][j] = m_filter [i].update (planes [i][j]);
 		}
-	    }
 	}
     } else {
 	fill_frames (range (*output),
@@ -28,6 +28,7 @@
 #include <psynth/graph/node.hpp>
 #include <psynth/graph/node_factory.hpp>
 #include <psynth/synth/filter.hpp>
+#include <psynth/synth/biquad_bank.hpp>
 
 namespace psynth
 {
@@ -77,6 +78,12 @@ public:
     static constexpr float DEFAULT_CUTOFF    = 660.0f;
     static constexpr float DEFAULT_RESONANCE = 0.5f;
 
+    /**
+     * Number of samples during which the coefficients of the biquad
+     * filters are held when the cutoff is modulated.
+     */
+    static constexpr std::size_t CONTROL_PERIOD = 16;
+
 private:
     int m_param_type;
     float m_param_cutoff;
@@ -84,6 +91,10 @@ private:
 
     filter_values m_filter_values;
     std::vector<filter> m_filter;
+    synth::biquad_bank m_bank;
+    std::vector<float*> m_planes;
+    std::vector<float*> m_frame;
+    std::vector<float>  m_cutoff;
 
     void do_update (const node0* caller, int caller_port_type, int caller_port);
     void do_advance () {}
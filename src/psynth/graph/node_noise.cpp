@@ -21,7 +21,6 @@
  ***************************************************************************/
 
 #include <algorithm>
-#include <climits>
 #include "graph/node_noise.hpp"
 
 namespace psynth
@@ -69,13 +68,8 @@ node_noise::node_noise (const audio_info& prop,
 	  n_control_out),
     m_param_type (NOISE_PINK),
     m_param_ampl (DEFAULT_AMPL),
-    m_b0 (0.0f),
-    m_b1 (0.0f),
-    m_b2 (0.0f),
-    m_b3 (0.0f),
-    m_b4 (0.0f),
-    m_b5 (0.0f),
-    m_b6 (0.0f)
+    m_pink {},
+    m_brown (0.0f)
 {
     add_param ("type", node_param::INT, &m_param_type);
     add_param ("amplitude", node_param::FLOAT, &m_param_ampl);
@@ -95,21 +89,21 @@ void node_noise::update_noise (sample* buf)
     const sample* ampl = ampl_buf ? (const sample*) &const_range (*ampl_buf)[0] : NULL;
 
     int n_samp = get_info().block_size;
-    sample* out = buf;
+    m_engine.fill (buf, n_samp);
     if (m_param_type == NOISE_PINK)
-	if (ampl)
-	    while (n_samp--)
-		*out++ = update_pink () * (m_param_ampl + m_param_ampl * *ampl++);
-	else
-	    while (n_samp--)
-		*out++ = update_pink () * m_param_ampl;
+	synth::kernels ().pink_filter (m_pink, buf, n_samp);
+    else if (m_param_type == NOISE_BROWN)
+	synth::kernels ().brown_filter (&m_brown, buf, n_samp);
+
+    sample* out = buf;
+    if (ampl)
+	while (n_samp--) {
+	    *out = *out * (m_param_ampl + m_param_ampl * *ampl++);
+	    ++out;
+	}
     else
-	if (ampl)
-	    while (n_samp--)
-		*out++ = update_white () * (m_param_ampl + m_param_ampl * *ampl++);
-	else
-	    while (n_samp--)
-		*out++ = update_white () * m_param_ampl;
+	while (n_samp--)
+	    *out++ *= m_param_ampl;
 
     /* Modulate amplitude with trigger envelope. */
     if (trig_buf) {
@@ -126,29 +120,5 @@ void node_noise::update_noise (sample* buf)
     }
 }
 
-sample node_noise::update_pink ()
-{
-    sample white;
-    sample pink;
-
-    white = update_white () * 0.2;
-
-    m_b0 = 0.99886f * m_b0 + white * 0.0555179f;
-    m_b1 = 0.99332f * m_b1 + white * 0.0750759f;
-    m_b2 = 0.96900f * m_b2 + white * 0.1538520f;
-    m_b3 = 0.86650f * m_b3 + white * 0.3104856f;
-    m_b4 = 0.55000f * m_b4 + white * 0.5329522f;
-    m_b5 = -0.7616f * m_b5 - white * 0.0168980f;
-    pink = m_b0 + m_b1 + m_b2 + m_b3 + m_b4 + m_b5 + m_b6 + white * 0.5362f;
-    m_b6 = white * 0.115926f;
-
-    return pink;
-}
-
-sample node_noise::update_white()
-{
-    return 1.0f - ((rand () % INT_MAX) / (float)INT_MAX * 2.0);
-}
-
 } /* namespace graph */
 } /* namespace psynth */
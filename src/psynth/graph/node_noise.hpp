@@ -26,6 +26,7 @@
 #include <psynth/graph/node.hpp>
 #include <psynth/graph/node_types.hpp>
 #include <psynth/graph/node_factory.hpp>
+#include <psynth/synth/noise.hpp>
 
 namespace psynth
 {
@@ -48,6 +49,7 @@ public:
     enum type {
 	NOISE_WHITE,
 	NOISE_PINK,
+	NOISE_BROWN,
 	N_TYPES
     };
 
@@ -60,22 +62,17 @@ public:
     static constexpr float DEFAULT_AMPL = 0.3f;
 
 protected:
-    sample update_pink ();
-    sample update_white ();
     void update_noise (sample* buf);
 
 private:
     int   m_param_type;
     float m_param_ampl;
 
-    /* Pink noise factors. */
-    sample m_b0;
-    sample m_b1;
-    sample m_b2;
-    sample m_b3;
-    sample m_b4;
-    sample m_b5;
-    sample m_b6;
+    synth::noise_engine m_engine;
+
+    /* Pink and brown filter states. */
+    float m_pink [7];
+    float m_brown;
 
     //bool  m_restart;
 
@@ -28,6 +28,7 @@
 #include "base/logger.hpp"
 #include "base/file_manager.hpp"
 #include "sound/output.hpp"
+#include "sound/expression.hpp"
 #include "synth/util.hpp"
 #include "graph/node_types.hpp"
 #include "graph/node_sampler.hpp"
@@ -64,7 +65,8 @@ node_sampler::node_sampler(const audio_info& info):
     m_param_rate (1.0f),
     m_param_tempo (1.0f),
     m_param_pitch (1.0f),
-    m_restart (false)
+    m_restart (false),
+    m_trig_gain (info.block_size)
 {
     add_param ("file", node_param::STRING, &m_param_file,
 	       boost::bind (&node_sampler::on_file_change, this, _1));
@@ -141,29 +143,19 @@ void node_sampler::do_update (const node0* caller, int caller_port_type, int cal
 	fill_frames (range (*out), audio_frame (0));
 
     /* Set amplitude. */
-    transform_frames (
-        range (*out), range (*out),
-        [&] (audio_frame in) -> audio_frame {
-            static_transform (in, in, [&] (audio_sample in) -> audio_sample {
-                    return in * this->m_param_ampl;
-                });
-            return in;
-        });
-
-    /* Apply trigger envelope. */
+    lazy (range (*out)) *= m_param_ampl;
+
+    /* Apply trigger envelope, the gain is trig * env + (1 - env). */
     if (trig_buf) {
+	const size_t n_samp = get_info ().block_size;
+	m_trig_gain.resize (n_samp);
+	trig_env = get_in_envelope (LINK_CONTROL, IN_C_TRIGGER);
+	synth::blend_envelope (trig_env,
+			       (const sample*) &const_range (*trig)[0],
+			       1.0f, &m_trig_gain [0], n_samp);
 	for (size_t i = 0; i < get_info ().num_channels; ++i) {
 	    sample* buf = (sample*) &range (*out)[0][i];
-	    int n_samp = get_info ().block_size;
-	    trig_buf = (const sample*) &const_range (*trig)[0];
-	    trig_env = get_in_envelope (LINK_CONTROL, IN_C_TRIGGER);
-
-	    while (n_samp--) {
-		float env_val = (float) (audio_sample) trig_env.update();
-		*buf = *buf * ((1.0f - env_val) + (env_val * *trig_buf));
-		++buf;
-		++trig_buf;
-	    }
+	    synth::kernels ().modulate (buf, &m_trig_gain [0], buf, n_samp);
 	}
     }
 
@@ -24,6 +24,7 @@
 #define PSYNTH_OBJECTSAMPLER_H
 
 #include <mutex>
+#include <vector>
 
 #include <psynth/graph/node.hpp>
 #include <psynth/io/file_input.hpp>
@@ -89,6 +90,9 @@ private:
 
     bool m_restart;
 
+    /* Gain applied by the trigger, through its envelope. */
+    std::vector<float> m_trig_gain;
+
     std::string m_param_file;
 
     std::mutex m_update_mutex;
@@ -59,6 +59,8 @@ PSYNTH_DECLARE_ALSA_FORMAT (sound::bits8,    SND_PCM_FORMAT_U8);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits8s,   SND_PCM_FORMAT_S8);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits16,   SND_PCM_FORMAT_U16);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits16s,  SND_PCM_FORMAT_S16);
+PSYNTH_DECLARE_ALSA_FORMAT (sound::bits24,   SND_PCM_FORMAT_U24_3LE);
+PSYNTH_DECLARE_ALSA_FORMAT (sound::bits24s,  SND_PCM_FORMAT_S24_3LE);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits32,   SND_PCM_FORMAT_U32);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits32s,  SND_PCM_FORMAT_S32);
 PSYNTH_DECLARE_ALSA_FORMAT (sound::bits32sf, SND_PCM_FORMAT_FLOAT);
@@ -31,6 +31,7 @@
 #ifndef PSYNTH_IO_BUFFERED_INPUT_TPP_
 #define PSYNTH_IO_BUFFERED_INPUT_TPP_
 
+#include <psynth/synth/util.hpp>
 #include <psynth/io/buffered_input.hpp>
 
 namespace psynth
@@ -81,7 +82,7 @@ std::size_t buffered_input_impl<Ir, Op>::take (const Range& data)
         auto dst = sub_range (sound::range (_buffer), 0, to_read);
         old_read = read;
         read += _input_ptr->take (dst);
-        copy_and_convert_frames (dst, src);
+        synth::convert_frames (dst, src);
     }
 
     return read;
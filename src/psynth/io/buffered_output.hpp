@@ -42,6 +42,7 @@
 
 #include <psynth/base/type_traits.hpp>
 #include <psynth/sound/metafunctions.hpp>
+#include <psynth/synth/util.hpp>
 #include <psynth/io/output.hpp>
 
 namespace psynth
@@ -70,6 +71,7 @@ public:
     buffered_output_impl (OutputPtr output_ptr = 0)
         : _buffer (default_output_buffer_size)
         , _output_ptr (output_ptr)
+        , _use_dither (false)
     {}
 
     std::size_t put (const const_range& data);
@@ -89,14 +91,26 @@ public:
     void set_buffer_size (std::size_t new_size)
     { _buffer.recreate (new_size); }
 
+    /**
+     * Enables adding TPDF dither when the output has 16 or 24 bit
+     * samples. It is disabled by default.
+     */
+    void set_dither (bool enable)
+    { _use_dither = enable; }
+
+    bool dither () const
+    { return _use_dither; }
+
 protected:
     void set_output (OutputPtr ptr)
     {
         _output_ptr = ptr;
     }
 
-    buffer_type _buffer;
-    OutputPtr   _output_ptr;
+    buffer_type        _buffer;
+    OutputPtr          _output_ptr;
+    synth::tpdf_dither _dither;
+    bool               _use_dither;
 };
 
 template <class Base, class OutputPtr>
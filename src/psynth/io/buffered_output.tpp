@@ -32,6 +32,7 @@
 #define PSYNTH_IO_BUFFERED_OUTPUT_TPP_
 
 #include <psynth/sound/buffer.hpp>
+#include <psynth/synth/util.hpp>
 #include <psynth/io/buffered_output.hpp>
 
 namespace psynth
@@ -81,7 +82,7 @@ std::size_t buffered_output_impl<Ir, Op>::put (const Range& data)
         auto src = sub_range (data, written, to_write);
         auto dst = sub_range (sound::range (_buffer), 0, to_write);
         old_written = written;
-        copy_and_convert_frames (src, dst);
+        synth::convert_frames (src, dst, _use_dither ? &_dither : 0);
         written += _output_ptr->put (dst);
     }
 
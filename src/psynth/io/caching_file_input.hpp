@@ -43,7 +43,7 @@
 #include <boost/pointee.hpp>
 
 #include <psynth/sound/metafunctions.hpp>
-#include <psynth/sound/ring_buffer.hpp>
+#include <psynth/sound/spsc_ring_buffer.hpp>
 #include <psynth/io/file_common.hpp>
 #include <psynth/io/async_base.hpp>
 
@@ -105,6 +105,10 @@ public:
     bool is_backwards () const
     { return _backwards; }
 
+    /**
+     * Like seek (), this must be called from the thread that calls
+     * take ().
+     */
     void set_backwards (bool backwards);
 
     /** @todo Synchronization? */
@@ -130,7 +134,11 @@ public:
     typedef typename sound::buffer_from_range<range>::type
     buffer_type;
 
-    typedef sound::ring_buffer<buffer_type> ring_buffer_type;
+    /**
+     * Written by the caching thread and read by the one calling
+     * take (), which thus never locks unless the cache is empty.
+     */
+    typedef sound::spsc_ring_buffer<buffer_type> ring_buffer_type;
 
     void set_input (InputPtr ptr);
 
@@ -145,7 +153,6 @@ public:
     input_buffer_type                   _tmp_buffer;
     ring_buffer_type                    _buffer;
     typename ring_buffer_type::range&   _range;
-    typename ring_buffer_type::position _read_ptr;
 
     bool           _backwards;
     std::ptrdiff_t _read_pos;
@@ -155,7 +162,7 @@ public:
 
     std::thread             _thread;
     std::mutex              _input_mutex;
-    std::mutex              _buffer_mutex;
+    std::mutex              _cond_mutex;
     std::condition_variable _cond;
 
     void run ();
@@ -31,6 +31,8 @@
 #ifndef PSYNTH_IO_CACHING_FILE_READER_TPP_
 #define PSYNTH_IO_CACHING_FILE_READER_TPP_
 
+#include <algorithm>
+
 #include <psynth/io/caching_file_input.hpp>
 
 namespace psynth
@@ -74,7 +76,6 @@ caching_file_input_impl<R, I>::caching_file_input_impl (
     , _tmp_buffer (threshold)
     , _buffer (buffer_size)
     , _range (sound::range (_buffer))
-    , _read_ptr (_range.end_pos ())
     , _backwards (false)
     , _read_pos (0)
     , _new_read_pos (_read_pos)
@@ -83,33 +84,38 @@ caching_file_input_impl<R, I>::caching_file_input_impl (
     assert (chunk_size < threshold && threshold < buffer_size);
 }
 
+/**
+ * The cached frames are in the old direction, so they are discarded
+ * and the caching thread starts reading again from the frame that
+ * would have been returned next.
+ */
 template <class R, class I>
 void caching_file_input_impl<R, I>::set_backwards (bool backwards)
 {
     if (_backwards != backwards)
     {
- 	std::unique_lock<std::mutex> buffer_lock (_buffer_mutex);
-        std::unique_lock<std::mutex> input_lock  (_input_mutex);
-
-        std::ptrdiff_t old_avail = _range.available (_read_ptr);
-
-	_backwards = backwards;
-	_range.set_backwards ();
-	_read_ptr = _range.sync (_read_ptr);
-
-        std::ptrdiff_t new_avail  = _range.available (_read_ptr);
-        std::ptrdiff_t diff_avail = new_avail - old_avail;
-
-	/* Fix reading position. */
-	if (_backwards) {
-	    _new_read_pos = _read_pos + diff_avail;
-	    if (_new_read_pos < 0)
-		_new_read_pos += _chunk_size;
-	} else {
-	    _new_read_pos += _read_pos + diff_avail;
-	    if (_new_read_pos >= std::ptrdiff_t (_chunk_size))
-		_new_read_pos -= _chunk_size;
-	}
+        {
+            std::unique_lock<std::mutex> input_lock (_input_mutex);
+
+            const std::ptrdiff_t avail = _range.available ();
+            std::ptrdiff_t pos = _backwards ?
+                _read_pos + avail :
+                _read_pos - avail;
+
+            if (_input)
+            {
+                const std::ptrdiff_t length = _input->length ();
+                if (pos < 0)
+                    pos += length;
+                else if (pos > length)
+                    pos -= length;
+            }
+
+            _range.clear ();
+            _backwards    = backwards;
+            _new_read_pos = pos;
+        }
+        _cond.notify_all ();
     }
 }
 
@@ -123,49 +129,39 @@ template <class R, class I>
 std::size_t caching_file_input_impl<R, I>::seek (
     std::ptrdiff_t offset, seek_dir dir)
 {
-    std::unique_lock<std::mutex> buffer_lock (_buffer_mutex);
     {
-        std::unique_lock<std::mutex> input_lock  (_input_mutex);
+        std::unique_lock<std::mutex> input_lock (_input_mutex);
 
-        _read_pos = _input->seek (offset, dir);
-        _read_ptr = _range.end_pos ();
+        _read_pos = _new_read_pos = _input->seek (offset, dir);
+        _range.clear ();
     }
     _cond.notify_all();
     return _read_pos;
 }
 
 /**
- * @todo Fix potential performance lost with the std::reverse, think
- * of an override in psynth::sound.
+ * This only blocks when the cache is empty. Otherwise the frames are
+ * taken from the lock free ring buffer and the caching thread is
+ * woken up when it runs under the threshold.
  */
 template <class R, class I>
 template <typename Range>
 std::size_t caching_file_input_impl<R, I>::take (const Range& buf)
 {
-    std::size_t nsamples = buf.size ();
-    std::size_t nread;
-
+    if (!_range.available ())
     {
-	std::unique_lock<std::mutex> lock (_buffer_mutex);
-
-	while (_range.available (_read_ptr) <= 0)
+        std::unique_lock<std::mutex> lock (_cond_mutex);
+        _cond.notify_all ();
+        while (!_range.available ())
             _cond.wait (lock);
+    }
 
-	nread = std::min<std::size_t> (nsamples, _range.available (_read_ptr));
-
-        if (nread)
-        {
-            _range.read_and_convert (_read_ptr, sub_range (buf, 0, nread));
-
-            // TODO: Why is ring_buffer_range::size_type signed?
-	    if ((std::size_t) _range.available (_read_ptr) < _threshold)
-		_cond.notify_all ();
+    const std::size_t nread = _range.read_and_convert (
+        sub_range (buf, 0, std::min<std::size_t> (buf.size (),
+                                                  _range.available ())));
 
-	    lock.unlock ();
-	    if (_backwards)
-                std::reverse (buf.begin (), buf.begin () + nread);
-	}
-    }
+    if ((std::size_t) _range.available () < _threshold)
+        _cond.notify_all ();
 
     return nread;
 }
@@ -222,6 +218,10 @@ void caching_file_input_impl<R, I>::run ()
                     sound::range (_tmp_buffer), 0, must_read);
 		nread = _input->take (block);
 
+		/* Frames are cached in the order they will be taken. */
+		if (_backwards)
+		    std::reverse (block.begin (), block.begin () + nread);
+
 		/* Check wether whe have finished reading and loop. */
                 if (!_backwards)
                 {
@@ -230,23 +230,24 @@ void caching_file_input_impl<R, I>::run ()
                     if (!nread)
                         _new_read_pos = 0;
                 }
+
+                /*
+                 * Written while holding the input lock, so seeking and
+                 * changing the direction can safely discard the
+                 * cached frames.
+                 */
+                if (nread)
+                    _range.write_and_convert (
+                        sound::sub_range (block, 0, nread));
 	    }
 	} /* lock _input_mutex */
 
-	/* Add it to the buffer. */
-	if (nread)
-        {
-	    std::unique_lock<std::mutex> lock (_buffer_mutex);
-            auto block = sound::sub_range (sound::range (_tmp_buffer), 0, nread);
-            _range.write_and_convert (block);
-            _cond.notify_all ();
-	}
-
 	/* Wait until more data is needed. */
 	{
-	    std::unique_lock<std::mutex> lock (_buffer_mutex);
+	    std::unique_lock<std::mutex> lock (_cond_mutex);
+	    _cond.notify_all ();
 	    while (!_finished &&
-		   ((std::size_t) _range.available (_read_ptr) > _threshold
+		   ((std::size_t) _range.available () > _threshold
                     || !_input))
 		_cond.wait (lock);
 	}
@@ -257,7 +258,10 @@ template <class R, class I>
 void caching_file_input_impl<R, I>::stop ()
 {
     _finished = true;
-    _cond.notify_all ();
+    {
+        std::unique_lock<std::mutex> lock (_cond_mutex);
+        _cond.notify_all ();
+    }
     _thread.join ();
     _finished = false;
 }
@@ -266,9 +270,8 @@ void caching_file_input_impl<R, I>::stop ()
 template <class R, class I>
 void caching_file_input_impl<R, I>::set_input (I input)
 {
-    std::unique_lock<std::mutex> buffer_lock (_buffer_mutex);
     {
-        std::unique_lock<std::mutex> input_lock  (_input_mutex);
+        std::unique_lock<std::mutex> input_lock (_input_mutex);
         _input = input;
     }
     _cond.notify_all();
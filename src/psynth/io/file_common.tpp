@@ -54,6 +54,12 @@ namespace mpl = boost::mpl;
 namespace detail
 {
 
+/**
+ * Number of samples converted at once for the formats that
+ * libsndfile does not take directly.
+ */
+constexpr std::size_t file_chunk_size = 1024;
+
 template <class Sample>
 struct file_format : public mpl::int_<SF_FORMAT_ENDMASK> {};
 
@@ -67,6 +73,7 @@ struct file_format : public mpl::int_<SF_FORMAT_ENDMASK> {};
 // PSYNTH_DECLARE_ALSA_FORMAT (sound::bits8s,   SF_FORMAT_PCM_S8);
 
 PSYNTH_DECLARE_FILE_FORMAT (sound::bits16s,  SF_FORMAT_PCM_16);
+PSYNTH_DECLARE_FILE_FORMAT (sound::bits24s,  SF_FORMAT_PCM_24);
 PSYNTH_DECLARE_FILE_FORMAT (sound::bits32s,  SF_FORMAT_PCM_32);
 PSYNTH_DECLARE_FILE_FORMAT (sound::bits32sf, SF_FORMAT_FLOAT);
 
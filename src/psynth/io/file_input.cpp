@@ -28,6 +28,8 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
 #include "file_input.hpp"
 
 namespace psynth
@@ -69,6 +71,29 @@ file_input_take_impl (SNDFILE* file, sound::bits32sf* ptr, std::size_t frames)
     return res;
 }
 
+std::size_t
+file_input_take_impl (SNDFILE* file, sound::bits24s* ptr,
+                      std::size_t frames, std::size_t channels)
+{
+    int buf [file_chunk_size];
+    const std::size_t chunk = file_chunk_size / channels;
+    std::size_t nread = 0;
+
+    while (nread < frames)
+    {
+        const std::size_t count = std::min (chunk, frames - nread);
+        const sf_count_t res = sf_readf_int (file, buf, count);
+        for (std::size_t i = 0; i < std::size_t (res) * channels; ++i)
+            ptr [nread * channels + i] = buf [i] >> 8;
+
+        nread += res;
+        if (res < sf_count_t (count))
+            break;
+    }
+
+    return nread;
+}
+
 } /* namespace detail */
 
 } /* namespace io */
@@ -50,6 +50,21 @@ file_input_take_impl (SNDFILE* file, sound::bits32s* ptr, std::size_t frames);
 std::size_t
 file_input_take_impl (SNDFILE* file, sound::bits32sf* ptr, std::size_t frames);
 
+/**
+ * @see file_output_put_impl
+ */
+std::size_t
+file_input_take_impl (SNDFILE* file, sound::bits24s* ptr,
+                      std::size_t frames, std::size_t channels);
+
+template <typename Sample>
+std::size_t
+file_input_take_impl (SNDFILE* file, Sample* ptr,
+                      std::size_t frames, std::size_t channels)
+{
+    return file_input_take_impl (file, ptr, frames);
+}
+
 } /* namespace detail */
 
 template <class Range>
@@ -79,7 +94,8 @@ std::size_t file_input<Range>::take (const range& data)
     return detail::file_input_take_impl (
         _file,
         &data [0][0],
-        data.size ());
+        data.size (),
+        sound::num_samples<Range>::value);
 }
 
 template <class Range>
@@ -31,6 +31,8 @@
 #define PSYNTH_MODULE_NAME "psynth.io.file"
 
 #include <cassert>
+#include <algorithm>
+#include <cstdint>
 #include "file_output.hpp"
 
 namespace psynth
@@ -70,6 +72,29 @@ file_output_put_impl (SNDFILE* file, const sound::bits32sf* ptr, std::size_t fra
     return sf_writef_float (file, reinterpret_cast<const float*>(ptr), frames);
 }
 
+std::size_t
+file_output_put_impl (SNDFILE* file, const sound::bits24s* ptr,
+                      std::size_t frames, std::size_t channels)
+{
+    int buf [file_chunk_size];
+    const std::size_t chunk = file_chunk_size / channels;
+    std::size_t written = 0;
+
+    while (written < frames)
+    {
+        const std::size_t count = std::min (chunk, frames - written);
+        for (std::size_t i = 0; i < count * channels; ++i)
+            buf [i] = std::int32_t (ptr [written * channels + i]) * 256;
+
+        const sf_count_t res = sf_writef_int (file, buf, count);
+        written += res;
+        if (res < sf_count_t (count))
+            break;
+    }
+
+    return written;
+}
+
 
 } /* namespace detail */
 
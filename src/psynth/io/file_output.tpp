@@ -50,6 +50,22 @@ file_output_put_impl (SNDFILE* file, const sound::bits32s* ptr, std::size_t fram
 std::size_t
 file_output_put_impl (SNDFILE* file, const sound::bits32sf* ptr, std::size_t frames);
 
+/**
+ * libsndfile does not take packed 24 bit samples, they are written
+ * in chunks expanded to int.
+ */
+std::size_t
+file_output_put_impl (SNDFILE* file, const sound::bits24s* ptr,
+                      std::size_t frames, std::size_t channels);
+
+template <typename Sample>
+std::size_t
+file_output_put_impl (SNDFILE* file, const Sample* ptr,
+                      std::size_t frames, std::size_t channels)
+{
+    return file_output_put_impl (file, ptr, frames);
+}
+
 } /* namespace detail */
 
 template <class Range>
@@ -95,7 +111,8 @@ std::size_t file_output<Range>::put (const const_range& data)
     return detail::file_output_put_impl (
         _file,
         &data [0][0],
-        data.size ());
+        data.size (),
+        sound::num_samples<Range>::value);
 }
 
 template <class Range>
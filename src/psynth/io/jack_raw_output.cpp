@@ -34,6 +34,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "base/logger.hpp"
+#include "base/denormal.hpp"
 #include "base/scope_guard.hpp"
 #include "jack_raw_output.hpp"
 
@@ -195,6 +196,7 @@ void jack_raw_output::connect_ports ()
 int jack_raw_output::_process_cb (jack_nframes_t nframes,
                                   void* jack_client)
 {
+    base::denormal_guard denormal_guard;
     static_cast<jack_raw_output*>(jack_client)->_on_process (nframes);
     return 0;
 }
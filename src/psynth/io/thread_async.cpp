@@ -31,6 +31,7 @@
 #define PSYNTH_MODULE_NAME "psynth.io.thread_async"
 
 #include "base/logger.hpp"
+#include "base/denormal.hpp"
 #include "thread_async.hpp"
 
 #if __GTHREADS
@@ -60,6 +61,7 @@ void thread_async::stop ()
 
 void thread_async::run ()
 {
+    base::denormal_guard denormal_guard;
     if (_realtime)
         _request_rt ();
     prepare ();
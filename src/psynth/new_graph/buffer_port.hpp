@@ -31,6 +31,8 @@
 #ifndef PSYNTH_GRAPH_BUFFER_PORT_HPP_
 #define PSYNTH_GRAPH_BUFFER_PORT_HPP_
 
+#include <psynth/base/denormal.hpp>
+#include <psynth/sound/channel_base_algorithm.hpp>
 #include <psynth/new_graph/processor.hpp>
 #include <psynth/new_graph/buffers.hpp>
 #include <psynth/new_graph/port.hpp>
@@ -54,8 +56,21 @@ public:
     virtual typename T::range rt_out_range ()
     { return range (this->rt_get_out ()); }
 
+    std::size_t rt_count_subnormals () const
+    {
+        auto count = std::size_t (0);
+        for (auto f : rt_out_range ())
+            sound::static_for_each (f, [&] (float s) {
+                    count += base::is_subnormal (s);
+                });
+        return count;
+    }
+
     void rt_context_update (rt_process_context& ctx)
-    { this->rt_get_out ().recreate (ctx.block_size ()); }
+    {
+        this->rt_get_out ().recreate (
+            ctx.block_size (), buffer_alignment, ctx.allocator ());
+    }
 };
 
 template <typename T>
@@ -93,7 +108,8 @@ public:
     void rt_context_update (rt_process_context& ctx)
     {
         base_type::rt_context_update (ctx);
-        _default.recreate (ctx.block_size (), _default_value, 0);
+        _default.recreate (ctx.block_size (), _default_value,
+                           buffer_alignment, ctx.allocator ());
     }
 
 private:
@@ -39,25 +39,44 @@
 
 #include <psynth/sound/buffer.hpp>
 #include <psynth/sound/ring_buffer.hpp>
+#include <psynth/sound/spsc_ring_buffer.hpp>
+#include <psynth/sound/mirrored_buffer.hpp>
 #include <psynth/sound/buffer_range.hpp>
 #include <psynth/sound/ring_buffer_range.hpp>
 
 #include <psynth/sound/typedefs.hpp>
+#include <psynth/base/memory.hpp>
 
 namespace psynth
 {
 namespace graph
 {
 
-typedef sound::stereo32sf_planar_buffer            audio_buffer;
+/**
+ * Allocation policy of the graph buffers. Port buffers are allocated
+ * with the processor arena, if any, and every plane starts in its own
+ * cache line.
+ *
+ * @see processor::set_buffer_arena
+ */
+typedef base::arena_allocator<unsigned char>       buffer_allocator;
+constexpr std::size_t buffer_alignment = base::cache_line_size;
+
+typedef sound::buffer<sound::stereo32sf_frame, true, buffer_allocator>
+audio_buffer;
 typedef sound::stereo32sf_planar_range             audio_range;
 typedef sound::stereo32sfc_planar_range            audio_const_range;
 typedef sound::stereo32sf_planar_ring_buffer       audio_ring_buffer;
 typedef sound::stereo32sf_planar_ring_range        audio_ring_range;
+typedef sound::stereo32sf_planar_spsc_ring_buffer  audio_spsc_ring_buffer;
+typedef sound::spsc_ring_buffer<
+    sound::mirrored_buffer<sound::stereo32sf_frame, true> >
+audio_mirrored_ring_buffer;
 typedef audio_range::value_type                    audio_frame;
 typedef sound::bits32sf                            audio_sample;
 
-typedef sound::mono32sf_buffer                     sample_buffer;
+typedef sound::buffer<sound::mono32sf_frame, false, buffer_allocator>
+sample_buffer;
 typedef sound::mono32sf_range                      sample_range;
 typedef sound::mono32sfc_range                     sample_const_range;
 typedef sound::mono32sf_ring_buffer                sample_ring_buffer;
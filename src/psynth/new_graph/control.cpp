@@ -30,8 +30,12 @@
 
 #define PSYNTH_MODULE_NAME "psynth.graph.control"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
+#include "synth/kernels.hpp"
+#include "processor.hpp"
 #include "node.hpp"
 #include "control.hpp"
 
@@ -77,5 +81,84 @@ out_control_base::out_control_base (const std::string& name, node* owner)
         owner->register_component (*this);
 }
 
+smoothed_in_control::smoothed_in_control (const std::string& name,
+                                          node* owner,
+                                          float value,
+                                          smoothing mode,
+                                          float time)
+    : in_control<float> (name, owner, value)
+    , _mode (mode)
+    , _time (time)
+    , _target (value)
+    , _current (value)
+    , _step (0.0f)
+    , _threshold (0.0f)
+    , _length (1)
+    , _remaining (0)
+{
+}
+
+void smoothed_in_control::rt_context_update (rt_process_context& ctx)
+{
+    const allocator_type alloc (ctx.allocator ());
+    const std::size_t n = ctx.block_size ();
+    const float samples = std::max (_time * ctx.frame_rate (), 1.0f);
+
+    // The one pole ramp is target + (current - target) * decay [i].
+    std::vector<float, allocator_type> decay (n, 0.0f, alloc);
+    const float pole = std::exp (-1.0f / samples);
+    float d = 1.0f;
+    for (auto& x : decay)
+        x = d *= pole;
+
+    std::vector<float, allocator_type> ramp (n, 0.0f, alloc);
+    _ramp.swap (ramp);
+    _decay.swap (decay);
+    _length    = std::size_t (samples);
+    _target    = _current = rt_get ();
+    _remaining = 0;
+}
+
+const float* smoothed_in_control::rt_smooth ()
+{
+    if (rt_get () != _target)
+    {
+        _target    = rt_get ();
+        _remaining = _length;
+        _step      = (_target - _current) / _length;
+        _threshold = std::abs (_target - _current) * smoothing_threshold;
+    }
+
+    if (_current == _target || _ramp.empty ())
+    {
+        _current = _target;
+        return 0;
+    }
+
+    const std::size_t n = _ramp.size ();
+    float* ramp = &_ramp [0];
+    if (_mode == smoothing::linear)
+    {
+        assert (_remaining > 0);
+        const std::size_t m = std::min (_remaining, n);
+        synth::kernels ().ramp (ramp, m, _current + _step, _step);
+        std::fill (ramp + m, ramp + n, _target);
+        _remaining -= m;
+        if (!_remaining)
+            ramp [m - 1] = _target;
+        _current = ramp [n - 1];
+    }
+    else
+    {
+        const float delta = _current - _target;
+        for (std::size_t i = 0; i < n; ++i)
+            ramp [i] = _target + delta * _decay [i];
+        _current = std::abs (delta * _decay [n - 1]) > _threshold ?
+            ramp [n - 1] : _target;
+    }
+
+    return ramp;
+}
+
 } /* namespace graph */
 } /* namespace psynth */
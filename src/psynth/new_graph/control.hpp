@@ -34,10 +34,12 @@
 #include <atomic>
 #include <map>
 #include <mutex>
+#include <vector>
 
 #include <boost/any.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <psynth/base/memory.hpp>
 #include <psynth/base/type_value.hpp>
 #include <psynth/new_graph/node_fwd.hpp>
 #include <psynth/new_graph/event.hpp>
@@ -99,6 +101,7 @@ class in_control_base : public control_base
 {
 public:
     virtual void str (const std::string& s) = 0;
+    virtual void rt_context_update (rt_process_context&) {}
 
     template <typename T>
     T get () const;
@@ -322,6 +325,83 @@ private:
     bool _is_updated;
 };
 
+/**
+ *  How a smoothed_in_control follows a change of its value.
+ */
+enum class smoothing
+{
+    /** A straight line, reaching the new value in the smoothing time. */
+    linear,
+    /**
+     *  An exponential approach whose time constant is the smoothing
+     *  time, that stops once it is within smoothing_threshold of the
+     *  size of the change.
+     */
+    one_pole
+};
+
+constexpr float default_smoothing_time = 0.02f;
+constexpr float smoothing_threshold = 1e-4f;
+
+/**
+ *  A float control whose changes are smoothed in the real time
+ *  thread, so that parameters applied once per block do not step.
+ *
+ *  The node calls rt_smooth () once per block to get the values of
+ *  the control for every sample of the block. The ramp is only
+ *  computed while the value is changing: otherwise it returns null,
+ *  and the node can use the scalar rt_get_smoothed () as before.
+ */
+class smoothed_in_control : public in_control<float>
+{
+public:
+    typedef base::arena_allocator<float> allocator_type;
+
+    smoothed_in_control (const std::string& name,
+                         node* owner = 0,
+                         float value = 0.0f,
+                         smoothing mode = smoothing::linear,
+                         float time = default_smoothing_time);
+
+    smoothing mode () const
+    { return _mode; }
+
+    float time () const
+    { return _time; }
+
+    /**
+     *  Sizes the ramp for the block size and jumps to the current
+     *  value, which a running smoothing would otherwise start from.
+     */
+    void rt_context_update (rt_process_context& ctx);
+
+    /**
+     *  Advances the smoothing by a block. Returns the values of the
+     *  control for every sample of the block, the last of which is
+     *  rt_get_smoothed (), or null when it is rt_get_smoothed () for
+     *  the whole block.
+     */
+    const float* rt_smooth ();
+
+    /**
+     *  The smoothed value at the end of the last block.
+     */
+    float rt_get_smoothed () const
+    { return _current; }
+
+private:
+    smoothing   _mode;
+    float       _time;
+    float       _target;
+    float       _current;
+    float       _step;
+    float       _threshold;
+    std::size_t _length;
+    std::size_t _remaining;
+    std::vector<float, allocator_type> _ramp;
+    std::vector<float, allocator_type> _decay;
+};
+
 extern template class in_control<std::string>;
 extern template class in_control<float>;
 extern template class in_control<int>;
@@ -136,6 +136,9 @@ void in_control<T>::set (const T& val)
     {
         _rt_value = val;
     }
+
+    if (this->_has_owner ())
+        this->owner ().notify_change ();
 }
 
 template <typename T>
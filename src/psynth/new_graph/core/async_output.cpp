@@ -29,6 +29,8 @@
  */
 
 #include <iostream>
+#include <algorithm>
+#include <cassert>
 #include "sound/output.hpp"
 
 #include "io/output.hpp"
@@ -54,6 +56,9 @@ constexpr float default_buffer_factor = 4.0f;
 async_output::async_output (device_ptr out)
     : _in_input ("input", this, audio_frame (0))
     , _output (out)
+    , _remainder_pos (0)
+    , _rt_pending (0)
+    , _rt_in_callback (false)
     , _buffer (out ? out->buffer_size () * default_buffer_factor : 0)
 {
     using namespace std::placeholders;
@@ -100,30 +105,69 @@ void async_output::set_output (device_ptr out)
     }
 }
 
+void async_output::rt_on_context_update (rt_process_context& ctx)
+{
+    _remainder.recreate (
+        ctx.block_size (), buffer_alignment, ctx.allocator ());
+    _remainder_pos = _remainder.size ();
+}
+
 void async_output::rt_do_process (rt_process_context& ctx)
 {
-    // This request might come from another thread. Thus, we store it
-    // in the ring buffer. If it was us who made the request and the
-    // buffer size matches the block size, then we'll directly send it
-    // to the device, otherwise we accumulate the results until the
-    // device requests the information.
+    // If it was us who made the request, the block goes straight to
+    // the device and whatever does not fit in the current period is
+    // kept as remainder for the next one. Otherwise, the request
+    // might come from another thread and we store it in the ring
+    // buffer until the device asks for it.
+
+    auto in   = _in_input.rt_in_range ();
+    auto size = std::size_t (in.size ());
 
-    range (_buffer).write (_in_input.rt_in_range ());
+    if (_rt_in_callback && _rt_pending > 0 &&
+        _remainder_pos == std::size_t (_remainder.size ()))
+    {
+        auto direct = std::min (_rt_pending, size);
+        _output->put (sub_range (in, 0, direct));
+        _rt_pending -= direct;
+
+        _remainder_pos = _remainder.size () - (size - direct);
+        sound::copy_frames (sub_range (in, direct, size - direct),
+                            sub_range (range (_remainder), _remainder_pos,
+                                       size - direct));
+    }
+    else
+        range (_buffer).write (in);
 }
 
-void async_output::_output_callback (std::size_t nframes)
+std::size_t async_output::_put_remainder (std::size_t nframes)
 {
-    // FIXME: This needs locking or fixing the ring buffer
-    // implementation to be lock free.
+    auto slice = std::min (nframes, _remainder.size () - _remainder_pos);
+    _output->put (sub_range (range (_remainder), _remainder_pos, slice));
+    _remainder_pos += slice;
+    return nframes - slice;
+}
 
+std::size_t async_output::_put_buffered (std::size_t nframes)
+{
     auto& rng = range (_buffer);
-    while (rng.available (_pos) < (std::ptrdiff_t) nframes)
-        rt_request_process ();
-
-    _output->put (rng.sub_buffer_one (_pos, nframes));
-    _output->put (rng.sub_buffer_two (_pos, nframes));
+    auto slice = std::min<std::size_t> (nframes, rng.available ());
+    _output->put (rng.sub_buffer_one (slice));
+    if (!rng.is_mirrored ())
+        _output->put (rng.sub_buffer_two (slice));
+    rng.skip (slice);
+    return nframes - slice;
+}
 
-    rng.advance (_pos, nframes);
+void async_output::_output_callback (std::size_t nframes)
+{
+    _rt_pending = _put_buffered (_put_remainder (nframes));
+    if (_rt_pending > 0)
+    {
+        _rt_in_callback = true;
+        rt_request_frames (_rt_pending);
+        assert (_rt_pending == 0);
+        _rt_in_callback = false;
+    }
 }
 
 } /* namespace core */
@@ -31,6 +31,8 @@
 #ifndef PSYNTH_GRAPH_CORE_ASYNC_OUTPUT_NODE_HPP_
 #define PSYNTH_GRAPH_CORE_ASYNC_OUTPUT_NODE_HPP_
 
+#include <atomic>
+
 #include <psynth/io/output_fwd.hpp>
 
 #include <psynth/new_graph/control.hpp>
@@ -70,20 +72,36 @@ public:
     void stop ();
 
 protected:
-    void rt_do_update_context (rt_process_context& ctx);
+    void rt_on_context_update (rt_process_context& ctx);
     void rt_do_process (rt_process_context& ctx);
 
 private:
     void _output_callback (std::size_t nframes);
 
-    defaulting_audio_in_port _in_input;
+    std::size_t _put_remainder (std::size_t nframes);
+    std::size_t _put_buffered (std::size_t nframes);
 
-    // FIXME: Actually there is unnecesary buffering here, because we
-    // buffer first to accumulate the output, then to convert it.
+    defaulting_audio_in_port _in_input;
 
     device_ptr         _output;
-    audio_ring_buffer  _buffer;
-    audio_ring_buffer::range::position _pos;
+
+    /**
+     * When the device requests the frames itself they are sent
+     * directly to it. The frames of the last block that did not fit
+     * in the device period are kept here until the next callback.
+     */
+    audio_buffer       _remainder;
+    std::size_t        _remainder_pos;
+    std::size_t        _rt_pending;
+    std::atomic<bool>  _rt_in_callback;
+
+    /**
+     * Blocks processed because of requests from other threads are
+     * accumulated here until the device asks for them. The processor
+     * thread writes and the device thread reads, so it is lock free,
+     * and it is mirrored so the device gets them in a single put.
+     */
+    audio_mirrored_ring_buffer _buffer;
 };
 
 } /* namespace core */
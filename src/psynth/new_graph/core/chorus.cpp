@@ -0,0 +1,318 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        chorus.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Chorus and flanger nodes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "synth/util.hpp"
+#include "chorus.hpp"
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+PSYNTH_REGISTER_NODE_STATIC (audio_chorus);
+PSYNTH_REGISTER_NODE_STATIC (sample_chorus);
+PSYNTH_REGISTER_NODE_STATIC (audio_flanger);
+PSYNTH_REGISTER_NODE_STATIC (sample_flanger);
+
+constexpr float default_chorus_delay  = 0.02f;
+constexpr float default_chorus_depth  = 0.003f;
+constexpr float default_chorus_rate   = 0.8f;
+constexpr int   default_chorus_voices = 2;
+constexpr float default_chorus_wet    = 0.7f;
+constexpr float default_chorus_dry    = 1.0f;
+
+constexpr float default_flanger_delay    = 0.003f;
+constexpr float default_flanger_depth    = 0.002f;
+constexpr float default_flanger_rate     = 0.25f;
+constexpr float default_flanger_feedback = 0.5f;
+constexpr float default_flanger_wet      = 0.7f;
+constexpr float default_flanger_dry      = 0.7f;
+
+/** Larger feedbacks would make the flanger ring forever. */
+constexpr float max_flanger_feedback = 0.99f;
+
+/**
+ * The delay lines are written and read in chunks of this size, so
+ * they do not depend on the block size and taps can stay behind the
+ * samples being written.
+ */
+constexpr std::size_t chunk_size = 64;
+
+namespace
+{
+
+/**
+ * Fills @a times with @a n delays ramping from @a from by @a slope
+ * per sample, plus a triangle of amplitude @a depth starting at @a
+ * phase, kept within [@a lo, @a hi]. @a lfo is scratch space.
+ */
+void sweep (float* times, float* lfo, std::size_t n,
+            float from, float slope,
+            float phase, float speed, float depth,
+            float lo, float hi)
+{
+    const auto& k = synth::kernels ();
+    k.triangle (lfo, n, phase, speed, depth);
+    k.ramp (times, n, from, slope);
+    k.mix (times, lfo, times, n);
+    for (std::size_t i = 0; i < n; ++i)
+        times [i] = std::min (std::max (times [i], lo), hi);
+}
+
+} /* anonymous namespace */
+
+template <class B>
+constexpr float chorus<B>::max_delay;
+
+template <class B>
+constexpr int chorus<B>::max_voices;
+
+template <class B>
+chorus<B>::chorus ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _ctl_delay ("delay", this, default_chorus_delay)
+    , _ctl_depth ("depth", this, default_chorus_depth)
+    , _ctl_rate ("rate", this, default_chorus_rate)
+    , _ctl_voices ("voices", this, default_chorus_voices)
+    , _ctl_wet ("wet", this, default_chorus_wet)
+    , _ctl_dry ("dry", this, default_chorus_dry)
+    , _line (sound::num_samples<typename B::range>::value)
+    , _frame_rate (0)
+    , _last_delay (-1.0f)
+    , _phase (0.0f)
+{
+}
+
+template <class B>
+void chorus<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    if (ctx.frame_rate () == _frame_rate)
+        return;
+
+    _frame_rate = ctx.frame_rate ();
+    _last_delay = -1.0f;
+    _line.recreate (std::size_t (max_delay * _frame_rate) + 1, chunk_size,
+                    synth::delay_line::allocator_type (ctx.allocator ()));
+}
+
+template <class B>
+void chorus<B>::rt_do_process (rt_process_context& ctx)
+{
+    typedef synth::delay_line::interpolation interpolation;
+    constexpr std::size_t channels =
+        sound::num_samples<typename B::range>::value;
+
+    const float* in [channels];
+    float*       out [channels];
+    synth::detail::range_planes (_in_input.rt_in_range (), in);
+    synth::detail::range_planes (_out_output.rt_out_range (), out);
+    const std::size_t n = _out_output.rt_out_range ().size ();
+
+    const float lo = synth::delay_line::min_delay (interpolation::cubic);
+    const float hi = _line.max_delay ();
+    const float depth = std::min (std::max (_ctl_depth.rt_get () *
+                                            _frame_rate, 0.0f),
+                                  (hi - lo) / 2);
+    const float target = std::min (
+        std::max (_ctl_delay.rt_get () * _frame_rate, lo + depth),
+        hi - depth);
+    const float from  = _last_delay < 0.0f ? target : _last_delay;
+    const float slope = n ? (target - from) / n : 0.0f;
+    const float speed = _ctl_rate.rt_get () / _frame_rate;
+    const int   voices = std::min (std::max (_ctl_voices.rt_get (), 1),
+                                   max_voices);
+    _last_delay = target;
+
+    float times [chunk_size];
+    float lfo [chunk_size];
+    float taps [channels][chunk_size];
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t len = std::min (chunk_size, n - i);
+        const float* in_chunk [channels];
+        float*       out_chunk [channels];
+        float*       tap_planes [channels];
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            in_chunk [c]   = in [c] + i;
+            out_chunk [c]  = out [c] + i;
+            tap_planes [c] = taps [c];
+        }
+
+        _line.write_planes (in_chunk, len);
+        for (int v = 0; v < voices; ++v)
+        {
+            sweep (times, lfo, len, from + slope * i, slope,
+                   _phase + float (v) / voices, speed, depth, lo, hi);
+            if (v == 0)
+                _line.read_planes (out_chunk, times, len,
+                                   interpolation::cubic);
+            else
+            {
+                _line.read_planes (tap_planes, times, len,
+                                   interpolation::cubic);
+                for (std::size_t c = 0; c < channels; ++c)
+                    synth::kernels ().mix (out_chunk [c], taps [c],
+                                           out_chunk [c], len);
+            }
+        }
+        _phase += speed * len;
+    }
+    _phase -= std::floor (_phase);
+
+    const float wet = _ctl_wet.rt_get () / voices;
+    const float dry = _ctl_dry.rt_get ();
+    for (std::size_t c = 0; c < channels; ++c)
+        for (std::size_t i = 0; i < n; ++i)
+            out [c][i] = out [c][i] * wet + in [c][i] * dry;
+}
+
+template <class B>
+constexpr float flanger<B>::max_delay;
+
+template <class B>
+flanger<B>::flanger ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _ctl_delay ("delay", this, default_flanger_delay)
+    , _ctl_depth ("depth", this, default_flanger_depth)
+    , _ctl_rate ("rate", this, default_flanger_rate)
+    , _ctl_feedback ("feedback", this, default_flanger_feedback)
+    , _ctl_wet ("wet", this, default_flanger_wet)
+    , _ctl_dry ("dry", this, default_flanger_dry)
+    , _line (sound::num_samples<typename B::range>::value)
+    , _frame_rate (0)
+    , _last_delay (-1.0f)
+    , _phase (0.0f)
+{
+}
+
+template <class B>
+void flanger<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    if (ctx.frame_rate () == _frame_rate)
+        return;
+
+    _frame_rate = ctx.frame_rate ();
+    _last_delay = -1.0f;
+    _line.recreate (std::size_t (max_delay * _frame_rate) + 1, chunk_size,
+                    synth::delay_line::allocator_type (ctx.allocator ()));
+}
+
+/**
+ * The delayed signal is read before writing the samples that feed it
+ * back, so every chunk must be shorter than the shortest delay of
+ * the sweep.
+ */
+template <class B>
+void flanger<B>::rt_do_process (rt_process_context& ctx)
+{
+    typedef synth::delay_line::interpolation interpolation;
+    constexpr std::size_t channels =
+        sound::num_samples<typename B::range>::value;
+
+    const float* in [channels];
+    float*       out [channels];
+    synth::detail::range_planes (_in_input.rt_in_range (), in);
+    synth::detail::range_planes (_out_output.rt_out_range (), out);
+    const std::size_t n = _out_output.rt_out_range ().size ();
+
+    const float lo = synth::delay_line::min_delay (interpolation::cubic);
+    const float hi = _line.max_delay ();
+    const float depth = std::min (std::max (_ctl_depth.rt_get () *
+                                            _frame_rate, 0.0f),
+                                  (hi - lo - 1.0f) / 2);
+    const float target = std::min (
+        std::max (_ctl_delay.rt_get () * _frame_rate, lo + 1.0f + depth),
+        hi - depth);
+    const float from  = _last_delay < 0.0f ? target : _last_delay;
+    const float slope = n ? (target - from) / n : 0.0f;
+    const float speed = _ctl_rate.rt_get () / _frame_rate;
+    _last_delay = target;
+
+    // The depth may have grown since the last block, so this is kept
+    // positive and the sweep is clamped when the delay ramps.
+    const float shortest = std::max (std::min (from, target) - depth - lo,
+                                     1.0f);
+    const float feedback = std::min (std::max (_ctl_feedback.rt_get (),
+                                               -max_flanger_feedback),
+                                     max_flanger_feedback);
+    const float wet      = _ctl_wet.rt_get ();
+    const float dry      = _ctl_dry.rt_get ();
+
+    float times [chunk_size];
+    float lfo [chunk_size];
+    float taps [channels][chunk_size];
+    float back [channels][chunk_size];
+    for (std::size_t i = 0; i < n; )
+    {
+        const std::size_t len = std::min (
+            std::min (chunk_size, n - i), std::size_t (shortest));
+        float* tap_planes [channels];
+        float* back_planes [channels];
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            tap_planes [c]  = taps [c];
+            back_planes [c] = back [c];
+        }
+
+        sweep (times, lfo, len, from + slope * i - len, slope,
+               _phase, speed, depth, lo, hi);
+        _line.read_planes (tap_planes, times, len, interpolation::cubic);
+
+        for (std::size_t c = 0; c < channels; ++c)
+            for (std::size_t j = 0; j < len; ++j)
+            {
+                const float x = in [c][i + j];
+                back [c][j]    = x + feedback * taps [c][j];
+                out [c][i + j] = x * dry + taps [c][j] * wet;
+            }
+
+        _line.write_planes (back_planes, len);
+        _phase += speed * len;
+        i += len;
+    }
+    _phase -= std::floor (_phase);
+}
+
+template class chorus<audio_buffer>;
+template class chorus<sample_buffer>;
+template class flanger<audio_buffer>;
+template class flanger<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
@@ -0,0 +1,155 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        chorus.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Chorus and flanger nodes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_CORE_CHORUS_HPP_
+#define PSYNTH_GRAPH_CORE_CHORUS_HPP_
+
+#include <psynth/synth/delay_line.hpp>
+#include <psynth/new_graph/node.hpp>
+#include <psynth/new_graph/soft_buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+/**
+ *  Chorus node, mixing the input with a few copies of it whose delay
+ *  sweeps around a base delay, each one with a different phase of a
+ *  triangle low frequency oscillator.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input" : Buffer
+ *
+ *  Params:
+ *    "delay"  : float, base delay in seconds
+ *    "depth"  : float, amplitude of the sweep in seconds
+ *    "rate"   : float, frequency of the sweep
+ *    "voices" : int, between 1 and max_voices
+ *    "wet"    : float, gain of the delayed voices
+ *    "dry"    : float, gain of the input signal
+ */
+template <class Buffer>
+class chorus : public node
+{
+public:
+    static constexpr float max_delay = 0.1f;
+    static constexpr int   max_voices = 4;
+
+    chorus ();
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+
+    in_control<float> _ctl_delay;
+    in_control<float> _ctl_depth;
+    in_control<float> _ctl_rate;
+    in_control<int>   _ctl_voices;
+    in_control<float> _ctl_wet;
+    in_control<float> _ctl_dry;
+
+    synth::delay_line _line;
+    std::size_t _frame_rate;
+    float _last_delay;
+    float _phase;
+};
+
+/**
+ *  Flanger node, mixing the input with a copy of it whose short delay
+ *  sweeps with a triangle low frequency oscillator, and that is fed
+ *  back into the delay.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input" : Buffer
+ *
+ *  Params:
+ *    "delay"    : float, base delay in seconds
+ *    "depth"    : float, amplitude of the sweep in seconds
+ *    "rate"     : float, frequency of the sweep
+ *    "feedback" : float, gain of the delayed signal fed back
+ *    "wet"      : float, gain of the delayed signal
+ *    "dry"      : float, gain of the input signal
+ */
+template <class Buffer>
+class flanger : public node
+{
+public:
+    static constexpr float max_delay = 0.1f;
+
+    flanger ();
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+
+    in_control<float> _ctl_delay;
+    in_control<float> _ctl_depth;
+    in_control<float> _ctl_rate;
+    in_control<float> _ctl_feedback;
+    in_control<float> _ctl_wet;
+    in_control<float> _ctl_dry;
+
+    synth::delay_line _line;
+    std::size_t _frame_rate;
+    float _last_delay;
+    float _phase;
+};
+
+typedef chorus<audio_buffer>   audio_chorus;
+typedef chorus<sample_buffer>  sample_chorus;
+typedef flanger<audio_buffer>  audio_flanger;
+typedef flanger<sample_buffer> sample_flanger;
+
+extern template class chorus<audio_buffer>;
+extern template class chorus<sample_buffer>;
+extern template class flanger<audio_buffer>;
+extern template class flanger<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_CHORUS_HPP_ */
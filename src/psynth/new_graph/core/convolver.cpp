@@ -0,0 +1,182 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        convolver.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Convolution node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#define PSYNTH_MODULE_NAME "psynth.graph.core.convolver"
+
+#include <algorithm>
+
+#include "base/logger.hpp"
+#include "synth/util.hpp"
+#include "convolver.hpp"
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+PSYNTH_REGISTER_NODE_STATIC (audio_convolver);
+PSYNTH_REGISTER_NODE_STATIC (sample_convolver);
+
+constexpr float default_wet = 1.0f;
+constexpr float default_dry = 0.0f;
+
+template <class B>
+convolver<B>::convolver ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _ctl_wet ("wet", this, default_wet)
+    , _ctl_dry ("dry", this, default_dry)
+    , _generation (0)
+    , _rt_state (std::make_shared<rt_state> ())
+{
+}
+
+template <class B>
+typename convolver<B>::engine_ptr
+convolver<B>::_make_engine (const impulse_ptr& ir, std::size_t block_size)
+{
+    if (block_size < 2 || (block_size & (block_size - 1)))
+    {
+        PSYNTH_LOG << base::log::warning
+                   << "Can not convolve blocks of " << block_size
+                   << " frames, it is not a power of two.";
+        return engine_ptr ();
+    }
+
+    return std::make_shared<synth::convolver> (
+        ir->empty () ? 0 : &(*ir) [0], ir->size (), block_size,
+        sound::num_samples<typename B::range>::value);
+}
+
+template <class B>
+void convolver<B>::set_impulse (std::vector<float> ir)
+{
+    auto impulse = std::make_shared<const std::vector<float> > (
+        std::move (ir));
+    ++_generation;
+
+    if (is_attached_to_process () && process ().is_running ())
+    {
+        auto& ctx = process ().context ();
+        ctx.push_job (prepare_job (_rt_state, impulse, ctx.block_size (),
+                                   _generation));
+    }
+    else
+    {
+        _rt_state->impulse    = impulse;
+        _rt_state->generation = _generation;
+        _rt_state->engine     = is_attached_to_process () ?
+            _make_engine (impulse, process ().context ().block_size ()) :
+            engine_ptr ();
+    }
+}
+
+template <class B>
+void convolver<B>::prepare_job::operator () (async_process_context& ctx) const
+{
+    auto state = _state.lock ();
+    if (state)
+        ctx.push_rt_event<rt_engine_event> (
+            std::move (state), _make_engine (_ir, _block_size), _ir,
+            _block_size, _generation);
+}
+
+template <class B>
+void convolver<B>::rt_engine_event::operator () (rt_process_context& ctx)
+{
+    // Jobs may finish in any order, only newer responses are taken.
+    if (_generation >= _state->generation)
+    {
+        std::swap (_state->impulse, _ir);
+        _state->generation = _generation;
+        if (_block_size == ctx.block_size ())
+            std::swap (_state->engine, _engine);
+        else
+            ctx.push_job (prepare_job (_state, _state->impulse,
+                                       ctx.block_size (), _generation));
+    }
+
+    // If the node was removed meanwhile, this may be the last
+    // reference to its state.
+    ctx.push_async_event<async_release_event> (
+        std::move (_engine), std::move (_ir), std::move (_state));
+}
+
+template <class B>
+void convolver<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    auto& state = *_rt_state;
+    if (!state.impulse ||
+        (state.engine && state.engine->block_size () == ctx.block_size ()))
+        return;
+
+    if (process ().is_running ())
+        ctx.push_job (prepare_job (_rt_state, state.impulse,
+                                   ctx.block_size (), state.generation));
+    else
+        state.engine = _make_engine (state.impulse, ctx.block_size ());
+}
+
+template <class B>
+void convolver<B>::rt_do_process (rt_process_context& ctx)
+{
+    constexpr std::size_t channels =
+        sound::num_samples<typename B::range>::value;
+
+    const float* in [channels];
+    float*       out [channels];
+    synth::detail::range_planes (_in_input.rt_in_range (), in);
+    synth::detail::range_planes (_out_output.rt_out_range (), out);
+
+    const std::size_t n = _out_output.rt_out_range ().size ();
+    auto& engine = _rt_state->engine;
+    if (engine && engine->block_size () == n)
+        engine->update_planes (in, out, n);
+    else
+        for (std::size_t c = 0; c < channels; ++c)
+            std::fill_n (out [c], n, 0.0f);
+
+    const float wet = _ctl_wet.rt_get ();
+    const float dry = _ctl_dry.rt_get ();
+    for (std::size_t c = 0; c < channels; ++c)
+        for (std::size_t i = 0; i < n; ++i)
+            out [c][i] = out [c][i] * wet + in [c][i] * dry;
+}
+
+template class convolver<audio_buffer>;
+template class convolver<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
@@ -0,0 +1,174 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        convolver.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Convolution node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#ifndef PSYNTH_GRAPH_CORE_CONVOLVER_HPP_
+#define PSYNTH_GRAPH_CORE_CONVOLVER_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <psynth/synth/convolver.hpp>
+#include <psynth/new_graph/node.hpp>
+#include <psynth/new_graph/soft_buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+/**
+ *  Convolution node, a synth::convolver applying the same impulse
+ *  response to every channel, as for reverbs or speaker cabinets.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input"  : Buffer
+ *
+ *  Params:
+ *    "wet" : float, gain of the convolved signal
+ *    "dry" : float, gain of the input signal
+ */
+template <class Buffer>
+class convolver : public node
+{
+public:
+    convolver ();
+
+    /**
+     * Uses the impulse response @a ir from now on. When the processor
+     * is running the response is prepared by a job in its job pool,
+     * and the previous one keeps being used until it is ready.
+     */
+    void set_impulse (std::vector<float> ir);
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+private:
+    typedef std::shared_ptr<const std::vector<float> > impulse_ptr;
+    typedef std::shared_ptr<synth::convolver>          engine_ptr;
+
+    /**
+     * The response and engine used by the real-time thread. It is
+     * shared with the jobs and events that prepare new engines, so
+     * they can outlive the node. Once the node is gone they drop
+     * their result.
+     */
+    struct rt_state
+    {
+        std::size_t generation;
+        impulse_ptr impulse;
+        engine_ptr  engine;
+    };
+
+    typedef std::shared_ptr<rt_state> rt_state_ptr;
+    typedef std::weak_ptr<rt_state>   rt_state_weak_ptr;
+
+    static engine_ptr _make_engine (const impulse_ptr& ir,
+                                    std::size_t block_size);
+
+    struct prepare_job
+    {
+        prepare_job (rt_state_weak_ptr state, impulse_ptr ir,
+                     std::size_t block_size, std::size_t generation)
+            : _state (std::move (state)), _ir (std::move (ir))
+            , _block_size (block_size), _generation (generation) {}
+        void operator () (async_process_context& ctx) const;
+    private:
+        rt_state_weak_ptr _state;
+        impulse_ptr       _ir;
+        std::size_t       _block_size;
+        std::size_t       _generation;
+    };
+
+    struct rt_engine_event : public rt_event
+    {
+        rt_engine_event (rt_state_ptr state, engine_ptr engine,
+                         impulse_ptr ir, std::size_t block_size,
+                         std::size_t generation)
+            : _state (std::move (state))
+            , _engine (std::move (engine)), _ir (std::move (ir))
+            , _block_size (block_size), _generation (generation) {}
+        void operator () (rt_process_context& ctx);
+    private:
+        rt_state_ptr _state;
+        engine_ptr   _engine;
+        impulse_ptr  _ir;
+        std::size_t  _block_size;
+        std::size_t  _generation;
+    };
+
+    /**
+     * Takes the engines and responses that are no longer used, such
+     * that they are freed by the asynchronous thread. It may also
+     * take the last reference to the state of a removed node.
+     */
+    struct async_release_event : public async_event
+    {
+        async_release_event (engine_ptr engine, impulse_ptr ir,
+                             rt_state_ptr state)
+            : _engine (std::move (engine)), _ir (std::move (ir))
+            , _state (std::move (state)) {}
+        void operator () (async_process_context& ctx) {}
+    private:
+        engine_ptr   _engine;
+        impulse_ptr  _ir;
+        rt_state_ptr _state;
+    };
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+
+    in_control<float> _ctl_wet;
+    in_control<float> _ctl_dry;
+
+    std::size_t  _generation;
+    rt_state_ptr _rt_state;
+};
+
+typedef convolver<audio_buffer>  audio_convolver;
+typedef convolver<sample_buffer> sample_convolver;
+
+extern template class convolver<audio_buffer>;
+extern template class convolver<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_CONVOLVER_HPP_ */
@@ -0,0 +1,274 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        delay.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Delay and echo nodes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include "synth/util.hpp"
+#include "delay.hpp"
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+PSYNTH_REGISTER_NODE_STATIC (audio_delay);
+PSYNTH_REGISTER_NODE_STATIC (sample_delay);
+PSYNTH_REGISTER_NODE_STATIC (audio_echo);
+PSYNTH_REGISTER_NODE_STATIC (sample_echo);
+
+constexpr float default_delay_time = 0.3f;
+constexpr float default_delay_wet  = 0.5f;
+constexpr float default_delay_dry  = 1.0f;
+
+constexpr float default_echo_time     = 0.5f;
+constexpr float default_echo_feedback = 0.5f;
+constexpr float default_echo_damping  = 0.3f;
+constexpr float default_echo_wet      = 1.0f;
+constexpr float default_echo_dry      = 1.0f;
+
+/**
+ * The delay lines are written and read in chunks of this size, so
+ * they do not depend on the block size and taps can stay behind the
+ * samples being written.
+ */
+constexpr std::size_t chunk_size = 64;
+
+template <class B>
+constexpr float delay<B>::max_delay;
+
+template <class B>
+delay<B>::delay ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _in_delay ("delay", this, 0.0f)
+    , _ctl_delay ("delay", this, default_delay_time)
+    , _ctl_wet ("wet", this, default_delay_wet)
+    , _ctl_dry ("dry", this, default_delay_dry)
+    , _line (sound::num_samples<typename B::range>::value)
+    , _frame_rate (0)
+    , _last_delay (-1.0f)
+{
+}
+
+template <class B>
+void delay<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    if (ctx.frame_rate () == _frame_rate)
+        return;
+
+    _frame_rate = ctx.frame_rate ();
+    _last_delay = -1.0f;
+    _line.recreate (std::size_t (max_delay * _frame_rate) + 1, chunk_size,
+                    synth::delay_line::allocator_type (ctx.allocator ()));
+}
+
+template <class B>
+void delay<B>::rt_do_process (rt_process_context& ctx)
+{
+    typedef synth::delay_line::interpolation interpolation;
+    constexpr std::size_t channels =
+        sound::num_samples<typename B::range>::value;
+
+    const float* in [channels];
+    float*       out [channels];
+    synth::detail::range_planes (_in_input.rt_in_range (), in);
+    synth::detail::range_planes (_out_output.rt_out_range (), out);
+    const std::size_t n = _out_output.rt_out_range ().size ();
+
+    const float lo = synth::delay_line::min_delay (interpolation::cubic);
+    const float hi = _line.max_delay ();
+    const float target = std::min (
+        std::max (_ctl_delay.rt_get () * _frame_rate, lo), hi);
+    const float from  = _last_delay < 0.0f ? target : _last_delay;
+    const float slope = n ? (target - from) / n : 0.0f;
+    _last_delay = target;
+
+    const float* mod = 0;
+    if (_in_delay.rt_in_available ())
+    {
+        const float* mod_plane [1];
+        synth::detail::range_planes (_in_delay.rt_in_range (), mod_plane);
+        mod = mod_plane [0];
+    }
+
+    float times [chunk_size];
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t len = std::min (chunk_size, n - i);
+        const float* in_chunk [channels];
+        float*       out_chunk [channels];
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            in_chunk [c]  = in [c] + i;
+            out_chunk [c] = out [c] + i;
+        }
+
+        _line.write_planes (in_chunk, len);
+        if (mod)
+        {
+            for (std::size_t j = 0; j < len; ++j)
+            {
+                const float t =
+                    (from + slope * (i + j)) * (1.0f + mod [i + j]);
+                times [j] = std::min (std::max (t, lo), hi);
+            }
+            _line.read_planes (out_chunk, times, len, interpolation::cubic);
+        }
+        else
+            _line.read_planes (out_chunk, from + slope * i,
+                               from + slope * (i + len), len,
+                               interpolation::cubic);
+    }
+
+    const float wet = _ctl_wet.rt_get ();
+    const float dry = _ctl_dry.rt_get ();
+    for (std::size_t c = 0; c < channels; ++c)
+        for (std::size_t i = 0; i < n; ++i)
+            out [c][i] = out [c][i] * wet + in [c][i] * dry;
+}
+
+template <class B>
+constexpr float echo<B>::max_delay;
+
+template <class B>
+echo<B>::echo ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _ctl_delay ("delay", this, default_echo_time)
+    , _ctl_feedback ("feedback", this, default_echo_feedback)
+    , _ctl_damping ("damping", this, default_echo_damping)
+    , _ctl_wet ("wet", this, default_echo_wet)
+    , _ctl_dry ("dry", this, default_echo_dry)
+    , _line (sound::num_samples<typename B::range>::value)
+    , _frame_rate (0)
+    , _last_delay (-1.0f)
+{
+    std::fill_n (_allpass, _line.channels (), 0.0f);
+    std::fill_n (_lowpass, _line.channels (), 0.0f);
+}
+
+template <class B>
+void echo<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    if (ctx.frame_rate () == _frame_rate)
+        return;
+
+    _frame_rate = ctx.frame_rate ();
+    _last_delay = -1.0f;
+    _line.recreate (std::size_t (max_delay * _frame_rate) + 1, chunk_size,
+                    synth::delay_line::allocator_type (ctx.allocator ()));
+    std::fill_n (_allpass, _line.channels (), 0.0f);
+    std::fill_n (_lowpass, _line.channels (), 0.0f);
+}
+
+/**
+ * The repetitions are read before writing the samples that feed them
+ * back, so every chunk must be shorter than the delay. The fixed
+ * fractional delay is interpolated with an allpass, that unlike
+ * linear interpolation does not lowpass the signal a bit more on
+ * every repetition.
+ */
+template <class B>
+void echo<B>::rt_do_process (rt_process_context& ctx)
+{
+    typedef synth::delay_line::interpolation interpolation;
+    constexpr std::size_t channels =
+        sound::num_samples<typename B::range>::value;
+
+    const float* in [channels];
+    float*       out [channels];
+    synth::detail::range_planes (_in_input.rt_in_range (), in);
+    synth::detail::range_planes (_out_output.rt_out_range (), out);
+    const std::size_t n = _out_output.rt_out_range ().size ();
+
+    const float lo = synth::delay_line::min_delay (interpolation::allpass)
+        + 1.0f;
+    const float hi = _line.max_delay ();
+    const float target = std::min (
+        std::max (_ctl_delay.rt_get () * _frame_rate, lo), hi);
+    const float from  = _last_delay < 0.0f ? target : _last_delay;
+    const float slope = n ? (target - from) / n : 0.0f;
+    _last_delay = target;
+
+    const float longest  = std::min (from, target) -
+        synth::delay_line::min_delay (interpolation::allpass);
+    const float feedback = std::min (std::max (_ctl_feedback.rt_get (),
+                                               -1.0f), 1.0f);
+    const float damping  = std::min (std::max (_ctl_damping.rt_get (),
+                                               0.0f), 0.999f);
+    const float wet      = _ctl_wet.rt_get ();
+    const float dry      = _ctl_dry.rt_get ();
+
+    float taps [channels][chunk_size];
+    float back [channels][chunk_size];
+    for (std::size_t i = 0; i < n; )
+    {
+        const std::size_t len = std::min (
+            std::min (chunk_size, n - i), std::size_t (longest));
+        float* tap_planes [channels];
+        float* back_planes [channels];
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            tap_planes [c]  = taps [c];
+            back_planes [c] = back [c];
+        }
+
+        _line.read_planes (tap_planes, from + slope * i - len,
+                           from + slope * (i + len) - len, len,
+                           interpolation::allpass, _allpass);
+
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            float state = _lowpass [c];
+            for (std::size_t j = 0; j < len; ++j)
+            {
+                state = taps [c][j] + damping * (state - taps [c][j]);
+                const float x = in [c][i + j];
+                back [c][j]    = x + feedback * state;
+                out [c][i + j] = x * dry + state * wet;
+            }
+            _lowpass [c] = state;
+        }
+
+        _line.write_planes (back_planes, len);
+        i += len;
+    }
+}
+
+template class delay<audio_buffer>;
+template class delay<sample_buffer>;
+template class echo<audio_buffer>;
+template class echo<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
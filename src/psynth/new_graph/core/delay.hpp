@@ -0,0 +1,148 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        delay.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Delay and echo nodes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_CORE_DELAY_HPP_
+#define PSYNTH_GRAPH_CORE_DELAY_HPP_
+
+#include <psynth/synth/delay_line.hpp>
+#include <psynth/new_graph/node.hpp>
+#include <psynth/new_graph/soft_buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+/**
+ *  Delay node, mixing the input with a copy of it delayed by up to
+ *  max_delay seconds.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input" : Buffer
+ *    "delay" : sample_buffer, the delay is delay * (1 + delay)
+ *
+ *  Params:
+ *    "delay" : float, in seconds
+ *    "wet"   : float, gain of the delayed signal
+ *    "dry"   : float, gain of the input signal
+ */
+template <class Buffer>
+class delay : public node
+{
+public:
+    static constexpr float max_delay = 2.0f;
+
+    delay ();
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+    soft_sample_in_port         _in_delay;
+
+    in_control<float> _ctl_delay;
+    in_control<float> _ctl_wet;
+    in_control<float> _ctl_dry;
+
+    synth::delay_line _line;
+    std::size_t _frame_rate;
+    float _last_delay;
+};
+
+/**
+ *  Echo node, a delay that feeds its output back into itself through
+ *  a one pole lowpass filter, so every repetition is quieter and
+ *  darker than the previous one.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input" : Buffer
+ *
+ *  Params:
+ *    "delay"    : float, in seconds
+ *    "feedback" : float, gain of every repetition
+ *    "damping"  : float, in [0, 1), how much the repetitions are
+ *                 lowpassed
+ *    "wet"      : float, gain of the repetitions
+ *    "dry"      : float, gain of the input signal
+ */
+template <class Buffer>
+class echo : public node
+{
+public:
+    static constexpr float max_delay = 2.0f;
+
+    echo ();
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+
+    in_control<float> _ctl_delay;
+    in_control<float> _ctl_feedback;
+    in_control<float> _ctl_damping;
+    in_control<float> _ctl_wet;
+    in_control<float> _ctl_dry;
+
+    synth::delay_line _line;
+    std::size_t _frame_rate;
+    float _last_delay;
+    float _allpass [sound::num_samples<typename Buffer::range>::value];
+    float _lowpass [sound::num_samples<typename Buffer::range>::value];
+};
+
+typedef delay<audio_buffer>  audio_delay;
+typedef delay<sample_buffer> sample_delay;
+typedef echo<audio_buffer>   audio_echo;
+typedef echo<sample_buffer>  sample_echo;
+
+extern template class delay<audio_buffer>;
+extern template class delay<sample_buffer>;
+extern template class echo<audio_buffer>;
+extern template class echo<sample_buffer>;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_DELAY_HPP_ */
@@ -0,0 +1,92 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        filter.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Filter node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "filter.hpp"
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+PSYNTH_REGISTER_NODE_STATIC (audio_filter);
+PSYNTH_REGISTER_NODE_STATIC (sample_filter);
+
+constexpr int   default_mode      = 0;
+constexpr float default_frequency = 440.0f;
+constexpr float default_resonance = 0.7071f;
+
+template <class B>
+filter<B>::filter ()
+    : _out_output ("output", this)
+    , _in_input ("input", this, 0.0f)
+    , _in_cutoff ("cutoff", this, 0.0f)
+    , _ctl_mode ("mode", this, default_mode)
+    , _ctl_frequency ("frequency", this, default_frequency)
+    , _ctl_resonance ("resonance", this, default_resonance)
+    , _filter (sound::num_samples<typename B::range>::value,
+               synth::state_variable_filter::mode::lowpass,
+               default_frequency,
+               default_resonance,
+               44100.0f)         // Doesn't matter
+{
+}
+
+template <class B>
+void filter<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    _filter.set_frame_rate (ctx.frame_rate ());
+}
+
+template <class B>
+void filter<B>::rt_do_process (rt_process_context& ctx)
+{
+    typedef synth::state_variable_filter::mode mode;
+
+    const int m = _ctl_mode.rt_get ();
+    _filter.set_mode (m >= 0 && m <= int (mode::notch) ? mode (m)
+                      : mode::lowpass);
+    _filter.set_frequency (_ctl_frequency.rt_get ());
+    _filter.set_resonance (_ctl_resonance.rt_get ());
+
+    if (_in_cutoff.rt_in_available ())
+        _filter.update (_in_input.rt_in_range (),
+                        _out_output.rt_out_range (),
+                        _in_cutoff.rt_in_range ());
+    else
+        _filter.update (_in_input.rt_in_range (),
+                        _out_output.rt_out_range ());
+}
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
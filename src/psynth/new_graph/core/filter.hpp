@@ -0,0 +1,91 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        filter.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Filter node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PSYNTH_GRAPH_CORE_FILTER_HPP_
+#define PSYNTH_GRAPH_CORE_FILTER_HPP_
+
+#include <psynth/synth/state_variable_filter.hpp>
+#include <psynth/new_graph/node.hpp>
+#include <psynth/new_graph/soft_buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+/**
+ *  Filter node, a synth::state_variable_filter.
+ *
+ *  Output:
+ *    "output" : Buffer
+ *
+ *  Input:
+ *    "input"  : Buffer
+ *    "cutoff" : sample_buffer, the cutoff is frequency * (1 + cutoff)
+ *
+ *  Params:
+ *    "mode"      : int (0 : lowpass, 1 : highpass, 2 : bandpass,
+ *                       3 : notch)
+ *    "frequency" : float
+ *    "resonance" : float
+ */
+template <class Buffer>
+class filter : public node
+{
+public:
+    filter ();
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+    void rt_do_process (rt_process_context& ctx);
+
+    buffer_out_port<Buffer>     _out_output;
+    soft_buffer_in_port<Buffer> _in_input;
+    soft_sample_in_port         _in_cutoff;
+
+    in_control<int>   _ctl_mode;
+    in_control<float> _ctl_frequency;
+    in_control<float> _ctl_resonance;
+
+    synth::state_variable_filter _filter;
+};
+
+typedef filter<audio_buffer>  audio_filter;
+typedef filter<sample_buffer> sample_filter;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_FILTER_HPP_ */
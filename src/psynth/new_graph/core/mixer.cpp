@@ -30,7 +30,7 @@
 
 #include <boost/lexical_cast.hpp>
 
-#include "synth/util.hpp"
+#include "sound/expression.hpp"
 #include "mixer.hpp"
 
 namespace psynth
@@ -79,12 +79,15 @@ void mixer<B>::rt_do_process (rt_process_context& ctx)
     auto out  = _out_output.rt_out_range ();
     float gain = _ctl_gain.rt_get ();
 
-    sound::fill_frames (out, frame_type (0.0f));
     for (auto& in : _in_inputs)
     {
         if (in->rt_in_available ())
         {
-            synth::mix (out, in->rt_in_range (), gain, out);
+            auto input = sound::lazy (in->rt_in_range ()) * gain;
+            if (num_mixed == 0)
+                sound::lazy (out) = input;
+            else
+                sound::lazy (out) += input;
             ++ num_mixed;
         }
     }
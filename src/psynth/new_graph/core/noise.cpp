@@ -27,7 +27,7 @@
  *
  */
 
-#include <psynth/sound/buffer_range_factory.hpp>
+#include <psynth/sound/expression.hpp>
 #include "noise.hpp"
 
 namespace psynth
@@ -39,8 +39,10 @@ namespace core
 
 PSYNTH_REGISTER_NODE_STATIC (audio_white_noise);
 PSYNTH_REGISTER_NODE_STATIC (audio_pink_noise);
+PSYNTH_REGISTER_NODE_STATIC (audio_brown_noise);
 PSYNTH_REGISTER_NODE_STATIC (sample_white_noise);
 PSYNTH_REGISTER_NODE_STATIC (sample_pink_noise);
+PSYNTH_REGISTER_NODE_STATIC (sample_brown_noise);
 
 template <template<class> class D, class O>
 noise<D, O>::noise ()
@@ -53,12 +55,10 @@ noise<D, O>::noise ()
 template <template<class> class D, class Output>
 void noise<D, Output>::rt_do_process (rt_process_context& ctx)
 {
-    typedef typename Output::port_type::value_type out_frame_type;
-    auto out_buf = _out_output.rt_out_range ();
-    auto mod_buf = sound::channel_converted_range<out_frame_type>(
-        _in_modulator.rt_in_range ());
-    _noise.update (out_buf);
-    synth::modulate (out_buf, mod_buf, _ctl_amplitude.rt_get (), out_buf);
+    auto out_buf = sound::lazy (_out_output.rt_out_range ());
+    auto mod_buf = sound::lazy (_in_modulator.rt_in_range ());
+    _noise.update (out_buf.get ());
+    out_buf = out_buf * mod_buf * _ctl_amplitude.rt_get ();
 }
 
 
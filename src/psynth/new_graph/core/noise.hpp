@@ -64,8 +64,10 @@ protected:
 
 typedef noise<synth::white_noise_distribution, audio_out_port>  audio_white_noise;
 typedef noise<synth::pink_noise_distribution,  audio_out_port>  audio_pink_noise;
+typedef noise<synth::brown_noise_distribution, audio_out_port>  audio_brown_noise;
 typedef noise<synth::white_noise_distribution, sample_out_port> sample_white_noise;
 typedef noise<synth::pink_noise_distribution,  sample_out_port> sample_pink_noise;
+typedef noise<synth::brown_noise_distribution, sample_out_port> sample_brown_noise;
 
 
 } /* namespace core */
@@ -28,7 +28,10 @@
  *
  */
 
+#include <algorithm>
 #include <iostream>
+
+#include "synth/util.hpp"
 #include "oscillator.hpp"
 
 namespace psynth
@@ -56,6 +59,11 @@ constexpr float default_frequency = 440.0f;
 constexpr float default_amplitude = 0.5f;
 constexpr int   default_modulator = 1;
 
+/**
+ * Samples generated with the same frequency while it is smoothed.
+ */
+constexpr std::size_t frequency_step = 16;
+
 template <class G, class O>
 oscillator<G, O>::oscillator ()
     : _out_output ("output", this)
@@ -75,32 +83,69 @@ void oscillator<G, O>::rt_on_context_update (rt_process_context& ctx)
     _osc.set_frame_rate (ctx.frame_rate ());
 }
 
+/**
+ * While the amplitude is smoothed the wave is generated with unit
+ * amplitude and then scaled by the ramp. The generators need a
+ * constant frequency, so while it is smoothed it follows the ramp in
+ * steps of frequency_step samples.
+ */
 template <class G, class O>
 void oscillator<G, O>::rt_do_process (rt_process_context& ctx)
 {
-    _osc.set_frequency (_ctl_frequency.rt_get ());
-    _osc.set_amplitude (_ctl_amplitude.rt_get ());
+    typedef decltype (_out_output.rt_out_range ()) range;
+    constexpr std::size_t channels = sound::num_samples<range>::value;
+
+    const float* frequency = _ctl_frequency.rt_smooth ();
+    const float* amplitude = _ctl_amplitude.rt_smooth ();
+    const std::size_t n = _out_output.rt_out_range ().size ();
+
+    _osc.set_amplitude (amplitude ? 1.0f : _ctl_amplitude.rt_get_smoothed ());
+    if (!frequency)
+    {
+        _osc.set_frequency (_ctl_frequency.rt_get_smoothed ());
+        _rt_update (0, n);
+    }
+    else
+        for (std::size_t i = 0; i < n; i += frequency_step)
+        {
+            const std::size_t len = std::min (frequency_step, n - i);
+            _osc.set_frequency (frequency [i + len - 1]);
+            _rt_update (i, len);
+        }
+
+    if (amplitude)
+    {
+        float* out [channels];
+        synth::detail::range_planes (_out_output.rt_out_range (), out);
+        for (std::size_t c = 0; c < channels; ++c)
+            synth::kernels ().modulate (out [c], amplitude, out [c], n);
+    }
+}
+
+template <class G, class O>
+void oscillator<G, O>::_rt_update (std::size_t first, std::size_t n)
+{
+    const auto out = sound::sub_range (_out_output.rt_out_range (), first, n);
 
     if (!_in_modulator.rt_in_available ())
-        _osc.update (_out_output.rt_out_range ());
+        _osc.update (out);
     else
     {
+        const auto mod = sound::sub_range (
+            _in_modulator.rt_in_range (), first, n);
         switch (_ctl_modulator.rt_get ())
         {
         case 0:
-            _osc.update_am (_out_output.rt_out_range (),
-                            _in_modulator.rt_in_range ());
+            _osc.update_am (out, mod);
             break;
         case 1:
-            _osc.update_fm (_out_output.rt_out_range (),
-                            _in_modulator.rt_in_range ());
+            _osc.update_fm (out, mod);
             break;
         case 2:
-            _osc.update_pm (_out_output.rt_out_range (),
-                            _in_modulator.rt_in_range ());
+            _osc.update_pm (out, mod);
             break;
         default:
-            _osc.update (_out_output.rt_out_range ());
+            _osc.update (out);
         }
     }
 }
@@ -53,8 +53,8 @@ namespace core
  *    "modulator" : sample_buffer
  *
  *  Params:
- *    "frequency" : float
- *    "amplitude" : float
+ *    "frequency" : float, smoothed
+ *    "amplitude" : float, smoothed
  *    "modulator" : int (0 : am, 1 : fm, 2 : pm)
  *
  *  @todo The audio/sample kind of input difference should finish with
@@ -73,11 +73,14 @@ protected:
     Output _out_output;
     soft_sample_in_port _in_modulator;
 
-    in_control<float> _ctl_frequency;
-    in_control<float> _ctl_amplitude;
-    in_control<int>   _ctl_modulator;
+    smoothed_in_control _ctl_frequency;
+    smoothed_in_control _ctl_amplitude;
+    in_control<int>     _ctl_modulator;
 
     synth::oscillator<Generator> _osc;
+
+private:
+    void _rt_update (std::size_t first, std::size_t n);
 };
 
 typedef oscillator<synth::sine_generator, audio_out_port>
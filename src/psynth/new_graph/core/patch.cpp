@@ -32,7 +32,9 @@
 
 #include <iostream>
 
+#include "base/throw.hpp"
 #include "new_graph/core/patch_port.hpp"
+#include "new_graph/sink_node.hpp"
 #include "new_graph/processor.hpp"
 #include "new_graph/port.hpp"
 #include "patch.hpp"
@@ -47,12 +49,159 @@ namespace core
 PSYNTH_REGISTER_NODE_STATIC (patch);
 
 PSYNTH_DEFINE_ERROR (patch_child_error);
+PSYNTH_DEFINE_ERROR (patch_freeze_error);
+
+namespace
+{
+
+/**
+ * Calls @a fn for every contiguous slice of a block of @a frames
+ * frames in a loop of @a loop_frames, starting at @a loop_pos, which
+ * is updated.
+ */
+template <class Fn>
+void for_each_loop_slice (std::size_t& loop_pos,
+                          std::size_t loop_frames,
+                          std::size_t frames,
+                          Fn fn)
+{
+    for (std::size_t block_pos = 0; block_pos < frames; )
+    {
+        auto slice = std::min (frames - block_pos, loop_frames - loop_pos);
+        fn (loop_pos, block_pos, slice);
+        block_pos += slice;
+        loop_pos   = (loop_pos + slice) % loop_frames;
+    }
+}
+
+bool contains_sinks (patch& p)
+{
+    for (auto& n : p.childs ())
+    {
+        if (std::dynamic_pointer_cast<sink_node> (n))
+            return true;
+        auto child = std::dynamic_pointer_cast<patch> (n);
+        if (child && contains_sinks (*child))
+            return true;
+    }
+    return false;
+}
+
+} /* anonymous namespace */
+
+patch::patch ()
+    : _freeze_frames (0)
+    , _rt_freeze_state (freeze_state::none)
+    , _rt_freeze_frames (0)
+    , _rt_freeze_pos (0)
+    , _rt_freeze_recorded (0)
+{
+}
 
 void patch::rt_process (rt_process_context& ctx)
 {
     node::rt_process (ctx);
-    for (auto& n : _rt_outputs)
-        n.rt_process (ctx);
+    if (_rt_freeze_state != freeze_state::playing)
+        for (auto& n : _rt_outputs)
+            n.rt_process (ctx);
+}
+
+void patch::rt_do_process (rt_process_context& ctx)
+{
+    switch (_rt_freeze_state)
+    {
+    case freeze_state::recording:
+        for (auto& n : _rt_outputs)
+            n.rt_process (ctx);
+        for_each_loop_slice (
+            _rt_freeze_pos, _rt_freeze_frames, ctx.block_size (),
+            [&] (std::size_t loop_pos, std::size_t block_pos,
+                 std::size_t slice) {
+                if (_rt_freeze_recorded < _rt_freeze_frames)
+                    for (auto& n : _rt_outputs)
+                        n.rt_freeze_record (loop_pos, block_pos, slice);
+                _rt_freeze_recorded += slice;
+            });
+        if (_rt_freeze_recorded >= _rt_freeze_frames)
+            _rt_freeze_state = freeze_state::playing;
+        break;
+
+    case freeze_state::playing:
+        for_each_loop_slice (
+            _rt_freeze_pos, _rt_freeze_frames, ctx.block_size (),
+            [&] (std::size_t loop_pos, std::size_t block_pos,
+                 std::size_t slice) {
+                for (auto& n : _rt_outputs)
+                    n.rt_freeze_play (loop_pos, block_pos, slice);
+            });
+        break;
+
+    default:
+        break;
+    }
+}
+
+void patch::freeze (std::size_t loop_frames)
+{
+    if (loop_frames == 0)
+        PSYNTH_THROW (patch_freeze_error) << "Can not freeze an empty loop.";
+    _check_freezable ();
+
+    if (is_frozen ())
+        unfreeze ();
+
+    for (auto& n : _childs)
+        if (auto port = std::dynamic_pointer_cast<patch_out_port_base> (n))
+            port->freeze (loop_frames);
+
+    _freeze_frames = loop_frames;
+    execute_rt ([=] {
+            this->_rt_freeze_state    = freeze_state::recording;
+            this->_rt_freeze_frames   = loop_frames;
+            this->_rt_freeze_pos      = 0;
+            this->_rt_freeze_recorded = 0;
+        });
+}
+
+void patch::unfreeze ()
+{
+    if (!is_frozen ())
+        return;
+
+    _freeze_frames = 0;
+    execute_rt ([=] {
+            this->_rt_freeze_state = freeze_state::none;
+        });
+
+    for (auto& n : _childs)
+        if (auto port = std::dynamic_pointer_cast<patch_out_port_base> (n))
+            port->unfreeze ();
+}
+
+void patch::notify_change ()
+{
+    unfreeze ();
+    node::notify_change ();
+}
+
+void patch::_check_freezable ()
+{
+    for (auto& in : inputs ())
+        if (in.connected ())
+            PSYNTH_THROW (patch_freeze_error)
+                << "Can not freeze a patch with connected inputs.";
+
+    for (auto& n : _childs)
+    {
+        auto port = std::dynamic_pointer_cast<patch_out_port_base> (n);
+        if (port && !port->can_freeze ())
+            PSYNTH_THROW (patch_freeze_error)
+                << "Can not freeze output: " << port->patch_port ().name ();
+    }
+
+    if (contains_sinks (*this))
+        PSYNTH_THROW (patch_freeze_error)
+            << "Can not freeze a patch containing sinks.";
 }
 
 void patch::rt_context_update (rt_process_context& ctx)
@@ -79,6 +228,7 @@ node_ptr patch::add (node_ptr child)
         &child->patch () == this)
         return child;
     child->check_attached_to_patch (false);
+    notify_change ();
 
     child->attach_to_patch (*this);
     _childs.push_back (child);
@@ -116,6 +266,7 @@ void patch::remove (node_ptr child)
     if (!child->is_attached_to_patch () ||
         &child->patch () != this)
         throw patch_child_error ();
+    notify_change ();
 
     for (auto& p : child->inputs ())
         p.disconnect ();
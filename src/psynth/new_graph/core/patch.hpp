@@ -48,6 +48,7 @@ namespace core
 {
 
 PSYNTH_DECLARE_ERROR (error, patch_child_error);
+PSYNTH_DECLARE_ERROR (error, patch_freeze_error);
 
 class patch : public node
 {
@@ -84,9 +85,29 @@ public:
     void rt_context_update (rt_process_context& ctx);
     void rt_advance ();
 
+    patch ();
+
     node_ptr add (node_ptr child);
     void remove (node_ptr child);
 
+    /**
+     * Freezes the patch.  The outputs of the patch are recorded
+     * during the next @a loop_frames frames and, from then on, that
+     * loop is played back instead of processing the nodes in the
+     * patch.  The patch is unfrozen automatically as soon as any
+     * parameter or connection inside it changes.
+     *
+     * Only patches with buffer outputs, no connected inputs and no
+     * sinks inside can be frozen.
+     */
+    void freeze (std::size_t loop_frames);
+    void unfreeze ();
+
+    bool is_frozen () const
+    { return _freeze_frames != 0; }
+
+    void notify_change ();
+
     child_range childs ()
     { return boost::make_iterator_range (_childs); }
     child_const_range cchilds () const
@@ -102,6 +123,23 @@ protected:
     child_list _childs;
     rt_child_list _rt_childs;
     rt_output_list _rt_outputs;
+
+private:
+    enum class freeze_state
+    {
+        none,
+        recording,
+        playing
+    };
+
+    void rt_do_process (rt_process_context& ctx);
+    void _check_freezable ();
+
+    std::size_t  _freeze_frames;
+    freeze_state _rt_freeze_state;
+    std::size_t  _rt_freeze_frames;
+    std::size_t  _rt_freeze_pos;
+    std::size_t  _rt_freeze_recorded;
 };
 
 } /* namespace core */
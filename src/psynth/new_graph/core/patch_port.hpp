@@ -68,6 +68,21 @@ public:
 
     virtual out_port_base& patch_port () = 0;
 
+    /**
+     * Interface used by the patch to freeze its outputs. Only ports
+     * carrying buffers can be frozen.
+     */
+    virtual bool can_freeze () const
+    { return false; }
+    virtual void freeze (std::size_t loop_frames) {}
+    virtual void unfreeze () {}
+    virtual void rt_freeze_record (std::size_t loop_pos,
+                                   std::size_t block_pos,
+                                   std::size_t frames) {}
+    virtual void rt_freeze_play (std::size_t loop_pos,
+                                 std::size_t block_pos,
+                                 std::size_t frames) {}
+
 protected:
     void rt_do_process (rt_process_context& ctx);
 };
@@ -146,11 +161,43 @@ public:
     out_port<port_type>& patch_port ()
     { return _forward_port; }
 
-private:
+protected:
     detail::port_name_control<patch_out_port_base> _ctl_port_name;
     ForwardPort _forward_port;
 };
 
+/**
+ * An output port that keeps a loop of its output when the patch is
+ * frozen.
+ */
+template <class ForwardPort>
+class patch_freezable_out_port_impl : public patch_out_port_impl<ForwardPort>
+{
+public:
+    typedef typename ForwardPort::port_type port_type;
+
+    bool can_freeze () const
+    { return true; }
+
+    void freeze (std::size_t loop_frames);
+    void unfreeze ();
+
+    void rt_freeze_record (std::size_t loop_pos,
+                           std::size_t block_pos,
+                           std::size_t frames);
+    void rt_freeze_play (std::size_t loop_pos,
+                         std::size_t block_pos,
+                         std::size_t frames);
+
+private:
+    typedef std::shared_ptr<port_type> loop_ptr;
+
+    void _set_loop (loop_ptr loop);
+    void _rt_set_loop (rt_process_context& ctx, const loop_ptr& loop);
+
+    loop_ptr _rt_loop;
+};
+
 template <class T>
 struct patch_out_port
     : public patch_out_port_impl <forward_port<T> >
@@ -159,13 +206,13 @@ struct patch_out_port
 
 template <class T>
 struct patch_buffer_out_port
-    : public patch_out_port_impl <buffer_forward_port<T> >
+    : public patch_freezable_out_port_impl <buffer_forward_port<T> >
 {
 };
 
 template <class T>
 struct patch_soft_buffer_out_port
-    : public patch_out_port_impl <soft_buffer_forward_port<T> >
+    : public patch_freezable_out_port_impl <soft_buffer_forward_port<T> >
 {
 };
 
@@ -182,4 +229,6 @@ typedef patch_soft_buffer_in_port<sample_buffer> sample_patch_soft_in_port;
 } /* namespace graph */
 } /* namespace psynth */
 
+#include <psynth/new_graph/core/patch_port.tpp>
+
 #endif /* PSYNTH_GRAPH_CORE_PATCH_PORT_HPP_ */
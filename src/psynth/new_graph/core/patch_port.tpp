@@ -0,0 +1,112 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        patch_port.tpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Patch port templates implementation.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_CORE_PATCH_PORT_TPP_
+#define PSYNTH_GRAPH_CORE_PATCH_PORT_TPP_
+
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/new_graph/core/patch_port.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+template <class FP>
+void patch_freezable_out_port_impl<FP>::freeze (std::size_t loop_frames)
+{
+    _set_loop (std::make_shared<port_type> (loop_frames));
+}
+
+template <class FP>
+void patch_freezable_out_port_impl<FP>::unfreeze ()
+{
+    this->execute_rt ([=] {
+            this->_forward_port.rt_hold (false);
+        });
+    _set_loop (loop_ptr ());
+}
+
+template <class FP>
+void patch_freezable_out_port_impl<FP>::_set_loop (loop_ptr loop)
+{
+    if (this->is_attached_to_process () && this->process ().is_running ())
+        this->process ().context ().push_rt_event (
+            make_rt_event ([=] (rt_process_context& ctx) {
+                    this->_rt_set_loop (ctx, loop);
+                }));
+    else
+        _rt_loop = std::move (loop);
+}
+
+/**
+ * The loop may hold seconds of audio, so the old one is handed to the
+ * asynchronous thread to be freed there.
+ */
+template <class FP>
+void patch_freezable_out_port_impl<FP>::_rt_set_loop (
+    rt_process_context& ctx, const loop_ptr& loop)
+{
+    auto old = _rt_loop;
+    _rt_loop = loop;
+    if (old)
+        ctx.push_async_event (
+            make_async_event ([old] (async_process_context&) {}));
+}
+
+template <class FP>
+void patch_freezable_out_port_impl<FP>::rt_freeze_record (
+    std::size_t loop_pos, std::size_t block_pos, std::size_t frames)
+{
+    const FP& port = this->_forward_port;
+    sound::copy_frames (
+        sub_range (const_range (port.rt_get_out ()), block_pos, frames),
+        sub_range (range (*_rt_loop), loop_pos, frames));
+}
+
+template <class FP>
+void patch_freezable_out_port_impl<FP>::rt_freeze_play (
+    std::size_t loop_pos, std::size_t block_pos, std::size_t frames)
+{
+    auto& out = static_cast<buffer_out_port<port_type>&> (
+        this->_forward_port);
+    this->_forward_port.rt_hold (true);
+    sound::copy_frames (
+        sub_range (const_range (*_rt_loop), loop_pos, frames),
+        sub_range (out.rt_out_range (), block_pos, frames));
+}
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_PATCH_PORT_TPP_ */
@@ -0,0 +1,210 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        pipe.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Pipeline stage node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.graph.core.pipe"
+
+#include <algorithm>
+
+#include "base/logger.hpp"
+#include "base/denormal.hpp"
+#include "pipe.hpp"
+
+#if __GTHREADS
+#include <pthread.h>
+#include <string.h>
+#endif
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+PSYNTH_REGISTER_NODE_STATIC (audio_pipe);
+PSYNTH_REGISTER_NODE_STATIC (sample_pipe);
+
+template <class B>
+pipe<B>::pipe ()
+    : _in_input ("input", this)
+    , _out_output ("output", this)
+    , _ctl_cpu ("cpu", this, -1)
+    , _worker_running (false)
+    , _worker_quit (false)
+    , _rt_requested (0)
+    , _rt_done (0)
+{
+}
+
+template <class B>
+pipe<B>::~pipe ()
+{
+    if (_worker_running)
+        stop ();
+}
+
+template <class B>
+void pipe<B>::start ()
+{
+    _worker_quit = false;
+    _worker_running = true;
+    _worker = std::thread (std::bind (&pipe::_worker_loop, this));
+}
+
+template <class B>
+void pipe<B>::stop ()
+{
+    // Once the flag is cleared the real-time thread processes the
+    // stage itself, so after the block in flight, if any, is done the
+    // worker is not woken again but to quit.
+    _worker_running = false;
+    while (_rt_done.load (std::memory_order_acquire) !=
+           _rt_requested.load ())
+        std::this_thread::yield ();
+
+    _worker_quit = true;
+    _worker_wakeup.post ();
+    if (_worker.joinable ())
+        _worker.join ();
+}
+
+template <class B>
+void pipe<B>::rt_on_context_update (rt_process_context& ctx)
+{
+    typedef typename B::value_type frame_type;
+    _back.recreate (ctx.block_size (), frame_type (0.0f),
+                    buffer_alignment, ctx.allocator ());
+    sound::fill_frames (_out_output.rt_out_range (), frame_type (0.0f));
+    _stage_ctx.rt_update (ctx);
+}
+
+template <class B>
+void pipe<B>::rt_process (rt_process_context& ctx)
+{
+    // The output was already computed during the previous block, we
+    // must not pull our input from here.
+}
+
+template <class B>
+void pipe<B>::rt_stage_begin (rt_process_context& ctx)
+{
+    // The request is counted before looking at the flag, so stop ()
+    // either sees it and waits for it, or we see the worker stopping.
+    auto requested = _rt_requested.fetch_add (1) + 1;
+    if (_worker_running)
+        _worker_wakeup.post ();
+    else
+    {
+        _rt_stage_process (_stage_ctx);
+        _rt_done.store (requested, std::memory_order_release);
+    }
+}
+
+template <class B>
+void pipe<B>::rt_stage_join (rt_process_context& ctx)
+{
+    while (_rt_done.load (std::memory_order_acquire) !=
+           _rt_requested.load (std::memory_order_relaxed))
+        std::this_thread::yield ();
+
+    _stage_ctx.rt_flush_events (ctx);
+}
+
+template <class B>
+void pipe<B>::rt_stage_end (rt_process_context& ctx)
+{
+    _back.swap (_out_output.rt_get_out ());
+}
+
+template <class B>
+void pipe<B>::_rt_stage_process (rt_process_context& ctx)
+{
+    typedef typename B::value_type frame_type;
+
+    _in_input.rt_process (ctx);
+    if (_in_input.rt_in_available ())
+        sound::copy_frames (_in_input.rt_in_range (), range (_back));
+    else
+        sound::fill_frames (range (_back), frame_type (0.0f));
+}
+
+template <class B>
+void pipe<B>::_worker_loop ()
+{
+    base::denormal_guard denormal_guard;
+    auto cpu = _pin_worker (-1);
+
+    for (;;)
+    {
+        _worker_wakeup.wait ();
+        if (_worker_quit)
+            break;
+
+        cpu = _pin_worker (cpu);
+        auto requested = _rt_requested.load (std::memory_order_acquire);
+        _rt_stage_process (_stage_ctx);
+        _rt_done.store (requested, std::memory_order_release);
+    }
+}
+
+/**
+ * Pins the calling worker to the CPU in the "cpu" control when it is
+ * not the one in @a pinned, or lets it run on any CPU again when the
+ * control is negative. Returns the value of the control, so a CPU
+ * that can not be used is not tried again until it changes.
+ */
+template <class B>
+int pipe<B>::_pin_worker (int pinned)
+{
+    auto cpu = std::max (_ctl_cpu.rt_get (), -1);
+    if (cpu == pinned)
+        return pinned;
+
+#if __GTHREADS
+    cpu_set_t cpus;
+    CPU_ZERO (&cpus);
+    if (cpu >= 0)
+        CPU_SET (cpu, &cpus);
+    else
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+            CPU_SET (i, &cpus);
+
+    auto ret = pthread_setaffinity_np (pthread_self (), sizeof (cpus), &cpus);
+    if (ret)
+        PSYNTH_LOG << base::log::warning
+                   << "Could not pin pipeline stage to CPU " << cpu
+                   << ": " << strerror (ret);
+#endif
+    return cpu;
+}
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
@@ -0,0 +1,110 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        pipe.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Pipeline stage node.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_CORE_PIPE_HPP_
+#define PSYNTH_GRAPH_CORE_PIPE_HPP_
+
+#include <atomic>
+#include <thread>
+
+#include <psynth/base/threads.hpp>
+#include <psynth/new_graph/control.hpp>
+#include <psynth/new_graph/buffer_port.hpp>
+#include <psynth/new_graph/stage_node.hpp>
+#include <psynth/new_graph/process_node.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+namespace core
+{
+
+/**
+ * A pipeline stage that processes the nodes connected to its input
+ * in a worker thread of its own, concurrently with the nodes it
+ * feeds, which see its output one block later. The worker can be
+ * pinned to a CPU with the "cpu" parameter, a negative value means
+ * no pinning. The worker applies changes of it before processing its
+ * next block.
+ *
+ * The nodes behind the stage push their events to a context of its
+ * own, which is merged into the processor context when the stage is
+ * joined.
+ *
+ * When the processor is not running, the stage is processed in the
+ * caller thread, still delaying its output by one block.
+ */
+template <class Buffer>
+class pipe : public stage_node
+           , public process_node
+{
+public:
+    pipe ();
+    ~pipe ();
+
+    void start ();
+    void stop ();
+
+    void rt_process (rt_process_context& ctx);
+    void rt_stage_begin (rt_process_context& ctx);
+    void rt_stage_join (rt_process_context& ctx);
+    void rt_stage_end (rt_process_context& ctx);
+
+protected:
+    void rt_on_context_update (rt_process_context& ctx);
+
+private:
+    void _rt_stage_process (rt_process_context& ctx);
+    void _worker_loop ();
+    int _pin_worker (int pinned);
+
+    buffer_in_port<Buffer>  _in_input;
+    buffer_out_port<Buffer> _out_output;
+    in_control<int>         _ctl_cpu;
+    Buffer                  _back;
+
+    std::thread                  _worker;
+    base::semaphore              _worker_wakeup;
+    std::atomic<bool>            _worker_running;
+    std::atomic<bool>            _worker_quit;
+    std::atomic<std::size_t>     _rt_requested;
+    std::atomic<std::size_t>     _rt_done;
+    stage_process_context        _stage_ctx;
+};
+
+typedef pipe<audio_buffer> audio_pipe;
+typedef pipe<sample_buffer> sample_pipe;
+
+} /* namespace core */
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_CORE_PIPE_HPP_ */
@@ -0,0 +1,306 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        host.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Runs many processors on a shared set of threads.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.graph.host"
+
+#include <algorithm>
+#include <ctime>
+
+#include "base/logger.hpp"
+#include "base/denormal.hpp"
+#include "processor.hpp"
+#include "host.hpp"
+
+#if __GTHREADS
+#include <pthread.h>
+#include <string.h>
+#endif
+
+namespace psynth
+{
+namespace graph
+{
+
+PSYNTH_DEFINE_ERROR_WHAT (host_error, "Host already running.");
+
+namespace
+{
+
+/**
+ * How often the asynchronous events of the sessions are dispatched.
+ */
+const auto async_poll_period = std::chrono::milliseconds (1);
+
+std::chrono::nanoseconds thread_cpu_time ()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec ts;
+    ::clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds (ts.tv_sec) +
+        std::chrono::nanoseconds (ts.tv_nsec);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+        std::chrono::steady_clock::now ().time_since_epoch ());
+#endif
+}
+
+/**
+ * Gives the calling thread real-time priority, like
+ * io::thread_async does for the audio threads.
+ */
+void request_rt_priority ()
+{
+#if __GTHREADS
+    sched_param p;
+    p.sched_priority = 1;
+    auto ret = pthread_setschedparam (pthread_self (), SCHED_FIFO, &p);
+
+#ifndef PSYNTH_NO_LOG_RT_REQUEST
+    if (ret)
+        PSYNTH_LOG << base::log::warning
+                   << "Could not set RT priority for host thread: "
+                   << strerror (ret);
+#endif
+#endif
+}
+
+} /* anonymous namespace */
+
+host_session::host_session (processor_ptr proc)
+    : _proc (proc)
+    , _period (std::chrono::duration_cast<clock::duration> (
+                   std::chrono::duration<double> (
+                       double (proc->context ().block_size ()) /
+                       proc->context ().frame_rate ())))
+    , _busy (false)
+    , _blocks (0)
+    , _missed_deadlines (0)
+    , _cpu_time (0)
+{
+}
+
+host_session_stats host_session::stats () const
+{
+    return host_session_stats {
+        _blocks,
+        _missed_deadlines,
+        std::chrono::nanoseconds (_cpu_time) };
+}
+
+double host_session::load () const
+{
+    auto blocks = _blocks.load ();
+    return blocks ?
+        double (_cpu_time) /
+        (blocks * std::chrono::duration_cast<std::chrono::nanoseconds> (
+            _period).count ()) :
+        0.0;
+}
+
+host::host (std::size_t rt_threads, std::size_t job_threads)
+    : _jobs (std::make_shared<base::job_pool> (job_threads))
+    , _num_threads (rt_threads ? rt_threads :
+                    std::max (1u, std::thread::hardware_concurrency ()))
+    , _is_running (false)
+{
+}
+
+host::~host ()
+{
+    if (is_running ())
+        stop ();
+}
+
+void host::start ()
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    if (_is_running)
+        throw host_error ();
+
+    _is_running = true;
+    _jobs->start ();
+
+    auto now = clock::now ();
+    for (auto& s : _sessions)
+    {
+        s->_deadline = now + s->_period;
+        s->_proc->start (false);
+    }
+
+    for (std::size_t i = 0; i < _num_threads; ++i)
+        _rt_threads.emplace_back (std::bind (&host::_rt_loop, this));
+    _async_thread = std::thread (std::bind (&host::_async_loop, this));
+}
+
+void host::stop ()
+{
+    {
+        std::unique_lock<std::mutex> g (_mutex);
+        _is_running = false;
+        _rt_cond.notify_all ();
+        _async_cond.notify_all ();
+    }
+
+    for (auto& t : _rt_threads)
+        if (t.joinable ())
+            t.join ();
+    _rt_threads.clear ();
+    if (_async_thread.joinable ())
+        _async_thread.join ();
+
+    for (auto& s : _sessions)
+        if (s->_proc->is_running ())
+            s->_proc->stop ();
+    _jobs->stop ();
+}
+
+bool host::is_running () const
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    return _is_running;
+}
+
+std::size_t host::size () const
+{
+    std::unique_lock<std::mutex> g (_mutex);
+    return _sessions.size ();
+}
+
+host_session_ptr host::add (processor_ptr proc)
+{
+    proc->set_job_pool (_jobs);
+    auto session = host_session_ptr (new host_session (proc));
+
+    std::unique_lock<std::mutex> g (_mutex);
+    if (_is_running)
+    {
+        session->_deadline = clock::now () + session->_period;
+        proc->start (false);
+    }
+    _sessions.push_back (session);
+    _rt_cond.notify_one ();
+
+    return session;
+}
+
+void host::remove (host_session_ptr session)
+{
+    {
+        std::unique_lock<std::mutex> g (_mutex);
+        auto it = std::find (_sessions.begin (), _sessions.end (), session);
+        if (it == _sessions.end ())
+            return;
+        _sessions.erase (it);
+        while (session->_busy)
+            _idle_cond.wait (g);
+    }
+
+    if (session->_proc->is_running ())
+        session->_proc->stop ();
+}
+
+host_session* host::_earliest ()
+{
+    host_session* best = 0;
+    for (auto& s : _sessions)
+        if (!s->_busy && (!best || s->_deadline < best->_deadline))
+            best = s.get ();
+    return best;
+}
+
+void host::_rt_loop ()
+{
+    base::denormal_guard denormal_guard;
+    request_rt_priority ();
+    std::unique_lock<std::mutex> g (_mutex);
+
+    while (_is_running)
+    {
+        auto s = _earliest ();
+        if (!s)
+        {
+            _rt_cond.wait (g);
+            continue;
+        }
+
+        auto release = s->_deadline - s->_period;
+        if (clock::now () < release)
+        {
+            _rt_cond.wait_until (g, release);
+            continue;
+        }
+
+        s->_busy = true;
+        g.unlock ();
+
+        auto cpu_start = thread_cpu_time ();
+        s->_proc->rt_request_process ();
+        auto cpu = thread_cpu_time () - cpu_start;
+        auto end = clock::now ();
+
+        g.lock ();
+        s->_busy = false;
+        s->_blocks += 1;
+        s->_cpu_time += cpu.count ();
+        if (end > s->_deadline)
+            s->_missed_deadlines += 1;
+
+        // Do not try to catch up when lagging more than a period
+        // behind, that would only starve the other sessions.
+        s->_deadline += s->_period;
+        if (s->_deadline < end)
+            s->_deadline = end + s->_period;
+
+        // This thread takes the earliest session itself when it loops
+        // back, one more worker is enough to cover the rest.
+        _rt_cond.notify_one ();
+        _idle_cond.notify_all ();
+    }
+}
+
+void host::_async_loop ()
+{
+    std::unique_lock<std::mutex> g (_mutex);
+
+    while (_is_running)
+    {
+        auto sessions = _sessions;
+        g.unlock ();
+        for (auto& s : sessions)
+            s->_proc->async_process ();
+        g.lock ();
+
+        if (_is_running)
+            _async_cond.wait_for (g, async_poll_period);
+    }
+}
+
+} /* namespace graph */
+} /* namespace psynth */
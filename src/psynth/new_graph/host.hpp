@@ -0,0 +1,177 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        host.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Runs many processors on a shared set of threads.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_HOST_HPP_
+#define PSYNTH_GRAPH_HOST_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/utility.hpp>
+
+#include <psynth/base/job_pool.hpp>
+#include <psynth/new_graph/exception.hpp>
+#include <psynth/new_graph/processor_fwd.hpp>
+#include <psynth/new_graph/host_fwd.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+
+PSYNTH_DECLARE_ERROR (error, host_error);
+
+/**
+ * When zero, the host uses one real-time thread per core.
+ */
+constexpr std::size_t default_host_threads = 0;
+
+struct host_session_stats
+{
+    std::size_t              blocks;
+    std::size_t              missed_deadlines;
+    std::chrono::nanoseconds cpu_time;
+};
+
+/**
+ * A processor run by a host.
+ */
+class host_session : private boost::noncopyable
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    processor& proc ()
+    { return *_proc; }
+
+    processor_ptr proc_ptr () const
+    { return _proc; }
+
+    /**
+     * The time between the deadlines of two consecutive blocks.
+     */
+    clock::duration period () const
+    { return _period; }
+
+    host_session_stats stats () const;
+
+    /**
+     * Returns the fraction of the real time of this session that is
+     * spent processing it.
+     */
+    double load () const;
+
+private:
+    friend class host;
+
+    explicit host_session (processor_ptr proc);
+
+    processor_ptr             _proc;
+    clock::duration           _period;
+    clock::time_point         _deadline;
+    bool                      _busy;
+    std::atomic<std::size_t>  _blocks;
+    std::atomic<std::size_t>  _missed_deadlines;
+    std::atomic<std::int64_t> _cpu_time;
+};
+
+/**
+ * Owns many independent processors and runs them in a fixed pool of
+ * real-time threads, which request SCHED_FIFO priority when the
+ * system allows it. Blocks are scheduled earliest deadline first:
+ * a session is ready to process a block once per period, and the
+ * block should be done before the next period starts. The sessions
+ * share a single asynchronous thread and job pool.
+ *
+ * Nothing pulls the processors besides the host, thus the sessions
+ * should not contain sinks driven by a device, like async_output,
+ * but passive ones.
+ */
+class host : private boost::noncopyable
+{
+public:
+    explicit host (std::size_t rt_threads = default_host_threads,
+                   std::size_t job_threads = base::default_job_threads);
+    ~host ();
+
+    void start ();
+    void stop ();
+
+    bool is_running () const;
+
+    /**
+     * Adds a session for @a proc, which must not be running. The
+     * processor is started right away when the host is running.
+     */
+    host_session_ptr add (processor_ptr proc);
+
+    /**
+     * Removes the session, waiting for the block that it might be
+     * processing, and stops its processor.
+     */
+    void remove (host_session_ptr session);
+
+    std::size_t size () const;
+
+    std::size_t rt_threads () const
+    { return _num_threads; }
+
+    base::job_pool_ptr job_pool () const
+    { return _jobs; }
+
+private:
+    typedef host_session::clock clock;
+    typedef std::vector<host_session_ptr> session_list;
+
+    host_session* _earliest ();
+    void _rt_loop ();
+    void _async_loop ();
+
+    session_list             _sessions;
+    std::vector<std::thread> _rt_threads;
+    std::thread              _async_thread;
+    mutable std::mutex       _mutex;
+    std::condition_variable  _rt_cond;    // Workers wait for sessions.
+    std::condition_variable  _idle_cond;  // remove () waits for a block.
+    std::condition_variable  _async_cond; // The async loop sleeps.
+    base::job_pool_ptr       _jobs;
+    std::size_t              _num_threads;
+    bool                     _is_running;
+};
+
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_HOST_HPP_ */
@@ -31,6 +31,8 @@
 #define PSYNTH_MODULE_NAME "psynth.graph.node"
 
 #include "base/throw.hpp"
+#include "base/denormal.hpp"
+#include "core/patch.hpp"
 #include "node.hpp"
 #include "port.hpp"
 #include "control.hpp"
@@ -55,6 +57,7 @@ node::node ()
     : _patch (0)
     , _process (0)
     , _rt_processed (false)
+    , _subnormal_count (0)
 {
 }
 
@@ -64,6 +67,8 @@ void node::rt_context_update (rt_process_context& ctx)
         in.rt_context_update (ctx);
     for (auto& out : outputs ())
         out.rt_context_update (ctx);
+    for (auto& param : params ())
+        param.rt_context_update (ctx);
     rt_on_context_update (ctx);
 }
 
@@ -75,14 +80,33 @@ void node::rt_process (rt_process_context& ctx)
         for (auto& in : inputs ())
             in.rt_process (ctx);
         this->rt_do_process (ctx);
+#if PSYNTH_DEBUG
+        if (base::subnormal_tracing ())
+            _rt_count_subnormals ();
+#endif
     }
 }
 
+void node::_rt_count_subnormals ()
+{
+    auto count = std::size_t (0);
+    for (auto& out : outputs ())
+        count += out.rt_count_subnormals ();
+    if (count)
+        _subnormal_count.fetch_add (count, std::memory_order_relaxed);
+}
+
 void node::rt_advance ()
 {
     _rt_processed = false;
 }
 
+void node::notify_change ()
+{
+    if (is_attached_to_patch ())
+        _patch->notify_change ();
+}
+
 in_port_base& node::in (const std::string& name)
 {
     auto it = _inputs.find (name);
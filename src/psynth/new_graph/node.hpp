@@ -31,6 +31,7 @@
 #ifndef PSYNTH_GRAPH_NODE_HPP_
 #define PSYNTH_GRAPH_NODE_HPP_
 
+#include <atomic>
 #include <map>
 #include <iostream> // FIXME!
 
@@ -174,11 +175,33 @@ public:
     template <class Fn>
     void execute_rt (const Fn& fn);
 
+    /**
+     * Returns the number of subnormal samples that this node has
+     * output while subnormal tracing was enabled. It is always zero
+     * in release builds.
+     *
+     * @see base::enable_subnormal_tracing ()
+     */
+    std::size_t subnormal_count () const
+    { return _subnormal_count.load (std::memory_order_relaxed); }
+
+    void reset_subnormal_count ()
+    { _subnormal_count.store (0, std::memory_order_relaxed); }
+
+    /**
+     * Called from the user thread whenever a parameter or a
+     * connection of this node changes.  By default, the notification
+     * is forwarded to the patch containing the node.
+     */
+    virtual void notify_change ();
+
 private:
 
     virtual void rt_on_context_update (rt_process_context& ctx) {}
     virtual void rt_do_process (rt_process_context& ctx) {}
 
+    void _rt_count_subnormals ();
+
     core::patch* _patch;
     processor*   _process;
 
@@ -189,6 +212,8 @@ private:
 
     bool _rt_processed;
     bool _rt_post_processed;
+
+    std::atomic<std::size_t> _subnormal_count;
 };
 
 void connect (node_ptr source, const std::string& out_port,
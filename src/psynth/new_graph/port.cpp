@@ -173,6 +173,8 @@ void in_port_base::_user_connect (out_port_base* source)
     _source_port = source;
     if (source)
         detail::out_port_access::add_reference (*_source_port, this);
+    if (_has_owner ())
+        owner ().notify_change ();
 }
 
 void in_port_base::_rt_connect (out_port_base* source)
@@ -175,6 +175,13 @@ public:
     virtual bool rt_out_available () const
     { return true; }
 
+    /**
+     * Returns how many subnormal samples the port holds, used to
+     * trace where subnormals come from in debug builds.
+     */
+    virtual std::size_t rt_count_subnormals () const
+    { return 0; }
+
     reference_range references ()
     { return reference_range (_refs.begin (), _refs.end ()); }
     const_reference_range references () const
@@ -315,13 +322,20 @@ public:
 
     const port_type& rt_get_out () const
     {
-        if (InPort::rt_connected ())
+        if (InPort::rt_connected () && !_rt_held)
             return this->rt_get_in ();
         return OutPort::rt_get_out ();
     }
 
     bool rt_out_available () const
-    { return InPort::rt_connected (); }
+    { return InPort::rt_connected () || _rt_held; }
+
+    /**
+     * While held, the port outputs its own value regardless of the
+     * input connection.
+     */
+    void rt_hold (bool held)
+    { _rt_held = held; }
 
 protected:
     forward_port_impl (std::string in_name,
@@ -330,7 +344,11 @@ protected:
                        node* out_owner)
         : InPort (in_name, in_owner)
         , OutPort (out_name, out_owner)
+        , _rt_held (false)
     {}
+
+private:
+    bool _rt_held;
 };
 
 template <typename T>
@@ -41,5 +41,10 @@ void process_node::rt_request_process ()
     process ().rt_request_process ();
 }
 
+std::size_t process_node::rt_request_frames (std::size_t nframes)
+{
+    return process ().rt_request_frames (nframes);
+}
+
 } /* namespace graph */
 } /* namespace psynth */
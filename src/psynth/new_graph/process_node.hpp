@@ -46,6 +46,7 @@ public:
 
 protected:
     void rt_request_process ();
+    std::size_t rt_request_frames (std::size_t nframes);
 };
 
 } /* namespace graph */
@@ -31,10 +31,15 @@
 #define PSYNTH_MODULE_NAME "psynth.graph.processor"
 
 #include <iostream>
+#include <algorithm>
 
 #include "base/throw.hpp"
+#include "base/denormal.hpp"
+#include "synth/kernels.hpp"
+#include "synth/wave_tables.hpp"
 #include "core/patch.hpp"
 #include "sink_node.hpp"
+#include "stage_node.hpp"
 #include "process_node.hpp"
 #include "processor.hpp"
 
@@ -61,9 +66,34 @@ basic_process_context::basic_process_context (std::size_t block_size,
     , _block_size (block_size)
     , _frame_rate (frame_rate)
     , _async_request_flip (false)
+    , _jobs (std::make_shared<base::job_pool> ())
 {
 }
 
+stage_process_context::stage_process_context (std::size_t queue_size)
+    : basic_process_context (default_block_size, default_frame_rate,
+                             queue_size)
+    , rt_process_context (default_block_size, default_frame_rate,
+                          queue_size)
+{
+}
+
+void stage_process_context::rt_update (const basic_process_context& ctx)
+{
+    _block_size = ctx._block_size;
+    _frame_rate = ctx._frame_rate;
+    _jobs       = ctx._jobs;
+    _arena      = ctx._arena;
+}
+
+void stage_process_context::rt_flush_events (rt_process_context& ctx)
+{
+    ctx._rt_buffers.local ().splice_back (_rt_buffers.local ());
+    _rt_buffers.local ().clear ();
+    ctx._async_buffers.back ().splice_back (_async_buffers.back ());
+    _async_buffers.back ().clear ();
+}
+
 processor::processor (core::patch_ptr root,
                       std::size_t block_size,
                       std::size_t frame_rate,
@@ -71,7 +101,9 @@ processor::processor (core::patch_ptr root,
     : _root (root ? root : core::new_patch ())
     , _ctx (block_size, frame_rate, queue_size)
     , _is_running (false)
+    , _has_async_thread (false)
 {
+    synth::initialize_wave_tables ();
     _explore_node_add (_root);
 }
 
@@ -81,13 +113,19 @@ processor::~processor ()
         stop ();
 }
 
-void processor::start ()
+void processor::start (bool async_thread)
 {
     if (_is_running)
         throw processor_not_idle_error ();
+    synth::resolve_kernels ();
     _is_running = true;
-    _ctx._async_thread = std::thread (
-        std::bind (&processor::_async_loop, this));
+    _has_async_thread = async_thread;
+    if (async_thread)
+    {
+        _ctx._jobs->start ();
+        _ctx._async_thread = std::thread (
+            std::bind (&processor::_async_loop, this));
+    }
     for (auto& n : _procs)
         n->start ();
 }
@@ -106,8 +144,48 @@ void processor::stop ()
         _ctx._async_cond.notify_all ();
     }
 
-    if (_ctx._async_thread.joinable ())
-        _ctx._async_thread.join ();
+    if (_has_async_thread)
+    {
+        if (_ctx._async_thread.joinable ())
+            _ctx._async_thread.join ();
+        _ctx._jobs->stop ();
+    }
+    else
+        async_process ();
+}
+
+void processor::set_job_pool (base::job_pool_ptr jobs)
+{
+    if (_is_running)
+        throw processor_not_idle_error ();
+    _ctx._jobs = jobs;
+}
+
+void processor::set_buffer_arena (base::memory_arena_ptr arena)
+{
+    if (_is_running)
+        throw processor_not_idle_error ();
+    _ctx._arena = arena;
+    _root->rt_context_update (_ctx);
+}
+
+void processor::async_process ()
+{
+    std::unique_lock<std::mutex> g (_ctx._async_mutex);
+    _async_process_once ();
+}
+
+void processor::_async_process_once ()
+{
+    for (auto& ev : _ctx._async_buffers.front ())
+        ev (_ctx);
+    _ctx._async_buffers.front ().clear ();
+    _ctx._async_request_flip = true;
+
+    _ctx._async_buffers.flip_local ();
+    for (auto& ev : _ctx._async_buffers.front ())
+        ev (_ctx);
+    _ctx._async_buffers.front ().clear ();
 }
 
 void processor::_async_loop ()
@@ -117,15 +195,7 @@ void processor::_async_loop ()
     {
         std::unique_lock<std::mutex> g (_ctx._async_mutex);
 
-        for (auto& ev : _ctx._async_buffers.front ())
-            ev (_ctx);
-        _ctx._async_buffers.front ().clear ();
-        _ctx._async_request_flip = true;
-
-        _ctx._async_buffers.flip_local ();
-        for (auto& ev : _ctx._async_buffers.front ())
-            ev (_ctx);
-        _ctx._async_buffers.front ().clear ();
+        _async_process_once ();
 
         while (_ctx._async_request_flip &&
                _ctx._async_buffers.local ().empty () &&
@@ -134,6 +204,38 @@ void processor::_async_loop ()
     }
 }
 
+namespace
+{
+
+std::size_t stage_depth (node& n)
+{
+    auto depth = std::size_t (0);
+    for (auto& in : n.inputs ())
+        if (in.connected ())
+            depth = std::max (depth, stage_depth (in.source ().owner ()));
+    return depth + (dynamic_cast<stage_node*> (&n) ? 1 : 0);
+}
+
+std::size_t sink_stage_depth (core::patch& p)
+{
+    auto depth = std::size_t (0);
+    for (auto& n : p.childs ())
+    {
+        if (std::dynamic_pointer_cast<sink_node> (n))
+            depth = std::max (depth, stage_depth (*n));
+        if (auto child = std::dynamic_pointer_cast<core::patch> (n))
+            depth = std::max (depth, sink_stage_depth (*child));
+    }
+    return depth;
+}
+
+} /* anonymous namespace */
+
+std::size_t processor::latency ()
+{
+    return sink_stage_depth (*_root) * _ctx.block_size ();
+}
+
 void processor::set_block_size (std::size_t new_size)
 {
     assert (false);
@@ -152,6 +254,7 @@ void processor::rt_request_process (std::ptrdiff_t iterations)
 
 void processor::rt_request_process ()
 {
+    base::denormal_guard denormal_guard;
     auto request_lock = base::make_unique_lock (
         _rt_mutex,
         std::try_to_lock);
@@ -162,6 +265,18 @@ void processor::rt_request_process ()
         request_lock.lock ();
 }
 
+std::size_t processor::rt_request_frames (std::size_t nframes)
+{
+    base::denormal_guard denormal_guard;
+    auto request_lock = base::make_unique_lock (_rt_mutex);
+    auto blocks = (nframes + _ctx.block_size () - 1) / _ctx.block_size ();
+
+    for (auto i = std::size_t (0); i < blocks; ++i)
+        _rt_process_once ();
+
+    return blocks;
+}
+
 void processor::_rt_process_once ()
 {
     _ctx._rt_buffers.flip_back ();
@@ -169,8 +284,16 @@ void processor::_rt_process_once ()
         ev (_ctx);
     _ctx._rt_buffers.front ().clear ();
 
+    for (auto& s : _stages)
+        s->rt_stage_begin (_ctx);
     for (auto& s : _sinks)
         s->rt_process (_ctx);
+    // A stage may still be reading the output of another one, so no
+    // stage publishes its output before all of them have finished.
+    for (auto& s : _stages)
+        s->rt_stage_join (_ctx);
+    for (auto& s : _stages)
+        s->rt_stage_end (_ctx);
     _root->rt_advance ();
 
     _ctx._rt_buffers.flip_local ();
@@ -209,6 +332,18 @@ void processor::_explore_node_add (node_ptr n)
                     }));
     }
 
+    auto stage = std::dynamic_pointer_cast<stage_node> (n);
+    if (stage)
+    {
+        if (!is_running ())
+            _stages.push_back (stage);
+        else
+            context ().push_rt_event (
+                make_rt_event ([=] (rt_process_context&) {
+                        this->_stages.push_back (stage);
+                    }));
+    }
+
     auto proc = std::dynamic_pointer_cast<process_node> (n);
     if (proc)
     {
@@ -245,6 +380,18 @@ void processor::_explore_node_remove (node_ptr n)
                     }));
     }
 
+    auto stage = std::dynamic_pointer_cast<stage_node> (n);
+    if (stage)
+    {
+        if (!is_running ())
+            _stages.remove (stage);
+        else
+            context ().push_rt_event (
+                make_rt_event ([=] (rt_process_context&) {
+                        this->_stages.remove (stage);
+                    }));
+    }
+
     auto proc = std::dynamic_pointer_cast<process_node> (n);
     if (proc)
     {
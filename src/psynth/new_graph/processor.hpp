@@ -40,13 +40,16 @@
 #include <psynth/new_graph/node_fwd.hpp>
 #include <psynth/new_graph/port_fwd.hpp>
 #include <psynth/new_graph/sink_node_fwd.hpp>
+#include <psynth/new_graph/stage_node_fwd.hpp>
 #include <psynth/new_graph/process_node_fwd.hpp>
 
 #include <psynth/new_graph/exception.hpp>
 #include <psynth/new_graph/event.hpp>
 #include <psynth/new_graph/triple_buffer.hpp>
+#include <psynth/new_graph/buffers.hpp>
 
 #include <psynth/base/hetero_deque.hpp>
+#include <psynth/base/job_pool.hpp>
 #include <psynth/base/threads.hpp>
 
 namespace psynth
@@ -59,13 +62,18 @@ PSYNTH_DECLARE_ERROR (processor_error, processor_not_running_error);
 PSYNTH_DECLARE_ERROR (processor_error, processor_not_idle_error);
 
 constexpr std::size_t default_queue_size = 1 << 20;
+constexpr std::size_t default_stage_queue_size = 1 << 14;
 constexpr std::size_t default_block_size = 1 << 6;
 constexpr std::size_t default_frame_rate = 44100;
 
 class processor;
 
-typedef base::hetero_deque<rt_event>    rt_event_deque;
-typedef base::hetero_deque<async_event> async_event_deque;
+/*
+ * Movable so the events of a pipeline stage can be passed on to the
+ * processor.
+ */
+typedef base::hetero_deque<rt_event, true>    rt_event_deque;
+typedef base::hetero_deque<async_event, true> async_event_deque;
 
 typedef triple_buffer<
     rt_event_deque,
@@ -89,6 +97,12 @@ public:
     std::size_t frame_rate () const
     { return _frame_rate; }
 
+    /**
+     * Returns the allocator that port buffers should use.
+     */
+    buffer_allocator allocator () const
+    { return buffer_allocator (_arena); }
+
 protected:
     /** Only processor can create instances. */
     basic_process_context (std::size_t block_size,
@@ -107,7 +121,11 @@ protected:
     std::mutex              _async_mutex;
     bool                    _async_request_flip;
 
+    base::job_pool_ptr      _jobs;
+    base::memory_arena_ptr  _arena;
+
     friend class processor;
+    friend class stage_process_context;
 };
 
 class rt_process_context : public virtual basic_process_context
@@ -137,6 +155,17 @@ public:
                 std::forward<Concrete> (arg));
     }
 
+    /**
+     * Posts a job to be run in the job pool. The job is not posted
+     * directly, an async event does it for us instead, such that no
+     * memory is allocated from the real-time thread.
+     *
+     * @see async_process_context::push_job
+     */
+    template <class Fn>
+    bool push_job (Fn&& fn,
+                   base::job_priority prio = base::job_priority::normal);
+
 protected:
     friend class processor;
 
@@ -178,6 +207,15 @@ public:
                 std::forward<Concrete> (arg));
     }
 
+    /**
+     * Posts a job to be run in the job pool.  The job is called with
+     * the async context as parameter and it may send its results
+     * back to the real-time thread with push_rt_event.
+     */
+    template <class Fn>
+    void push_job (Fn&& fn,
+                   base::job_priority prio = base::job_priority::normal);
+
 protected:
     friend class processor;
 
@@ -215,6 +253,11 @@ public:
                 std::forward<Concrete> (arg));
     }
 
+    /** @see async_process_context::push_job */
+    template <class Fn>
+    void push_job (Fn&& fn,
+                   base::job_priority prio = base::job_priority::normal);
+
 protected:
     friend class processor;
 
@@ -242,6 +285,33 @@ public: // Eases unit testing!
     {}
 };
 
+/**
+ * The context of the nodes that a pipeline stage processes outside of
+ * the real-time thread. Their events go to queues of its own, so
+ * concurrent stages do not race on the ones of the processor, and
+ * are moved to the processor context once the stage is joined.
+ *
+ * @see stage_node
+ */
+class stage_process_context : public rt_process_context
+{
+public:
+    explicit stage_process_context (
+        std::size_t queue_size = default_stage_queue_size);
+
+    /**
+     * Takes the block size, frame rate, buffer arena and job pool of
+     * @a ctx.
+     */
+    void rt_update (const basic_process_context& ctx);
+
+    /**
+     * Moves the events pushed through this context to the same queues
+     * of @a ctx, which must be used from the calling thread. Events
+     * that do not fit are dropped, like when pushing them directly.
+     */
+    void rt_flush_events (rt_process_context& ctx);
+};
 
 class processor : private boost::noncopyable
 {
@@ -253,9 +323,43 @@ public:
 
     ~processor ();
 
-    void start ();
+    /**
+     * Starts the processor. When @a async_thread is false, no thread
+     * is spawned for the asynchronous events and the job pool is not
+     * started, it is then up to the caller to periodically call
+     * async_process () and to run the job pool, as host does.
+     */
+    void start (bool async_thread = true);
     void stop ();
 
+    /**
+     * Runs the pending asynchronous events, without waiting for new
+     * ones. Only needed when the processor was started without its
+     * own asynchronous thread.
+     */
+    void async_process ();
+
+    /**
+     * Makes the process contexts post their jobs in @a jobs. Can
+     * only be called when the processor is not running.
+     */
+    void set_job_pool (base::job_pool_ptr jobs);
+
+    base::job_pool_ptr job_pool () const
+    { return _ctx._jobs; }
+
+    /**
+     * Makes the port buffers take their memory from @a arena, moving
+     * the existing ones into it. A null arena makes them use the
+     * heap. Can only be called when the processor is not running.
+     *
+     * @see base::memory_arena
+     */
+    void set_buffer_arena (base::memory_arena_ptr arena);
+
+    base::memory_arena_ptr buffer_arena () const
+    { return _ctx._arena; }
+
     core::patch_ptr root ()
     { return _root; }
 
@@ -268,12 +372,37 @@ public:
     void set_block_size (std::size_t new_size);
     void set_frame_rate (std::size_t new_frame_rate);
 
+    /**
+     * Processes one block, or @a iterations of them. Subnormal
+     * numbers are flushed to zero while processing, whichever the
+     * calling thread is, so this also covers rendering offline.
+     */
     void rt_request_process (std::ptrdiff_t iterations);
     void rt_request_process ();
 
+    /**
+     * Requests the processing of an arbitrary number of frames. As
+     * many blocks as needed to cover @a nframes are processed, all of
+     * them under the same lock. When @a nframes is not a multiple of
+     * the block size the last block is processed in excess, and it is
+     * up to the sink driving the requests to keep the extra frames as
+     * a remainder and discount them in its next request.
+     *
+     * @return The number of blocks that were actually processed.
+     */
+    std::size_t rt_request_frames (std::size_t nframes);
+
     bool is_running () const
     { return _is_running; }
 
+    /**
+     * Returns the latency, in frames, added by the pipeline stages
+     * in the longest path from a sink.
+     *
+     * @see stage_node
+     */
+    std::size_t latency ();
+
     /** To be called by patches */
     void notify_add_node (node_ptr node)
     { _explore_node_add (node); }
@@ -287,21 +416,25 @@ private:
     void _explore_node_remove (node_ptr node);
 
     void _async_loop ();
+    void _async_process_once ();
     void _rt_process_once ();
 
     typedef std::list<sink_node_ptr> sink_node_list;
+    typedef std::list<stage_node_ptr> stage_node_list;
     typedef std::list<process_node_ptr> process_node_list;
 
     core::patch_ptr         _root;
 
-    process_node_list       _procs; // Not readed from rt-threads.
-    sink_node_list          _sinks; // Readed from rt-threads.
+    process_node_list       _procs;  // Not readed from rt-threads.
+    sink_node_list          _sinks;  // Readed from rt-threads.
+    stage_node_list         _stages; // Readed from rt-threads.
 
     full_process_context    _ctx;
 
     std::mutex              _rt_mutex;
 
     std::atomic<bool>       _is_running;
+    bool                    _has_async_thread;
 };
 
 } /* namespace graph */
@@ -85,6 +85,36 @@ bool async_process_context::push_async_event (Args&&... args)
         std::forward<Args> (args) ...);
 }
 
+template <class Fn>
+bool rt_process_context::push_job (Fn&& fn, base::job_priority prio)
+{
+    typedef typename std::decay<Fn>::type fn_type;
+    fn_type job (std::forward<Fn> (fn));
+
+    return push_async_event (
+        make_async_event ([job, prio] (async_process_context& ctx) {
+                ctx.push_job (job, prio);
+            }));
+}
+
+template <class Fn>
+void async_process_context::push_job (Fn&& fn, base::job_priority prio)
+{
+    typedef typename std::decay<Fn>::type fn_type;
+    fn_type job (std::forward<Fn> (fn));
+
+    auto ctx = this;
+    _jobs->post ([job, ctx] () mutable { job (*ctx); }, prio);
+}
+
+template <class Fn>
+void user_process_context::push_job (Fn&& fn, base::job_priority prio)
+{
+    auto& ctx = static_cast<full_process_context&> (*this);
+    static_cast<async_process_context&> (ctx).push_job (
+        std::forward<Fn> (fn), prio);
+}
+
 } /* namespace graph */
 } /* namespace psynth */
 
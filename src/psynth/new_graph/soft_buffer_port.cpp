@@ -46,7 +46,8 @@ void soft_buffer_in_port<B>::rt_context_update (rt_process_context& ctx)
     base_type::rt_context_update (ctx);
     auto delta = 1.0f / (_duration * ctx.frame_rate ());
     _envelope.set_deltas (delta, -delta);
-    _local_buffer.recreate (ctx.block_size ());
+    _local_buffer.recreate (
+        ctx.block_size (), buffer_alignment, ctx.allocator ());
 }
 
 template <class B>
@@ -70,13 +71,10 @@ void soft_buffer_in_port<B>::rt_process (rt_process_context& ctx)
     base_type::rt_process (ctx);
     if (this->rt_in_available ())
     {
-        _envelope.update (range (_local_buffer));
-
-        synth::blend (const_range (base_type::rt_get_in ()),
-                      range (_local_buffer),
-                      _stable_value,
-                      range (_local_buffer));
-
+        synth::blend_envelope (_envelope,
+                               const_range (base_type::rt_get_in ()),
+                               _stable_value,
+                               range (_local_buffer));
     }
     else
     {
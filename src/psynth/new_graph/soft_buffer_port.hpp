@@ -28,6 +28,9 @@
  *
  */
 
+#ifndef PSYNTH_GRAPH_SOFT_BUFFER_PORT_HPP_
+#define PSYNTH_GRAPH_SOFT_BUFFER_PORT_HPP_
+
 #include <iostream>
 
 #include <psynth/sound/output.hpp>
@@ -116,3 +119,5 @@ extern template class soft_buffer_forward_port<sample_buffer>;
 
 } /* namespace graph */
 } /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_SOFT_BUFFER_PORT_HPP_ */
@@ -0,0 +1,81 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        stage_node.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Base class for pipeline stage nodes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_GRAPH_STAGE_NODE_HPP_
+#define PSYNTH_GRAPH_STAGE_NODE_HPP_
+
+#include <psynth/new_graph/node.hpp>
+
+namespace psynth
+{
+namespace graph
+{
+
+/**
+ * A node that cuts the graph in two pipeline stages. The nodes
+ * feeding a stage are processed by the stage itself, possibly in
+ * another thread while the rest of the graph is processed, and their
+ * output becomes visible downstream one block later. Thus, every
+ * stage in a path adds one block of latency.
+ *
+ * @note The nodes upstream of a stage must only be reachable through
+ * it, otherwise they would be processed concurrently from two
+ * threads.
+ */
+class stage_node : public virtual node
+{
+public:
+    /**
+     * Starts processing the next block of the nodes feeding the
+     * stage. Called by the processor before processing the sinks.
+     */
+    virtual void rt_stage_begin (rt_process_context& ctx) = 0;
+
+    /**
+     * Waits for the work started in rt_stage_begin to finish and
+     * moves the events that it pushed to @a ctx. Called by the
+     * processor after processing the sinks.
+     *
+     * @see stage_process_context
+     */
+    virtual void rt_stage_join (rt_process_context& ctx) = 0;
+
+    /**
+     * Publishes the result of the work as the output of the stage.
+     * Called by the processor once every stage has been joined, as
+     * the work of a stage may read the output of another.
+     */
+    virtual void rt_stage_end (rt_process_context& ctx) = 0;
+};
+
+} /* namespace graph */
+} /* namespace psynth */
+
+#endif /* PSYNTH_GRAPH_STAGE_NODE_HPP_ */
@@ -58,6 +58,7 @@
 #include <psynth/sound/buffer_range.hpp>
 #include <psynth/sound/buffer_range_factory.hpp>
 #include <psynth/sound/bit_aligned_frame_iterator.hpp>
+#include <psynth/sound/simd.hpp>
 
 //#ifdef _MSC_VER
 //#pragma warning(push)
@@ -285,15 +286,50 @@ namespace psynth
 namespace sound
 {
 
+namespace detail
+{
+
+template <typename Range1, typename Range2> PSYNTH_FORCEINLINE
+void copy_frames_aux (const Range1& src, const Range2& dst, no_simd_tag)
+{
+    std::copy (src.begin(), src.end(), dst.begin());
+}
+
+/**
+   Interleaved ranges already end up in std::memmove, which picks the
+   best instruction set at run-time.
+*/
+template <typename Range1, typename Range2> PSYNTH_FORCEINLINE
+void copy_frames_aux (const Range1& src, const Range2& dst, mono_simd_tag)
+{
+    copy_frames_aux (src, dst, no_simd_tag ());
+}
+
+template <typename Range1, typename Range2> PSYNTH_FORCEINLINE
+void copy_frames_aux (const Range1& src, const Range2& dst,
+                      stereo_planar_simd_tag)
+{
+    simd::copy (simd_ptr (at_c<0> (src.begin ())),
+                simd_ptr (at_c<0> (dst.begin ())), src.size ());
+    simd::copy (simd_ptr (at_c<1> (src.begin ())),
+                simd_ptr (at_c<1> (dst.begin ())), src.size ());
+}
+
+} /* namespace detail */
+
 /**
    \ingroup ImageRangeSTLAlgorithmsCopyFrames
    \brief std::copy for image ranges
+
+   Floating point mono and planar stereo ranges use the vectorized
+   kernels in simd.hpp.
 */
 template <typename Range1, typename Range2> PSYNTH_FORCEINLINE
 void copy_frames (const Range1& src, const Range2& dst)
 {
     assert (src.size () == dst.size ());
-    std::copy (src.begin(), src.end(), dst.begin());
+    detail::copy_frames_aux (
+        src, dst, typename detail::simd_range_pair_tag<Range1, Range2>::type ());
 }
 
 /**
@@ -420,6 +456,33 @@ void fill_aux(It first, It last, const P& p, boost::mpl::false_)
     std::fill (first, last, p);
 }
 
+template <typename Range, typename P>
+PSYNTH_FORCEINLINE
+void fill_frames_aux (const Range& r, const P& p, no_simd_tag)
+{
+    fill_aux (r.begin (), r.end (), p, is_planar<Range>());
+}
+
+template <typename Range, typename P>
+PSYNTH_FORCEINLINE
+void fill_frames_aux (const Range& r, const P& p, mono_simd_tag)
+{
+    const typename Range::value_type v (p);
+    simd::fill (simd_ptr (r.begin ()), r.size (),
+                *simd_ptr (&at_c<0> (v)));
+}
+
+template <typename Range, typename P>
+PSYNTH_FORCEINLINE
+void fill_frames_aux (const Range& r, const P& p, stereo_planar_simd_tag)
+{
+    const typename Range::value_type v (p);
+    simd::fill (simd_ptr (at_c<0> (r.begin ())), r.size (),
+                *simd_ptr (&at_c<0> (v)));
+    simd::fill (simd_ptr (at_c<1> (r.begin ())), r.size (),
+                *simd_ptr (&at_c<1> (v)));
+}
+
 } /* namespace detail */
 
 /**
@@ -429,8 +492,8 @@ void fill_aux(It first, It last, const P& p, boost::mpl::false_)
 template <typename Range, typename Value> PSYNTH_FORCEINLINE
 void fill_frames (const Range& buf_range, const Value& val)
 {
-    detail::fill_aux (buf_range.begin (), buf_range.end (),
-		      val, is_planar<Range>());
+    detail::fill_frames_aux (
+        buf_range, val, typename detail::simd_range_tag<Range>::type ());
 }
 
 /**
@@ -440,8 +503,8 @@ void fill_frames (const Range& buf_range, const Value& val)
 template <typename Range, typename Value> PSYNTH_FORCEINLINE
 void fill_frames (Range& buf_range, const Value& val)
 {
-    detail::fill_aux (buf_range.begin (), buf_range.end (),
-		      val, is_planar<Range>());
+    detail::fill_frames_aux (
+        buf_range, val, typename detail::simd_range_tag<Range>::type ());
 }
 
 namespace detail
@@ -782,13 +845,48 @@ F for_each_frame_position (const Range& buf, F fun)
    \ingroup ImageRangeSTLAlgorithmsGenerateFrames
    \brief std::generate for image ranges
 */
+namespace detail
+{
+
 template <typename Range, typename F>
 PSYNTH_FORCEINLINE
-void generate_frames (const Range& v, F fun)
+void generate_frames_aux (const Range& v, F& fun, no_simd_tag)
 {
     std::generate (v.begin (), v.end (), fun);
 }
 
+template <typename Range, typename F>
+PSYNTH_FORCEINLINE
+void generate_frames_aux (const Range& v, F& fun, mono_simd_tag)
+{
+    auto out = v.begin ();
+    const std::ptrdiff_t size = v.size ();
+    for (std::ptrdiff_t x = 0; x < size; ++x)
+        out [x] = fun ();
+}
+
+template <typename Range, typename F>
+PSYNTH_FORCEINLINE
+void generate_frames_aux (const Range& v, F& fun, stereo_planar_simd_tag)
+{
+    typedef typename Range::reference reference;
+    auto out0 = at_c<0> (v.begin ());
+    auto out1 = at_c<1> (v.begin ());
+    const std::ptrdiff_t size = v.size ();
+    for (std::ptrdiff_t x = 0; x < size; ++x)
+        reference (out0 [x], out1 [x]) = fun ();
+}
+
+} /* namespace detail */
+
+template <typename Range, typename F>
+PSYNTH_FORCEINLINE
+void generate_frames (const Range& v, F fun)
+{
+    detail::generate_frames_aux (
+        v, fun, typename detail::simd_range_tag<Range>::type ());
+}
+
 /**
    \defgroup ImageRangeSTLAlgorithmsEqualFrames equal_frames
    \ingroup ImageRangeSTLAlgorithms
@@ -921,12 +1019,57 @@ bool equal_frames (const Range1& v1, const Range2& v2)
 
    @todo Implement with STL?
 */
+namespace detail
+{
+
+template <typename Range1, typename Range2, typename F> PSYNTH_FORCEINLINE
+void transform_frames_aux (const Range1& src, const Range2& dst, F& fun,
+                           no_simd_tag)
+{
+    for (std::ptrdiff_t x = 0; x < src.size (); ++x)
+	dst [x] = fun (src [x]);
+}
+
+template <typename Range1, typename Range2, typename F> PSYNTH_FORCEINLINE
+void transform_frames_aux (const Range1& src, const Range2& dst, F& fun,
+                           mono_simd_tag)
+{
+    auto in  = src.begin ();
+    auto out = dst.begin ();
+    const std::ptrdiff_t size = src.size ();
+    for (std::ptrdiff_t x = 0; x < size; ++x)
+	out [x] = fun (in [x]);
+}
+
+/**
+   Walks the planes with plain pointers instead of planar iterators,
+   which lets the compiler vectorize @a fun when it is inlined.
+*/
+template <typename Range1, typename Range2, typename F> PSYNTH_FORCEINLINE
+void transform_frames_aux (const Range1& src, const Range2& dst, F& fun,
+                           stereo_planar_simd_tag)
+{
+    typedef typename Range1::reference src_reference;
+    typedef typename Range2::reference dst_reference;
+    auto in0  = at_c<0> (src.begin ());
+    auto in1  = at_c<1> (src.begin ());
+    auto out0 = at_c<0> (dst.begin ());
+    auto out1 = at_c<1> (dst.begin ());
+    const std::ptrdiff_t size = src.size ();
+    for (std::ptrdiff_t x = 0; x < size; ++x)
+        dst_reference (out0 [x], out1 [x]) =
+            fun (src_reference (in0 [x], in1 [x]));
+}
+
+} /* namespace detail */
+
 template <typename Range1, typename Range2, typename F> PSYNTH_FORCEINLINE
 F transform_frames (const Range1& src, const Range2& dst, F fun)
 {
     assert (src.size() == dst.size());
-    for (std::ptrdiff_t x = 0; x < src.size (); ++x)
-	dst [x] = fun (src [x]);
+    detail::transform_frames_aux (
+        src, dst, fun,
+        typename detail::simd_range_pair_tag<Range1, Range2>::type ());
     return fun;
 }
 
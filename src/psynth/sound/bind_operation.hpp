@@ -0,0 +1,279 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        bind_operation.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Operations on variants with the type dispatch cached.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_BIND_OPERATION_HPP_
+#define PSYNTH_SOUND_BIND_OPERATION_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include <psynth/sound/apply_operation.hpp>
+#include <psynth/sound/variant.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+namespace detail
+{
+
+template <typename UnaryOp>
+struct bound_unary_thunks
+{
+    typedef typename UnaryOp::result_type result_type;
+    typedef result_type (*mutable_fn) (void*, UnaryOp&);
+    typedef result_type (*const_fn) (const void*, UnaryOp&);
+
+    mutable_fn apply;
+    const_fn   applyc;
+
+    template <typename T>
+    static result_type apply_to (void* bits, UnaryOp& op)
+    { return op (*static_cast<T*> (bits)); }
+
+    template <typename T>
+    static result_type apply_to_c (const void* bits, UnaryOp& op)
+    { return op (*static_cast<const T*> (bits)); }
+
+    /**
+     * The const thunk is only instantiated when the operation can be
+     * called with a const @a T, otherwise it is left null.
+     */
+    template <typename T>
+    static auto const_thunk (int)
+        -> decltype ((void) std::declval<UnaryOp&> () (
+                         std::declval<const T&> ()), const_fn ())
+    { return &apply_to_c<T>; }
+
+    template <typename T>
+    static const_fn const_thunk (long)
+    { return 0; }
+
+    struct make_fn
+    {
+        typedef bound_unary_thunks result_type;
+
+        template <typename T>
+        result_type operator () (const T&) const
+        { return result_type { &apply_to<T>, const_thunk<T> (0) }; }
+    };
+};
+
+template <typename BinaryOp>
+struct bound_binary_thunks
+{
+    typedef typename BinaryOp::result_type result_type;
+    typedef result_type (*const_fn) (const void*, const void*, BinaryOp&);
+
+    const_fn applyc;
+
+    template <typename T1, typename T2>
+    static result_type apply_to_c (const void* bits1, const void* bits2,
+                                   BinaryOp& op)
+    { return op (*static_cast<const T1*> (bits1),
+                 *static_cast<const T2*> (bits2)); }
+
+    struct make_fn
+    {
+        typedef bound_binary_thunks result_type;
+
+        template <typename T1, typename T2>
+        result_type operator () (const T1&, const T2&) const
+        { return result_type { &apply_to_c<T1, T2> }; }
+    };
+};
+
+} /* namespace detail */
+
+/**
+ * \ingroup Variant
+ * \brief A unary operation bound to the current type of a variant.
+ *
+ * apply_operation () finds the concrete type of the variant every
+ * time it is called. A bound_operation finds it once, when it is
+ * created, and afterwards calls the operation specialized for that
+ * type directly. It can be applied to any variant of the same
+ * types, and it binds itself again, only once, when the variant
+ * holds a different type than the last time.
+ *
+ * This is meant for operations on dynamic buffers and ranges that
+ * are run once per block:
+ *
+ * @code
+ * auto copy = bind_operation (dyn_range, copy_frames_fn ());
+ * ...
+ * copy (dyn_range);
+ * @endcode
+ */
+template <typename Types, typename UnaryOp>
+class bound_operation
+{
+    typedef detail::bound_unary_thunks<UnaryOp> thunks;
+
+public:
+    typedef typename UnaryOp::result_type result_type;
+
+    bound_operation (const variant<Types>& var, UnaryOp op)
+        : _op (op)
+        , _index (var._index)
+        , _thunks (apply_operation (var, typename thunks::make_fn ()))
+    {}
+
+    result_type operator () (variant<Types>& var)
+    {
+        rebind (var);
+        return _thunks.apply (&var._bits, _op);
+    }
+
+    /**
+     * Only valid when the operation can be called with the current
+     * type of @a var as a const reference.
+     */
+    result_type operator () (const variant<Types>& var)
+    {
+        rebind (var);
+        assert (_thunks.applyc);
+        return _thunks.applyc (&var._bits, _op);
+    }
+
+    /**
+     * Returns whether the operation can be applied to @a var without
+     * binding it again.
+     */
+    bool is_bound_to (const variant<Types>& var) const
+    { return var._index == _index; }
+
+    UnaryOp& op ()
+    { return _op; }
+
+    const UnaryOp& op () const
+    { return _op; }
+
+private:
+    void rebind (const variant<Types>& var)
+    {
+        if (var._index != _index)
+        {
+            _thunks = apply_operation (var, typename thunks::make_fn ());
+            _index  = var._index;
+        }
+    }
+
+    UnaryOp     _op;
+    std::size_t _index;
+    thunks      _thunks;
+};
+
+/**
+ * \ingroup Variant
+ * \brief A binary operation bound to the current types of two
+ * variants.
+ * @see bound_operation
+ */
+template <typename Types1, typename Types2, typename BinaryOp>
+class bound_binary_operation
+{
+    typedef detail::bound_binary_thunks<BinaryOp> thunks;
+
+public:
+    typedef typename BinaryOp::result_type result_type;
+
+    bound_binary_operation (const variant<Types1>& var1,
+                            const variant<Types2>& var2,
+                            BinaryOp op)
+        : _op (op)
+        , _index1 (var1._index)
+        , _index2 (var2._index)
+        , _thunks (apply_operation (var1, var2,
+                                    typename thunks::make_fn ()))
+    {}
+
+    result_type operator () (const variant<Types1>& var1,
+                             const variant<Types2>& var2)
+    {
+        if (!is_bound_to (var1, var2))
+        {
+            _thunks = apply_operation (var1, var2,
+                                       typename thunks::make_fn ());
+            _index1 = var1._index;
+            _index2 = var2._index;
+        }
+        return _thunks.applyc (&var1._bits, &var2._bits, _op);
+    }
+
+    bool is_bound_to (const variant<Types1>& var1,
+                      const variant<Types2>& var2) const
+    { return var1._index == _index1 && var2._index == _index2; }
+
+    BinaryOp& op ()
+    { return _op; }
+
+    const BinaryOp& op () const
+    { return _op; }
+
+private:
+    BinaryOp    _op;
+    std::size_t _index1;
+    std::size_t _index2;
+    thunks      _thunks;
+};
+
+/**
+ * \ingroup Variant
+ * \brief Binds a unary operation to the current type of @a var.
+ */
+template <typename Types, typename UnaryOp>
+bound_operation<Types, UnaryOp>
+bind_operation (const variant<Types>& var, UnaryOp op)
+{
+    return bound_operation<Types, UnaryOp> (var, op);
+}
+
+/**
+ * \ingroup Variant
+ * \brief Binds a binary operation to the current types of @a var1
+ * and @a var2.
+ */
+template <typename Types1, typename Types2, typename BinaryOp>
+bound_binary_operation<Types1, Types2, BinaryOp>
+bind_operation (const variant<Types1>& var1,
+                const variant<Types2>& var2,
+                BinaryOp op)
+{
+    return bound_binary_operation<Types1, Types2, BinaryOp> (
+        var1, var2, op);
+}
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_BIND_OPERATION_HPP_ */
@@ -316,10 +316,11 @@ private:
 
     std::size_t total_allocated_size_in_bytes (size_type size) const
     {
-        std::size_t size_in_units = size * memunit_step (
-	    typename range::iterator ());
-        if (IsPlanar)
-            size_in_units = size_in_units * num_samples<range>::value;
+        // planes are laid out one every get_size_in_memunits (), which
+        // includes their alignment padding
+        std::size_t size_in_units = IsPlanar ?
+	    get_size_in_memunits (size) * num_samples<range>::value :
+	    size * memunit_step (typename range::iterator ());
 
         // return the size rounded up to the nearest byte
         return (size_in_units +
@@ -0,0 +1,450 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        expression.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Lazy arithmetic expressions over floating point ranges.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_EXPRESSION_HPP_
+#define PSYNTH_SOUND_EXPRESSION_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include <psynth/base/compat.hpp>
+#include <psynth/sound/frame.hpp>
+#include <psynth/sound/planar_frame_iterator.hpp>
+#include <psynth/sound/simd.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+/**
+ * @defgroup SoundExpression Range expressions
+ *
+ * Arithmetic over whole ranges that is evaluated lazily. Wrapping a
+ * range with lazy () lets it take part in expressions with the usual
+ * operators, and nothing is computed until the expression is assigned
+ * to another lazy range:
+ *
+ * @code
+ * lazy (out) = (lazy (a) + lazy (b) * gain) * lazy (env);
+ * @endcode
+ *
+ * The whole expression is computed in a single pass over memory, one
+ * channel at a time, with plain pointer loops that the compiler can
+ * vectorize. Single channel operands are applied to every channel of
+ * the destination, so a mono envelope can modulate a stereo signal.
+ *
+ * Only ranges of floating point samples stored in memory, either
+ * interleaved or planar, are supported. Operands must have the same
+ * size as the destination. An operand may be the destination itself,
+ * because every frame only depends on the same frame of the operands,
+ * but it must not partially overlap it.
+ */
+
+namespace detail
+{
+
+/**
+ * Access to the raw planes of the ranges that can be used in
+ * expressions.
+ */
+template <typename Iterator>
+struct expr_plane_traits;
+
+template <typename Layout>
+struct expr_plane_traits<frame<bits32sf, Layout>*>
+{
+    static constexpr std::ptrdiff_t stride =
+        num_samples<frame<bits32sf, Layout> >::value;
+
+    static float* plane (frame<bits32sf, Layout>* it, std::size_t c)
+    { return simd_ptr (it) + c; }
+};
+
+template <typename Layout>
+struct expr_plane_traits<const frame<bits32sf, Layout>*>
+{
+    static constexpr std::ptrdiff_t stride =
+        num_samples<frame<bits32sf, Layout> >::value;
+
+    static const float* plane (const frame<bits32sf, Layout>* it,
+                               std::size_t c)
+    { return simd_ptr (it) + c; }
+};
+
+template <typename ChannelSpace>
+struct expr_plane_traits<planar_frame_iterator<bits32sf*, ChannelSpace> >
+{
+    static constexpr std::ptrdiff_t stride = 1;
+
+    static float* plane (
+        const planar_frame_iterator<bits32sf*, ChannelSpace>& it,
+        std::size_t c)
+    { return simd_ptr (dynamic_at_c (it, c)); }
+};
+
+template <typename ChannelSpace>
+struct expr_plane_traits<
+    planar_frame_iterator<const bits32sf*, ChannelSpace> >
+{
+    static constexpr std::ptrdiff_t stride = 1;
+
+    static const float* plane (
+        const planar_frame_iterator<const bits32sf*, ChannelSpace>& it,
+        std::size_t c)
+    { return simd_ptr (dynamic_at_c (it, c)); }
+};
+
+struct expr_add
+{
+    static PSYNTH_FORCEINLINE float apply (float a, float b)
+    { return a + b; }
+};
+
+struct expr_sub
+{
+    static PSYNTH_FORCEINLINE float apply (float a, float b)
+    { return a - b; }
+};
+
+struct expr_mul
+{
+    static PSYNTH_FORCEINLINE float apply (float a, float b)
+    { return a * b; }
+};
+
+struct expr_div
+{
+    static PSYNTH_FORCEINLINE float apply (float a, float b)
+    { return a / b; }
+};
+
+struct expr_assign
+{
+    PSYNTH_FORCEINLINE void operator () (float& dst, float x) const
+    { dst = x; }
+};
+
+template <class Op>
+struct expr_update
+{
+    PSYNTH_FORCEINLINE void operator () (float& dst, float x) const
+    { dst = Op::apply (dst, x); }
+};
+
+} /* namespace detail */
+
+/**
+ * Base of every expression node.
+ *
+ * Nodes define the number of @c channels they produce, a @c size_ok
+ * method checking the size of the ranges they read, and a @c bind
+ * method that returns, for one channel, a function object computing
+ * the value of the frame at an index.
+ */
+template <typename Derived>
+struct range_expr_base
+{
+    const Derived& self () const
+    { return static_cast<const Derived&> (*this); }
+};
+
+/**
+ * A constant that is the same for every frame and channel.
+ */
+class scalar_expr : public range_expr_base<scalar_expr>
+{
+public:
+    static constexpr std::size_t channels = 1;
+
+    template <typename ChannelSpace>
+    static constexpr bool accepts ()
+    { return true; }
+
+    struct kernel
+    {
+        float value;
+
+        PSYNTH_FORCEINLINE float operator () (std::ptrdiff_t) const
+        { return value; }
+    };
+
+    explicit scalar_expr (float value)
+        : _value (value)
+    {}
+
+    bool size_ok (std::ptrdiff_t) const
+    { return true; }
+
+    kernel bind (std::size_t) const
+    { return kernel { _value }; }
+
+private:
+    float _value;
+};
+
+template <typename Op, typename Left, typename Right>
+class binary_expr : public range_expr_base<binary_expr<Op, Left, Right> >
+{
+    static_assert (Left::channels == Right::channels ||
+                   Left::channels == 1 || Right::channels == 1,
+                   "Operands have an incompatible number of channels.");
+
+public:
+    static constexpr std::size_t channels =
+        Left::channels > Right::channels ? Left::channels : Right::channels;
+
+    template <typename ChannelSpace>
+    static constexpr bool accepts ()
+    {
+        return Left::template accepts<ChannelSpace> () &&
+            Right::template accepts<ChannelSpace> ();
+    }
+
+    struct kernel
+    {
+        typename Left::kernel  left;
+        typename Right::kernel right;
+
+        PSYNTH_FORCEINLINE float operator () (std::ptrdiff_t i) const
+        { return Op::apply (left (i), right (i)); }
+    };
+
+    binary_expr (const Left& left, const Right& right)
+        : _left (left)
+        , _right (right)
+    {}
+
+    bool size_ok (std::ptrdiff_t size) const
+    { return _left.size_ok (size) && _right.size_ok (size); }
+
+    kernel bind (std::size_t c) const
+    { return kernel { _left.bind (c), _right.bind (c) }; }
+
+private:
+    Left  _left;
+    Right _right;
+};
+
+template <typename Expr>
+class negate_expr : public range_expr_base<negate_expr<Expr> >
+{
+public:
+    static constexpr std::size_t channels = Expr::channels;
+
+    template <typename ChannelSpace>
+    static constexpr bool accepts ()
+    { return Expr::template accepts<ChannelSpace> (); }
+
+    struct kernel
+    {
+        typename Expr::kernel expr;
+
+        PSYNTH_FORCEINLINE float operator () (std::ptrdiff_t i) const
+        { return -expr (i); }
+    };
+
+    explicit negate_expr (const Expr& expr)
+        : _expr (expr)
+    {}
+
+    bool size_ok (std::ptrdiff_t size) const
+    { return _expr.size_ok (size); }
+
+    kernel bind (std::size_t c) const
+    { return kernel { _expr.bind (c) }; }
+
+private:
+    Expr _expr;
+};
+
+/**
+ * A range taking part in an expression. When the range is mutable,
+ * assigning an expression to it evaluates the expression into the
+ * range.
+ */
+template <typename Range>
+class range_expr : public range_expr_base<range_expr<Range> >
+{
+    typedef detail::expr_plane_traits<typename Range::iterator> traits;
+    typedef typename channel_space_type<Range>::type channel_space;
+
+public:
+    typedef Range range;
+
+    static constexpr std::size_t channels = num_samples<Range>::value;
+
+    template <typename ChannelSpace>
+    static constexpr bool accepts ()
+    {
+        return channels == 1 ||
+            std::is_same<ChannelSpace, channel_space>::value;
+    }
+
+    struct kernel
+    {
+        const float* data;
+
+        PSYNTH_FORCEINLINE float operator () (std::ptrdiff_t i) const
+        { return data [i * traits::stride]; }
+    };
+
+    explicit range_expr (const Range& rng)
+        : _range (rng)
+    {}
+
+    const Range& get () const
+    { return _range; }
+
+    bool size_ok (std::ptrdiff_t size) const
+    { return _range.size () == size; }
+
+    kernel bind (std::size_t c) const
+    { return kernel { traits::plane (_range.begin (),
+                                     channels == 1 ? 0 : c) }; }
+
+    const range_expr& operator= (const range_expr& expr) const
+    { return evaluate (expr, detail::expr_assign ()); }
+
+    template <typename Expr>
+    const range_expr& operator= (const range_expr_base<Expr>& expr) const
+    { return evaluate (expr.self (), detail::expr_assign ()); }
+
+    const range_expr& operator= (float value) const
+    { return evaluate (scalar_expr (value), detail::expr_assign ()); }
+
+    template <typename Expr>
+    const range_expr& operator+= (const range_expr_base<Expr>& expr) const
+    { return evaluate (expr.self (),
+                       detail::expr_update<detail::expr_add> ()); }
+
+    template <typename Expr>
+    const range_expr& operator-= (const range_expr_base<Expr>& expr) const
+    { return evaluate (expr.self (),
+                       detail::expr_update<detail::expr_sub> ()); }
+
+    template <typename Expr>
+    const range_expr& operator*= (const range_expr_base<Expr>& expr) const
+    { return evaluate (expr.self (),
+                       detail::expr_update<detail::expr_mul> ()); }
+
+    const range_expr& operator*= (float value) const
+    { return evaluate (scalar_expr (value),
+                       detail::expr_update<detail::expr_mul> ()); }
+
+private:
+    template <typename Expr, typename Update>
+    const range_expr& evaluate (const Expr& expr, Update update) const
+    {
+        static_assert (Expr::channels == 1 || Expr::channels == channels,
+                       "The expression has a different number of channels.");
+        static_assert (Expr::template accepts<channel_space> (),
+                       "The expression mixes different channel layouts.");
+        assert (expr.size_ok (_range.size ()));
+
+        const std::ptrdiff_t size = _range.size ();
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            float* out = traits::plane (_range.begin (), c);
+            const auto kernel = expr.bind (c);
+
+            // Blocks of a fixed size get vectorized even by the cheap
+            // cost model used at -O2.
+            std::ptrdiff_t i = 0;
+            for (; i + std::ptrdiff_t (simd::width) <= size;
+                 i += simd::width)
+            {
+                PSYNTH_IVDEP
+                for (std::size_t j = 0; j < simd::width; ++j)
+                    update (out [(i + j) * traits::stride], kernel (i + j));
+            }
+            for (; i < size; ++i)
+                update (out [i * traits::stride], kernel (i));
+        }
+        return *this;
+    }
+
+    Range _range;
+};
+
+/**
+ * Makes @a range usable in expressions.
+ * @ingroup SoundExpression
+ */
+template <typename Range>
+range_expr<Range> lazy (const Range& rng)
+{
+    return range_expr<Range> (rng);
+}
+
+template <typename Expr>
+negate_expr<Expr> operator- (const range_expr_base<Expr>& expr)
+{
+    return negate_expr<Expr> (expr.self ());
+}
+
+#define PSYNTH_SOUND_DEFINE_EXPR_OPERATOR(op, functor)                  \
+    template <typename Left, typename Right>                            \
+    binary_expr<detail::functor, Left, Right>                           \
+    operator op (const range_expr_base<Left>& left,                     \
+                 const range_expr_base<Right>& right)                   \
+    {                                                                   \
+        return binary_expr<detail::functor, Left, Right> (              \
+            left.self (), right.self ());                               \
+    }                                                                   \
+                                                                        \
+    template <typename Left>                                            \
+    binary_expr<detail::functor, Left, scalar_expr>                     \
+    operator op (const range_expr_base<Left>& left, float right)        \
+    {                                                                   \
+        return binary_expr<detail::functor, Left, scalar_expr> (        \
+            left.self (), scalar_expr (right));                         \
+    }                                                                   \
+                                                                        \
+    template <typename Right>                                           \
+    binary_expr<detail::functor, scalar_expr, Right>                    \
+    operator op (float left, const range_expr_base<Right>& right)       \
+    {                                                                   \
+        return binary_expr<detail::functor, scalar_expr, Right> (       \
+            scalar_expr (left), right.self ());                         \
+    }
+
+PSYNTH_SOUND_DEFINE_EXPR_OPERATOR (+, expr_add)
+PSYNTH_SOUND_DEFINE_EXPR_OPERATOR (-, expr_sub)
+PSYNTH_SOUND_DEFINE_EXPR_OPERATOR (*, expr_mul)
+PSYNTH_SOUND_DEFINE_EXPR_OPERATOR (/, expr_div)
+
+#undef PSYNTH_SOUND_DEFINE_EXPR_OPERATOR
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_EXPRESSION_HPP_ */
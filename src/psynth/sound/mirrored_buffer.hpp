@@ -0,0 +1,209 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        mirrored_buffer.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Buffer whose memory is mirrored after its end.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_MIRRORED_BUFFER_HPP_
+#define PSYNTH_SOUND_MIRRORED_BUFFER_HPP_
+
+#include <memory>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/utility.hpp>
+
+#include <psynth/base/memory.hpp>
+#include <psynth/sound/metafunctions.hpp>
+#include <psynth/sound/buffer_range.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+/**
+ * A buffer allocated with base::mirrored_memory, one region per
+ * plane, so the frames right after the end of its range are again
+ * the ones at the beginning. When used as the storage of a
+ * ring_buffer or a spsc_ring_buffer, every window of the ring is
+ * contiguous in memory.
+ *
+ * The size is rounded up so every plane fills whole pages, and the
+ * frames are initialized to zero. The samples must be plain values.
+ * The alignment and allocator parameters exist only to be usable
+ * where a buffer is, as the memory is always page aligned.
+ */
+template <typename Frame, bool IsPlanar>
+class mirrored_buffer : private boost::noncopyable
+{
+public:
+    typedef std::allocator<unsigned char> allocator_type;
+
+    typedef typename range_type_from_frame<Frame, IsPlanar>::type range;
+    typedef typename range::const_type  const_range;
+
+    typedef typename range::size_type        size_type;
+    typedef typename range::value_type       value_type;
+    typedef typename range::difference_type  difference_type;
+    typedef typename range::reference        reference;
+
+    typedef typename range::iterator               iterator;
+    typedef typename const_range::iterator         const_iterator;
+
+    explicit mirrored_buffer (size_type size = 0,
+                              std::size_t alignment = 0,
+                              const allocator_type alloc_in =
+                              allocator_type ())
+    {
+        recreate (size);
+    }
+
+    size_type size () const
+    { return _range.size (); }
+
+    /**
+     * Returns wether the memory is actually mirrored, which might
+     * not be if the system does not support it.
+     */
+    bool is_mirrored () const
+    { return _memory.is_mirrored (); }
+
+    void recreate (size_type size, std::size_t alignment = 0)
+    {
+        const std::size_t bytes = region_size (size);
+        if (size_type (bytes / unit_size ()) != _range.size ())
+        {
+            base::mirrored_memory memory (bytes, planes ());
+            _range = make_range (memory, boost::mpl::bool_<IsPlanar> ());
+            _memory = std::move (memory);
+        }
+    }
+
+    allocator_type allocator () const
+    { return allocator_type (); }
+
+private:
+    typedef typename sample_type<range>::type sample;
+
+    static std::size_t planes ()
+    { return IsPlanar ? num_samples<range>::value : 1; }
+
+    static std::size_t unit_size ()
+    { return IsPlanar ? sizeof (sample) : sizeof (Frame); }
+
+    /**
+     * Whole pages holding whole frames.
+     */
+    static std::size_t region_size (size_type size)
+    {
+        std::size_t bytes = base::round_to_page (size * unit_size ());
+        while (bytes % unit_size ())
+            bytes += base::page_size ();
+        return bytes;
+    }
+
+    static range make_range (const base::mirrored_memory& memory,
+                             boost::mpl::false_)
+    {
+        return range (memory.size () / unit_size (),
+                      iterator (reinterpret_cast<Frame*> (memory.data ())));
+    }
+
+    static range make_range (const base::mirrored_memory& memory,
+                             boost::mpl::true_)
+    {
+        iterator first;
+        for (std::size_t i = 0; i < planes (); ++i)
+            dynamic_at_c (first, i) =
+                reinterpret_cast<sample*> (memory.data (i));
+        return range (memory.size () / unit_size (), first);
+    }
+
+    template <typename F, bool P> friend
+    const typename mirrored_buffer<F, P>::range&
+    range (mirrored_buffer<F, P>& buf);
+
+    template <typename F, bool P> friend
+    const typename mirrored_buffer<F, P>::const_range
+    const_range (const mirrored_buffer<F, P>& buf);
+
+    base::mirrored_memory _memory;
+    range                 _range;
+};
+
+template <typename Frame, bool IsPlanar> inline
+const typename mirrored_buffer<Frame, IsPlanar>::range&
+range (mirrored_buffer<Frame, IsPlanar>& buf)
+{
+    return buf._range;
+}
+
+template <typename Frame, bool IsPlanar> inline
+const typename mirrored_buffer<Frame, IsPlanar>::const_range
+const_range (const mirrored_buffer<Frame, IsPlanar>& buf)
+{
+    return typename mirrored_buffer<Frame, IsPlanar>::const_range (
+        buf._range);
+}
+
+namespace detail
+{
+
+/**
+ * Used by the ring buffers to know whether their storage is
+ * mirrored.
+ */
+template <typename Buffer>
+bool buffer_is_mirrored (const Buffer&)
+{ return false; }
+
+template <typename Frame, bool IsPlanar>
+bool buffer_is_mirrored (const mirrored_buffer<Frame, IsPlanar>& buf)
+{ return buf.is_mirrored (); }
+
+} /* namespace detail */
+
+template <typename Frame, bool IsPlanar>
+struct sample_type<mirrored_buffer<Frame, IsPlanar> > :
+    public sample_type<Frame> {};
+
+template <typename Frame, bool IsPlanar>
+struct channel_space_type<mirrored_buffer<Frame, IsPlanar> >  :
+    public channel_space_type<Frame> {};
+
+template <typename Frame, bool IsPlanar>
+struct sample_mapping_type<mirrored_buffer<Frame, IsPlanar> > :
+    public sample_mapping_type<Frame> {};
+
+template <typename Frame, bool IsPlanar>
+struct is_planar<mirrored_buffer<Frame, IsPlanar> > :
+    public boost::mpl::bool_<IsPlanar> {};
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_MIRRORED_BUFFER_HPP_ */
@@ -32,6 +32,7 @@
 #define PSYNTH_SOUND_RING_BUFFER_H_
 
 #include <psynth/sound/buffer.hpp>
+#include <psynth/sound/mirrored_buffer.hpp>
 #include <psynth/sound/ring_buffer_range.hpp>
 
 namespace psynth
@@ -61,7 +62,9 @@ public:
 			       std::size_t alignment = 0)
 	: _buffer (size, alignment)
 	, _range  (range_base (range (_buffer)))
-    {}
+    {
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
+    }
 
     template <typename Allocator>
     explicit ring_buffer_base (size_type size,
@@ -69,12 +72,15 @@ public:
 			       Allocator alloc_in)
 	: _buffer (size, alignment, alloc_in)
 	, _range  (range_base (range (_buffer)))
-    {}
+    {
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
+    }
 
     explicit ring_buffer_base (const Buffer& buf)
 	: _buffer (buf)
 	, _range (range_base (range (_buffer)))
     {
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
 	_range.advance (size ());
     }
 
@@ -83,6 +89,7 @@ public:
 	: _buffer (buf)
 	, _range (range_base (range (_buffer)))
     {
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
 	_range.advance (size ());
     }
 
@@ -90,6 +97,7 @@ public:
     {
 	_buffer = buf._buffer;
 	_range  = range_base (range (_buffer));
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
 	_range.advance (buf._range.count ());
         return *this;
     }
@@ -99,6 +107,7 @@ public:
     {
 	_buffer = buf._buffer;
 	_range  = range_base (range (_buffer));
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
 	_range.advance (buf._range.count ());
         return *this;
     }
@@ -119,6 +128,7 @@ public:
     {
 	_buffer.recreate (size, alignment);
 	_range = range_base (range (_buffer));
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
     }
 
     template <typename Allocator>
@@ -128,6 +138,7 @@ public:
     {
 	_buffer.recreate (size, alignment, alloc_in);
 	_range = range_base (range (_buffer));
+	_range.set_mirrored (detail::buffer_is_mirrored (_buffer));
     }
 
 
@@ -312,6 +323,8 @@ public:
     {
 	this->_buffer.recreate (size, val, alignment);
 	this->_range = range (sound::range (this->_buffer));
+	this->_range.set_mirrored (
+	    detail::buffer_is_mirrored (this->_buffer));
     }
 
 #ifdef PSYNTH_BUFFER_MODELS_RANGE
@@ -43,6 +43,7 @@
 
 #include <psynth/sound/metafunctions.hpp>
 #include <psynth/sound/buffer_range.hpp>
+#include <psynth/sound/buffer_range_factory.hpp>
 
 namespace psynth
 {
@@ -236,6 +237,7 @@ public:
      */
     ring_buffer_range_base ()
 	: _backwards (false)
+	, _mirrored (false)
 	, _startpos (0)
 	, _writepos (0, 0)
     {}
@@ -243,6 +245,7 @@ public:
     /** Copy constructor */
     ring_buffer_range_base (const ring_buffer_range_base& range)
 	: _backwards (range._backwards)
+	, _mirrored (range._mirrored)
 	, _startpos (0)
 	, _writepos (range._writepos)
 	, _range (range._range)
@@ -250,6 +253,7 @@ public:
 
     explicit ring_buffer_range_base (const Range& range)
 	: _backwards (false)
+	, _mirrored (false)
 	, _startpos (0)
 	, _writepos (0, 0)
 	, _range (range)
@@ -281,6 +285,7 @@ public:
     template <class Range2>
     ring_buffer_range_base (const ring_buffer_range_base<Range2>& range)
 	: _backwards (range._backwards)
+	, _mirrored (range._mirrored)
 	, _startpos (0)
 	, _writepos (range._writepos)
 	, _range (range._range)
@@ -290,6 +295,7 @@ public:
     ring_buffer_range_base& operator= (const ring_buffer_range_base& range)
     {
 	_backwards = range._backwards;
+	_mirrored  = range._mirrored;
 	_startpos  = range._startpos;
 	_writepos  = range._writepos;
 	return *this;
@@ -466,6 +472,23 @@ public:
     bool is_backwards () const
     { return _backwards; }
 
+    /**
+     * Returns wether the memory after the end of the range mirrors
+     * its beginning.
+     * @see mirrored_buffer
+     */
+    bool is_mirrored () const
+    { return _mirrored; }
+
+    /**
+     * Tells that the memory after the end of the range mirrors its
+     * beginning, so any window of the ring is contiguous: reads and
+     * writes need only one copy and sub_buffer_two () is always
+     * empty.
+     */
+    void set_mirrored (bool mirrored)
+    { _mirrored = mirrored; }
+
     /**
      * Changes the reading direction of the current pointer write pointer.
      * If you are using this buffer as an intermediate buffer from another
@@ -568,9 +591,22 @@ public:
 					    size () - _writepos._pos + r._pos));
     }
 
+    /**
+     * Returns @a slice frames from @a pos, which may go past the end
+     * of the range only if it is mirrored.
+     */
+    typename buffer_range_type<Range>::type
+    window (size_type pos, size_type slice) const
+    {
+	assert (_mirrored || pos + slice <= size ());
+	return sub_range (_range, pos, slice);
+    }
+
 public:
     bool          _backwards;  /**< @c true if we are reading and
 			          writting the ringbuffer backwards. */
+    bool          _mirrored;   /**< @c true if the memory after the
+			          range mirrors its beginning. */
     size_type     _startpos;   /**< The new starting position of the
 				  ring buffer. */
     position      _writepos;
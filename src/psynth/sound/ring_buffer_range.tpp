@@ -51,10 +51,10 @@ ring_buffer_range_base<R>::sub_buffer_one (const Position& p,
 					   size_type slice) const
 {
     assert (slice <= available (p));
-    if (p._pos + slice > size ())
+    if (!_mirrored && p._pos + slice > size ())
 	return sub_range (_range, p._pos, size () - p._pos);
     else
-	return sub_range (_range, p._pos, slice);
+	return window (p._pos, slice);
 }
 
 template <class R>
@@ -65,10 +65,10 @@ ring_buffer_range_base<R>::sub_buffer_two (const Position& p,
 {
     assert (slice <= available (p));
 
-    if (p._pos + slice > size ())
+    if (!_mirrored && p._pos + slice > size ())
 	return sub_range (_range, 0, p._pos + slice - size ());
     else
-	return sub_range (_range, p._pos + slice, 0);
+	return window (p._pos, 0);
 }
 
 template <class R>
@@ -83,7 +83,7 @@ ring_buffer_range_base<R>::read (Position& r,
     if (is_backwards ())
         advance (r, -slice);
 
-    if (r._pos + slice > size ())
+    if (!_mirrored && r._pos + slice > size ())
     {
 	const size_type slice_one = size () - r._pos;
 	const size_type slice_two = slice - slice_one;
@@ -93,7 +93,7 @@ ring_buffer_range_base<R>::read (Position& r,
 		     sub_range (buf, slice_one, slice_two));
     }
     else
-	copy_frames (sub_range (_range, r._pos, slice),
+	copy_frames (window (r._pos, slice),
 		     sub_range (buf, 0, slice));
 
     if (!is_backwards ())
@@ -115,7 +115,7 @@ ring_buffer_range_base<R>::read_and_convert (Position& r,
     if (is_backwards ())
         advance (r, -slice);
 
-    if (r._pos + slice > size ())
+    if (!_mirrored && r._pos + slice > size ())
     {
 	const size_type slice_one = size () - r._pos;
 	const size_type slice_two = slice - slice_one;
@@ -127,7 +127,7 @@ ring_buffer_range_base<R>::read_and_convert (Position& r,
 				 cc);
     }
     else
-	copy_and_convert_frames (sub_range (_range, r._pos, slice),
+	copy_and_convert_frames (window (r._pos, slice),
 				 sub_range (buf, 0, slice),
 				 cc);
 
@@ -154,7 +154,7 @@ void ring_buffer_range_base<R>::write (const Range& buf, size_type nwrite)
     if (is_backwards ())
         advance (-slice);
 
-    if (_writepos._pos + slice > size ())
+    if (!_mirrored && _writepos._pos + slice > size ())
     {
 	const size_type slice_one = size () - _writepos._pos;
 	const size_type slice_two = slice - slice_one;
@@ -163,8 +163,8 @@ void ring_buffer_range_base<R>::write (const Range& buf, size_type nwrite)
 	copy_frames (sub_range (buf, offset + slice_one, slice_two),
 		     sub_range (_range, 0, slice_two));
     } else
-	copy_frames (sub_range (buf, 0, slice),
-		     sub_range (_range, _writepos._pos, slice));
+	copy_frames (sub_range (buf, offset, slice),
+		     window (_writepos._pos, slice));
 
     if (!is_backwards ())
         advance (slice);
@@ -188,7 +188,7 @@ void ring_buffer_range_base<R>::write_and_convert (const Range& buf,
     if (is_backwards ())
         advance (-nwrite);
 
-    if (_writepos._pos + slice > size ())
+    if (!_mirrored && _writepos._pos + slice > size ())
     {
 	const size_type slice_one = size () - _writepos._pos;
 	const size_type slice_two = slice - slice_one;
@@ -202,8 +202,8 @@ void ring_buffer_range_base<R>::write_and_convert (const Range& buf,
 	    cc);
     } else
 	copy_and_convert_frames (
-	    sub_range (buf, 0, slice),
-	    sub_range (_range, _writepos._pos, slice),
+	    sub_range (buf, offset, slice),
+	    window (_writepos._pos, slice),
 	    cc);
 
     if (!is_backwards ())
@@ -350,6 +350,67 @@ private:
     integer_t _value;
 };
 
+/**
+   \defgroup Sample24ValueModel sample24_value
+   \ingroup SampleModel
+   \brief Represents the value of a 24 bit integral sample stored in
+   three bytes in little endian order, as audio files and devices
+   usually do. Models: SampleValueConcept
+
+   Example:
+   \code
+   assert(sample_traits<bits24s>::min_value()==-(1 << 23));
+   assert(sizeof(bits24s)==3);
+   \endcode
+*/
+template <bool IsSigned>
+class sample24_value
+{
+public:
+    typedef typename boost::mpl::if_c<
+        IsSigned, boost::int32_t, boost::uint32_t>::type integer_t;
+
+    typedef sample24_value        value_type;
+    typedef value_type&           reference;
+    typedef const value_type&     const_reference;
+    typedef value_type*           pointer;
+    typedef const value_type*     const_pointer;
+
+    static value_type min_value ()
+    { return value_type (IsSigned ? -(1 << 23) : 0); }
+    static value_type max_value ()
+    { return value_type (IsSigned ? (1 << 23) - 1 : (1 << 24) - 1); }
+    static value_type zero_value ()
+    { return value_type (IsSigned ? 0 : 1 << 23); }
+    BOOST_STATIC_CONSTANT(bool, is_mutable = true);
+
+    sample24_value () {}
+    sample24_value (integer_t v) { set (v); }
+    template <typename Scalar>
+    sample24_value (Scalar v) { set (integer_t (v)); }
+
+    operator integer_t () const
+    {
+        const boost::uint32_t v =
+            boost::uint32_t (_bytes [0]) |
+            boost::uint32_t (_bytes [1]) << 8 |
+            boost::uint32_t (_bytes [2]) << 16;
+        return IsSigned ?
+            integer_t (boost::int32_t (v ^ 0x800000) - 0x800000) :
+            integer_t (v);
+    }
+
+private:
+    void set (integer_t v)
+    {
+        _bytes [0] = boost::uint8_t (v);
+        _bytes [1] = boost::uint8_t (v >> 8);
+        _bytes [2] = boost::uint8_t (v >> 16);
+    }
+
+    boost::uint8_t _bytes [3];
+};
+
 namespace detail
 {
 
@@ -1009,6 +1070,24 @@ typedef boost::int16_t  bits16s;
 */
 typedef boost::int32_t  bits32s;
 
+/**
+   \defgroup bits24 bits24
+   \ingroup SampleModel
+   \brief 24-bit unsigned integral sample type stored in three
+   bytes. Models SampleValueConcept
+   \ingroup bits24
+*/
+typedef sample24_value<false> bits24;
+
+/**
+   \defgroup bits24s bits24s
+   \ingroup SampleModel
+   \brief 24-bit signed integral sample type stored in three
+   bytes. Models SampleValueConcept
+   \ingroup bits24s
+*/
+typedef sample24_value<true> bits24s;
+
 /**
    \defgroup bits32f bits32f
    \ingroup SampleModel
@@ -1048,6 +1127,10 @@ struct is_integral<psynth::sound::packed_dynamic_sample_reference<
 		       BitField, NumBits, IsMutable> > :
 	public boost::mpl::true_ {};
 
+template <bool IsSigned>
+struct is_integral<psynth::sound::sample24_value<IsSigned> > :
+	public boost::mpl::true_ {};
+
 template <typename BaseSampleValue,
 	  typename MinVal, typename MaxVal, typename ZeroVal>
 struct is_integral<psynth::sound::scoped_sample_value<
@@ -1073,6 +1156,10 @@ struct is_integral<psynth::sound::packed_dynamic_sample_reference<
 		       BitField, NumBits, IsMutable> > :
 	public std::true_type {};
 
+template <bool IsSigned>
+struct is_integral<psynth::sound::sample24_value<IsSigned> > :
+	public std::true_type {};
+
 template <typename BaseSampleValue,
 	  typename MinVal, typename MaxVal, typename ZeroVal>
 struct is_integral<psynth::sound::scoped_sample_value<
@@ -95,6 +95,10 @@ template <>
 struct unsigned_integral_max_value<uint32_t> :
 	public boost::mpl::integral_c<uintmax_t, 0xFFFFFFFF> {};
 
+template <>
+struct unsigned_integral_max_value<bits24> :
+	public boost::mpl::integral_c<uintmax_t, 0xFFFFFF> {};
+
 template <int K>
 struct unsigned_integral_max_value<packed_sample_value<K> >
     : public boost::mpl::integral_c<
@@ -113,6 +117,10 @@ template <int K>
 struct unsigned_integral_num_bits<packed_sample_value<K> >
     : public boost::mpl::int_<K> {};
 
+template <>
+struct unsigned_integral_num_bits<bits24>
+    : public boost::mpl::int_<24> {};
+
 } /* namespace detail */
 
 /**
@@ -440,6 +448,21 @@ template <> struct sample_converter_unsigned<bits32f, bits32> :
     }
 };
 
+/**
+ * \brief 24 bit <-> float sample conversion. Floats can not hold
+ * the maximum 24 bit value plus the rounding offset.
+ */
+template <> struct sample_converter_unsigned<bits32f, bits24> :
+    public std::unary_function<bits32f, bits24>
+{
+    bits24 operator () (bits32f x) const
+    {
+        if (x >= sample_traits<bits32f>::max_value ())
+	    return sample_traits<bits24>::max_value();
+        return bits24 (x * sample_traits<bits24>::max_value () + 0.5f);
+    }
+};
+
 /** @} */
 
 namespace detail
@@ -472,6 +495,15 @@ struct sample_convert_to_unsigned <bits16s> :
     type operator () (bits16s  val) const { return val + 32768; }
 };
 
+template <>
+struct sample_convert_to_unsigned <bits24s> :
+    public std::unary_function<bits24s, bits24>
+{
+    typedef bits24 type;
+    type operator () (bits24s val) const
+    { return type (uint32_t (int32_t (val) + (1 << 23))); }
+};
+
 template <> struct sample_convert_to_unsigned<bits32s> :
 	public std::unary_function<bits32s, bits32>
 {
@@ -517,6 +549,15 @@ struct sample_convert_from_unsigned<bits16s> :
     { return val-32768; }
 };
 
+template <>
+struct sample_convert_from_unsigned<bits24s> :
+    public std::unary_function<bits24, bits24s>
+{
+    typedef bits24s type;
+    type operator () (bits24 val) const
+    { return type (int32_t (uint32_t (val)) - (1 << 23)); }
+};
+
 template <>
 struct sample_convert_from_unsigned<bits32s> :
     public std::unary_function<bits32, bits32s>
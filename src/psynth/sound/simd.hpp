@@ -0,0 +1,184 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        simd.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Explicitly vectorized kernels for floating point samples.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_SIMD_HPP
+#define PSYNTH_SOUND_SIMD_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#if defined (__AVX512F__) || defined (__AVX__)
+#  include <immintrin.h>
+#elif defined (__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include <psynth/base/compat.hpp>
+#include <psynth/sound/sample.hpp>
+#include <psynth/sound/frame.hpp>
+#include <psynth/sound/planar_frame_iterator.hpp>
+#include <psynth/sound/mono.hpp>
+#include <psynth/sound/stereo.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+/**
+ * Kernels working on raw arrays of floats, vectorized with the
+ * widest instruction set enabled at compile time. Unaligned loads
+ * and stores are used, so any pointer is fine. The results are
+ * bit-exact with the plain scalar loops.
+ */
+namespace simd
+{
+
+#if defined (__AVX512F__)
+constexpr std::size_t width = 16;
+constexpr const char* isa_name = "avx512";
+#elif defined (__AVX__)
+constexpr std::size_t width = 8;
+constexpr const char* isa_name = "avx";
+#elif defined (__SSE2__)
+constexpr std::size_t width = 4;
+constexpr const char* isa_name = "sse2";
+#else
+constexpr std::size_t width = 1;
+constexpr const char* isa_name = "none";
+#endif
+
+inline void fill (float* dst, std::size_t n, float value)
+{
+    std::size_t i = 0;
+#if defined (__AVX512F__)
+    const __m512 v = _mm512_set1_ps (value);
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps (dst + i, v);
+#elif defined (__AVX__)
+    const __m256 v = _mm256_set1_ps (value);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps (dst + i, v);
+#elif defined (__SSE2__)
+    const __m128 v = _mm_set1_ps (value);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps (dst + i, v);
+#endif
+    for (; i < n; ++i)
+        dst [i] = value;
+}
+
+/**
+ * Overlapping arrays are handled like std::memmove does.
+ */
+inline void copy (const float* src, float* dst, std::size_t n)
+{
+    if (src == dst)
+        return;
+    if (dst > src && dst < src + n)
+    {
+        std::memmove (dst, src, n * sizeof (float));
+        return;
+    }
+
+    std::size_t i = 0;
+#if defined (__AVX512F__)
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps (dst + i, _mm512_loadu_ps (src + i));
+#elif defined (__AVX__)
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps (dst + i, _mm256_loadu_ps (src + i));
+#elif defined (__SSE2__)
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps (dst + i, _mm_loadu_ps (src + i));
+#endif
+    for (; i < n; ++i)
+        dst [i] = src [i];
+}
+
+} /* namespace simd */
+
+namespace detail
+{
+
+/** Ranges that can not use the vectorized kernels. */
+struct no_simd_tag {};
+/** Single sample interleaved floating point ranges. */
+struct mono_simd_tag {};
+/** Two channel planar floating point ranges. */
+struct stereo_planar_simd_tag {};
+
+template <typename Iterator>
+struct simd_iterator_tag
+{ typedef no_simd_tag type; };
+
+template <>
+struct simd_iterator_tag<frame<bits32sf, mono_layout>*>
+{ typedef mono_simd_tag type; };
+template <>
+struct simd_iterator_tag<const frame<bits32sf, mono_layout>*>
+{ typedef mono_simd_tag type; };
+
+template <>
+struct simd_iterator_tag<planar_frame_iterator<bits32sf*, stereo_space> >
+{ typedef stereo_planar_simd_tag type; };
+template <>
+struct simd_iterator_tag<
+    planar_frame_iterator<const bits32sf*, stereo_space> >
+{ typedef stereo_planar_simd_tag type; };
+
+template <typename Range>
+struct simd_range_tag :
+        public simd_iterator_tag<typename Range::iterator> {};
+
+template <typename Range1, typename Range2,
+          typename Tag1 = typename simd_range_tag<Range1>::type,
+          typename Tag2 = typename simd_range_tag<Range2>::type>
+struct simd_range_pair_tag
+{ typedef no_simd_tag type; };
+
+template <typename Range1, typename Range2, typename Tag>
+struct simd_range_pair_tag<Range1, Range2, Tag, Tag>
+{ typedef Tag type; };
+
+template <typename T>
+PSYNTH_FORCEINLINE float* simd_ptr (T* p)
+{ return reinterpret_cast<float*> (p); }
+
+template <typename T>
+PSYNTH_FORCEINLINE const float* simd_ptr (const T* p)
+{ return reinterpret_cast<const float*> (p); }
+
+} /* namespace detail */
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_SIMD_HPP */
@@ -0,0 +1,136 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        spsc_ring_buffer.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Lock-free single producer, single consumer ring buffer.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_SPSC_RING_BUFFER_HPP_
+#define PSYNTH_SOUND_SPSC_RING_BUFFER_HPP_
+
+#include <boost/utility.hpp>
+
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/mirrored_buffer.hpp>
+#include <psynth/sound/spsc_ring_buffer_range.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+/**
+ * A buffer holding its own spsc_ring_buffer_range. The range is
+ * accessed with the range () free function, as in ring_buffer. With
+ * a mirrored_buffer as @a Buffer every window is contiguous.
+ */
+template <class Buffer>
+class spsc_ring_buffer : private boost::noncopyable
+{
+public:
+    typedef spsc_ring_buffer_range<typename Buffer::range> range;
+    typedef typename range::size_type                       size_type;
+    typedef typename Buffer::allocator_type                 allocator_type;
+
+    explicit spsc_ring_buffer (size_type size = 0,
+                               std::size_t alignment = 0,
+                               const allocator_type alloc_in =
+                               allocator_type ())
+        : _buffer (size, alignment, alloc_in)
+        , _range (sound::range (_buffer))
+    {
+        _range.set_mirrored (detail::buffer_is_mirrored (_buffer));
+    }
+
+    size_type size () const
+    { return _range.size (); }
+
+    /**
+     * Changes the size of the buffer, discarding its contents. Not
+     * thread safe.
+     */
+    void recreate (size_type size, std::size_t alignment = 0)
+    {
+        _buffer.recreate (size, alignment);
+        _range = range (sound::range (_buffer));
+        _range.set_mirrored (detail::buffer_is_mirrored (_buffer));
+    }
+
+    allocator_type& allocator ()
+    { return _buffer.allocator (); }
+
+    const allocator_type& allocator () const
+    { return _buffer.allocator (); }
+
+private:
+    template <typename B> friend
+    typename spsc_ring_buffer<B>::range& range (spsc_ring_buffer<B>& buf);
+
+    template <typename B> friend
+    const typename spsc_ring_buffer<B>::range&
+    const_range (const spsc_ring_buffer<B>& buf);
+
+    Buffer _buffer;
+    range  _range;
+};
+
+/**
+ * As with ring_buffer, this returns a reference because reading and
+ * writing mutate the range.
+ */
+template <typename B>
+typename spsc_ring_buffer<B>::range& range (spsc_ring_buffer<B>& buf)
+{
+    return buf._range;
+}
+
+template <typename B>
+const typename spsc_ring_buffer<B>::range&
+const_range (const spsc_ring_buffer<B>& buf)
+{
+    return buf._range;
+}
+
+template <typename Buffer>
+struct sample_type<spsc_ring_buffer<Buffer> > :
+    public sample_type<Buffer> {};
+
+template <typename Buffer>
+struct channel_space_type<spsc_ring_buffer<Buffer> > :
+    public channel_space_type<Buffer> {};
+
+template <typename Buffer>
+struct sample_mapping_type<spsc_ring_buffer<Buffer> > :
+    public sample_mapping_type<Buffer> {};
+
+template <typename Buffer>
+struct is_planar<spsc_ring_buffer<Buffer> > :
+    public is_planar<Buffer> {};
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_SPSC_RING_BUFFER_HPP_ */
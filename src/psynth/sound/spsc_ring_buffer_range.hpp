@@ -0,0 +1,304 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        spsc_ring_buffer_range.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Lock-free single producer, single consumer ring buffer range.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_HPP_
+#define PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+#include <psynth/sound/metafunctions.hpp>
+#include <psynth/sound/buffer_range.hpp>
+#include <psynth/sound/buffer_range_factory.hpp>
+#include <psynth/sound/ring_buffer_range.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+/**
+ * A ring buffer that can be written by one thread and read by
+ * another without any locking. Unlike ring_buffer_range, it keeps
+ * the only read position itself and the writer never overwrites
+ * data that has not been read: the frames that do not fit are
+ * dropped instead.
+ *
+ * The write and read counters are published with release semantics
+ * and loaded with acquire semantics, so the frames written before
+ * updating a counter are visible to the other side after it sees
+ * the new value.
+ *
+ * Members documented as producer side may only be called from the
+ * writer thread, and members documented as consumer side only from
+ * the reader thread. Copying, assigning and reset () are not thread
+ * safe at all.
+ */
+template <typename Range>
+class spsc_ring_buffer_range
+{
+public:
+    typedef Range range;
+
+    typedef typename Range::size_type       size_type;
+    typedef typename Range::difference_type difference_type;
+
+    spsc_ring_buffer_range ()
+        : _write_count (0)
+        , _read_count (0)
+        , _error (ring_buffer_error::none)
+        , _mirrored (false)
+    {}
+
+    explicit spsc_ring_buffer_range (const Range& range)
+        : _write_count (0)
+        , _read_count (0)
+        , _error (ring_buffer_error::none)
+        , _mirrored (false)
+        , _range (range)
+    {}
+
+    spsc_ring_buffer_range (const spsc_ring_buffer_range& other)
+        : _write_count (other._write_count.load ())
+        , _read_count (other._read_count.load ())
+        , _error (other._error.load ())
+        , _mirrored (other._mirrored)
+        , _range (other._range)
+    {}
+
+    spsc_ring_buffer_range& operator= (const spsc_ring_buffer_range& other)
+    {
+        _write_count = other._write_count.load ();
+        _read_count  = other._read_count.load ();
+        _error       = other._error.load ();
+        _mirrored    = other._mirrored;
+        _range       = other._range;
+        return *this;
+    }
+
+    /**
+     * Returns the size of the buffer.
+     */
+    size_type size () const
+    { return _range.size (); }
+
+    /**
+     * Returns the number of frames that can be read. It may be
+     * called from both sides.
+     */
+    size_type available () const
+    {
+        return _write_count.load (std::memory_order_acquire) -
+            _read_count.load (std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the number of frames that can be written without
+     * dropping any. It may be called from both sides.
+     */
+    size_type space () const
+    { return size () - available (); }
+
+    /**
+     * Returns the last error that happened since the last call to
+     * clear_error (). It is ring_buffer_error::underrun if the
+     * writer had to drop frames because the reader did not keep up,
+     * and ring_buffer_error::overrun if the reader asked for more
+     * frames than there were available.
+     */
+    ring_buffer_error error () const
+    { return _error.load (std::memory_order_relaxed); }
+
+    void clear_error ()
+    { _error.store (ring_buffer_error::none, std::memory_order_relaxed); }
+
+    /**
+     * Total number of frames written so far.
+     */
+    std::size_t write_count () const
+    { return _write_count.load (std::memory_order_acquire); }
+
+    /**
+     * Total number of frames read or skipped so far.
+     */
+    std::size_t read_count () const
+    { return _read_count.load (std::memory_order_acquire); }
+
+    /**
+     * Consumer side. Fills @a range with data from the ring buffer.
+     * @return The number of frames read.
+     */
+    template <class Range2>
+    size_type read (const Range2& range)
+    { return read (range, range.size ()); }
+
+    /**
+     * Consumer side. Reads at most @a samples frames into @a range.
+     * @return The number of frames read.
+     */
+    template <class Range2>
+    size_type read (const Range2& range, size_type samples);
+
+    /**
+     * Consumer side, like read () but converting the frames with
+     * @a cc.
+     */
+    template <class Range2, class CC = default_channel_converter>
+    size_type read_and_convert (const Range2& range, CC cc = CC ())
+    { return read_and_convert (range, range.size (), cc); }
+
+    template <class Range2, class CC = default_channel_converter>
+    size_type read_and_convert (const Range2& range, size_type samples,
+                                CC cc = CC ());
+
+    /**
+     * Consumer side. Returns the first part of the next @a slice
+     * frames to be read, so they can be used in place.
+     * @see skip
+     */
+    typename buffer_range_type<Range>::type
+    sub_buffer_one (size_type slice) const;
+
+    /**
+     * Consumer side. Returns the part of the next @a slice frames
+     * to be read that wraps around the end of the buffer.
+     */
+    typename buffer_range_type<Range>::type
+    sub_buffer_two (size_type slice) const;
+
+    /**
+     * Consumer side. Discards at most @a n frames.
+     * @return The number of frames discarded.
+     */
+    size_type skip (size_type n);
+
+    /**
+     * Consumer side. Discards all the available frames.
+     */
+    void clear ()
+    { skip (available ()); }
+
+    /**
+     * Producer side. Writes all the frames in @a range.
+     * @return The number of frames written.
+     */
+    template <class Range2>
+    size_type write (const Range2& range)
+    { return write (range, range.size ()); }
+
+    /**
+     * Producer side. Writes the first @a samples frames in @a range.
+     * @return The number of frames written.
+     */
+    template <class Range2>
+    size_type write (const Range2& range, size_type samples);
+
+    /**
+     * Producer side, like write () but converting the frames with
+     * @a cc.
+     */
+    template <class Range2, class CC = default_channel_converter>
+    size_type write_and_convert (const Range2& range, CC cc = CC ())
+    { return write_and_convert (range, range.size (), cc); }
+
+    template <class Range2, class CC = default_channel_converter>
+    size_type write_and_convert (const Range2& range, size_type samples,
+                                 CC cc = CC ());
+
+    /** @see ring_buffer_range_base::is_mirrored */
+    bool is_mirrored () const
+    { return _mirrored; }
+
+    /** @see ring_buffer_range_base::set_mirrored */
+    void set_mirrored (bool mirrored)
+    { _mirrored = mirrored; }
+
+    /**
+     * Empties the buffer and clears the error state.
+     */
+    void reset ()
+    {
+        _write_count = 0;
+        _read_count  = 0;
+        _error       = ring_buffer_error::none;
+    }
+
+private:
+    template <class Range2, class Copy>
+    size_type _read (const Range2& range, size_type samples, Copy copy);
+
+    template <class Range2, class Copy>
+    size_type _write (const Range2& range, size_type samples, Copy copy);
+
+    typename buffer_range_type<Range>::type
+    _window (size_type pos, size_type slice) const
+    {
+        assert (_mirrored || pos + slice <= size ());
+        return sub_range (_range, pos, slice);
+    }
+
+    size_type _position (std::size_t count) const
+    { return size () ? count % std::size_t (size ()) : 0; }
+
+    /*
+     * The counters are kept apart so the writer and the reader do not
+     * keep invalidating each other cache line.
+     */
+    std::atomic<std::size_t>       _write_count;
+    char                           _write_pad [64];
+    std::atomic<std::size_t>       _read_count;
+    char                           _read_pad [64];
+    std::atomic<ring_buffer_error> _error;
+    bool                           _mirrored;
+    Range                          _range;
+};
+
+template <typename Range>
+struct sample_type<spsc_ring_buffer_range<Range> > :
+    public sample_type<Range> {};
+
+template <typename Range>
+struct channel_space_type<spsc_ring_buffer_range<Range> > :
+    public channel_space_type<Range> {};
+
+template <typename Range>
+struct sample_mapping_type<spsc_ring_buffer_range<Range> > :
+    public sample_mapping_type<Range> {};
+
+template <typename Range>
+struct is_planar<spsc_ring_buffer_range<Range> > :
+    public is_planar<Range> {};
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#include <psynth/sound/spsc_ring_buffer_range.tpp>
+
+#endif /* PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_HPP_ */
@@ -0,0 +1,203 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        spsc_ring_buffer_range.tpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Lock-free single producer, single consumer ring buffer range.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_TPP_
+#define PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_TPP_
+
+#include <cassert>
+#include <algorithm>
+
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/sound/buffer_range_factory.hpp>
+
+namespace psynth
+{
+namespace sound
+{
+
+namespace detail
+{
+
+struct spsc_copy_fn
+{
+    template <class Src, class Dst>
+    void operator () (const Src& src, const Dst& dst) const
+    { copy_frames (src, dst); }
+};
+
+template <class CC>
+struct spsc_convert_fn
+{
+    CC cc;
+
+    template <class Src, class Dst>
+    void operator () (const Src& src, const Dst& dst) const
+    { copy_and_convert_frames (src, dst, cc); }
+};
+
+} /* namespace detail */
+
+template <class R>
+typename buffer_range_type<R>::type
+spsc_ring_buffer_range<R>::sub_buffer_one (size_type slice) const
+{
+    assert (slice <= available ());
+    const size_type pos = _position (
+        _read_count.load (std::memory_order_relaxed));
+    return _mirrored ?
+        _window (pos, slice) :
+        sub_range (_range, pos, std::min (slice, size () - pos));
+}
+
+template <class R>
+typename buffer_range_type<R>::type
+spsc_ring_buffer_range<R>::sub_buffer_two (size_type slice) const
+{
+    assert (slice <= available ());
+    const size_type pos = _position (
+        _read_count.load (std::memory_order_relaxed));
+    return !_mirrored && pos + slice > size () ?
+        sub_range (_range, 0, pos + slice - size ()) :
+        _window (pos, 0);
+}
+
+template <class R>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::skip (size_type n)
+{
+    const std::size_t r = _read_count.load (std::memory_order_relaxed);
+    const size_type slice = std::min (available (), n);
+    _read_count.store (r + slice, std::memory_order_release);
+    return slice;
+}
+
+template <class R>
+template <class Range2>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::read (const Range2& buf, size_type samples)
+{
+    return _read (buf, samples, detail::spsc_copy_fn ());
+}
+
+template <class R>
+template <class Range2, class CC>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::read_and_convert (const Range2& buf,
+                                             size_type samples, CC cc)
+{
+    return _read (buf, samples, detail::spsc_convert_fn<CC> { cc });
+}
+
+template <class R>
+template <class Range2>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::write (const Range2& buf, size_type samples)
+{
+    return _write (buf, samples, detail::spsc_copy_fn ());
+}
+
+template <class R>
+template <class Range2, class CC>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::write_and_convert (const Range2& buf,
+                                              size_type samples, CC cc)
+{
+    return _write (buf, samples, detail::spsc_convert_fn<CC> { cc });
+}
+
+template <class R>
+template <class Range2, class Copy>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::_read (const Range2& buf, size_type samples,
+                                  Copy copy)
+{
+    const std::size_t r = _read_count.load (std::memory_order_relaxed);
+    const size_type avail =
+        _write_count.load (std::memory_order_acquire) - r;
+    const size_type slice = std::min (avail, samples);
+    const size_type pos   = _position (r);
+
+    if (slice < samples)
+        _error.store (ring_buffer_error::overrun, std::memory_order_relaxed);
+
+    if (!_mirrored && pos + slice > size ())
+    {
+        const size_type slice_one = size () - pos;
+        const size_type slice_two = slice - slice_one;
+        copy (sub_range (_range, pos, slice_one),
+              sub_range (buf, 0, slice_one));
+        copy (sub_range (_range, 0, slice_two),
+              sub_range (buf, slice_one, slice_two));
+    }
+    else
+        copy (_window (pos, slice),
+              sub_range (buf, 0, slice));
+
+    _read_count.store (r + slice, std::memory_order_release);
+    return slice;
+}
+
+template <class R>
+template <class Range2, class Copy>
+typename spsc_ring_buffer_range<R>::size_type
+spsc_ring_buffer_range<R>::_write (const Range2& buf, size_type samples,
+                                   Copy copy)
+{
+    const std::size_t w = _write_count.load (std::memory_order_relaxed);
+    const size_type free =
+        size () - (w - _read_count.load (std::memory_order_acquire));
+    const size_type slice = std::min (free, samples);
+    const size_type pos   = _position (w);
+
+    if (slice < samples)
+        _error.store (ring_buffer_error::underrun,
+                      std::memory_order_relaxed);
+
+    if (!_mirrored && pos + slice > size ())
+    {
+        const size_type slice_one = size () - pos;
+        const size_type slice_two = slice - slice_one;
+        copy (sub_range (buf, 0, slice_one),
+              sub_range (_range, pos, slice_one));
+        copy (sub_range (buf, slice_one, slice_two),
+              sub_range (_range, 0, slice_two));
+    }
+    else
+        copy (sub_range (buf, 0, slice),
+              _window (pos, slice));
+
+    _write_count.store (w + slice, std::memory_order_release);
+    return slice;
+}
+
+} /* namespace sound */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SOUND_SPSC_RING_BUFFER_RANGE_TPP_ */
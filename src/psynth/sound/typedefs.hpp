@@ -6,7 +6,7 @@
  *  @date        Tue Oct 19 13:04:44 2010
  *
  *  @brief Useful typedefs.
- *  @todo Add 24 bit integrals and 64 bit float types.
+ *  @todo Add 64 bit float types.
  */
 
 /*
@@ -60,6 +60,7 @@
     template <typename, bool, typename>     class buffer;		\
     template <typename>              class ring_buffer_range;		\
     template <typename>              class ring_buffer;			\
+    template <typename>              class spsc_ring_buffer;		\
     typedef frame<bits##T, LAYOUT >         CS##T##_frame;		\
     typedef const frame<bits##T, LAYOUT >   CS##T##c_frame;		\
     typedef frame<bits##T, LAYOUT >&        CS##T##_ref;		\
@@ -78,7 +79,8 @@
     CS##T##_buffer;							\
     typedef ring_buffer_range<CS##T##_range> CS##T##_ring_range;	\
     typedef ring_buffer_range<CS##T##c_range> CS##T##c_ring_range;	\
-    typedef ring_buffer<CS##T##_buffer> CS##T##_ring_buffer;
+    typedef ring_buffer<CS##T##_buffer> CS##T##_ring_buffer;		\
+    typedef spsc_ring_buffer<CS##T##_buffer> CS##T##_spsc_ring_buffer;
 
 // CS = 'bgr' CS_FULL = 'rgb' LAYOUT='bgr_layout'
 #define PSYNTH_SOUND_DEFINE_ALL_TYPEDEFS_INTERNAL(T,CS,CS_FULL,LAYOUT)	\
@@ -107,7 +109,9 @@
     CS##T##_planar_buffer;						\
     typedef ring_buffer_range<CS##T##_planar_range> CS##T##_planar_ring_range; \
     typedef ring_buffer_range<CS##T##c_planar_range> CS##T##c_planar_ring_range; \
-    typedef ring_buffer<CS##T##_planar_buffer> CS##T##_planar_ring_buffer;
+    typedef ring_buffer<CS##T##_planar_buffer> CS##T##_planar_ring_buffer; \
+    typedef spsc_ring_buffer<CS##T##_planar_buffer>                     \
+    CS##T##_planar_spsc_ring_buffer;
 
 
 #define PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(T,CS)        \
@@ -125,6 +129,8 @@ namespace sound
 template <typename B, typename Mn, typename Mx, typename Zx>
 struct scoped_sample_value;
 
+template <bool IsSigned> class sample24_value;
+
 struct float_zero;
 struct float_one;
 typedef scoped_sample_value<
@@ -137,11 +143,15 @@ typedef uint32_t bits32;
 typedef int8_t   bits8s;
 typedef int16_t  bits16s;
 typedef int32_t  bits32s;
+typedef sample24_value<false> bits24;
+typedef sample24_value<true>  bits24s;
 
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(8,    mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(8s,   mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(16,   mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(16s,  mono)
+PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(24,   mono)
+PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(24s,  mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32,   mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32s,  mono)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32f,  mono)
@@ -150,6 +160,8 @@ PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(8,    stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(8s,   stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(16,   stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(16s,  stereo)
+PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(24,   stereo)
+PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(24s,  stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32,   stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32s,  stereo)
 PSYNTH_SOUND_DEFINE_BASE_TYPEDEFS(32f,  stereo)
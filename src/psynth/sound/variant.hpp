@@ -140,6 +140,12 @@ struct copy_construct_in_place_fn;
    MPL Random Access Container
 */
 
+template <typename Types, typename UnaryOp>
+class bound_operation;
+
+template <typename Types1, typename Types2, typename BinaryOp>
+class bound_binary_operation;
+
 template <typename Types>    // models MPL Random Access Container
 class variant
 {
@@ -268,6 +274,12 @@ private:
     apply_operation (const variant<Types1>& arg1,
 		     const variant<Types2>& arg2, BinaryOp op);
 
+    template <typename Types2, typename UnaryOp>
+    friend class bound_operation;
+
+    template <typename Types1, typename Types2, typename BinaryOp>
+    friend class bound_binary_operation;
+
     base_t       _bits;
     std::size_t  _index;
 };
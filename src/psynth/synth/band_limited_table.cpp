@@ -0,0 +1,116 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        band_limited_table.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Mipmapped band-limited wave tables.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "synth/kernels.hpp"
+#include "synth/band_limited_table.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+constexpr std::size_t band_limited_table::default_size;
+
+/**
+ * The harmonics of the cycle are found with a plain discrete Fourier
+ * transform, and then every level is synthesized back from the ones
+ * it keeps. This is quadratic in the size of the table, but it is
+ * only done once per wave.
+ */
+void band_limited_table::build (const std::vector<float>& cycle)
+{
+    _size = cycle.size ();
+    assert (_size >= 4 && (_size & (_size - 1)) == 0);
+
+    _levels = levels_for_size (_size);
+
+    std::vector<double> cos_table (_size);
+    std::vector<double> sin_table (_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        cos_table [i] = std::cos (2 * M_PI * i / _size);
+        sin_table [i] = std::sin (2 * M_PI * i / _size);
+    }
+
+    const std::size_t harmonics = max_harmonic (0);
+    std::vector<double> re (harmonics + 1, 0.0);
+    std::vector<double> im (harmonics + 1, 0.0);
+    for (std::size_t h = 0; h <= harmonics; ++h)
+    {
+        for (std::size_t i = 0; i < _size; ++i)
+        {
+            const std::size_t k = (h * i) & (_size - 1);
+            re [h] += cycle [i] * cos_table [k];
+            im [h] += cycle [i] * sin_table [k];
+        }
+        re [h] *= (h ? 2.0 : 1.0) / _size;
+        im [h] *= (h ? 2.0 : 1.0) / _size;
+    }
+
+    _storage.assign (data_size (_size), 0.0f);
+    _data = &_storage [0];
+    std::vector<double> acc (_size);
+    for (std::size_t l = 0; l < _levels; ++l)
+    {
+        std::fill (acc.begin (), acc.end (), re [0]);
+        for (std::size_t h = 1; h <= max_harmonic (l); ++h)
+            for (std::size_t i = 0; i < _size; ++i)
+            {
+                const std::size_t k = (h * i) & (_size - 1);
+                acc [i] += re [h] * cos_table [k] + im [h] * sin_table [k];
+            }
+
+        float* dst = &_storage [l * (_size + 1)];
+        std::copy (acc.begin (), acc.end (), dst);
+        dst [_size] = dst [0];
+    }
+}
+
+float band_limited_table::update (float* dst, std::size_t n,
+                                  float x, float speed, float ampl) const
+{
+    return kernels ().wave_table (level (level_for (speed)), _size,
+                                  dst, n, x, speed, ampl);
+}
+
+void band_limited_table::update_phases (const float* x, float* dst,
+                                        std::size_t n,
+                                        float speed, float ampl) const
+{
+    kernels ().wave_table_phases (level (level_for (speed)), _size,
+                                  x, dst, n, ampl);
+}
+
+} /* namespace synth */
+} /* namespace psynth */
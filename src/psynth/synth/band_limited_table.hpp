@@ -0,0 +1,172 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        band_limited_table.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Mipmapped band-limited wave tables.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SYNTH_BAND_LIMITED_TABLE_HPP_
+#define PSYNTH_SYNTH_BAND_LIMITED_TABLE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * One cycle of a periodic wave stored at several levels of detail,
+ * one per octave. Level @c k only keeps the harmonics up to
+ * max_harmonic (k), so a wave played from the right level does not
+ * alias. Every level has size () samples plus a guard sample equal to
+ * the first one, so interpolation never needs to wrap around.
+ *
+ * The samples are either owned by the table or borrowed from memory
+ * that outlives it, like a read-only file mapping shared by several
+ * processes.
+ */
+class band_limited_table
+{
+public:
+    static constexpr std::size_t default_size = 2048;
+
+    /**
+     * Builds the table from the wave given by @a gen, a function of
+     * the phase in [0, 1). The size must be a power of two.
+     */
+    template <class Generator>
+    explicit band_limited_table (Generator gen,
+                                 std::size_t size = default_size)
+    {
+        std::vector<float> cycle (size);
+        for (std::size_t i = 0; i < size; ++i)
+            cycle [i] = gen (float (i) / size);
+        build (cycle);
+    }
+
+    /**
+     * Uses the levels stored in @a data, which must hold
+     * data_size (size) floats laid out like data () and outlive the
+     * table.
+     */
+    band_limited_table (const float* data, std::size_t size)
+        : _size (size)
+        , _levels (levels_for_size (size))
+        , _data (data)
+    {}
+
+    band_limited_table (const band_limited_table&) = delete;
+    band_limited_table& operator= (const band_limited_table&) = delete;
+
+    /**
+     * Number of levels of a table of @a size samples.
+     */
+    static std::size_t levels_for_size (std::size_t size)
+    {
+        std::size_t levels = 1;
+        while ((size / 4) >> levels)
+            ++levels;
+        return levels;
+    }
+
+    /**
+     * Number of floats needed to store every level of a table of @a
+     * size samples.
+     */
+    static std::size_t data_size (std::size_t size)
+    { return levels_for_size (size) * (size + 1); }
+
+    const float* data () const
+    { return _data; }
+
+    std::size_t size () const
+    { return _size; }
+
+    std::size_t levels () const
+    { return _levels; }
+
+    std::size_t max_harmonic (std::size_t level) const
+    { return (_size / 4) >> level; }
+
+    const float* level (std::size_t k) const
+    { return _data + k * (_size + 1); }
+
+    /**
+     * Returns the most detailed level whose harmonics stay below the
+     * Nyquist frequency when the phase grows @a speed per sample.
+     */
+    std::size_t level_for (float speed) const
+    {
+        const float max = 0.5f / (speed < 0 ? -speed : speed);
+        std::size_t k = 0;
+        while (k + 1 < _levels && max_harmonic (k) > max)
+            ++k;
+        return k;
+    }
+
+    /**
+     * Interpolated value of the level @a table at the phase @a x.
+     */
+    float get (const float* table, float x) const
+    {
+        const float p = (x - std::floor (x)) * _size;
+        const std::size_t i = std::size_t (p);
+        const float a = p - i;
+        const std::size_t j = i & (_size - 1);
+        return table [j] + a * (table [j + 1] - table [j]);
+    }
+
+    /**
+     * Fills @a dst with @a n samples from the phase @a x growing @a
+     * speed per sample, scaled by @a ampl, and returns the phase
+     * after the last sample. It uses the vectorized kernels.
+     */
+    float update (float* dst, std::size_t n,
+                  float x, float speed, float ampl) const;
+
+    /**
+     * Like update (), but reads sample @c i at the phase @a x [i]. The
+     * level is chosen for phases growing up to @a speed per sample.
+     */
+    void update_phases (const float* x, float* dst, std::size_t n,
+                        float speed, float ampl) const;
+
+private:
+    void build (const std::vector<float>& cycle);
+
+    std::size_t        _size;
+    std::size_t        _levels;
+    std::vector<float> _storage;
+    const float*       _data;
+};
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_BAND_LIMITED_TABLE_HPP_ */
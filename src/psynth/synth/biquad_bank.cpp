@@ -0,0 +1,83 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        biquad_bank.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Biquad filters run in lock step.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <cassert>
+
+#include "synth/biquad_bank.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+constexpr std::size_t biquad_bank::max_lanes;
+
+biquad_bank::biquad_bank (std::size_t lanes)
+    : _lanes (lanes)
+{
+    assert (lanes <= max_lanes);
+    std::fill (_coef, _coef + 5 * max_lanes, 0.0f);
+    reset ();
+}
+
+void biquad_bank::set_coefficients (std::size_t lane,
+                                    float b0, float b1, float b2,
+                                    float a1, float a2)
+{
+    assert (lane < _lanes);
+    _coef [lane]                 = b0;
+    _coef [max_lanes + lane]     = b1;
+    _coef [2 * max_lanes + lane] = b2;
+    _coef [3 * max_lanes + lane] = a1;
+    _coef [4 * max_lanes + lane] = a2;
+}
+
+void biquad_bank::set_values (std::size_t lane, const filter_values& values)
+{
+    assert (values.m_type != filter_values::MOOG);
+    set_coefficients (lane, values.m_b0a0, values.m_b1a0, values.m_b2a0,
+                      values.m_a1a0, values.m_a2a0);
+}
+
+void biquad_bank::set_values (const filter_values& values)
+{
+    for (std::size_t l = 0; l < _lanes; ++l)
+        set_values (l, values);
+}
+
+void biquad_bank::reset ()
+{
+    std::fill (_state, _state + 4 * max_lanes, 0.0f);
+}
+
+} /* namespace synth */
+} /* namespace psynth */
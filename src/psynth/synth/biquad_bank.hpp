@@ -0,0 +1,94 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        biquad_bank.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Biquad filters run in lock step.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PSYNTH_SYNTH_BIQUAD_BANK_HPP_
+#define PSYNTH_SYNTH_BIQUAD_BANK_HPP_
+
+#include <cstddef>
+
+#include <psynth/synth/filter.hpp>
+#include <psynth/synth/kernels.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * Up to max_lanes biquad filters, one per channel or voice, that
+ * process their planes together with the biquad kernel. Every lane
+ * has its own coefficients and state, and gives the same output than
+ * a scalar psynth::filter with the same values up to rounding. The
+ * Moog type of filter_values is not a biquad and is not supported.
+ */
+class biquad_bank
+{
+public:
+    static constexpr std::size_t max_lanes = biquad_lanes;
+
+    explicit biquad_bank (std::size_t lanes = 2);
+
+    std::size_t lanes () const
+    { return _lanes; }
+
+    void set_coefficients (std::size_t lane,
+                           float b0, float b1, float b2,
+                           float a1, float a2);
+
+    /**
+     * Uses the coefficients of @a values in @a lane or in every lane.
+     */
+    void set_values (std::size_t lane, const filter_values& values);
+    void set_values (const filter_values& values);
+
+    /**
+     * Clears the state of every lane.
+     */
+    void reset ();
+
+    /**
+     * Filters @a n samples of every plane of @a in into @a out, one
+     * per lane. The planes may be the same.
+     */
+    void update_planes (const float* const* in, float* const* out,
+                        std::size_t n)
+    { kernels ().biquad (_coef, _state, in, out, _lanes, n); }
+
+private:
+    std::size_t _lanes;
+    float       _coef [5 * max_lanes];
+    float       _state [4 * max_lanes];
+};
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_BIQUAD_BANK_HPP_ */
@@ -0,0 +1,296 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        convolver.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Partitioned convolution.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include <algorithm>
+#include <cassert>
+
+#include "synth/convolver.hpp"
+#include "synth/kernels.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+constexpr std::size_t convolver::stage_growth;
+
+/**
+ * Uniformly partitioned overlap-save convolution with @c parts
+ * partitions of @c size samples of the response starting at @c
+ * offset. The input is kept in a ring of three blocks of @c size
+ * samples: the one being filled, the one being transformed and the
+ * one before it. The transform of a block is spread over the @c
+ * period calls that fill the next one, and its result is then
+ * played during the following @c period calls, thus @c offset must
+ * be at least twice @c size. A stage without offset instead
+ * transforms every block as soon as it is filled.
+ */
+struct convolver::stage
+{
+    struct channel
+    {
+        std::vector<float> input;
+        std::vector<float> spectra_re;
+        std::vector<float> spectra_im;
+        std::vector<float> acc_re;
+        std::vector<float> acc_im;
+        std::vector<float> output;
+    };
+
+    stage (const float* ir, std::size_t ir_size,
+           std::size_t size, std::size_t offset, std::size_t parts,
+           std::size_t block_size, std::size_t channels);
+
+    void reset ();
+    void feed (const float* const* in, std::size_t pos);
+    void update (float* const* out, std::size_t pos, bool mix);
+    void run (channel& ch, std::size_t first, std::size_t last);
+
+    real_fft    fft;
+    std::size_t size;
+    std::size_t offset;
+    std::size_t parts;
+    std::size_t bins;
+    std::size_t block_size;
+    std::size_t period;
+    std::size_t work;
+
+    std::vector<float>   ir_re;
+    std::vector<float>   ir_im;
+    std::vector<channel> channels;
+
+    std::size_t step;
+    std::size_t current;
+    std::size_t slot;
+    std::size_t ready;
+};
+
+convolver::stage::stage (const float* ir, std::size_t ir_size,
+                         std::size_t size_, std::size_t offset_,
+                         std::size_t parts_, std::size_t block_size_,
+                         std::size_t nchannels)
+    : fft (2 * size_)
+    , size (size_)
+    , offset (offset_)
+    , parts (parts_)
+    , bins (size_ + 1)
+    , block_size (block_size_)
+    , period (size_ / block_size_)
+    , work (2 * fft.work () + parts_ * (size_ + 1))
+    , ir_re (parts_ * (size_ + 1))
+    , ir_im (parts_ * (size_ + 1))
+    , channels (nchannels)
+{
+    assert (offset == 0 ? size == block_size : offset >= 2 * size);
+
+    // The inverse transform is not normalised, we do it here.
+    const float scale = 1.0f / (2 * size);
+    std::vector<float> segment (2 * size);
+    for (std::size_t p = 0; p < parts; ++p)
+    {
+        const std::size_t begin = std::min (ir_size, offset + p * size);
+        const std::size_t end   = std::min (ir_size, begin + size);
+        std::fill (segment.begin (), segment.end (), 0.0f);
+        for (std::size_t i = begin; i < end; ++i)
+            segment [i - begin] = ir [i] * scale;
+        fft.forward (&segment [0], &ir_re [p * bins], &ir_im [p * bins]);
+    }
+
+    for (auto& ch : channels)
+    {
+        ch.input.resize (3 * size);
+        ch.spectra_re.resize (parts * bins);
+        ch.spectra_im.resize (parts * bins);
+        ch.acc_re.resize (bins);
+        ch.acc_im.resize (bins);
+        ch.output.resize (4 * size);
+    }
+
+    reset ();
+}
+
+void convolver::stage::reset ()
+{
+    for (auto& ch : channels)
+    {
+        std::fill (ch.input.begin (), ch.input.end (), 0.0f);
+        std::fill (ch.spectra_re.begin (), ch.spectra_re.end (), 0.0f);
+        std::fill (ch.spectra_im.begin (), ch.spectra_im.end (), 0.0f);
+        std::fill (ch.output.begin (), ch.output.end (), 0.0f);
+    }
+
+    step    = 0;
+    current = 0;
+    slot    = 0;
+    ready   = 0;
+}
+
+void convolver::stage::run (channel& ch, std::size_t first, std::size_t last)
+{
+    const std::size_t pending = offset ? (current + 2) % 3 : current;
+    const float* lo = &ch.input [(pending + 2) % 3 * size];
+    const float* hi = &ch.input [pending * size];
+    float* spectrum_re = &ch.spectra_re [slot * bins];
+    float* spectrum_im = &ch.spectra_im [slot * bins];
+
+    std::size_t start = detail::run_phase (
+        first, last, 0, fft.work (), [&] (std::size_t a, std::size_t b) {
+            fft.forward_steps (lo, hi, spectrum_re, spectrum_im, a, b);
+        });
+
+    // Partition p of the response applies to the block p blocks
+    // before the pending one.
+    start = detail::run_phase (
+        first, last, start, parts * bins, [&] (std::size_t a, std::size_t b) {
+            while (a < b)
+            {
+                const std::size_t p = a / bins;
+                const std::size_t k = a % bins;
+                const std::size_t n = std::min (bins - k, b - a);
+                const std::size_t s = ((slot + parts - p) % parts) * bins;
+                if (p == 0)
+                {
+                    std::fill_n (&ch.acc_re [k], n, 0.0f);
+                    std::fill_n (&ch.acc_im [k], n, 0.0f);
+                }
+                kernels ().complex_mac (
+                    &ch.spectra_re [s + k], &ch.spectra_im [s + k],
+                    &ir_re [p * bins + k], &ir_im [p * bins + k],
+                    &ch.acc_re [k], &ch.acc_im [k], n);
+                a += n;
+            }
+        });
+
+    detail::run_phase (
+        first, last, start, fft.work (), [&] (std::size_t a, std::size_t b) {
+            fft.inverse_steps (&ch.acc_re [0], &ch.acc_im [0],
+                               &ch.output [(1 - ready) * 2 * size], a, b);
+        });
+}
+
+void convolver::stage::feed (const float* const* in, std::size_t pos)
+{
+    for (std::size_t c = 0; c < channels.size (); ++c)
+        std::copy (in [c] + pos, in [c] + pos + block_size,
+                   &channels [c].input [current * size + step * block_size]);
+}
+
+void convolver::stage::update (float* const* out, std::size_t pos, bool mix)
+{
+    const std::size_t first = step * work / period;
+    const std::size_t last  = (step + 1) * work / period;
+    for (auto& ch : channels)
+        run (ch, first, last);
+
+    if (!offset)
+        ready = 1 - ready;
+
+    // With overlap-save only the second half of the result is valid.
+    for (std::size_t c = 0; c < channels.size (); ++c)
+    {
+        const float* y =
+            &channels [c].output [ready * 2 * size + size + step * block_size];
+        if (mix)
+            kernels ().mix (out [c] + pos, y, out [c] + pos, block_size);
+        else
+            std::copy (y, y + block_size, out [c] + pos);
+    }
+
+    if (++step == period)
+    {
+        step    = 0;
+        current = (current + 1) % 3;
+        slot    = (slot + 1) % parts;
+        if (offset)
+            ready = 1 - ready;
+    }
+}
+
+convolver::convolver (const float* ir, std::size_t ir_size,
+                      std::size_t block_size, std::size_t channels)
+    : _block_size (block_size)
+    , _channels (channels)
+    , _ir_size (ir_size)
+{
+    assert (block_size >= 2 && (block_size & (block_size - 1)) == 0);
+
+    // Every stage ends where the next one can start, at twice the
+    // size of its partitions.
+    std::size_t size   = block_size;
+    std::size_t offset = 0;
+    while (offset < ir_size)
+    {
+        const std::size_t end   = 2 * size * stage_growth;
+        const std::size_t parts =
+            (std::min (end, ir_size) - offset + size - 1) / size;
+        _stages.emplace_back (
+            new stage (ir, ir_size, size, offset, parts, block_size, channels));
+        offset = end;
+        size  *= stage_growth;
+    }
+}
+
+convolver::~convolver ()
+{
+}
+
+void convolver::reset ()
+{
+    for (auto& s : _stages)
+        s->reset ();
+}
+
+void convolver::update_planes (const float* const* in, float* const* out,
+                               std::size_t n)
+{
+    assert (n % _block_size == 0);
+
+    if (_stages.empty ())
+    {
+        for (std::size_t c = 0; c < _channels; ++c)
+            std::fill_n (out [c], n, 0.0f);
+        return;
+    }
+
+    // Every stage takes its input before any output is written, in
+    // case the planes are the same.
+    for (std::size_t pos = 0; pos < n; pos += _block_size)
+    {
+        for (auto& s : _stages)
+            s->feed (in, pos);
+        for (std::size_t i = 0; i < _stages.size (); ++i)
+            _stages [i]->update (out, pos, i > 0);
+    }
+}
+
+} /* namespace synth */
+} /* namespace psynth */
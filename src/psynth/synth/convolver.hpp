@@ -0,0 +1,113 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        convolver.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Partitioned convolution.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#ifndef PSYNTH_SYNTH_CONVOLVER_HPP_
+#define PSYNTH_SYNTH_CONVOLVER_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <psynth/synth/fft.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * Convolution of one or more channels with an impulse response,
+ * such as a reverb or a cabinet response, without added latency.
+ *
+ * The response is split in partitions that are convolved in the
+ * frequency domain with the overlap-save method. The first stage
+ * uses partitions of the block size, and every following stage
+ * uses partitions stage_growth times larger than the previous one.
+ * The result of a large partition is only needed twice its size
+ * after its input arrives, so its transforms are spread over the
+ * blocks in between and the cost per block stays small and about
+ * constant whatever the length of the response.
+ *
+ * Constructing a convolver allocates and transforms the response,
+ * it should be done outside of the real-time thread. Processing
+ * does not allocate.
+ */
+class convolver
+{
+public:
+    static constexpr std::size_t stage_growth = 8;
+
+    /**
+     * Prepares the convolution of @a channels channels with the @a
+     * ir_size samples in @a ir, in blocks of @a block_size samples, a
+     * power of two no less than 2.
+     */
+    convolver (const float* ir, std::size_t ir_size,
+               std::size_t block_size, std::size_t channels = 1);
+
+    ~convolver ();
+
+    std::size_t block_size () const
+    { return _block_size; }
+
+    std::size_t channels () const
+    { return _channels; }
+
+    std::size_t ir_size () const
+    { return _ir_size; }
+
+    /**
+     * Clears the input history.
+     */
+    void reset ();
+
+    /**
+     * Convolves @a n samples of every plane in @a in into @a out,
+     * where @a n is a multiple of the block size. The planes may be
+     * the same.
+     */
+    void update_planes (const float* const* in, float* const* out,
+                        std::size_t n);
+
+private:
+    struct stage;
+
+    std::size_t _block_size;
+    std::size_t _channels;
+    std::size_t _ir_size;
+    std::vector<std::unique_ptr<stage> > _stages;
+};
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_CONVOLVER_HPP_ */
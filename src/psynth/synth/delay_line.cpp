@@ -0,0 +1,172 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        delay_line.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Fractional delay line.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "synth/delay_line.hpp"
+#include "synth/kernels.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+namespace
+{
+
+/** Delays are computed in chunks of this size when ramping. */
+const std::size_t ramp_chunk_size = 64;
+
+} /* anonymous namespace */
+
+float delay_line::min_delay (interpolation mode)
+{
+    switch (mode)
+    {
+    case interpolation::cubic:
+        return 1.0f;
+    case interpolation::allpass:
+        return 0.5f;
+    default:
+        return 0.0f;
+    }
+}
+
+delay_line::delay_line (std::size_t channels,
+                        std::size_t max_delay,
+                        std::size_t max_block,
+                        const allocator_type& alloc)
+    : _channels (channels)
+    , _buffer (alloc)
+{
+    recreate (max_delay, max_block, alloc);
+}
+
+void delay_line::recreate (std::size_t max_delay, std::size_t max_block,
+                           const allocator_type& alloc)
+{
+    // The cubic interpolation reads one sample after and two before
+    // the position of the delay.
+    const std::size_t needed = max_delay + max_block + 3;
+    std::size_t size = 1;
+    while (size < needed)
+        size *= 2;
+
+    _max_delay = max_delay;
+    _max_block = max_block;
+    _size      = size;
+    _head      = 0;
+
+    std::vector<float, allocator_type> buffer (_channels * size, 0.0f,
+                                               alloc);
+    _buffer.swap (buffer);
+}
+
+void delay_line::reset ()
+{
+    std::fill (_buffer.begin (), _buffer.end (), 0.0f);
+    _head = 0;
+}
+
+void delay_line::write_planes (const float* const* in, std::size_t n)
+{
+    assert (n <= _max_block);
+
+    const std::size_t first = std::min (n, _size - _head);
+    for (std::size_t c = 0; c < _channels; ++c)
+    {
+        float* buf = &_buffer [c * _size];
+        std::memcpy (buf + _head, in [c], first * sizeof (float));
+        std::memcpy (buf, in [c] + first, (n - first) * sizeof (float));
+    }
+
+    _head = (_head + n) & (_size - 1);
+}
+
+void delay_line::read_channel (std::size_t c, float* out,
+                               const float* delay,
+                               std::size_t now, std::size_t n,
+                               interpolation mode, float* state) const
+{
+    const float* buf = &_buffer [c * _size];
+    const std::size_t mask = _size - 1;
+
+    switch (mode)
+    {
+    case interpolation::cubic:
+        kernels ().delay_cubic (buf, mask, now, delay, out, n);
+        break;
+    case interpolation::allpass:
+        assert (state);
+        state [c] = kernels ().delay_allpass (buf, mask, now, delay, out, n,
+                                              state [c]);
+        break;
+    default:
+        kernels ().delay_linear (buf, mask, now, delay, out, n);
+        break;
+    }
+}
+
+void delay_line::read_planes (float* const* out, const float* delay,
+                              std::size_t n,
+                              interpolation mode, float* state) const
+{
+    assert (n <= _max_block);
+
+    const std::size_t now = (_head - n) & (_size - 1);
+    for (std::size_t c = 0; c < _channels; ++c)
+        read_channel (c, out [c], delay, now, n, mode, state);
+}
+
+void delay_line::read_planes (float* const* out, float from, float to,
+                              std::size_t n,
+                              interpolation mode, float* state) const
+{
+    assert (n <= _max_block);
+    assert (from >= min_delay (mode) && from <= _max_delay);
+    assert (to >= min_delay (mode) && to <= _max_delay);
+
+    const std::size_t now   = (_head - n) & (_size - 1);
+    const float       slope = n ? (to - from) / n : 0.0f;
+    float delay [ramp_chunk_size];
+
+    for (std::size_t i = 0; i < n; i += ramp_chunk_size)
+    {
+        const std::size_t len = std::min (ramp_chunk_size, n - i);
+        kernels ().ramp (delay, len, from + slope * i, slope);
+        for (std::size_t c = 0; c < _channels; ++c)
+            read_channel (c, out [c] + i, delay, now + i, len, mode, state);
+    }
+}
+
+} /* namespace synth */
+} /* namespace psynth */
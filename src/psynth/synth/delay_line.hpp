@@ -0,0 +1,148 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        delay_line.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Fractional delay line.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SYNTH_DELAY_LINE_HPP_
+#define PSYNTH_SYNTH_DELAY_LINE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <psynth/base/memory.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * A delay line for one or more channels, from which taps can be read
+ * at fractional and per sample modulated delays.
+ *
+ * Each channel is a ring buffer whose size is a power of two, so
+ * positions wrap with a mask. Samples are written a block at a
+ * time, and reads are relative to the last block written: sample i
+ * of a read of @c n samples delayed by @c d is the one written @c d
+ * samples before sample i of the last @c n written. A read before
+ * writing a block of @c n samples, as a feedback loop needs, is thus
+ * a read delayed by @c d - @c n after the previous one.
+ */
+class delay_line
+{
+public:
+    typedef base::arena_allocator<float> allocator_type;
+
+    enum class interpolation
+    {
+        linear,
+        cubic,
+        allpass
+    };
+
+    /**
+     * The smallest delay that each interpolation can read without
+     * looking at samples not written yet.
+     */
+    static float min_delay (interpolation mode);
+
+    /**
+     * Creates a line for @a channels channels that can be read
+     * delayed by up to @a max_delay samples, in blocks of up to @a
+     * max_block samples.
+     */
+    explicit delay_line (std::size_t channels  = 1,
+                         std::size_t max_delay = 0,
+                         std::size_t max_block = 0,
+                         const allocator_type& alloc = allocator_type ());
+
+    /**
+     * Reallocates the line for new limits, clearing it.
+     */
+    void recreate (std::size_t max_delay, std::size_t max_block,
+                   const allocator_type& alloc = allocator_type ());
+
+    std::size_t channels () const
+    { return _channels; }
+
+    std::size_t max_delay () const
+    { return _max_delay; }
+
+    std::size_t max_block () const
+    { return _max_block; }
+
+    /**
+     * Clears the written samples.
+     */
+    void reset ();
+
+    /**
+     * Writes @a n samples of every plane in @a in.
+     */
+    void write_planes (const float* const* in, std::size_t n);
+
+    /**
+     * Reads @a n samples of every channel into @a out, sample i
+     * delayed by @a delay [i], which must be between min_delay () and
+     * max_delay (). Allpass interpolation is recursive, @a state
+     * keeps one value per channel between the reads of a tap and is
+     * not used by the other interpolations.
+     */
+    void read_planes (float* const* out, const float* delay,
+                      std::size_t n,
+                      interpolation mode = interpolation::linear,
+                      float* state = 0) const;
+
+    /**
+     * Like the previous read_planes (), with the delay moving
+     * linearly from @a from at the first sample towards @a to, which
+     * it would reach at sample @a n. Delay changes are smoothed
+     * this way instead of jumping.
+     */
+    void read_planes (float* const* out, float from, float to,
+                      std::size_t n,
+                      interpolation mode = interpolation::linear,
+                      float* state = 0) const;
+
+private:
+    void read_channel (std::size_t c, float* out, const float* delay,
+                       std::size_t now, std::size_t n,
+                       interpolation mode, float* state) const;
+
+    std::size_t _channels;
+    std::size_t _max_delay;
+    std::size_t _max_block;
+    std::size_t _size;
+    std::size_t _head;
+    std::vector<float, allocator_type> _buffer;
+};
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_DELAY_LINE_HPP_ */
@@ -31,11 +31,27 @@
 #ifndef PSYNTH_SYNTH_ENVELOPE_H
 #define PSYNTH_SYNTH_ENVELOPE_H
 
+#include <cstddef>
+
 namespace psynth
 {
 namespace synth
 {
 
+/**
+ * A piece of an envelope over which it changes linearly, the value of
+ * its i-th sample being start + i * slope.
+ */
+struct envelope_segment
+{
+    std::size_t size;
+    float       start;
+    float       slope;
+
+    bool is_constant () const
+    { return slope == 0.0f || size == 1; }
+};
+
 /**
  * Basic envelope interface.
  */
@@ -66,6 +82,13 @@ public:
      */
     virtual void update (const range& samples) = 0;
 
+    /**
+     * Advances the envelope over its next linear segment.
+     * @param samples The maximum size of the segment, not zero.
+     * @return The segment.
+     */
+    virtual envelope_segment next_segment (std::size_t samples) = 0;
+
     /**
      * Start the envelope effect.
      */
@@ -83,7 +106,47 @@ public:
     virtual bool finished () = 0;
 };
 
+/**
+ * Fills @a n samples of @a dst with the envelope, which is advanced.
+ */
+template <class Envelope>
+void render_envelope (Envelope& env, float* dst, std::size_t n);
+
+/**
+ * Fills every frame of @a samples with the envelope, which is
+ * advanced.
+ */
+template <class Envelope, class Range>
+void render_envelope (Envelope& env, const Range& samples);
+
+/**
+ * dst = src * env over @a n samples. Where the envelope stays at one
+ * or zero the source is just copied or the output cleared.
+ */
+template <class Envelope>
+void apply_envelope (Envelope& env, const float* src, float* dst,
+                     std::size_t n);
+
+/**
+ * dst = src * env + stable * (1 - env) over @a n samples, like
+ * synth::blend. Where the envelope stays at one or zero the source or
+ * the stable value are just copied.
+ */
+template <class Envelope>
+void blend_envelope (Envelope& env, const float* src, float stable,
+                     float* dst, std::size_t n);
+
+/**
+ * Like the former, for every channel of the ranges, which all get
+ * the same envelope.
+ */
+template <class Envelope, class SrcRange, class DstRange>
+void blend_envelope (Envelope& env, const SrcRange& src, float stable,
+                     const DstRange& dst);
+
 } /* namespace synth */
 } /* namespace psynth */
 
+#include <psynth/synth/envelope.tpp>
+
 #endif /* PSYNTH_ENVELOPE_H */
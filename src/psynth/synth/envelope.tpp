@@ -0,0 +1,215 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        envelope.tpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Block rendering of envelopes.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SYNTH_ENVELOPE_TPP_
+#define PSYNTH_SYNTH_ENVELOPE_TPP_
+
+#include <algorithm>
+
+#include <psynth/sound/channel_base_algorithm.hpp>
+#include <psynth/sound/simd.hpp>
+#include <psynth/synth/envelope.hpp>
+#include <psynth/synth/kernels.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+namespace detail
+{
+
+/** Ramps are rendered to the stack in chunks of this size. */
+const std::size_t envelope_chunk = 64;
+
+template <class Envelope, class Range>
+void render_envelope_aux (Envelope& env, const Range& samples,
+                          sound::detail::mono_simd_tag)
+{
+    render_envelope (env, sound::detail::simd_ptr (samples.begin ()),
+                     samples.size ());
+}
+
+template <class Envelope, class Range, class Tag>
+void render_envelope_aux (Envelope& env, const Range& samples, Tag)
+{
+    typedef typename Range::value_type frame;
+    typedef typename sound::sample_type<frame>::type sample;
+
+    const std::size_t n = samples.size ();
+    for (std::size_t i = 0; i < n; )
+    {
+        const envelope_segment seg = env.Envelope::next_segment (n - i);
+        for (std::size_t j = 0; j < seg.size; ++i, ++j)
+            samples [i] = frame (sample (seg.start + j * seg.slope));
+    }
+}
+
+template <class Envelope, class SrcRange, class DstRange>
+void blend_envelope_aux (Envelope& env, const SrcRange& src, float stable,
+                         const DstRange& dst, sound::detail::no_simd_tag)
+{
+    typedef typename DstRange::value_type dst_frame;
+    typedef typename sound::sample_type<dst_frame>::type dst_sample;
+    typedef typename sound::sample_type<
+        typename SrcRange::value_type>::type src_sample;
+
+    const std::size_t n = src.size ();
+    for (std::size_t i = 0; i < n; )
+    {
+        const envelope_segment seg = env.Envelope::next_segment (n - i);
+        for (std::size_t j = 0; j < seg.size; ++i, ++j)
+        {
+            const float e = seg.start + j * seg.slope;
+            dst_frame res;
+            sound::static_transform (
+                src [i], res, [&] (src_sample x) -> dst_sample {
+                    return dst_sample (float (x) * e + stable * (1.0f - e));
+                });
+            dst [i] = res;
+        }
+    }
+}
+
+template <class Envelope, class SrcRange, class DstRange>
+void blend_envelope_aux (Envelope& env, const SrcRange& src, float stable,
+                         const DstRange& dst, sound::detail::mono_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    blend_envelope (env, simd_ptr (src.begin ()), stable,
+                    simd_ptr (dst.begin ()), src.size ());
+}
+
+template <class Envelope, class SrcRange, class DstRange>
+void blend_envelope_aux (Envelope& env, const SrcRange& src, float stable,
+                         const DstRange& dst,
+                         sound::detail::stereo_planar_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    Envelope first (env);
+    blend_envelope (first, simd_ptr (sound::at_c<0> (src.begin ())), stable,
+                    simd_ptr (sound::at_c<0> (dst.begin ())), src.size ());
+    blend_envelope (env, simd_ptr (sound::at_c<1> (src.begin ())), stable,
+                    simd_ptr (sound::at_c<1> (dst.begin ())), src.size ());
+}
+
+} /* namespace detail */
+
+template <class Envelope>
+void render_envelope (Envelope& env, float* dst, std::size_t n)
+{
+    while (n)
+    {
+        const envelope_segment seg = env.Envelope::next_segment (n);
+        if (seg.is_constant ())
+            std::fill (dst, dst + seg.size, seg.start);
+        else
+            kernels ().ramp (dst, seg.size, seg.start, seg.slope);
+        dst += seg.size;
+        n   -= seg.size;
+    }
+}
+
+template <class Envelope, class Range>
+void render_envelope (Envelope& env, const Range& samples)
+{
+    detail::render_envelope_aux (
+        env, samples,
+        typename sound::detail::simd_range_tag<Range>::type ());
+}
+
+template <class Envelope>
+void apply_envelope (Envelope& env, const float* src, float* dst,
+                     std::size_t n)
+{
+    float ramp [detail::envelope_chunk];
+    while (n)
+    {
+        const envelope_segment seg = env.Envelope::next_segment (
+            std::min (n, detail::envelope_chunk));
+        if (!seg.is_constant ())
+        {
+            kernels ().ramp (ramp, seg.size, seg.start, seg.slope);
+            kernels ().modulate (src, ramp, dst, seg.size);
+        }
+        else if (seg.start == 0.0f)
+            std::fill (dst, dst + seg.size, 0.0f);
+        else if (seg.start != 1.0f)
+            for (std::size_t i = 0; i < seg.size; ++i)
+                dst [i] = src [i] * seg.start;
+        else if (src != dst)
+            std::copy (src, src + seg.size, dst);
+        src += seg.size;
+        dst += seg.size;
+        n   -= seg.size;
+    }
+}
+
+template <class Envelope>
+void blend_envelope (Envelope& env, const float* src, float stable,
+                     float* dst, std::size_t n)
+{
+    float ramp [detail::envelope_chunk];
+    while (n)
+    {
+        const envelope_segment seg = env.Envelope::next_segment (
+            std::min (n, detail::envelope_chunk));
+        if (!seg.is_constant ())
+        {
+            kernels ().ramp (ramp, seg.size, seg.start, seg.slope);
+            kernels ().blend (src, ramp, stable, dst, seg.size);
+        }
+        else if (seg.start == 0.0f)
+            std::fill (dst, dst + seg.size, stable);
+        else if (seg.start != 1.0f)
+            for (std::size_t i = 0; i < seg.size; ++i)
+                dst [i] = src [i] * seg.start + stable * (1.0f - seg.start);
+        else if (src != dst)
+            std::copy (src, src + seg.size, dst);
+        src += seg.size;
+        dst += seg.size;
+        n   -= seg.size;
+    }
+}
+
+template <class Envelope, class SrcRange, class DstRange>
+void blend_envelope (Envelope& env, const SrcRange& src, float stable,
+                     const DstRange& dst)
+{
+    detail::blend_envelope_aux (
+        env, src, stable, dst,
+        typename sound::detail::simd_range_pair_tag<
+            SrcRange, DstRange>::type ());
+}
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_ENVELOPE_TPP_ */
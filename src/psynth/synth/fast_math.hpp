@@ -0,0 +1,248 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        fast_math.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Fast approximations of elementary functions.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SYNTH_FAST_MATH_HPP_
+#define PSYNTH_SYNTH_FAST_MATH_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace psynth
+{
+namespace synth
+{
+
+/*
+ * Approximations of elementary functions for the code that computes
+ * them per sample or per control block. They are minimax polynomials
+ * after a range reduction made with integer conversions and bitwise
+ * selections, with no branches nor table lookups, so the loops
+ * calling them are vectorized. The error bounds are the ones
+ * measured against the standard library in double precision, and
+ * the tests check them.
+ */
+
+namespace detail
+{
+
+inline float fast_math_bits (std::int32_t x)
+{
+    float r;
+    std::memcpy (&r, &x, sizeof r);
+    return r;
+}
+
+inline std::int32_t fast_math_bits (float x)
+{
+    std::int32_t r;
+    std::memcpy (&r, &x, sizeof r);
+    return r;
+}
+
+/**
+ * Selects @a a where @a mask is all ones and @a b where it is zero.
+ * Unless floating point exceptions are ignored, GCC does not vectorize
+ * selections of floats that it can turn into conditional arithmetic,
+ * but it does vectorize these bitwise ones and the conversions of
+ * comparisons to integers used below.
+ */
+inline float fast_math_select (std::int32_t mask, float a, float b)
+{
+    return fast_math_bits ((fast_math_bits (a) & mask) |
+                           (fast_math_bits (b) & ~mask));
+}
+
+/**
+ * sin (2 pi t) for t in [-0.25, 0.25].
+ */
+inline float sin_quarter (float t)
+{
+    const float u = t * t;
+    return t * (6.283185274f + u * (-41.34167748f + u * (81.60223124f +
+                u * (-76.57499218f + u * 39.71091815f))));
+}
+
+/**
+ * x reduced to [-0.5, 0.5] by an integral number of cycles. The
+ * integer conversion limits |x| to 2^31, but the result loses
+ * precision much before as x grows.
+ */
+inline float reduce_cycle (float x)
+{
+    const float r = x - float (std::int32_t (x));
+    const std::int32_t above = r > 0.5f;
+    const std::int32_t below = r < -0.5f;
+    return r - float (above - below);
+}
+
+} /* namespace detail */
+
+/**
+ * sin (2 pi x), the sine of @a x cycles, for |x| < 2^31. The absolute
+ * error is below 2e-7.
+ */
+inline float fast_sin_cycles (float x)
+{
+    // sin (2 pi r) = sin (2 pi (0.5 - r)) = sin (2 pi (-0.5 - r)).
+    const float r = detail::reduce_cycle (x);
+    const std::int32_t above = r > 0.25f;
+    const std::int32_t below = r < -0.25f;
+    return detail::sin_quarter (0.5f * float (above - below) +
+                                float (1 - 2 * (above + below)) * r);
+}
+
+/**
+ * cos (2 pi x), with the same error as fast_sin_cycles ().
+ */
+inline float fast_cos_cycles (float x)
+{
+    return detail::sin_quarter (0.25f - std::abs (detail::reduce_cycle (x)));
+}
+
+/**
+ * sin (x) and cos (x). The absolute error is below 2e-7 plus 1e-7
+ * |x|, most of it from the rounding of @a x / 2 pi.
+ */
+inline float fast_sin (float x)
+{
+    return fast_sin_cycles (x * 0.159154943f);
+}
+
+inline float fast_cos (float x)
+{
+    return fast_cos_cycles (x * 0.159154943f);
+}
+
+/**
+ * tan (x) for |x| < pi / 2, as the quotient of the sine and the
+ * cosine. The relative error is below 4e-7 plus 1.2e-7 / (pi / 2 -
+ * |x|), which grows close to the poles with the rounding of @a x / 2
+ * pi.
+ */
+inline float fast_tan (float x)
+{
+    const float t = x * 0.159154943f;
+    return detail::sin_quarter (t) /
+        detail::sin_quarter (0.25f - std::abs (t));
+}
+
+/**
+ * 2^x, which is exact for integral @a x and has a relative error
+ * below 2e-7 otherwise. @a x is clamped to [-126, 128), so the
+ * result is never zero, infinite nor denormal.
+ */
+inline float fast_exp2 (float x)
+{
+    x = detail::fast_math_select (-std::int32_t (x < -126.0f), -126.0f, x);
+    x = detail::fast_math_select (-std::int32_t (x > 127.99f), 127.99f, x);
+    const std::int32_t t = std::int32_t (x);
+    const std::int32_t i = t - std::int32_t (x < float (t));
+    const float f = x - float (i);
+    const float p = 1.0f + f * (0.6931513118f + f * (0.2401644502f +
+                    f * (0.05579991311f + f * (0.009017030313f +
+                    f * 0.001867130073f))));
+    return p * detail::fast_math_bits ((i + 127) << 23);
+}
+
+/**
+ * log2 (x) for a positive normal @a x. The relative error is below
+ * 2.5e-7, and the absolute one is below 1.2e-7 in [0.5, 2].
+ */
+inline float fast_log2 (float x)
+{
+    const std::int32_t bits = detail::fast_math_bits (x);
+    const float f = detail::fast_math_bits ((bits & 0x7fffff) | 0x3f800000);
+    const std::int32_t high = f > 1.41421356f;
+    const std::int32_t e = ((bits >> 23) & 0xff) - 127 + high;
+    const float m = f * (1.0f - 0.5f * float (high));
+
+    // log2 (m) = log2 ((1 + z) / (1 - z)), z in [-0.172, 0.172].
+    const float z = (m - 1.0f) / (m + 1.0f);
+    const float v = z * z;
+    return float (e) + z * (2.885390080f + v * (0.9617988476f +
+                            v * (0.5767143840f + v * 0.4317358788f)));
+}
+
+/**
+ * e^x. The relative error is below 2e-7 plus 7e-8 |x|, the rounding
+ * of the change of base. The domain is clamped like fast_exp2 ()'s.
+ */
+inline float fast_exp (float x)
+{
+    return fast_exp2 (x * 1.44269504f);
+}
+
+/**
+ * x^y for a positive normal @a x. The relative error is below 3e-7
+ * plus 1.2e-7 |y log2 (x)|.
+ */
+inline float fast_pow (float x, float y)
+{
+    return fast_exp2 (y * fast_log2 (x));
+}
+
+/**
+ * tanh (x), with relative error below 6e-7 and absolute error below
+ * 2e-7.
+ */
+inline float fast_tanh (float x)
+{
+    const float a = detail::fast_math_select (
+        -std::int32_t (std::abs (x) > 9.0f), 9.0f, std::abs (x));
+    const float e = fast_exp2 (a * 2.88539008f);
+    const float big = (e - 1.0f) / (e + 1.0f);
+    const float v = a * a;
+    const float small = a * (1.0f + v * (-0.333333333f +
+                             v * (0.133333333f + v * -0.0539682540f)));
+    const float r = detail::fast_math_select (
+        -std::int32_t (a < 0.125f), small, big);
+    return std::copysign (r, x);
+}
+
+/**
+ * Conversions between decibels and linear gain. The relative error
+ * of db_to_gain () is below 2e-7 plus 8e-9 |db| and that of
+ * gain_to_db () is below 3e-7. A gain of zero maps to about -764 dB.
+ */
+inline float db_to_gain (float db)
+{
+    return fast_exp2 (db * 0.166096405f);
+}
+
+inline float gain_to_db (float gain)
+{
+    return fast_log2 (gain) * 6.02059991f;
+}
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_FAST_MATH_HPP_ */
@@ -0,0 +1,196 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        fft.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Real fast Fourier transform.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "synth/fft.hpp"
+#include "synth/kernels.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+real_fft::real_fft (std::size_t size)
+    : _size (size)
+{
+    assert (size >= 4 && (size & (size - 1)) == 0);
+
+    const std::size_t m = size / 2;
+    std::size_t bits = 0;
+    while ((std::size_t (1) << bits) < m)
+        ++bits;
+
+    // Loading, the passes of the complex transform and splitting.
+    _work = m + bits * (m / 2) + m / 2 + 1;
+
+    _reverse.resize (m);
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < bits; ++b)
+            r |= ((k >> b) & 1) << (bits - 1 - b);
+        _reverse [k] = r;
+    }
+
+    // The twiddles of the pass with butterflies of half size h are
+    // at [h - 1, 2h - 1).
+    _twiddle_re.resize (m - 1);
+    _twiddle_im.resize (m - 1);
+    for (std::size_t h = 1; h < m; h *= 2)
+        for (std::size_t j = 0; j < h; ++j)
+        {
+            const double w = -M_PI * j / h;
+            _twiddle_re [h - 1 + j] = std::cos (w);
+            _twiddle_im [h - 1 + j] = std::sin (w);
+        }
+
+    _split_re.resize (m);
+    _split_im.resize (m);
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        const double w = -2 * M_PI * k / size;
+        _split_re [k] = std::cos (w);
+        _split_im [k] = std::sin (w);
+    }
+}
+
+void real_fft::forward_steps (const float* lo, const float* hi,
+                              float* re, float* im,
+                              std::size_t first, std::size_t last) const
+{
+    const std::size_t m = _size / 2;
+
+    // The even and odd samples are the real and imaginary parts of
+    // the complex signal, in bit reversed order.
+    std::size_t start = detail::run_phase (
+        first, last, 0, m, [&] (std::size_t a, std::size_t b) {
+            for (std::size_t k = a; k < b; ++k)
+            {
+                const float* x = 2 * k < m ? lo + 2 * k : hi + 2 * k - m;
+                re [_reverse [k]] = x [0];
+                im [_reverse [k]] = x [1];
+            }
+        });
+
+    for (std::size_t h = 1; h < m; h *= 2)
+        start = detail::run_phase (
+            first, last, start, m / 2, [&] (std::size_t a, std::size_t b) {
+                kernels ().fft_dit_pass (re, im, &_twiddle_re [h - 1],
+                                         &_twiddle_im [h - 1], h, a, b);
+            });
+
+    // Bins k and m - k are computed together from the complex
+    // spectrum z as e + w^k o and conj (e - w^k o), where e and o are
+    // the spectra of the even and odd samples.
+    detail::run_phase (
+        first, last, start, m / 2 + 1, [&] (std::size_t a, std::size_t b) {
+            for (std::size_t k = a; k < b; ++k)
+            {
+                if (k == 0)
+                {
+                    const float r = re [0];
+                    re [0] = r + im [0];
+                    re [m] = r - im [0];
+                    im [0] = im [m] = 0.0f;
+                    continue;
+                }
+
+                const std::size_t j = m - k;
+                const float er = 0.5f * (re [k] + re [j]);
+                const float ei = 0.5f * (im [k] - im [j]);
+                const float or_ = 0.5f * (im [k] + im [j]);
+                const float oi = 0.5f * (re [j] - re [k]);
+                const float tr = _split_re [k] * or_ - _split_im [k] * oi;
+                const float ti = _split_re [k] * oi + _split_im [k] * or_;
+                re [k] = er + tr;
+                im [k] = ei + ti;
+                re [j] = er - tr;
+                im [j] = ti - ei;
+            }
+        });
+}
+
+void real_fft::inverse_steps (float* re, float* im, float* out,
+                              std::size_t first, std::size_t last) const
+{
+    const std::size_t m = _size / 2;
+
+    // The reverse of the splitting in forward_steps (), giving twice
+    // the complex spectrum z with its parts swapped, such that the
+    // forward passes compute the inverse transform.
+    std::size_t start = detail::run_phase (
+        first, last, 0, m / 2 + 1, [&] (std::size_t a, std::size_t b) {
+            for (std::size_t k = a; k < b; ++k)
+            {
+                const std::size_t j = m - k;
+                const float er = re [k] + re [j];
+                const float ei = im [k] - im [j];
+                const float gr = re [k] - re [j];
+                const float gi = im [k] + im [j];
+                const float wr = _split_re [k];
+                const float wi = _split_im [k];
+                const float or_ = wr * gr + wi * gi;
+                const float oi = wr * gi - wi * gr;
+                re [k] = ei + or_;
+                im [k] = er - oi;
+                if (k != 0)
+                {
+                    re [j] = or_ - ei;
+                    im [j] = er + oi;
+                }
+            }
+        });
+
+    for (std::size_t h = m / 2; h >= 1; h /= 2)
+        start = detail::run_phase (
+            first, last, start, m / 2, [&] (std::size_t a, std::size_t b) {
+                kernels ().fft_dif_pass (re, im, &_twiddle_re [h - 1],
+                                         &_twiddle_im [h - 1], h, a, b);
+            });
+
+    // The decimation in frequency leaves the result in bit reversed
+    // order.
+    detail::run_phase (
+        first, last, start, m, [&] (std::size_t a, std::size_t b) {
+            for (std::size_t n = a; n < b; ++n)
+            {
+                out [2 * n]     = im [_reverse [n]];
+                out [2 * n + 1] = re [_reverse [n]];
+            }
+        });
+}
+
+} /* namespace synth */
+} /* namespace psynth */
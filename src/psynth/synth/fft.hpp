@@ -0,0 +1,135 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        fft.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Real fast Fourier transform.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#ifndef PSYNTH_SYNTH_FFT_HPP_
+#define PSYNTH_SYNTH_FFT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * Radix-2 fast Fourier transform of real signals of a power of two
+ * size, computed as a complex transform of half the size whose
+ * passes are run by the kernels in synth/kernels.hpp. The
+ * spectrum has the size () / 2 + 1 non redundant bins, whose real and
+ * imaginary parts are kept in separate arrays.
+ *
+ * A transform is a sequence of work () steps of similar cost, and it
+ * can be spread over several calls by running a few steps at a time,
+ * passing the same arrays every time, such that the cost of a large
+ * transform can be amortised over many audio blocks. The object
+ * itself is not modified by the transforms and it may be shared.
+ */
+class real_fft
+{
+public:
+    explicit real_fft (std::size_t size);
+
+    std::size_t size () const
+    { return _size; }
+
+    std::size_t bins () const
+    { return _size / 2 + 1; }
+
+    std::size_t work () const
+    { return _work; }
+
+    /**
+     * Writes the spectrum of the size () samples in @a in into @a re
+     * and @a im.
+     */
+    void forward (const float* in, float* re, float* im) const
+    { forward_steps (in, in + _size / 2, re, im, 0, _work); }
+
+    /**
+     * Writes the size () samples of the signal whose spectrum is in
+     * @a re and @a im into @a out, scaled by size (). The spectrum is
+     * used as scratch and its contents are lost.
+     */
+    void inverse (float* re, float* im, float* out) const
+    { inverse_steps (re, im, out, 0, _work); }
+
+    /**
+     * Runs the steps [first, last) of forward (), where the first
+     * half of the signal is in @a lo and the second half is in @a hi.
+     */
+    void forward_steps (const float* lo, const float* hi,
+                        float* re, float* im,
+                        std::size_t first, std::size_t last) const;
+
+    /**
+     * Runs the steps [first, last) of inverse ().
+     */
+    void inverse_steps (float* re, float* im, float* out,
+                        std::size_t first, std::size_t last) const;
+
+private:
+    std::size_t _size;
+    std::size_t _work;
+    std::vector<std::size_t> _reverse;
+    std::vector<float> _twiddle_re;
+    std::vector<float> _twiddle_im;
+    std::vector<float> _split_re;
+    std::vector<float> _split_im;
+};
+
+namespace detail
+{
+
+/**
+ * Calls @a fn with the part of the steps [first, last) that falls in
+ * the phase of @a size steps starting at @a start, relative to the
+ * beginning of the phase. Returns the beginning of the next phase.
+ */
+template <class Fn>
+std::size_t run_phase (std::size_t first, std::size_t last,
+                       std::size_t start, std::size_t size, Fn fn)
+{
+    const std::size_t a = std::max (first, start);
+    const std::size_t b = std::min (last, start + size);
+    if (a < b)
+        fn (a - start, b - start);
+    return start + size;
+}
+
+} /* namespace detail */
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_FFT_HPP_ */
@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include "synth/fast_math.hpp"
 #include "synth/filter.hpp"
 
 namespace psynth
@@ -63,14 +64,14 @@ void filter_values::calculate ()
         // Empirical tunning
 	m_p = ( 3.6f - 3.2f * f ) * f;
 	m_k = 2.0f * m_p - 1;
-	m_r = m_res * powf( M_E, ( 1 - m_p ) * 1.386249f );
+	m_r = m_res * synth::fast_exp( ( 1 - m_p ) * 1.386249f );
 	return;
     }
 
     // other filters
-    const float omega = 2 * M_PI * m_freq / m_srate;
-    const float tsin = sinf( omega );
-    const float tcos = cosf( omega );
+    const float cycles = m_freq / m_srate;
+    const float tsin = synth::fast_sin_cycles( cycles );
+    const float tcos = synth::fast_cos_cycles( cycles );
 
     /*
       float alpha;
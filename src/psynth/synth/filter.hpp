@@ -29,9 +29,15 @@
 namespace psynth
 {
 
+namespace synth
+{
+class biquad_bank;
+} /* namespace synth */
+
 class filter_values
 {
     friend class filter;
+    friend class synth::biquad_bank;
 
 public:
     enum type {
@@ -0,0 +1,1156 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        kernels.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief DSP kernels selected at run-time for the CPU.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define PSYNTH_MODULE_NAME "psynth.synth.kernels"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#include "base/logger.hpp"
+#include "synth/kernels.hpp"
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#  define PSYNTH_KERNELS_X86 1
+#endif
+
+#ifdef __GNUC__
+/*
+ * Let the compiler vectorize the loops for every target, but never
+ * contract multiplications and additions, some targets have FMA and
+ * the results would not match anymore.
+ */
+#  pragma GCC optimize ("tree-vectorize", "fp-contract=off")
+#  define PSYNTH_KERNEL_BODY static inline __attribute__ ((always_inline))
+#  define PSYNTH_KERNEL_TARGET(isa) __attribute__ ((target (isa)))
+#else
+#  define PSYNTH_KERNEL_BODY static inline
+#  define PSYNTH_KERNEL_TARGET(isa)
+#endif
+
+namespace psynth
+{
+namespace synth
+{
+
+namespace
+{
+
+/** Kernels are run in chunks of this size when they need a buffer. */
+const std::size_t chunk_size = 64;
+
+PSYNTH_KERNEL_BODY
+void mix_body (const float* a, const float* b, float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = a [i] + b [i];
+}
+
+PSYNTH_KERNEL_BODY
+void mix_gain_body (const float* a, const float* b, float gain,
+                    float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = a [i] + b [i] * gain;
+}
+
+PSYNTH_KERNEL_BODY
+void modulate_body (const float* a, const float* b,
+                    float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = a [i] * b [i];
+}
+
+PSYNTH_KERNEL_BODY
+void modulate_gain_body (const float* a, const float* b, float gain,
+                         float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = a [i] * b [i] * gain;
+}
+
+PSYNTH_KERNEL_BODY
+void blend_body (const float* a, const float* b, float stable,
+                 float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = a [i] * b [i] + stable * (1.0f - b [i]);
+}
+
+PSYNTH_KERNEL_BODY
+void ramp_body (float* dst, std::size_t n, float start, float slope)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = start + float (std::int32_t (i)) * slope;
+}
+
+/**
+ * Signed integral sample formats, the conversions mirror the ones in
+ * sound::sample_convert.
+ */
+struct int16_format
+{
+    typedef std::int16_t raw;
+
+    PSYNTH_KERNEL_BODY float lsb ()
+    { return 2.0f / 65535.0f; }
+
+    PSYNTH_KERNEL_BODY void store (raw* dst, std::size_t i, float x)
+    {
+        const float u = (x + 1.0f) * .5f;
+        dst [i] = std::int16_t (std::int32_t (u * 65535.0f + 0.5f) - 32768);
+    }
+
+    PSYNTH_KERNEL_BODY float load (const raw* src, std::size_t i)
+    {
+        const float u = float (std::int32_t (src [i]) + 32768) / 65535.0f;
+        return u * 2.0f - 1.0f;
+    }
+};
+
+struct int24_format
+{
+    typedef std::uint8_t raw;
+
+    PSYNTH_KERNEL_BODY float lsb ()
+    { return 2.0f / 16777215.0f; }
+
+    PSYNTH_KERNEL_BODY void store (raw* dst, std::size_t i, float x)
+    {
+        const float u = (x + 1.0f) * .5f;
+        const std::uint32_t v = u >= 1.0f ?
+            0xFFFFFF : std::uint32_t (u * 16777215.0f + 0.5f);
+        const std::uint32_t s = v ^ 0x800000;
+        dst [i * 3]     = std::uint8_t (s);
+        dst [i * 3 + 1] = std::uint8_t (s >> 8);
+        dst [i * 3 + 2] = std::uint8_t (s >> 16);
+    }
+
+    PSYNTH_KERNEL_BODY float load (const raw* src, std::size_t i)
+    {
+        const std::uint32_t s =
+            std::uint32_t (src [i * 3]) |
+            std::uint32_t (src [i * 3 + 1]) << 8 |
+            std::uint32_t (src [i * 3 + 2]) << 16;
+        const float u = float (s ^ 0x800000) / 16777215.0f;
+        return u * 2.0f - 1.0f;
+    }
+};
+
+struct int32_format
+{
+    typedef std::int32_t raw;
+
+    /** Floats do not have enough precision to need dither here. */
+    PSYNTH_KERNEL_BODY float lsb ()
+    { return 0.0f; }
+
+    PSYNTH_KERNEL_BODY void store (raw* dst, std::size_t i, float x)
+    {
+        const float u = (x + 1.0f) * .5f;
+        const std::uint32_t v = u >= 1.0f ?
+            0xFFFFFFFF : std::uint32_t (u * 4294967295.0f + 0.5f);
+        dst [i] = std::int32_t (v ^ 0x80000000);
+    }
+
+    PSYNTH_KERNEL_BODY float load (const raw* src, std::size_t i)
+    {
+        const std::uint32_t v = std::uint32_t (src [i]) ^ 0x80000000;
+        const float u = v >= 0xFFFFFFFF ? 1.0f : float (v) / 4294967295.0f;
+        return u * 2.0f - 1.0f;
+    }
+};
+
+/**
+ * Hash of the sample index used to generate the dither noise. It
+ * only needs integer arithmetic, so it vectorizes and gives the same
+ * results for every instruction set.
+ */
+PSYNTH_KERNEL_BODY
+float dither_noise (std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return float (x >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * Converts the planes interleaving them in the same loop. When @a
+ * Channels is not zero it overrides @a channels, so the inner loop
+ * can be unrolled and the whole vectorized.
+ */
+template <class Format, std::size_t Channels, bool Dither>
+PSYNTH_KERNEL_BODY
+void float_to_int_body (const float* const* src, std::size_t channels,
+                        typename Format::raw* dst, std::size_t n,
+                        std::uint32_t seed)
+{
+    const std::size_t nch = Channels ? Channels : channels;
+    const float lsb = Format::lsb ();
+
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < nch; ++c)
+        {
+            float x = src [c][i];
+            if (Dither)
+            {
+                const std::uint32_t k =
+                    (seed + std::uint32_t (i * nch + c)) * 2;
+                x += (dither_noise (k) - dither_noise (k + 1)) * lsb;
+            }
+            x = x < -1.0f ? -1.0f : x > 1.0f ? 1.0f : x;
+            Format::store (dst, i * nch + c, x);
+        }
+}
+
+template <class Format, bool Dither>
+PSYNTH_KERNEL_BODY
+void float_to_int_channels (const float* const* src, std::size_t channels,
+                            typename Format::raw* dst, std::size_t n,
+                            std::uint32_t seed)
+{
+    switch (channels)
+    {
+    case 1:
+        float_to_int_body<Format, 1, Dither> (src, 1, dst, n, seed);
+        break;
+    case 2:
+        float_to_int_body<Format, 2, Dither> (src, 2, dst, n, seed);
+        break;
+    default:
+        float_to_int_body<Format, 0, Dither> (src, channels, dst, n, seed);
+        break;
+    }
+}
+
+template <class Format>
+PSYNTH_KERNEL_BODY
+void float_to_int (const float* const* src, std::size_t channels,
+                   typename Format::raw* dst, std::size_t n,
+                   std::uint32_t* dither)
+{
+    if (dither && Format::lsb () != 0.0f)
+    {
+        float_to_int_channels<Format, true> (src, channels, dst, n, *dither);
+        *dither += std::uint32_t (n * channels);
+    }
+    else
+        float_to_int_channels<Format, false> (src, channels, dst, n, 0);
+}
+
+template <class Format, std::size_t Channels>
+PSYNTH_KERNEL_BODY
+void int_to_float_body (const typename Format::raw* src,
+                        std::size_t channels,
+                        float* const* dst, std::size_t n)
+{
+    const std::size_t nch = Channels ? Channels : channels;
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t c = 0; c < nch; ++c)
+            dst [c][i] = Format::load (src, i * nch + c);
+}
+
+template <class Format>
+PSYNTH_KERNEL_BODY
+void int_to_float (const typename Format::raw* src, std::size_t channels,
+                   float* const* dst, std::size_t n)
+{
+    switch (channels)
+    {
+    case 1:
+        int_to_float_body<Format, 1> (src, 1, dst, n);
+        break;
+    case 2:
+        int_to_float_body<Format, 2> (src, 2, dst, n);
+        break;
+    default:
+        int_to_float_body<Format, 0> (src, channels, dst, n);
+        break;
+    }
+}
+
+/** Same as base::phase. */
+PSYNTH_KERNEL_BODY
+float phase_body (float x)
+{
+    const float i = float (std::int32_t (x));
+    return x - i + (x >= 0 ? 0.0f : 1.0f);
+}
+
+struct sawtooth_body
+{
+    PSYNTH_KERNEL_BODY float eval (float x)
+    { return -1.0f + phase_body (x) * 2.0f; }
+};
+
+struct square_body
+{
+    PSYNTH_KERNEL_BODY float eval (float x)
+    { return phase_body (x) > 0.5f ? -1.0f : 1.0f; }
+};
+
+struct triangle_body
+{
+    PSYNTH_KERNEL_BODY float eval (float x)
+    {
+        const float p = phase_body (x);
+        return p <= 0.25f ? p * 4.0f :
+               p <= 0.75f ? 2.0f - p * 4.0f :
+               p * 4.0f - 4.0f;
+    }
+};
+
+/**
+ * The phase is accumulated sample by sample, as the generic
+ * oscillators do, and then the waves are computed in a separate
+ * loop that can be vectorized.
+ */
+template <class Wave>
+PSYNTH_KERNEL_BODY
+float oscillator_body (float* dst, std::size_t n,
+                       float x, float speed, float ampl)
+{
+    float xs [chunk_size];
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t m = n - i < chunk_size ? n - i : chunk_size;
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            xs [j] = x;
+            x += speed;
+        }
+        for (std::size_t j = 0; j < m; ++j)
+            dst [i + j] = Wave::eval (xs [j]) * ampl;
+    }
+    return x;
+}
+
+/**
+ * Writes to @a dst the @a m <= chunk_size samples of @a table at the
+ * phases @a xs. The lookups are kept in their own loop so the
+ * computation of the indices and the interpolation around them are
+ * still vectorized.
+ */
+PSYNTH_KERNEL_BODY
+void wave_table_lookup (const float* table, std::size_t size,
+                        const float* xs, float* dst, std::size_t m,
+                        float ampl)
+{
+    const float fsize = float (size);
+    const std::int32_t mask = std::int32_t (size) - 1;
+    float as [chunk_size];
+    float ys [chunk_size];
+    float ds [chunk_size];
+    std::int32_t ks [chunk_size];
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        const float p = phase_body (xs [j]) * fsize;
+        const std::int32_t k = std::int32_t (p);
+        as [j] = p - float (k);
+        ks [j] = k & mask;
+    }
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        ys [j] = table [ks [j]];
+        ds [j] = table [ks [j] + 1] - ys [j];
+    }
+    for (std::size_t j = 0; j < m; ++j)
+        dst [j] = (ys [j] + as [j] * ds [j]) * ampl;
+}
+
+PSYNTH_KERNEL_BODY
+float wave_table_body (const float* table, std::size_t size,
+                       float* dst, std::size_t n,
+                       float x, float speed, float ampl)
+{
+    float xs [chunk_size];
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t m = n - i < chunk_size ? n - i : chunk_size;
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            xs [j] = x;
+            x += speed;
+        }
+        wave_table_lookup (table, size, xs, dst + i, m, ampl);
+    }
+    return x;
+}
+
+PSYNTH_KERNEL_BODY
+void wave_table_phases_body (const float* table, std::size_t size,
+                             const float* x, float* dst, std::size_t n,
+                             float ampl)
+{
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t m = n - i < chunk_size ? n - i : chunk_size;
+        wave_table_lookup (table, size, x + i, dst + i, m, ampl);
+    }
+}
+
+#ifdef __GNUC__
+typedef float biquad_vec __attribute__ ((vector_size (biquad_lanes * 4)));
+#else
+struct biquad_vec
+{
+    float v [biquad_lanes];
+
+    float& operator[] (std::size_t l)
+    { return v [l]; }
+
+    friend biquad_vec operator* (biquad_vec a, const biquad_vec& b)
+    {
+        for (std::size_t l = 0; l < biquad_lanes; ++l)
+            a.v [l] *= b.v [l];
+        return a;
+    }
+
+    friend biquad_vec operator+ (biquad_vec a, const biquad_vec& b)
+    {
+        for (std::size_t l = 0; l < biquad_lanes; ++l)
+            a.v [l] += b.v [l];
+        return a;
+    }
+
+    friend biquad_vec operator- (biquad_vec a, const biquad_vec& b)
+    {
+        for (std::size_t l = 0; l < biquad_lanes; ++l)
+            a.v [l] -= b.v [l];
+        return a;
+    }
+};
+#endif
+
+/**
+ * The lanes are transposed into vectors of biquad_lanes samples, so
+ * every step of the recursion is one vector operation for all of
+ * them and the state stays in registers. Lanes past @a lanes are fed
+ * zeros and their output dropped.
+ */
+PSYNTH_KERNEL_BODY
+void biquad_body (const float* coef, float* state,
+                  const float* const* src, float* const* dst,
+                  std::size_t lanes, std::size_t n)
+{
+    typedef biquad_vec vec;
+    const std::size_t w = biquad_lanes;
+    vec b0, b1, b2, a1, a2, x1, x2, y1, y2;
+    std::memcpy (&b0, coef, sizeof (vec));
+    std::memcpy (&b1, coef + w, sizeof (vec));
+    std::memcpy (&b2, coef + 2 * w, sizeof (vec));
+    std::memcpy (&a1, coef + 3 * w, sizeof (vec));
+    std::memcpy (&a2, coef + 4 * w, sizeof (vec));
+    std::memcpy (&x1, state, sizeof (vec));
+    std::memcpy (&x2, state + w, sizeof (vec));
+    std::memcpy (&y1, state + 2 * w, sizeof (vec));
+    std::memcpy (&y2, state + 3 * w, sizeof (vec));
+
+    vec xs [chunk_size];
+    for (std::size_t i = 0; i < n; i += chunk_size)
+    {
+        const std::size_t m = n - i < chunk_size ? n - i : chunk_size;
+        for (std::size_t l = 0; l < lanes; ++l)
+            for (std::size_t j = 0; j < m; ++j)
+                xs [j][l] = src [l][i + j];
+        for (std::size_t l = lanes; l < w; ++l)
+            for (std::size_t j = 0; j < m; ++j)
+                xs [j][l] = 0.0f;
+
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            const vec x = xs [j];
+            const vec y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            xs [j] = y;
+        }
+
+        for (std::size_t l = 0; l < lanes; ++l)
+            for (std::size_t j = 0; j < m; ++j)
+                dst [l][i + j] = xs [j][l];
+    }
+
+    std::memcpy (state, &x1, sizeof (vec));
+    std::memcpy (state + w, &x2, sizeof (vec));
+    std::memcpy (state + 2 * w, &y1, sizeof (vec));
+    std::memcpy (state + 3 * w, &y2, sizeof (vec));
+}
+
+/**
+ * Advances the first @a m xorshift generators in @a state and makes
+ * floats in [-1, 1) from their top 23 bits. The bits are put in the
+ * mantissa of a float in [2, 4), so it only takes integer operations
+ * and one subtraction, which vectorize for every instruction set.
+ */
+PSYNTH_KERNEL_BODY
+void white_noise_step (std::uint32_t* state, float* dst, std::size_t m)
+{
+    std::uint32_t bits [noise_lanes];
+    for (std::size_t l = 0; l < m; ++l)
+    {
+        std::uint32_t x = state [l];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state [l] = x;
+        bits [l] = (x >> 9) | 0x40000000u;
+    }
+    std::memcpy (dst, bits, m * sizeof (float));
+    for (std::size_t l = 0; l < m; ++l)
+        dst [l] = dst [l] - 3.0f;
+}
+
+PSYNTH_KERNEL_BODY
+void white_noise_body (std::uint32_t* state, float* dst, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + noise_lanes <= n; i += noise_lanes)
+        white_noise_step (state, dst + i, noise_lanes);
+    white_noise_step (state, dst + i, n - i);
+}
+
+/**
+ * Paul Kellet's refined pink filter is six one pole filters plus a
+ * direct and a delayed path, all of them linear. The outputs of a
+ * block of pink_block samples are thus a matrix times the inputs plus
+ * another times the states, which the kernel computes with
+ * independent vector operations. Only the update of the states
+ * carries from one block to the next.
+ */
+const std::size_t pink_block = biquad_lanes;
+const std::size_t pink_poles = 6;
+
+const float pink_pole [pink_poles] = {
+    0.99886f, 0.99332f, 0.96900f, 0.86650f, 0.55000f, -0.7616f };
+const float pink_gain [pink_poles] = {
+    0.0555179f, 0.0750759f, 0.1538520f, 0.3104856f, 0.5329522f, -0.0168980f };
+const float pink_direct  = 0.5362f;
+const float pink_delayed = 0.115926f;
+const float pink_scale   = 0.2f;
+
+struct pink_matrices
+{
+    /** Contribution of every input to the outputs of the block. */
+    biquad_vec input [pink_block];
+    /** Contribution of every state to the outputs of the block. */
+    biquad_vec state [pink_poles + 1];
+    /** Contribution of every input to the states after the block. */
+    biquad_vec update [pink_block];
+    /** Contribution of the states to themselves after the block. */
+    biquad_vec decay;
+};
+
+const pink_matrices& get_pink_matrices ()
+{
+    static const pink_matrices m = [] {
+        pink_matrices m;
+        const std::size_t w = pink_block;
+        for (std::size_t k = 0; k < w; ++k)
+        {
+            for (std::size_t j = 0; j < w; ++j)
+            {
+                double x = 0.0;
+                if (j <= k)
+                    for (std::size_t p = 0; p < pink_poles; ++p)
+                        x += double (pink_gain [p]) *
+                            std::pow (double (pink_pole [p]), double (k - j));
+                x += j == k     ? pink_direct  : 0.0;
+                x += j + 1 == k ? pink_delayed : 0.0;
+                m.input [j][k] = float (x * pink_scale);
+
+                double u = 0.0;
+                if (k < pink_poles)
+                    u = double (pink_gain [k]) *
+                        std::pow (double (pink_pole [k]), double (w - 1 - j));
+                else if (k == pink_poles && j == w - 1)
+                    u = pink_delayed;
+                m.update [j][k] = float (u * pink_scale);
+            }
+
+            for (std::size_t p = 0; p < pink_poles; ++p)
+                m.state [p][k] = float (
+                    std::pow (double (pink_pole [p]), double (k + 1)));
+            m.state [pink_poles][k] = k == 0 ? 1.0f : 0.0f;
+
+            m.decay [k] = k < pink_poles ? float (
+                std::pow (double (pink_pole [k]), double (w))) : 0.0f;
+        }
+        return m;
+    } ();
+    return m;
+}
+
+PSYNTH_KERNEL_BODY
+void splat (biquad_vec& v, float x)
+{
+    for (std::size_t l = 0; l < biquad_lanes; ++l)
+        v [l] = x;
+}
+
+PSYNTH_KERNEL_BODY
+void pink_filter_body (float* state, float* buf, std::size_t n)
+{
+    typedef biquad_vec vec;
+    const pink_matrices& m = get_pink_matrices ();
+
+    vec s;
+    for (std::size_t l = 0; l < biquad_lanes; ++l)
+        s [l] = l <= pink_poles ? state [l] : 0.0f;
+
+    std::size_t i = 0;
+    for (; i + pink_block <= n; i += pink_block)
+    {
+        vec x, y;
+        splat (x, buf [i]);
+        vec out  = m.input [0] * x;
+        vec next = m.update [0] * x;
+        for (std::size_t j = 1; j < pink_block; ++j)
+        {
+            splat (x, buf [i + j]);
+            out  = out + m.input [j] * x;
+            next = next + m.update [j] * x;
+        }
+        for (std::size_t p = 0; p <= pink_poles; ++p)
+        {
+            splat (y, s [p]);
+            out = out + m.state [p] * y;
+        }
+        s = next + m.decay * s;
+        std::memcpy (buf + i, &out, sizeof (vec));
+    }
+
+    for (std::size_t l = 0; l <= pink_poles; ++l)
+        state [l] = s [l];
+
+    for (; i < n; ++i)
+    {
+        const float white = buf [i] * pink_scale;
+        float pink = white * pink_direct + state [pink_poles];
+        for (std::size_t p = 0; p < pink_poles; ++p)
+        {
+            state [p] = pink_pole [p] * state [p] + white * pink_gain [p];
+            pink += state [p];
+        }
+        state [pink_poles] = white * pink_delayed;
+        buf [i] = pink;
+    }
+}
+
+/**
+ * Leaky integrator, y = (y + 0.02 x) / 1.02, with the output scaled
+ * to keep roughly the level of the white noise. Blocks are computed
+ * like in the pink filter.
+ */
+const float brown_pole  = 1.0f / 1.02f;
+const float brown_gain  = 0.02f / 1.02f;
+const float brown_scale = 3.5f;
+
+struct brown_matrices
+{
+    biquad_vec input [pink_block];
+    biquad_vec state;
+    float      update [pink_block];
+    float      decay;
+};
+
+const brown_matrices& get_brown_matrices ()
+{
+    static const brown_matrices m = [] {
+        brown_matrices m;
+        const std::size_t w = pink_block;
+        const double a = brown_pole;
+        for (std::size_t k = 0; k < w; ++k)
+        {
+            for (std::size_t j = 0; j < w; ++j)
+                m.input [j][k] = j <= k ? float (
+                    brown_scale * brown_gain * std::pow (a, double (k - j)))
+                    : 0.0f;
+            m.state [k] = float (brown_scale * std::pow (a, double (k + 1)));
+            m.update [k] = float (brown_gain * std::pow (a, double (w - 1 - k)));
+        }
+        m.decay = float (std::pow (a, double (w)));
+        return m;
+    } ();
+    return m;
+}
+
+PSYNTH_KERNEL_BODY
+void brown_filter_body (float* state, float* buf, std::size_t n)
+{
+    typedef biquad_vec vec;
+    const brown_matrices& m = get_brown_matrices ();
+
+    float y = state [0];
+    std::size_t i = 0;
+    for (; i + pink_block <= n; i += pink_block)
+    {
+        vec x;
+        splat (x, buf [i]);
+        vec out = m.input [0] * x;
+        float next = m.update [0] * buf [i];
+        for (std::size_t j = 1; j < pink_block; ++j)
+        {
+            splat (x, buf [i + j]);
+            out  = out + m.input [j] * x;
+            next = next + m.update [j] * buf [i + j];
+        }
+        splat (x, y);
+        out = out + m.state * x;
+        y = next + m.decay * y;
+        std::memcpy (buf + i, &out, sizeof (vec));
+    }
+
+    for (; i < n; ++i)
+    {
+        y = y * brown_pole + buf [i] * brown_gain;
+        buf [i] = y * brown_scale;
+    }
+    state [0] = y;
+}
+
+PSYNTH_KERNEL_BODY
+void complex_mac_body (const float* xr, const float* xi,
+                       const float* hr, const float* hi,
+                       float* yr, float* yi, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float r = xr [i] * hr [i] - xi [i] * hi [i];
+        const float m = xr [i] * hi [i] + xi [i] * hr [i];
+        yr [i] += r;
+        yi [i] += m;
+    }
+}
+
+template <bool Dit, class T>
+PSYNTH_KERNEL_BODY
+void fft_butterfly (T& ra, T& ia, T& rb, T& ib, const T& wr, const T& wi)
+{
+    if (Dit)
+    {
+        const T tr = wr * rb - wi * ib;
+        const T ti = wr * ib + wi * rb;
+        rb = ra - tr;
+        ib = ia - ti;
+        ra = ra + tr;
+        ia = ia + ti;
+    }
+    else
+    {
+        const T dr = ra - rb;
+        const T di = ia - ib;
+        ra = ra + rb;
+        ia = ia + ib;
+        rb = wr * dr - wi * di;
+        ib = wr * di + wi * dr;
+    }
+}
+
+/**
+ * The butterflies of a group are done biquad_lanes at a time in
+ * vectors, as the compiler would not vectorize them on its own for
+ * fear of aliasing. The first pass of a transform has groups of one
+ * butterfly, the twiddle is one and they are better done together.
+ */
+template <bool Dit>
+PSYNTH_KERNEL_BODY
+void fft_pass_body (float* re, float* im,
+                    const float* wr, const float* wi,
+                    std::size_t half,
+                    std::size_t first, std::size_t last)
+{
+    typedef biquad_vec vec;
+    const std::size_t w = biquad_lanes;
+
+    if (half == 1)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const float dr = re [2 * i] - re [2 * i + 1];
+            const float di = im [2 * i] - im [2 * i + 1];
+            re [2 * i] += re [2 * i + 1];
+            im [2 * i] += im [2 * i + 1];
+            re [2 * i + 1] = dr;
+            im [2 * i + 1] = di;
+        }
+        return;
+    }
+
+    while (first < last)
+    {
+        const std::size_t j   = first & (half - 1);
+        const std::size_t end = std::min (half, j + (last - first));
+        float* ra = re + 2 * (first - j);
+        float* ia = im + 2 * (first - j);
+        float* rb = ra + half;
+        float* ib = ia + half;
+
+        std::size_t k = j;
+        for (; k + w <= end; k += w)
+        {
+            vec var, via, vrb, vib, vwr, vwi;
+            std::memcpy (&var, ra + k, sizeof (vec));
+            std::memcpy (&via, ia + k, sizeof (vec));
+            std::memcpy (&vrb, rb + k, sizeof (vec));
+            std::memcpy (&vib, ib + k, sizeof (vec));
+            std::memcpy (&vwr, wr + k, sizeof (vec));
+            std::memcpy (&vwi, wi + k, sizeof (vec));
+            fft_butterfly<Dit> (var, via, vrb, vib, vwr, vwi);
+            std::memcpy (ra + k, &var, sizeof (vec));
+            std::memcpy (ia + k, &via, sizeof (vec));
+            std::memcpy (rb + k, &vrb, sizeof (vec));
+            std::memcpy (ib + k, &vib, sizeof (vec));
+        }
+        for (; k < end; ++k)
+            fft_butterfly<Dit> (ra [k], ia [k], rb [k], ib [k], wr [k], wi [k]);
+
+        first += end - j;
+    }
+}
+
+/**
+ * Splits the delays of the samples at @a now + i into the ring
+ * buffer index of the integer part, less @a offset, and the
+ * remaining fraction. The reads themselves can not be vectorized, the
+ * compiler does not use gathers, so the delay kernels work in chunks
+ * that compute the positions, then read, and then interpolate in
+ * separate loops.
+ */
+PSYNTH_KERNEL_BODY
+void delay_positions (std::uint32_t now, std::uint32_t mask,
+                      const float* delay, float offset,
+                      std::uint32_t* idx, float* frac, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::int32_t k = std::int32_t (delay [i] - offset);
+        frac [i] = delay [i] - float (k);
+        idx [i]  = (now + std::uint32_t (i) - std::uint32_t (k)) & mask;
+    }
+}
+
+PSYNTH_KERNEL_BODY
+void delay_linear_body (const float* buf, std::size_t mask,
+                        std::size_t now, const float* delay,
+                        float* dst, std::size_t n)
+{
+    const std::uint32_t m = mask;
+    std::uint32_t idx [chunk_size];
+    float frac [chunk_size], y0 [chunk_size], y1 [chunk_size];
+
+    for (std::size_t c = 0; c < n; c += chunk_size)
+    {
+        const std::size_t len = std::min (chunk_size, n - c);
+        delay_positions (now + c, m, delay + c, 0.0f, idx, frac, len);
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            y0 [i] = buf [idx [i]];
+            y1 [i] = buf [(idx [i] - 1) & m];
+        }
+        for (std::size_t i = 0; i < len; ++i)
+            dst [c + i] = y0 [i] + frac [i] * (y1 [i] - y0 [i]);
+    }
+}
+
+PSYNTH_KERNEL_BODY
+void delay_cubic_body (const float* buf, std::size_t mask,
+                       std::size_t now, const float* delay,
+                       float* dst, std::size_t n)
+{
+    const std::uint32_t m = mask;
+    std::uint32_t idx [chunk_size];
+    float frac [chunk_size], y [4][chunk_size];
+
+    for (std::size_t c = 0; c < n; c += chunk_size)
+    {
+        const std::size_t len = std::min (chunk_size, n - c);
+        delay_positions (now + c, m, delay + c, 0.0f, idx, frac, len);
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            y [0][i] = buf [(idx [i] + 1) & m];
+            y [1][i] = buf [idx [i]];
+            y [2][i] = buf [(idx [i] - 1) & m];
+            y [3][i] = buf [(idx [i] - 2) & m];
+        }
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            const float f  = frac [i];
+            const float c1 = 0.5f * (y [2][i] - y [0][i]);
+            const float c2 = y [0][i] - 2.5f * y [1][i] +
+                2.0f * y [2][i] - 0.5f * y [3][i];
+            const float c3 = 0.5f * (y [3][i] - y [0][i]) +
+                1.5f * (y [1][i] - y [2][i]);
+            dst [c + i] = ((c3 * f + c2) * f + c1) * f + y [1][i];
+        }
+    }
+}
+
+/**
+ * The integer part of the delay is chosen such that the fractional
+ * part is in [0.5, 1.5), where the allpass coefficient stays small
+ * and its phase delay flat.
+ */
+PSYNTH_KERNEL_BODY
+float delay_allpass_body (const float* buf, std::size_t mask,
+                          std::size_t now, const float* delay,
+                          float* dst, std::size_t n, float last)
+{
+    const std::uint32_t m = mask;
+    std::uint32_t idx [chunk_size];
+    float frac [chunk_size], eta [chunk_size];
+
+    for (std::size_t c = 0; c < n; c += chunk_size)
+    {
+        const std::size_t len = std::min (chunk_size, n - c);
+        delay_positions (now + c, m, delay + c, 0.5f, idx, frac, len);
+        for (std::size_t i = 0; i < len; ++i)
+            eta [i] = (1.0f - frac [i]) / (1.0f + frac [i]);
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            last = eta [i] * buf [idx [i]] + buf [(idx [i] - 1) & m] -
+                eta [i] * last;
+            dst [c + i] = last;
+        }
+    }
+    return last;
+}
+
+#define PSYNTH_DEFINE_KERNELS(suffix, isa_level, target)                \
+    target void mix_##suffix (const float* a, const float* b,           \
+                              float* dst, std::size_t n)                \
+    { mix_body (a, b, dst, n); }                                        \
+    target void mix_gain_##suffix (const float* a, const float* b,      \
+                                   float gain, float* dst,              \
+                                   std::size_t n)                       \
+    { mix_gain_body (a, b, gain, dst, n); }                             \
+    target void modulate_##suffix (const float* a, const float* b,      \
+                                   float* dst, std::size_t n)           \
+    { modulate_body (a, b, dst, n); }                                   \
+    target void modulate_gain_##suffix (const float* a, const float* b, \
+                                        float gain, float* dst,         \
+                                        std::size_t n)                  \
+    { modulate_gain_body (a, b, gain, dst, n); }                        \
+    target void blend_##suffix (const float* a, const float* b,         \
+                                float stable, float* dst,               \
+                                std::size_t n)                          \
+    { blend_body (a, b, stable, dst, n); }                              \
+    target void ramp_##suffix (float* dst, std::size_t n,               \
+                               float start, float slope)                \
+    { ramp_body (dst, n, start, slope); }                               \
+    target void float_to_int16_##suffix (const float* const* src,       \
+                                         std::size_t channels,          \
+                                         std::int16_t* dst,             \
+                                         std::size_t n,                 \
+                                         std::uint32_t* dither)         \
+    { float_to_int<int16_format> (src, channels, dst, n, dither); }     \
+    target void float_to_int24_##suffix (const float* const* src,       \
+                                         std::size_t channels,          \
+                                         std::uint8_t* dst,             \
+                                         std::size_t n,                 \
+                                         std::uint32_t* dither)         \
+    { float_to_int<int24_format> (src, channels, dst, n, dither); }     \
+    target void float_to_int32_##suffix (const float* const* src,       \
+                                         std::size_t channels,          \
+                                         std::int32_t* dst,             \
+                                         std::size_t n,                 \
+                                         std::uint32_t* dither)         \
+    { float_to_int<int32_format> (src, channels, dst, n, dither); }     \
+    target void int16_to_float_##suffix (const std::int16_t* src,       \
+                                         std::size_t channels,          \
+                                         float* const* dst,             \
+                                         std::size_t n)                 \
+    { int_to_float<int16_format> (src, channels, dst, n); }             \
+    target void int24_to_float_##suffix (const std::uint8_t* src,       \
+                                         std::size_t channels,          \
+                                         float* const* dst,             \
+                                         std::size_t n)                 \
+    { int_to_float<int24_format> (src, channels, dst, n); }             \
+    target void int32_to_float_##suffix (const std::int32_t* src,       \
+                                         std::size_t channels,          \
+                                         float* const* dst,             \
+                                         std::size_t n)                 \
+    { int_to_float<int32_format> (src, channels, dst, n); }             \
+    target float sawtooth_##suffix (float* dst, std::size_t n,          \
+                                    float x, float speed, float ampl)   \
+    { return oscillator_body<sawtooth_body> (dst, n, x, speed, ampl); } \
+    target float square_##suffix (float* dst, std::size_t n,            \
+                                  float x, float speed, float ampl)     \
+    { return oscillator_body<square_body> (dst, n, x, speed, ampl); }   \
+    target float triangle_##suffix (float* dst, std::size_t n,          \
+                                    float x, float speed, float ampl)   \
+    { return oscillator_body<triangle_body> (dst, n, x, speed, ampl); } \
+    target float wave_table_##suffix (const float* table,               \
+                                      std::size_t size,                 \
+                                      float* dst, std::size_t n,        \
+                                      float x, float speed, float ampl) \
+    { return wave_table_body (table, size, dst, n, x, speed, ampl); }   \
+    target void wave_table_phases_##suffix (const float* table,         \
+                                            std::size_t size,           \
+                                            const float* x,             \
+                                            float* dst, std::size_t n,  \
+                                            float ampl)                 \
+    { wave_table_phases_body (table, size, x, dst, n, ampl); }          \
+    target void biquad_##suffix (const float* coef, float* state,       \
+                                 const float* const* src,               \
+                                 float* const* dst,                     \
+                                 std::size_t lanes, std::size_t n)      \
+    { biquad_body (coef, state, src, dst, lanes, n); }                  \
+    target void white_noise_##suffix (std::uint32_t* state,             \
+                                      float* dst, std::size_t n)        \
+    { white_noise_body (state, dst, n); }                               \
+    target void pink_filter_##suffix (float* state, float* buf,         \
+                                      std::size_t n)                    \
+    { pink_filter_body (state, buf, n); }                               \
+    target void brown_filter_##suffix (float* state, float* buf,        \
+                                       std::size_t n)                   \
+    { brown_filter_body (state, buf, n); }                              \
+    target void complex_mac_##suffix (const float* xr, const float* xi, \
+                                      const float* hr, const float* hi, \
+                                      float* yr, float* yi,             \
+                                      std::size_t n)                    \
+    { complex_mac_body (xr, xi, hr, hi, yr, yi, n); }                   \
+    target void fft_dit_pass_##suffix (float* re, float* im,            \
+                                       const float* wr,                 \
+                                       const float* wi,                 \
+                                       std::size_t half,                \
+                                       std::size_t first,               \
+                                       std::size_t last)                \
+    { fft_pass_body<true> (re, im, wr, wi, half, first, last); }        \
+    target void fft_dif_pass_##suffix (float* re, float* im,            \
+                                       const float* wr,                 \
+                                       const float* wi,                 \
+                                       std::size_t half,                \
+                                       std::size_t first,               \
+                                       std::size_t last)                \
+    { fft_pass_body<false> (re, im, wr, wi, half, first, last); }       \
+    target void delay_linear_##suffix (const float* buf,                \
+                                       std::size_t mask,                \
+                                       std::size_t now,                 \
+                                       const float* delay,              \
+                                       float* dst, std::size_t n)       \
+    { delay_linear_body (buf, mask, now, delay, dst, n); }              \
+    target void delay_cubic_##suffix (const float* buf,                 \
+                                      std::size_t mask,                 \
+                                      std::size_t now,                  \
+                                      const float* delay,               \
+                                      float* dst, std::size_t n)        \
+    { delay_cubic_body (buf, mask, now, delay, dst, n); }               \
+    target float delay_allpass_##suffix (const float* buf,              \
+                                         std::size_t mask,              \
+                                         std::size_t now,               \
+                                         const float* delay,            \
+                                         float* dst, std::size_t n,     \
+                                         float last)                    \
+    { return delay_allpass_body (buf, mask, now, delay, dst, n, last); } \
+                                                                        \
+    const kernel_table suffix##_kernels = {                             \
+        isa_level,                                                      \
+        mix_##suffix,                                                   \
+        mix_gain_##suffix,                                              \
+        modulate_##suffix,                                              \
+        modulate_gain_##suffix,                                         \
+        blend_##suffix,                                                 \
+        ramp_##suffix,                                                  \
+        float_to_int16_##suffix,                                        \
+        float_to_int24_##suffix,                                        \
+        float_to_int32_##suffix,                                        \
+        int16_to_float_##suffix,                                        \
+        int24_to_float_##suffix,                                        \
+        int32_to_float_##suffix,                                        \
+        sawtooth_##suffix,                                              \
+        square_##suffix,                                                \
+        triangle_##suffix,                                              \
+        wave_table_##suffix,                                            \
+        wave_table_phases_##suffix,                                     \
+        biquad_##suffix,                                                \
+        white_noise_##suffix,                                           \
+        pink_filter_##suffix,                                           \
+        brown_filter_##suffix,                                          \
+        complex_mac_##suffix,                                           \
+        fft_dit_pass_##suffix,                                          \
+        fft_dif_pass_##suffix,                                          \
+        delay_linear_##suffix,                                          \
+        delay_cubic_##suffix,                                           \
+        delay_allpass_##suffix                                          \
+    };
+
+PSYNTH_DEFINE_KERNELS (generic, base::cpu_isa::generic, )
+
+#ifdef PSYNTH_KERNELS_X86
+PSYNTH_DEFINE_KERNELS (sse2, base::cpu_isa::sse2,
+                       PSYNTH_KERNEL_TARGET ("sse2"))
+PSYNTH_DEFINE_KERNELS (avx2, base::cpu_isa::avx2,
+                       PSYNTH_KERNEL_TARGET ("avx2"))
+PSYNTH_DEFINE_KERNELS (avx512, base::cpu_isa::avx512,
+                       PSYNTH_KERNEL_TARGET ("avx512f"))
+#endif
+
+std::atomic<const kernel_table*> current_kernels (0);
+
+} /* anonymous namespace */
+
+const kernel_table& kernels_for (base::cpu_isa isa)
+{
+#ifdef PSYNTH_KERNELS_X86
+    if (isa >= base::cpu_isa::avx512)
+        return avx512_kernels;
+    if (isa >= base::cpu_isa::avx2)
+        return avx2_kernels;
+    if (isa >= base::cpu_isa::sse2)
+        return sse2_kernels;
+#endif
+    return generic_kernels;
+}
+
+const kernel_table& resolve_kernels ()
+{
+    const kernel_table& table = kernels_for (base::current_isa ());
+    if (current_kernels.exchange (&table) != &table)
+        PSYNTH_LOG << base::log::info << "Using DSP kernels for: "
+                   << base::isa_name (table.isa);
+    return table;
+}
+
+const kernel_table& kernels ()
+{
+    const kernel_table* table = current_kernels.load ();
+    return table ? *table : resolve_kernels ();
+}
+
+} /* namespace synth */
+} /* namespace psynth */
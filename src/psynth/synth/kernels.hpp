@@ -0,0 +1,238 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        kernels.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief DSP kernels selected at run-time for the CPU.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_SYNTH_KERNELS_HPP_
+#define PSYNTH_SYNTH_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <psynth/base/cpu.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * Number of filters run at once by the biquad kernel.
+ */
+const std::size_t biquad_lanes = 8;
+
+/**
+ * Number of generators run at once by the white noise kernel.
+ */
+const std::size_t noise_lanes = 16;
+
+/**
+ * Function pointers to DSP kernels working on raw arrays of floats,
+ * all of them compiled for a given instruction set. All variants
+ * give bit-exact results. The source and destination arrays may be
+ * the same array but they should not partially overlap.
+ */
+struct kernel_table
+{
+    base::cpu_isa isa;
+
+    /** dst = a + b */
+    void (*mix) (const float* a, const float* b, float* dst, std::size_t n);
+    /** dst = a + b * gain */
+    void (*mix_gain) (const float* a, const float* b, float gain,
+                      float* dst, std::size_t n);
+    /** dst = a * b */
+    void (*modulate) (const float* a, const float* b,
+                      float* dst, std::size_t n);
+    /** dst = a * b * gain */
+    void (*modulate_gain) (const float* a, const float* b, float gain,
+                           float* dst, std::size_t n);
+    /** dst = a * b + stable * (1 - b) */
+    void (*blend) (const float* a, const float* b, float stable,
+                   float* dst, std::size_t n);
+    /** dst [i] = start + i * slope */
+    void (*ramp) (float* dst, std::size_t n, float start, float slope);
+
+    /**
+     * Convert @a n frames of @a channels planes of floating point
+     * samples to interleaved signed integral samples, like
+     * sound::sample_convert does but clipping the values out of [-1,
+     * 1]. 24 bit samples take three bytes in little endian order.
+     *
+     * When @a dither is not null, TPDF dither of one least
+     * significant bit is added to the 16 and 24 bit samples. The
+     * noise is a function of the value pointed by @a dither, which is
+     * advanced such that consecutive calls continue the sequence.
+     */
+    void (*float_to_int16) (const float* const* src, std::size_t channels,
+                            std::int16_t* dst, std::size_t n,
+                            std::uint32_t* dither);
+    void (*float_to_int24) (const float* const* src, std::size_t channels,
+                            std::uint8_t* dst, std::size_t n,
+                            std::uint32_t* dither);
+    void (*float_to_int32) (const float* const* src, std::size_t channels,
+                            std::int32_t* dst, std::size_t n,
+                            std::uint32_t* dither);
+
+    /**
+     * Convert @a n frames of interleaved signed integral samples to
+     * @a channels planes of floating point samples, like
+     * sound::sample_convert does.
+     */
+    void (*int16_to_float) (const std::int16_t* src, std::size_t channels,
+                            float* const* dst, std::size_t n);
+    void (*int24_to_float) (const std::uint8_t* src, std::size_t channels,
+                            float* const* dst, std::size_t n);
+    void (*int32_to_float) (const std::int32_t* src, std::size_t channels,
+                            float* const* dst, std::size_t n);
+
+    /**
+     * Oscillators generating @a n samples from the phase @a x, that
+     * grows @a speed per sample, scaled by @a ampl. They return the
+     * phase after the last sample, not wrapped.
+     */
+    float (*sawtooth) (float* dst, std::size_t n,
+                       float x, float speed, float ampl);
+    float (*square) (float* dst, std::size_t n,
+                     float x, float speed, float ampl);
+    float (*triangle) (float* dst, std::size_t n,
+                       float x, float speed, float ampl);
+
+    /**
+     * Oscillator reading one cycle of a wave from @a table, which has
+     * @a size samples, a power of two, followed by a copy of the
+     * first one. The samples are linearly interpolated.
+     */
+    float (*wave_table) (const float* table, std::size_t size,
+                         float* dst, std::size_t n,
+                         float x, float speed, float ampl);
+    /**
+     * Like wave_table, but sample @c i is read at the phase @a x [i],
+     * for oscillators whose phase is modulated.
+     */
+    void (*wave_table_phases) (const float* table, std::size_t size,
+                               const float* x, float* dst, std::size_t n,
+                               float ampl);
+
+    /**
+     * Runs @a lanes <= biquad_lanes direct form I biquads in lock
+     * step over @a n samples of the planes @a src into @a dst. @a
+     * coef holds b0, b1, b2, a1 and a2 for every lane, in blocks of
+     * biquad_lanes floats, and @a state likewise holds x[n-1],
+     * x[n-2], y[n-1] and y[n-2], which is updated.
+     */
+    void (*biquad) (const float* coef, float* state,
+                    const float* const* src, float* const* dst,
+                    std::size_t lanes, std::size_t n);
+
+    /**
+     * Fills @a dst with @a n uniform samples in [-1, 1) from the
+     * noise_lanes xorshift generators in @a state, which should not
+     * be zero. Sample i comes from the generator i % noise_lanes.
+     */
+    void (*white_noise) (std::uint32_t* state, float* dst, std::size_t n);
+
+    /**
+     * Filters @a n samples of white noise in @a buf into pink or
+     * brown noise, in place. @a state holds seven floats for the pink
+     * filter and one for the brown one, and is updated.
+     */
+    void (*pink_filter) (float* state, float* buf, std::size_t n);
+    void (*brown_filter) (float* state, float* buf, std::size_t n);
+
+    /**
+     * y += x * h for @a n complex numbers whose real and imaginary
+     * parts are in separate arrays.
+     */
+    void (*complex_mac) (const float* xr, const float* xi,
+                         const float* hr, const float* hi,
+                         float* yr, float* yi, std::size_t n);
+
+    /**
+     * Run the radix-2 butterflies [first, last) of a pass of a
+     * complex FFT, in place, over the real and imaginary parts in @a
+     * re and @a im. The butterflies are grouped by @a half, butterfly
+     * j of a group combining the elements j and j + @a half of its 2
+     * @a half elements with the twiddle j in @a wr and @a wi. The
+     * decimation in time pass multiplies before combining, and the
+     * decimation in frequency one after.
+     */
+    void (*fft_dit_pass) (float* re, float* im,
+                          const float* wr, const float* wi,
+                          std::size_t half,
+                          std::size_t first, std::size_t last);
+    void (*fft_dif_pass) (float* re, float* im,
+                          const float* wr, const float* wi,
+                          std::size_t half,
+                          std::size_t first, std::size_t last);
+
+    /**
+     * Read @a n samples from the ring buffer @a buf, whose size is a
+     * power of two and @a mask that size minus one. Sample i of @a
+     * dst is the one at index @a now + i delayed by @a delay [i]
+     * samples, that is, between the indexes now + i - floor (delay
+     * [i]) and the one before it. They interpolate linearly, with a
+     * Catmull-Rom cubic over the two neighbours at each side, which
+     * requires a delay of at least 1, or with a first order allpass
+     * whose last output is passed in and returned, which requires a
+     * delay of at least 0.5.
+     */
+    void (*delay_linear) (const float* buf, std::size_t mask,
+                          std::size_t now, const float* delay,
+                          float* dst, std::size_t n);
+    void (*delay_cubic) (const float* buf, std::size_t mask,
+                         std::size_t now, const float* delay,
+                         float* dst, std::size_t n);
+    float (*delay_allpass) (const float* buf, std::size_t mask,
+                            std::size_t now, const float* delay,
+                            float* dst, std::size_t n, float last);
+};
+
+/**
+ * Returns the kernels in use. They are selected the first time this
+ * is called, and then every time resolve_kernels () is called.
+ */
+const kernel_table& kernels ();
+
+/**
+ * Selects the kernels for base::current_isa (). This changes the
+ * kernels used by every thread and thus it should be called before
+ * starting the real-time threads, as processor::start does.
+ */
+const kernel_table& resolve_kernels ();
+
+/**
+ * Returns the kernels for the best instruction set that is not
+ * above @a isa and that is compiled in.
+ */
+const kernel_table& kernels_for (base::cpu_isa isa);
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_KERNELS_HPP_ */
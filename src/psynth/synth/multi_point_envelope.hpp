@@ -167,11 +167,9 @@ public:
     value_type update (std::size_t sample);
 
     void update (const range& samples)
-    {
-        generate_frames (samples, [&] () -> value_type {
-                return this->multi_point_envelope::update ();
-            });
-    }
+    { render_envelope (*this, samples); }
+
+    envelope_segment next_segment (std::size_t samples);
 
     bool finished ()
     { return _cur_point >= _val->size() - 1; }
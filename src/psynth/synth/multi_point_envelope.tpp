@@ -31,6 +31,8 @@
 #ifndef PSYNTH_SYNTH_MULTI_POINT_ENVELOPE_TPP_
 #define PSYNTH_SYNTH_MULTI_POINT_ENVELOPE_TPP_
 
+#include <algorithm>
+
 #include <psynth/synth/multi_point_envelope.hpp>
 
 namespace psynth
@@ -84,6 +86,39 @@ multi_point_envelope<R, Vp>::update (std::size_t sample)
     return val;
 }
 
+/**
+ * The first sample is computed like update () does, the rest of the
+ * segment are the samples that fall before the next point.
+ */
+template <class R, class Vp>
+envelope_segment multi_point_envelope<R, Vp>::next_segment (std::size_t samples)
+{
+    typedef typename sound::sample_type<R>::type sample;
+
+    const float start = sample (multi_point_envelope::update (1));
+    const float speed = _val->_factor;
+    const std::size_t last = _val->size () - 1;
+
+    if (_cur_point == last)
+    {
+        _time = 0.0f;
+        return envelope_segment { samples, start, 0.0f };
+    }
+    if (_cur_point > last || speed <= 0.0f || samples == 1)
+        return envelope_segment { 1, start, 0.0f };
+
+    const auto& a = _val->get (_cur_point);
+    const auto& b = _val->get (_cur_point + 1);
+    const float steps = (b.dt - _time) / speed;
+    const std::size_t more = steps < samples - 1 ?
+        std::size_t (std::max (steps, 0.0f)) : samples - 1;
+    _time += more * speed;
+
+    return envelope_segment {
+        more + 1, start,
+        (float (b.val) - float (a.val)) / (b.dt - a.dt) * speed };
+}
+
 } /* namespace synth */
 } /* namespace psynth */
 
@@ -28,19 +28,65 @@
 #ifndef PSYNTH_SYNTH_NOISE_HPP_
 #define PSYNTH_SYNTH_NOISE_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <type_traits>
 
 #include <boost/mpl/if.hpp>
 
 #include <psynth/sound/sample.hpp>
+#include <psynth/synth/kernels.hpp>
 
 namespace psynth
 {
 namespace synth
 {
 
-typedef std::mt19937 default_noise_generator;
+/**
+ * Uniform random bit generator made of noise_lanes xorshift
+ * generators, which fill () advances at once with the white noise
+ * kernel. Drawing single words, it gives the ones of the lanes in
+ * turn. It is not good enough for anything but audio noise.
+ */
+class noise_engine
+{
+public:
+    typedef std::uint32_t result_type;
+
+    static constexpr result_type default_seed = 5489u;
+
+    static constexpr result_type min ()
+    { return 1; }
+
+    static constexpr result_type max ()
+    { return 0xffffffffu; }
+
+    explicit noise_engine (result_type value = default_seed)
+    { seed (value); }
+
+    void seed (result_type value);
+
+    result_type operator() ();
+
+    /**
+     * Fills @a dst with @a n uniform samples in [-1, 1).
+     */
+    void fill (float* dst, std::size_t n)
+    { kernels ().white_noise (_state, dst, n); }
+
+private:
+    std::uint32_t _state [noise_lanes];
+    std::size_t   _next;
+};
+
+typedef noise_engine default_noise_generator;
+
+/**
+ * Number of planes for which the coloured noise distributions keep a
+ * separate filter state, so every channel gets its own noise.
+ */
+const std::size_t max_noise_planes = 2;
 
 template <typename SampleType>
 class white_noise_distribution
@@ -65,6 +111,14 @@ public:
     SampleType operator() (Engine& engine)
     { return _uniform (engine); }
 
+    /**
+     * Fills the plane @a dst with @a n samples, all at once when the
+     * engine is a noise_engine.
+     */
+    template <typename Engine>
+    void fill (Engine& engine, float* dst, std::size_t n,
+               std::size_t plane = 0);
+
 private:
     uniform_distribution_type _uniform;
 };
@@ -81,8 +135,32 @@ public:
     template <typename GenEngine>
     SampleType operator()(GenEngine& gen);
 
+    template <typename Engine>
+    void fill (Engine& engine, float* dst, std::size_t n,
+               std::size_t plane = 0);
+
+private:
+    float _state [max_noise_planes][7];
+};
+
+
+template<typename SampleType>
+class brown_noise_distribution : public white_noise_distribution<SampleType>
+{
+public:
+    brown_noise_distribution();
+    brown_noise_distribution(const brown_noise_distribution&) = default;
+    brown_noise_distribution& operator=(const brown_noise_distribution&) = default;
+
+    template <typename GenEngine>
+    SampleType operator()(GenEngine& gen);
+
+    template <typename Engine>
+    void fill (Engine& engine, float* dst, std::size_t n,
+               std::size_t plane = 0);
+
 private:
-    SampleType _b0, _b1, _b2, _b3, _b4, _b5, _b6;
+    float _state [max_noise_planes];
 };
 
 
@@ -133,7 +211,11 @@ class white_noise : public noise<white_noise_distribution<SampleType>, Generator
 {};
 
 template<typename SampleType, typename Generator = default_noise_generator>
-class pink_noise : public noise<white_noise_distribution<SampleType>, Generator>
+class pink_noise : public noise<pink_noise_distribution<SampleType>, Generator>
+{};
+
+template<typename SampleType, typename Generator = default_noise_generator>
+class brown_noise : public noise<brown_noise_distribution<SampleType>, Generator>
 {};
 
 
@@ -31,36 +31,114 @@
 #ifndef PSYNTH_SYNTH_NOISE_TPP_
 #define PSYNTH_SYNTH_NOISE_TPP_
 
+#include <cassert>
+
 #include <psynth/synth/noise.hpp>
 
 #include <psynth/sound/algorithm.hpp>
 #include <psynth/sound/channel_base_algorithm.hpp>
+#include <psynth/sound/simd.hpp>
 
 namespace psynth
 {
 namespace synth
 {
 
-template <class D, class G>
-template <class Range>
-void noise<D, G>::update (const Range& out_buf)
+inline void noise_engine::seed (result_type value)
+{
+    for (std::size_t l = 0; l < noise_lanes; ++l)
+    {
+        std::uint32_t x = value + std::uint32_t (l + 1) * 0x9e3779b9u;
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        _state [l] = x ? x : 1;
+    }
+    _next = 0;
+}
+
+inline noise_engine::result_type noise_engine::operator() ()
+{
+    std::uint32_t x = _state [_next];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _state [_next] = x;
+    _next = (_next + 1) % noise_lanes;
+    return x;
+}
+
+namespace detail
+{
+
+template <class Sample, class Engine>
+void fill_uniform (white_noise_distribution<Sample>& d, Engine& engine,
+                   float* dst, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        dst [i] = float (d (engine));
+}
+
+template <class Sample>
+void fill_uniform (white_noise_distribution<Sample>& d, noise_engine& engine,
+                   float* dst, std::size_t n)
+{
+    engine.fill (dst, n);
+}
+
+template <class Range, class D, class G>
+void noise_update (const Range& out, D& d, G& g, sound::detail::no_simd_tag)
 {
     typedef typename Range::value_type outval;
 
-    sound::generate_frames(out_buf, [&]() -> outval {
+    sound::generate_frames(out, [&]() -> outval {
             typedef typename sound::sample_type<outval>::type sample;
             outval result;
             sound::static_generate(result, [&]() -> sample {
-                    return _distribution(this->_generator);
+                    return d(g);
                 });
             return result;
         });
 }
 
+template <class Range, class D, class G>
+void noise_update (const Range& out, D& d, G& g, sound::detail::mono_simd_tag)
+{
+    d.fill (g, sound::detail::simd_ptr (out.begin ()), out.size (), 0);
+}
+
+template <class Range, class D, class G>
+void noise_update (const Range& out, D& d, G& g,
+                   sound::detail::stereo_planar_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    d.fill (g, simd_ptr (sound::at_c<0> (out.begin ())), out.size (), 0);
+    d.fill (g, simd_ptr (sound::at_c<1> (out.begin ())), out.size (), 1);
+}
+
+} /* namespace detail */
+
+template <class D, class G>
+template <class Range>
+void noise<D, G>::update (const Range& out_buf)
+{
+    typedef typename sound::detail::simd_range_tag<Range>::type simd_tag;
+    detail::noise_update (out_buf, _distribution, _generator, simd_tag ());
+}
+
+template <class Sample>
+template <class Engine>
+void white_noise_distribution<Sample>::fill (Engine& engine, float* dst,
+                                             std::size_t n, std::size_t plane)
+{
+    detail::fill_uniform (*this, engine, dst, n);
+}
 
 template <class Sample>
 pink_noise_distribution<Sample>::pink_noise_distribution()
-    : _b0 (.0f), _b1 (.0f), _b2 (.0f), _b3 (.0f), _b4 (.0f), _b5 (.0f), _b6 (.0f)
+    : _state {}
 {
 }
 
@@ -68,20 +146,44 @@ template <class Sample>
 template <class Engine>
 Sample pink_noise_distribution<Sample>::operator()(Engine& engine)
 {
-    Sample white = 0.2 * white_noise_distribution<Sample>::operator()(engine);
+    float x = white_noise_distribution<Sample>::operator()(engine);
+    kernels ().pink_filter (_state [0], &x, 1);
+    return Sample (x);
+}
 
-    _b0 = 0.99886f * _b0 + white * 0.0555179f;
-    _b1 = 0.99332f * _b1 + white * 0.0750759f;
-    _b2 = 0.96900f * _b2 + white * 0.1538520f;
-    _b3 = 0.86650f * _b3 + white * 0.3104856f;
-    _b4 = 0.55000f * _b4 + white * 0.5329522f;
-    _b5 = -0.7616f * _b5 - white * 0.0168980f;
+template <class Sample>
+template <class Engine>
+void pink_noise_distribution<Sample>::fill (Engine& engine, float* dst,
+                                            std::size_t n, std::size_t plane)
+{
+    assert (plane < max_noise_planes);
+    white_noise_distribution<Sample>::fill (engine, dst, n);
+    kernels ().pink_filter (_state [plane], dst, n);
+}
 
-    Sample pink = _b0 + _b1 + _b2 + _b3 + _b4 + _b5 + _b6 + white * 0.5362f;
+template <class Sample>
+brown_noise_distribution<Sample>::brown_noise_distribution()
+    : _state {}
+{
+}
 
-    _b6 = white * 0.115926f;
+template <class Sample>
+template <class Engine>
+Sample brown_noise_distribution<Sample>::operator()(Engine& engine)
+{
+    float x = white_noise_distribution<Sample>::operator()(engine);
+    kernels ().brown_filter (_state, &x, 1);
+    return Sample (x);
+}
 
-    return pink;
+template <class Sample>
+template <class Engine>
+void brown_noise_distribution<Sample>::fill (Engine& engine, float* dst,
+                                             std::size_t n, std::size_t plane)
+{
+    assert (plane < max_noise_planes);
+    white_noise_distribution<Sample>::fill (engine, dst, n);
+    kernels ().brown_filter (_state + plane, dst, n);
 }
 
 } /* namespace synth */
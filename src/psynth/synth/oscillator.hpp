@@ -15,7 +15,8 @@
 #include <cmath>
 #include <psynth/base/misc.hpp>
 #include <psynth/sound/typedefs.hpp>
-#include <psynth/synth/wave_table.hpp>
+#include <psynth/synth/fast_math.hpp>
+#include <psynth/synth/wave_tables.hpp>
 
 namespace psynth
 {
@@ -29,7 +30,7 @@ struct sine_generator
 {
     PSYNTH_FORCEINLINE sound::bits32sf
     operator () (float x)
-    { return std::sin (2 * M_PI * x); }
+    { return fast_sin_cycles (x); }
 };
 
 struct square_generator
@@ -87,13 +88,17 @@ struct exp_generator
 };
 
 
+/**
+ * An oscillator playing the wave of @a Generator. When @a wave_table
+ * is true, which is the default, it reads the wave from a
+ * band-limited table shared by every oscillator with the same
+ * generator, that does not alias at high frequencies. Otherwise the
+ * generator is evaluated for every sample.
+ */
 template <class Generator = sine_generator>
 class oscillator
 {
 public:
-    /** @todo Parametrize? */
-    static const std::size_t default_table_size = 1 << 12;
-
     oscillator (std::size_t frame_rate,
                 float       freq       = 220.0f,
 		float       ampl       = 1.0f,
@@ -107,8 +112,8 @@ public:
         , _phase (phase)
         , _wave_table (wave_table)
     {
-	if (wave_table && !s_table_init)
-	    initialize_table ();
+	if (wave_table)
+	    table ();
     }
 
     void restart ()
@@ -128,8 +133,8 @@ public:
 
     void set_wave_table (bool wave_table)
     {
-	if (wave_table && !s_table_init)
-	    initialize_table ();
+	if (wave_table)
+	    table ();
 	_wave_table = wave_table;
     }
 
@@ -145,9 +150,25 @@ public:
     template <class Range1, class Range2>
     void update_am (const Range1& out_buf, const Range2& mod_buf);
 
+    /**
+     * Returns the table of the generator. The generators in this file
+     * use the standard tables of initialize_wave_tables (), any other
+     * is built the first time this is called.
+     */
+    static const band_limited_table& table ();
+
 private:
-    static wave_table<sound::mono32sf_buffer> s_wave_table;
-    static bool                               s_table_init;
+    template <class Range1, class Wave>
+    void generate (const Range1& out_buf, Wave wave);
+
+    template <class Range1, class Range2, class Wave>
+    void generate_fm (const Range1& out_buf, const Range2& mod_buf, Wave wave);
+
+    template <class Range1, class Range2, class Wave>
+    void generate_pm (const Range1& out_buf, const Range2& mod_buf, Wave wave);
+
+    template <class Range1, class Range2, class Wave>
+    void generate_am (const Range1& out_buf, const Range2& mod_buf, Wave wave);
 
     Generator   _gen;
     std::size_t _frame_rate;
@@ -157,8 +178,6 @@ private:
     float       _ampl;
     float       _phase;
     bool        _wave_table;
-
-    void initialize_table ();
 };
 
 } /* namespace synth */
@@ -32,6 +32,8 @@
 #ifndef PSYNTH_SYNTH_OSCILLATOR_TPP_
 #define PSYNTH_SYNTH_OSCILLATOR_TPP_
 
+#include <psynth/sound/simd.hpp>
+#include <psynth/synth/kernels.hpp>
 #include <psynth/synth/oscillator.hpp>
 
 namespace psynth
@@ -39,47 +41,327 @@ namespace psynth
 namespace synth
 {
 
-template <typename G>
-wave_table<sound::mono32sf_buffer> oscillator<G>::s_wave_table;
+namespace detail
+{
+
+typedef float (*oscillator_kernel_fn) (float*, std::size_t,
+                                       float, float, float);
+
+/**
+ * Gives the kernel that computes the same samples than the generator
+ * @a G, if any.
+ */
+template <class G>
+struct oscillator_kernel
+{ static oscillator_kernel_fn get () { return 0; } };
 
-template <typename G>
-bool oscillator<G>::s_table_init = false;
+template <>
+struct oscillator_kernel<sawtooth_generator>
+{ static oscillator_kernel_fn get () { return kernels ().sawtooth; } };
 
+template <>
+struct oscillator_kernel<square_generator>
+{ static oscillator_kernel_fn get () { return kernels ().square; } };
+
+template <>
+struct oscillator_kernel<triangle_generator>
+{ static oscillator_kernel_fn get () { return kernels ().triangle; } };
 
 /**
- * @todo This is not reentrant!
+ * Reads a level of a band-limited table chosen for the phase growing
+ * @a speed per sample.
+ */
+struct table_wave
+{
+    const band_limited_table* table;
+    const float*              level;
+
+    table_wave (const band_limited_table& t, float speed)
+        : table (&t)
+        , level (t.level (t.level_for (speed)))
+    {}
+
+    PSYNTH_FORCEINLINE float operator () (float x) const
+    { return table->get (level, x); }
+};
+
+/**
+ * Gives the band-limited table of the generator @a G.
  */
 template <class G>
-void oscillator<G>::initialize_table ()
+struct generator_table
+{
+    static const band_limited_table& get ()
+    {
+        static const band_limited_table t ((G ()));
+        return t;
+    }
+};
+
+template <>
+struct generator_table<sine_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::sine); } };
+
+template <>
+struct generator_table<square_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::square); } };
+
+template <>
+struct generator_table<triangle_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::triangle); } };
+
+template <>
+struct generator_table<sawtooth_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::sawtooth); } };
+
+template <>
+struct generator_table<moogsaw_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::moogsaw); } };
+
+template <>
+struct generator_table<exp_generator>
+{ static const band_limited_table& get ()
+    { return standard_table (standard_wave::exp); } };
+
+template <class Range, class Kernel>
+bool oscillator_kernel_update (const Range& out, float& x,
+                               float speed, float ampl, Kernel kernel,
+                               sound::detail::no_simd_tag)
 {
-    s_wave_table.fill (default_table_size, _gen);
-    s_table_init = true;
+    return false;
+}
+
+template <class Range, class Kernel>
+bool oscillator_kernel_update (const Range& out, float& x,
+                               float speed, float ampl, Kernel kernel,
+                               sound::detail::mono_simd_tag)
+{
+    x = kernel (sound::detail::simd_ptr (out.begin ()), out.size (),
+                x, speed, ampl);
+    return true;
+}
+
+template <class Range, class Kernel>
+bool oscillator_kernel_update (const Range& out, float& x,
+                               float speed, float ampl, Kernel kernel,
+                               sound::detail::stereo_planar_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    x = kernel (simd_ptr (sound::at_c<0> (out.begin ())), out.size (),
+                x, speed, ampl);
+    sound::simd::copy (simd_ptr (sound::at_c<0> (out.begin ())),
+                       simd_ptr (sound::at_c<1> (out.begin ())),
+                       out.size ());
+    return true;
+}
+
+/**
+ * Number of phases that the modulated oscillators compute before
+ * reading them from the table at once.
+ */
+constexpr std::size_t modulated_chunk_size = 64;
+
+template <class Range1, class Range2, class Kernel, class Tag1, class Tag2>
+bool oscillator_modulated_update (const Range1& out, const Range2& mod,
+                                  Kernel kernel, Tag1, Tag2)
+{
+    return false;
+}
+
+template <class Range1, class Range2, class Kernel>
+bool oscillator_modulated_update (const Range1& out, const Range2& mod,
+                                  Kernel kernel,
+                                  sound::detail::mono_simd_tag,
+                                  sound::detail::mono_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    kernel (simd_ptr (out.begin ()), simd_ptr (mod.begin ()), out.size ());
+    return true;
+}
+
+template <class Range1, class Range2, class Kernel>
+bool oscillator_modulated_update (const Range1& out, const Range2& mod,
+                                  Kernel kernel,
+                                  sound::detail::stereo_planar_simd_tag,
+                                  sound::detail::mono_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    kernel (simd_ptr (sound::at_c<0> (out.begin ())),
+            simd_ptr (mod.begin ()), out.size ());
+    sound::simd::copy (simd_ptr (sound::at_c<0> (out.begin ())),
+                       simd_ptr (sound::at_c<1> (out.begin ())),
+                       out.size ());
+    return true;
+}
+
+} /* namespace detail */
+
+template <class G>
+const band_limited_table& oscillator<G>::table ()
+{
+    return detail::generator_table<G>::get ();
 }
 
 template <class G>
 template <class Range1>
 void oscillator<G>::update (const Range1& out_buf)
+{
+    typedef typename sound::detail::simd_range_tag<Range1>::type simd_tag;
+
+    if (_wave_table)
+    {
+        const band_limited_table& t = table ();
+        auto kernel = [&] (float* dst, std::size_t n,
+                           float x, float speed, float ampl) {
+            return t.update (dst, n, x, speed, ampl);
+        };
+        if (!detail::oscillator_kernel_update (
+                out_buf, _x, _speed, _ampl, kernel, simd_tag ()))
+            generate (out_buf, detail::table_wave (t, _speed));
+    }
+    else
+    {
+        const auto kernel = detail::oscillator_kernel<G>::get ();
+        if (!kernel || !detail::oscillator_kernel_update (
+                out_buf, _x, _speed, _ampl, kernel, simd_tag ()))
+            generate (out_buf, _gen);
+    }
+
+    _x = base::phase (_x);
+}
+
+/**
+ * The modulator is expected to be in [-1, 1], so the frequency goes
+ * up to twice the carrier and the table is chosen for that.
+ *
+ * With the wave table, the modulated updates compute the phases of a
+ * chunk of samples and then read them from the table with the
+ * vectorized kernel.
+ */
+template <class G>
+template <class Range1, class Range2>
+void oscillator<G>::update_fm (const Range1& out_buf, const Range2& mod_buf)
+{
+    typedef typename sound::detail::simd_range_tag<Range1>::type out_tag;
+    typedef typename sound::detail::simd_range_tag<Range2>::type mod_tag;
+    using detail::modulated_chunk_size;
+
+    if (_wave_table)
+    {
+        const band_limited_table& t = table ();
+        auto kernel = [&] (float* dst, const float* mod, std::size_t n) {
+            float xs [modulated_chunk_size];
+            float x = this->_x;
+            for (std::size_t i = 0; i < n; i += modulated_chunk_size)
+            {
+                const std::size_t m = n - i < modulated_chunk_size ?
+                    n - i : modulated_chunk_size;
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    xs [j] = x;
+                    x += (this->_freq + this->_freq * mod [i + j])
+                        / this->_frame_rate;
+                }
+                t.update_phases (xs, dst + i, m,
+                                 2 * this->_speed, this->_ampl);
+            }
+            this->_x = base::phase (x);
+        };
+        if (!detail::oscillator_modulated_update (
+                out_buf, mod_buf, kernel, out_tag (), mod_tag ()))
+            generate_fm (out_buf, mod_buf, detail::table_wave (t, 2 * _speed));
+    }
+    else
+        generate_fm (out_buf, mod_buf, _gen);
+}
+
+template <class G>
+template <class Range1, class Range2>
+void oscillator<G>::update_pm (const Range1& out_buf, const Range2& mod_buf)
+{
+    typedef typename sound::detail::simd_range_tag<Range1>::type out_tag;
+    typedef typename sound::detail::simd_range_tag<Range2>::type mod_tag;
+    using detail::modulated_chunk_size;
+
+    if (_wave_table)
+    {
+        const band_limited_table& t = table ();
+        auto kernel = [&] (float* dst, const float* mod, std::size_t n) {
+            float xs [modulated_chunk_size];
+            float x = this->_x;
+            for (std::size_t i = 0; i < n; i += modulated_chunk_size)
+            {
+                const std::size_t m = n - i < modulated_chunk_size ?
+                    n - i : modulated_chunk_size;
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    xs [j] = x + mod [i + j];
+                    x += this->_speed;
+                }
+                t.update_phases (xs, dst + i, m, this->_speed, this->_ampl);
+            }
+            this->_x = base::phase (x);
+        };
+        if (!detail::oscillator_modulated_update (
+                out_buf, mod_buf, kernel, out_tag (), mod_tag ()))
+            generate_pm (out_buf, mod_buf, detail::table_wave (t, _speed));
+    }
+    else
+        generate_pm (out_buf, mod_buf, _gen);
+}
+
+template <class G>
+template <class Range1, class Range2>
+void oscillator<G>::update_am (const Range1& out_buf, const Range2& mod_buf)
+{
+    typedef typename sound::detail::simd_range_tag<Range1>::type out_tag;
+    typedef typename sound::detail::simd_range_tag<Range2>::type mod_tag;
+
+    if (_wave_table)
+    {
+        const band_limited_table& t = table ();
+        auto kernel = [&] (float* dst, const float* mod, std::size_t n) {
+            this->_x = base::phase (
+                t.update (dst, n, this->_x, this->_speed, this->_ampl));
+            kernels ().modulate (dst, mod, dst, n);
+        };
+        if (!detail::oscillator_modulated_update (
+                out_buf, mod_buf, kernel, out_tag (), mod_tag ()))
+            generate_am (out_buf, mod_buf, detail::table_wave (t, _speed));
+    }
+    else
+        generate_am (out_buf, mod_buf, _gen);
+}
+
+template <class G>
+template <class Range1, class Wave>
+void oscillator<G>::generate (const Range1& out_buf, Wave wave)
 {
     typedef typename Range1::value_type frame_type;
 
     generate_frames (out_buf, [&] () -> frame_type {
-            frame_type ret { this->_gen (this->_x) * this->_ampl };
+            frame_type ret { wave (this->_x) * this->_ampl };
             this->_x += this->_speed;
             return ret;
         });
-
-    _x = base::phase (_x);
 }
 
 template <class G>
-template <class Range1, class Range2>
-void oscillator<G>::update_fm (const Range1& out_buf, const Range2& mod_buf)
+template <class Range1, class Range2, class Wave>
+void oscillator<G>::generate_fm (const Range1& out_buf,
+                                 const Range2& mod_buf,
+                                 Wave wave)
 {
     typedef typename Range2::value_type modval;
     typedef typename Range1::value_type outval;
 
     transform_frames (mod_buf, out_buf, [&] (modval m) -> outval {
-            auto ret = this->_gen (this->_x) * this->_ampl;
+            auto ret = wave (this->_x) * this->_ampl;
             this->_x += (this->_freq + this->_freq * (sound::bits32sf) (m))
                 / this->_frame_rate;
             return outval { ret };
@@ -88,14 +370,16 @@ void oscillator<G>::update_fm (const Range1& out_buf, const Range2& mod_buf)
 }
 
 template <class G>
-template <class Range1, class Range2>
-void oscillator<G>::update_pm (const Range1& out_buf, const Range2& mod_buf)
+template <class Range1, class Range2, class Wave>
+void oscillator<G>::generate_pm (const Range1& out_buf,
+                                 const Range2& mod_buf,
+                                 Wave wave)
 {
     typedef typename Range2::value_type modval;
     typedef typename Range1::value_type outval;
 
     transform_frames (mod_buf, out_buf, [&] (modval m) -> outval {
-            auto ret = this->_gen (this->_x + (sound::bits32sf) m) * this->_ampl;
+            auto ret = wave (this->_x + (sound::bits32sf) m) * this->_ampl;
             this->_x += this->_speed;
             return outval { ret };
         });
@@ -103,14 +387,16 @@ void oscillator<G>::update_pm (const Range1& out_buf, const Range2& mod_buf)
 }
 
 template <class G>
-template <class Range1, class Range2>
-void oscillator<G>::update_am (const Range1& out_buf, const Range2& mod_buf)
+template <class Range1, class Range2, class Wave>
+void oscillator<G>::generate_am (const Range1& out_buf,
+                                 const Range2& mod_buf,
+                                 Wave wave)
 {
     typedef typename Range2::value_type modval;
     typedef typename Range1::value_type outval;
 
     transform_frames (mod_buf, out_buf, [&] (modval m) -> outval {
-            auto ret = this->_gen (this->_x) * this->_ampl * (sound::bits32sf) m;
+            auto ret = wave (this->_x) * this->_ampl * (sound::bits32sf) m;
             this->_x += this->_speed;
             return outval { ret };
         });
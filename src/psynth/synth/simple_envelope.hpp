@@ -109,19 +109,33 @@ public:
     }
 
     void update (const range& samples)
-    {
-        sound::generate_frames (samples, [&] () -> value_type {
-                return this->simple_envelope::update ();
-            });
-    }
+    { render_envelope (*this, samples); }
 
     template <class Range2>
     void update (const Range2& samples)
+    { render_envelope (*this, samples); }
+
+    envelope_segment next_segment (std::size_t samples)
     {
-        sound::generate_frames (samples, [&] () {
-                return typename Range2::value_type (
-                    this->simple_envelope::update ());
-            });
+        const float one  = sound::sample_traits<sample_type>::max_value ();
+        const float zero = sound::sample_traits<sample_type>::zero_value ();
+        const float val  = _val;
+
+        /* The samples stay linear until one of them reaches a bound,
+         * that sample is the last of the segment. */
+        std::size_t size = samples;
+        float steps = samples;
+        if (_curr_dt > 0.0f && val < one)
+            steps = (one - val) / _curr_dt;
+        else if (_curr_dt < 0.0f && val > zero)
+            steps = (val - zero) / -_curr_dt;
+        else
+            return envelope_segment { samples, val, 0.0f };
+        if (steps < samples)
+            size = std::size_t (steps) + 1;
+
+        simple_envelope::update (size);
+        return envelope_segment { size, val, _curr_dt };
     }
 
     void press ()
@@ -0,0 +1,198 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        state_variable_filter.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Block based state variable filter.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "synth/fast_math.hpp"
+#include "synth/state_variable_filter.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+namespace
+{
+
+const float min_frequency = 1.0f;
+const float max_frequency_ratio = 0.49f;
+const float min_resonance = 0.01f;
+
+} /* anonymous namespace */
+
+constexpr std::size_t state_variable_filter::control_period;
+
+state_variable_filter::state_variable_filter (std::size_t channels,
+                                              mode        m,
+                                              float       frequency,
+                                              float       resonance,
+                                              float       frame_rate)
+    : _state (channels, state { 0.0f, 0.0f })
+    , _mode (m)
+    , _frequency (frequency)
+    , _resonance (resonance)
+    , _frame_rate (frame_rate)
+    , _dirty (false)
+{
+    _coef = _target = compute (_frequency);
+}
+
+void state_variable_filter::reset ()
+{
+    std::fill (_state.begin (), _state.end (), state { 0.0f, 0.0f });
+}
+
+/**
+ * The coefficients of the trapezoidal integrators, after the notation
+ * of Andrew Simper's "Linear trapezoidal integrated SVF".
+ */
+state_variable_filter::coefficients
+state_variable_filter::compute (float frequency) const
+{
+    const float f = std::min (std::max (frequency, min_frequency),
+                              max_frequency_ratio * _frame_rate);
+    const float g = fast_tan (float (M_PI) * f / _frame_rate);
+    const float k = 1.0f / std::max (_resonance, min_resonance);
+
+    coefficients c;
+    c.k  = k;
+    c.a1 = 1.0f / (1.0f + g * (g + k));
+    c.a2 = g * c.a1;
+    c.a3 = g * c.a2;
+    return c;
+}
+
+/**
+ * Every mode is a mix of the input and the band and low pass outputs,
+ * out = m0 * v0 + mk * k * v1 + m2 * v2, so the loop has no branches.
+ * The band pass is normalized to 0dB at the cutoff.
+ */
+template <bool Ramp>
+void state_variable_filter::process (const float* const* in,
+                                     float* const* out,
+                                     std::size_t offset, std::size_t n,
+                                     coefficients from,
+                                     const coefficients& step)
+{
+    static const float mixes [][3] = {
+        { 0.0f,  0.0f,  1.0f }, // lowpass
+        { 1.0f, -1.0f, -1.0f }, // highpass
+        { 0.0f,  1.0f,  0.0f }, // bandpass
+        { 1.0f, -1.0f,  0.0f }  // notch
+    };
+    const float* mix = mixes [std::size_t (_mode)];
+    const float m0 = mix [0], mk = mix [1], m2 = mix [2];
+
+    for (std::size_t c = 0; c < _state.size (); ++c)
+    {
+        const float* src = in [c] + offset;
+        float*       dst = out [c] + offset;
+        float ic1 = _state [c].ic1;
+        float ic2 = _state [c].ic2;
+        coefficients k = from;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (Ramp)
+            {
+                k.a1 += step.a1;
+                k.a2 += step.a2;
+                k.a3 += step.a3;
+                k.k  += step.k;
+            }
+
+            const float v0 = src [i];
+            const float v3 = v0 - ic2;
+            const float v1 = k.a1 * ic1 + k.a2 * v3;
+            const float v2 = ic2 + k.a2 * ic1 + k.a3 * v3;
+            ic1 = 2.0f * v1 - ic1;
+            ic2 = 2.0f * v2 - ic2;
+            dst [i] = m0 * v0 + mk * k.k * v1 + m2 * v2;
+        }
+
+        _state [c].ic1 = ic1;
+        _state [c].ic2 = ic2;
+    }
+}
+
+void state_variable_filter::ramp (const float* const* in, float* const* out,
+                                  std::size_t offset, std::size_t n,
+                                  const coefficients& target)
+{
+    const float inv = 1.0f / n;
+    coefficients step;
+    step.a1 = (target.a1 - _coef.a1) * inv;
+    step.a2 = (target.a2 - _coef.a2) * inv;
+    step.a3 = (target.a3 - _coef.a3) * inv;
+    step.k  = (target.k  - _coef.k)  * inv;
+    process<true> (in, out, offset, n, _coef, step);
+    _coef = target;
+}
+
+void state_variable_filter::update_planes (const float* const* in,
+                                           float* const* out,
+                                           std::size_t n)
+{
+    if (_dirty)
+    {
+        _target = compute (_frequency);
+        _dirty = false;
+    }
+
+    std::size_t offset = 0;
+    if (_coef.a1 != _target.a1 || _coef.k != _target.k)
+    {
+        offset = std::min (n, control_period);
+        if (offset)
+            ramp (in, out, 0, offset, _target);
+    }
+
+    process<false> (in, out, offset, n - offset, _coef, _coef);
+}
+
+void state_variable_filter::update_planes (const float* const* in,
+                                           float* const* out,
+                                           const float* mod,
+                                           std::size_t n)
+{
+    for (std::size_t offset = 0; offset < n; offset += control_period)
+    {
+        const std::size_t len = std::min (control_period, n - offset);
+        const float m = mod [offset + len - 1];
+        ramp (in, out, offset, len, compute (_frequency * (1.0f + m)));
+    }
+
+    _dirty = true;
+}
+
+} /* namespace synth */
+} /* namespace psynth */
@@ -0,0 +1,158 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        state_variable_filter.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Block based state variable filter.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PSYNTH_SYNTH_STATE_VARIABLE_FILTER_HPP_
+#define PSYNTH_SYNTH_STATE_VARIABLE_FILTER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * A state variable filter in the topology preserving transform
+ * form. Unlike the direct form biquads of filter.hpp it stays stable
+ * and free of zipper noise when the cutoff changes every sample, so
+ * it can be modulated at audio rate.
+ *
+ * It filters whole blocks of planar channels. When the cutoff is
+ * modulated the coefficients are computed once every control_period
+ * samples and linearly interpolated in between.
+ */
+class state_variable_filter
+{
+public:
+    enum class mode
+    {
+        lowpass,
+        highpass,
+        bandpass,
+        notch
+    };
+
+    static constexpr std::size_t control_period = 16;
+
+    /**
+     * The @a resonance is the Q factor, 0.7071 gives a flat
+     * Butterworth response.
+     */
+    explicit state_variable_filter (std::size_t channels   = 1,
+                                    mode        m          = mode::lowpass,
+                                    float       frequency  = 220.0f,
+                                    float       resonance  = 0.7071f,
+                                    float       frame_rate = 44100.0f);
+
+    void set_mode (mode m)
+    { _mode = m; }
+
+    void set_frequency (float frequency)
+    { _frequency = frequency; _dirty = true; }
+
+    void set_resonance (float resonance)
+    { _resonance = resonance; _dirty = true; }
+
+    void set_frame_rate (float frame_rate)
+    { _frame_rate = frame_rate; _dirty = true; }
+
+    /**
+     * Clears the state of every channel.
+     */
+    void reset ();
+
+    /**
+     * Filters @a n samples of every channel from @a in to @a out,
+     * which may be the same planes. Parameter changes are smoothed
+     * over the first control period.
+     */
+    void update_planes (const float* const* in, float* const* out,
+                        std::size_t n);
+
+    /**
+     * Like update_planes (), with the cutoff of sample @c i being
+     * frequency * (1 + mod [i]).
+     */
+    void update_planes (const float* const* in, float* const* out,
+                        const float* mod, std::size_t n);
+
+    /**
+     * Filters the range @a in into @a out, optionally modulating the
+     * cutoff with @a mod like update_planes (). The ranges must be
+     * mono or planar stereo with float samples, with as many channels
+     * as the filter.
+     */
+    template <class InRange, class OutRange>
+    void update (const InRange& in, const OutRange& out);
+
+    template <class InRange, class OutRange, class ModRange>
+    void update (const InRange& in, const OutRange& out,
+                 const ModRange& mod);
+
+private:
+    struct coefficients
+    {
+        float a1, a2, a3, k;
+    };
+
+    struct state
+    {
+        float ic1, ic2;
+    };
+
+    coefficients compute (float frequency) const;
+
+    template <bool Ramp>
+    void process (const float* const* in, float* const* out,
+                  std::size_t offset, std::size_t n,
+                  coefficients from, const coefficients& step);
+
+    void ramp (const float* const* in, float* const* out,
+               std::size_t offset, std::size_t n,
+               const coefficients& target);
+
+    std::vector<state> _state;
+    mode         _mode;
+    float        _frequency;
+    float        _resonance;
+    float        _frame_rate;
+    bool         _dirty;
+    coefficients _coef;
+    coefficients _target;
+};
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#include <psynth/synth/state_variable_filter.tpp>
+
+#endif /* PSYNTH_SYNTH_STATE_VARIABLE_FILTER_HPP_ */
@@ -0,0 +1,78 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        state_variable_filter.tpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Block based state variable filter.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PSYNTH_SYNTH_STATE_VARIABLE_FILTER_TPP_
+#define PSYNTH_SYNTH_STATE_VARIABLE_FILTER_TPP_
+
+#include <cassert>
+
+#include <psynth/synth/state_variable_filter.hpp>
+#include <psynth/synth/util.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+template <class InRange, class OutRange>
+void state_variable_filter::update (const InRange& in, const OutRange& out)
+{
+    const float* in_planes [2];
+    float*       out_planes [2];
+    assert (sound::num_samples<InRange>::value == _state.size ());
+    assert (sound::num_samples<OutRange>::value == _state.size ());
+    assert (in.size () == out.size ());
+    detail::range_planes (in, in_planes);
+    detail::range_planes (out, out_planes);
+    update_planes (in_planes, out_planes, out.size ());
+}
+
+template <class InRange, class OutRange, class ModRange>
+void state_variable_filter::update (const InRange& in, const OutRange& out,
+                                    const ModRange& mod)
+{
+    const float* in_planes [2];
+    float*       out_planes [2];
+    const float* mod_plane [1];
+    assert (sound::num_samples<InRange>::value == _state.size ());
+    assert (sound::num_samples<OutRange>::value == _state.size ());
+    assert (sound::num_samples<ModRange>::value == 1);
+    assert (in.size () == out.size () && mod.size () == out.size ());
+    detail::range_planes (in, in_planes);
+    detail::range_planes (out, out_planes);
+    detail::range_planes (mod, mod_plane);
+    update_planes (in_planes, out_planes, mod_plane [0], out.size ());
+}
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_STATE_VARIABLE_FILTER_TPP_ */
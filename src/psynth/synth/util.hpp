@@ -33,8 +33,14 @@
 #ifndef PSYNTH_SYNTH_UTIL_H_
 #define PSYNTH_SYNTH_UTIL_H_
 
+#include <cassert>
+#include <cstdint>
+
 #include <psynth/sound/forwards.hpp>
+#include <psynth/sound/typedefs.hpp>
 #include <psynth/sound/algorithm.hpp>
+#include <psynth/sound/simd.hpp>
+#include <psynth/synth/kernels.hpp>
 
 namespace psynth
 {
@@ -59,8 +65,76 @@ std::size_t find_hill (const Range& data, std::size_t start)
     return start;
 }
 
+namespace detail
+{
+
+/**
+ * The sound::detail::simd_range_tag shared by three ranges, or
+ * sound::detail::no_simd_tag if they can not be processed by the
+ * kernels in synth/kernels.hpp.
+ */
+template <class R1, class R2, class R3,
+          class Tag = typename sound::detail::simd_range_pair_tag<R1, R3>::type,
+          class Tag2 = typename sound::detail::simd_range_tag<R2>::type>
+struct kernel_range_tag
+{ typedef sound::detail::no_simd_tag type; };
+
+template <class R1, class R2, class R3, class Tag>
+struct kernel_range_tag<R1, R2, R3, Tag, Tag>
+{ typedef Tag type; };
+
+/**
+ * Stores the pointers to the one or two planes of @a r, which should
+ * be processable by the kernels, in @a planes.
+ */
+template <class Range, class Ptr>
+void range_planes (const Range& r, Ptr* planes, sound::detail::mono_simd_tag)
+{
+    planes [0] = sound::detail::simd_ptr (r.begin ());
+}
+
+template <class Range, class Ptr>
+void range_planes (const Range& r, Ptr* planes,
+                   sound::detail::stereo_planar_simd_tag)
+{
+    planes [0] = sound::detail::simd_ptr (sound::at_c<0> (r.begin ()));
+    planes [1] = sound::detail::simd_ptr (sound::at_c<1> (r.begin ()));
+}
+
+template <class Range, class Ptr>
+void range_planes (const Range& r, Ptr* planes)
+{
+    typedef typename sound::detail::simd_range_tag<Range>::type tag;
+    range_planes (r, planes, tag ());
+}
+
+template <class R1, class R2, class R3, class Kernel>
+void apply_kernel (const R1& src1, const R2& src2, const R3& dst,
+                   Kernel kernel, sound::detail::mono_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    assert (src1.size () == dst.size () && src2.size () == dst.size ());
+    kernel (simd_ptr (src1.begin ()), simd_ptr (src2.begin ()),
+            simd_ptr (dst.begin ()), dst.size ());
+}
+
+template <class R1, class R2, class R3, class Kernel>
+void apply_kernel (const R1& src1, const R2& src2, const R3& dst,
+                   Kernel kernel, sound::detail::stereo_planar_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    assert (src1.size () == dst.size () && src2.size () == dst.size ());
+    kernel (simd_ptr (sound::at_c<0> (src1.begin ())),
+            simd_ptr (sound::at_c<0> (src2.begin ())),
+            simd_ptr (sound::at_c<0> (dst.begin ())), dst.size ());
+    kernel (simd_ptr (sound::at_c<1> (src1.begin ())),
+            simd_ptr (sound::at_c<1> (src2.begin ())),
+            simd_ptr (sound::at_c<1> (dst.begin ())), dst.size ());
+}
+
 template <class R1, class R2, class R3>
-void mix (const R1& src1, const R2& src2, const R3& dst)
+void mix_aux (const R1& src1, const R2& src2, const R3& dst,
+              sound::detail::no_simd_tag)
 {
     typedef typename R1::value_type src1_frame;
     typedef typename R2::value_type src2_frame;
@@ -81,7 +155,8 @@ void mix (const R1& src1, const R2& src2, const R3& dst)
 }
 
 template <class R1, class R2, class R3, typename Sample>
-void mix (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
+void mix_aux (const R1& src1, const R2& src2, Sample ampl, const R3& dst,
+              sound::detail::no_simd_tag)
 {
     typedef typename R1::value_type src1_frame;
     typedef typename R2::value_type src2_frame;
@@ -103,7 +178,8 @@ void mix (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
 }
 
 template <class R1, class R2, class R3>
-void modulate (const R1& src1, const R2& src2, const R3& dst)
+void modulate_aux (const R1& src1, const R2& src2, const R3& dst,
+                   sound::detail::no_simd_tag)
 {
     typedef typename R1::value_type src1_frame;
     typedef typename R2::value_type src2_frame;
@@ -124,7 +200,8 @@ void modulate (const R1& src1, const R2& src2, const R3& dst)
 }
 
 template <class R1, class R2, class R3, typename Sample>
-void modulate (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
+void modulate_aux (const R1& src1, const R2& src2, Sample ampl,
+                   const R3& dst, sound::detail::no_simd_tag)
 {
     typedef typename R1::value_type src1_frame;
     typedef typename R2::value_type src2_frame;
@@ -145,9 +222,9 @@ void modulate (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
         });
 }
 
-
 template <class R1, class R2, class R3, typename Sample>
-void blend (const R1& src1, const R2& src2, Sample stable, const R3& dst)
+void blend_aux (const R1& src1, const R2& src2, Sample stable,
+                const R3& dst, sound::detail::no_simd_tag)
 {
     typedef typename R1::value_type src1_frame;
     typedef typename R2::value_type src2_frame;
@@ -171,6 +248,298 @@ void blend (const R1& src1, const R2& src2, Sample stable, const R3& dst)
         });
 }
 
+template <class R1, class R2, class R3, class Tag>
+void mix_aux (const R1& src1, const R2& src2, const R3& dst, Tag tag)
+{
+    apply_kernel (src1, src2, dst, kernels ().mix, tag);
+}
+
+template <class R1, class R2, class R3, typename Sample, class Tag>
+void mix_aux (const R1& src1, const R2& src2, Sample ampl, const R3& dst,
+              Tag tag)
+{
+    const auto kernel = kernels ().mix_gain;
+    const float gain = ampl;
+    apply_kernel (src1, src2, dst,
+                  [=] (const float* a, const float* b,
+                       float* out, std::size_t n) {
+                      kernel (a, b, gain, out, n);
+                  }, tag);
+}
+
+template <class R1, class R2, class R3, class Tag>
+void modulate_aux (const R1& src1, const R2& src2, const R3& dst, Tag tag)
+{
+    apply_kernel (src1, src2, dst, kernels ().modulate, tag);
+}
+
+template <class R1, class R2, class R3, typename Sample, class Tag>
+void modulate_aux (const R1& src1, const R2& src2, Sample ampl,
+                   const R3& dst, Tag tag)
+{
+    const auto kernel = kernels ().modulate_gain;
+    const float gain = ampl;
+    apply_kernel (src1, src2, dst,
+                  [=] (const float* a, const float* b,
+                       float* out, std::size_t n) {
+                      kernel (a, b, gain, out, n);
+                  }, tag);
+}
+
+template <class R1, class R2, class R3, typename Sample, class Tag>
+void blend_aux (const R1& src1, const R2& src2, Sample stable,
+                const R3& dst, Tag tag)
+{
+    const auto kernel = kernels ().blend;
+    const float value = stable;
+    apply_kernel (src1, src2, dst,
+                  [=] (const float* a, const float* b,
+                       float* out, std::size_t n) {
+                      kernel (a, b, value, out, n);
+                  }, tag);
+}
+
+/**
+ * Signed integral interleaved ranges holding the same channels than
+ * the floating point ranges with the given
+ * sound::detail::simd_range_tag, and the raw type the kernels use
+ * for their samples.
+ */
+template <class Iterator>
+struct int_iterator_traits
+{ typedef sound::detail::no_simd_tag type; };
+
+#define PSYNTH_SYNTH_INT_ITERATOR(iter, tag, raw_type)                  \
+    template <>                                                         \
+    struct int_iterator_traits<sound::iter>                             \
+    {                                                                   \
+        typedef sound::detail::tag type;                                \
+        typedef raw_type raw;                                           \
+    };
+
+PSYNTH_SYNTH_INT_ITERATOR (mono16s_ptr,    mono_simd_tag, std::int16_t)
+PSYNTH_SYNTH_INT_ITERATOR (mono16sc_ptr,   mono_simd_tag, std::int16_t)
+PSYNTH_SYNTH_INT_ITERATOR (mono24s_ptr,    mono_simd_tag, std::uint8_t)
+PSYNTH_SYNTH_INT_ITERATOR (mono24sc_ptr,   mono_simd_tag, std::uint8_t)
+PSYNTH_SYNTH_INT_ITERATOR (mono32s_ptr,    mono_simd_tag, std::int32_t)
+PSYNTH_SYNTH_INT_ITERATOR (mono32sc_ptr,   mono_simd_tag, std::int32_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo16s_ptr,  stereo_planar_simd_tag,
+                           std::int16_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo16sc_ptr, stereo_planar_simd_tag,
+                           std::int16_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo24s_ptr,  stereo_planar_simd_tag,
+                           std::uint8_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo24sc_ptr, stereo_planar_simd_tag,
+                           std::uint8_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo32s_ptr,  stereo_planar_simd_tag,
+                           std::int32_t)
+PSYNTH_SYNTH_INT_ITERATOR (stereo32sc_ptr, stereo_planar_simd_tag,
+                           std::int32_t)
+
+#undef PSYNTH_SYNTH_INT_ITERATOR
+
+template <class Src, class Dst,
+          class Tag1 = typename sound::detail::simd_range_tag<Src>::type,
+          class Tag2 = typename int_iterator_traits<
+              typename Dst::iterator>::type>
+struct to_int_tag
+{ typedef sound::detail::no_simd_tag type; };
+
+template <class Src, class Dst, class Tag>
+struct to_int_tag<Src, Dst, Tag, Tag>
+{ typedef Tag type; };
+
+template <class Src, class Dst>
+struct from_int_tag : public to_int_tag<Dst, Src> {};
+
+inline void float_to_int (const float* const* src, std::size_t channels,
+                          std::int16_t* dst, std::size_t n,
+                          std::uint32_t* dither)
+{ kernels ().float_to_int16 (src, channels, dst, n, dither); }
+
+inline void float_to_int (const float* const* src, std::size_t channels,
+                          std::uint8_t* dst, std::size_t n,
+                          std::uint32_t* dither)
+{ kernels ().float_to_int24 (src, channels, dst, n, dither); }
+
+inline void float_to_int (const float* const* src, std::size_t channels,
+                          std::int32_t* dst, std::size_t n,
+                          std::uint32_t* dither)
+{ kernels ().float_to_int32 (src, channels, dst, n, dither); }
+
+inline void int_to_float (const std::int16_t* src, std::size_t channels,
+                          float* const* dst, std::size_t n)
+{ kernels ().int16_to_float (src, channels, dst, n); }
+
+inline void int_to_float (const std::uint8_t* src, std::size_t channels,
+                          float* const* dst, std::size_t n)
+{ kernels ().int24_to_float (src, channels, dst, n); }
+
+inline void int_to_float (const std::int32_t* src, std::size_t channels,
+                          float* const* dst, std::size_t n)
+{ kernels ().int32_to_float (src, channels, dst, n); }
+
+template <class Src, class Dst>
+void convert_frames_aux (const Src& src, const Dst& dst,
+                         std::uint32_t*,
+                         sound::detail::no_simd_tag,
+                         sound::detail::no_simd_tag)
+{
+    sound::copy_and_convert_frames (src, dst);
+}
+
+template <class Src, class Dst>
+void convert_frames_aux (const Src& src, const Dst& dst,
+                         std::uint32_t* dither,
+                         sound::detail::mono_simd_tag,
+                         sound::detail::no_simd_tag)
+{
+    typedef typename int_iterator_traits<
+        typename Dst::iterator>::raw raw_type;
+    assert (src.size () == dst.size ());
+    const float* planes [] = { sound::detail::simd_ptr (src.begin ()) };
+    float_to_int (planes, 1, reinterpret_cast<raw_type*> (dst.begin ()),
+                  dst.size (), dither);
+}
+
+template <class Src, class Dst>
+void convert_frames_aux (const Src& src, const Dst& dst,
+                         std::uint32_t* dither,
+                         sound::detail::stereo_planar_simd_tag,
+                         sound::detail::no_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    typedef typename int_iterator_traits<
+        typename Dst::iterator>::raw raw_type;
+    assert (src.size () == dst.size ());
+    const float* planes [] = {
+        simd_ptr (sound::at_c<0> (src.begin ())),
+        simd_ptr (sound::at_c<1> (src.begin ()))
+    };
+    float_to_int (planes, 2, reinterpret_cast<raw_type*> (dst.begin ()),
+                  dst.size (), dither);
+}
+
+template <class Src, class Dst>
+void convert_frames_aux (const Src& src, const Dst& dst,
+                         std::uint32_t*,
+                         sound::detail::no_simd_tag,
+                         sound::detail::mono_simd_tag)
+{
+    typedef typename int_iterator_traits<
+        typename Src::iterator>::raw raw_type;
+    assert (src.size () == dst.size ());
+    float* planes [] = { sound::detail::simd_ptr (dst.begin ()) };
+    int_to_float (reinterpret_cast<const raw_type*> (src.begin ()), 1,
+                  planes, dst.size ());
+}
+
+template <class Src, class Dst>
+void convert_frames_aux (const Src& src, const Dst& dst,
+                         std::uint32_t*,
+                         sound::detail::no_simd_tag,
+                         sound::detail::stereo_planar_simd_tag)
+{
+    using sound::detail::simd_ptr;
+    typedef typename int_iterator_traits<
+        typename Src::iterator>::raw raw_type;
+    assert (src.size () == dst.size ());
+    float* planes [] = {
+        simd_ptr (sound::at_c<0> (dst.begin ())),
+        simd_ptr (sound::at_c<1> (dst.begin ()))
+    };
+    int_to_float (reinterpret_cast<const raw_type*> (src.begin ()), 2,
+                  planes, dst.size ());
+}
+
+} /* namespace detail */
+
+/**
+ * dst = src1 + src2. Floating point mono and planar stereo ranges
+ * use the kernels selected for the current CPU.
+ */
+template <class R1, class R2, class R3>
+void mix (const R1& src1, const R2& src2, const R3& dst)
+{
+    detail::mix_aux (
+        src1, src2, dst,
+        typename detail::kernel_range_tag<R1, R2, R3>::type ());
+}
+
+/**
+ * dst = src1 + src2 * ampl
+ */
+template <class R1, class R2, class R3, typename Sample>
+void mix (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
+{
+    detail::mix_aux (
+        src1, src2, ampl, dst,
+        typename detail::kernel_range_tag<R1, R2, R3>::type ());
+}
+
+/**
+ * dst = src1 * src2
+ */
+template <class R1, class R2, class R3>
+void modulate (const R1& src1, const R2& src2, const R3& dst)
+{
+    detail::modulate_aux (
+        src1, src2, dst,
+        typename detail::kernel_range_tag<R1, R2, R3>::type ());
+}
+
+/**
+ * dst = src1 * src2 * ampl
+ */
+template <class R1, class R2, class R3, typename Sample>
+void modulate (const R1& src1, const R2& src2, Sample ampl, const R3& dst)
+{
+    detail::modulate_aux (
+        src1, src2, ampl, dst,
+        typename detail::kernel_range_tag<R1, R2, R3>::type ());
+}
+
+/**
+ * dst = src1 * src2 + stable * (max - src2), this is, src2 fades
+ * between src1 and the @a stable value.
+ */
+template <class R1, class R2, class R3, typename Sample>
+void blend (const R1& src1, const R2& src2, Sample stable, const R3& dst)
+{
+    detail::blend_aux (
+        src1, src2, stable, dst,
+        typename detail::kernel_range_tag<R1, R2, R3>::type ());
+}
+
+/**
+ * State of the TPDF dither that convert_frames can add when reducing
+ * floating point samples to 16 or 24 bits.
+ */
+struct tpdf_dither
+{
+    explicit tpdf_dither (std::uint32_t seed = 0)
+        : state (seed) {}
+
+    std::uint32_t state;
+};
+
+/**
+ * Like sound::copy_and_convert_frames with the default converter,
+ * but using the kernels for the current CPU to convert between
+ * floating point mono or planar stereo ranges and signed 16, 24 or
+ * 32 bit interleaved ranges. When @a dither is not null, it is
+ * applied to the samples converted by the kernels.
+ */
+template <class Src, class Dst>
+void convert_frames (const Src& src, const Dst& dst,
+                     tpdf_dither* dither = 0)
+{
+    detail::convert_frames_aux (
+        src, dst, dither ? &dither->state : 0,
+        typename detail::to_int_tag<Src, Dst>::type (),
+        typename detail::from_int_tag<Src, Dst>::type ());
+}
+
 } /* namespace synth */
 } /* namespace psynth */
 
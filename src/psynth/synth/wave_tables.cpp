@@ -0,0 +1,244 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        wave_tables.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Band-limited tables of the standard waves.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#define PSYNTH_MODULE_NAME "psynth.synth.wave_tables"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "base/logger.hpp"
+#include "synth/oscillator.hpp"
+#include "synth/wave_tables.hpp"
+
+namespace psynth
+{
+namespace synth
+{
+
+namespace
+{
+
+/**
+ * Layout of the cache file, followed by the data () of every table in
+ * the order of standard_wave.
+ */
+struct cache_header
+{
+    char          magic [8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t size;
+    std::uint32_t waves;
+};
+
+const char cache_magic [8] = { 'P', 'S', 'Y', 'W', 'A', 'V', 'E', 'S' };
+const std::uint32_t cache_version = 2;
+const std::uint32_t cache_byte_order = 0x01020304;
+
+const std::size_t table_size = band_limited_table::default_size;
+const std::size_t table_floats = band_limited_table::data_size (table_size);
+const std::size_t cache_bytes =
+    sizeof (cache_header) + num_standard_waves * table_floats * sizeof (float);
+
+std::once_flag s_init_flag;
+std::unique_ptr<wave_tables> s_tables;
+
+/**
+ * Samples the sine table with libm. The polynomial in sine_generator
+ * is only meant for evaluation per sample and its error would end up
+ * baked in the table.
+ */
+struct exact_sine_generator
+{
+    float operator () (float x)
+    { return float (std::sin (2.0 * M_PI * x)); }
+};
+
+template <class Generator>
+band_limited_table* new_table ()
+{
+    return new band_limited_table (Generator ());
+}
+
+void init_tables (const std::string& cache_file)
+{
+    s_tables.reset (new wave_tables (cache_file));
+}
+
+} /* anonymous namespace */
+
+wave_tables::wave_tables (const std::string& cache_file)
+    : _mapping (0)
+{
+    if (!cache_file.empty () && map (cache_file))
+        return;
+
+    build ();
+
+    if (!cache_file.empty () && !(write (cache_file) && map (cache_file)))
+        PSYNTH_LOG << base::log::warning
+                   << "Could not share the wave tables in: " << cache_file;
+}
+
+void wave_tables::build ()
+{
+    typedef standard_wave w;
+    _tables [std::size_t (w::sine)].reset (new_table<exact_sine_generator> ());
+    _tables [std::size_t (w::square)].reset (new_table<square_generator> ());
+    _tables [std::size_t (w::triangle)].reset (
+        new_table<triangle_generator> ());
+    _tables [std::size_t (w::sawtooth)].reset (
+        new_table<sawtooth_generator> ());
+    _tables [std::size_t (w::moogsaw)].reset (new_table<moogsaw_generator> ());
+    _tables [std::size_t (w::exp)].reset (new_table<exp_generator> ());
+}
+
+void wave_tables::borrow (const float* data)
+{
+    for (std::size_t i = 0; i < num_standard_waves; ++i)
+        _tables [i].reset (
+            new band_limited_table (data + i * table_floats, table_size));
+}
+
+#ifdef __linux__
+
+wave_tables::~wave_tables ()
+{
+    if (_mapping)
+        ::munmap (_mapping, cache_bytes);
+}
+
+bool wave_tables::map (const std::string& file)
+{
+    const int fd = ::open (file.c_str (), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void* addr = MAP_FAILED;
+    if (::fstat (fd, &st) == 0 && std::size_t (st.st_size) == cache_bytes)
+        addr = ::mmap (0, cache_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close (fd);
+    if (addr == MAP_FAILED)
+        return false;
+
+    const cache_header* header = static_cast<const cache_header*> (addr);
+    if (std::memcmp (header->magic, cache_magic, sizeof (cache_magic)) ||
+        header->version != cache_version ||
+        header->byte_order != cache_byte_order ||
+        header->size != table_size ||
+        header->waves != num_standard_waves)
+    {
+        ::munmap (addr, cache_bytes);
+        return false;
+    }
+
+    borrow (reinterpret_cast<const float*> (header + 1));
+    if (_mapping)
+        ::munmap (_mapping, cache_bytes);
+    _mapping = addr;
+    return true;
+}
+
+/**
+ * The cache is written in a temporary file that is then renamed, so
+ * other processes never map a half written one.
+ */
+bool wave_tables::write (const std::string& file) const
+{
+    const std::string tmp = file + "." + std::to_string (::getpid ());
+    std::FILE* out = std::fopen (tmp.c_str (), "wb");
+    if (!out)
+        return false;
+
+    cache_header header;
+    std::memcpy (header.magic, cache_magic, sizeof (cache_magic));
+    header.version    = cache_version;
+    header.byte_order = cache_byte_order;
+    header.size       = table_size;
+    header.waves      = num_standard_waves;
+
+    bool ok = std::fwrite (&header, sizeof (header), 1, out) == 1;
+    for (std::size_t i = 0; ok && i < num_standard_waves; ++i)
+        ok = std::fwrite (_tables [i]->data (), sizeof (float),
+                          table_floats, out) == table_floats;
+    ok = std::fclose (out) == 0 && ok;
+
+    if (!ok || std::rename (tmp.c_str (), file.c_str ()) != 0)
+    {
+        std::remove (tmp.c_str ());
+        return false;
+    }
+    return true;
+}
+
+#else
+
+wave_tables::~wave_tables ()
+{
+}
+
+bool wave_tables::map (const std::string&)
+{
+    return false;
+}
+
+bool wave_tables::write (const std::string&) const
+{
+    return false;
+}
+
+#endif
+
+void initialize_wave_tables (const std::string& cache_file)
+{
+    std::call_once (s_init_flag, init_tables, cache_file);
+}
+
+const band_limited_table& standard_table (standard_wave w)
+{
+    initialize_wave_tables ();
+    return s_tables->get (w);
+}
+
+} /* namespace synth */
+} /* namespace psynth */
@@ -0,0 +1,115 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        wave_tables.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Band-limited tables of the standard waves.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PSYNTH_SYNTH_WAVE_TABLES_HPP_
+#define PSYNTH_SYNTH_WAVE_TABLES_HPP_
+
+#include <memory>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include <psynth/synth/band_limited_table.hpp>
+
+namespace psynth
+{
+namespace synth
+{
+
+/**
+ * The waves of the generators in oscillator.hpp, whose tables are
+ * built once per process and shared by every oscillator.
+ */
+enum class standard_wave
+{
+    sine,
+    square,
+    triangle,
+    sawtooth,
+    moogsaw,
+    exp
+};
+
+const std::size_t num_standard_waves = 6;
+
+/**
+ * The tables of every standard wave.
+ *
+ * When @a cache_file is not empty the tables are mapped read-only
+ * from that file, so that every process on the machine shares one
+ * copy. If the file is missing or does not match, the tables are
+ * computed and the file is written for the next processes. Failing
+ * to read or write the cache is not an error, the tables are then
+ * kept in the memory of the process.
+ */
+class wave_tables : private boost::noncopyable
+{
+public:
+    explicit wave_tables (const std::string& cache_file = "");
+    ~wave_tables ();
+
+    const band_limited_table& get (standard_wave w) const
+    { return *_tables [std::size_t (w)]; }
+
+    /**
+     * Tells whether the tables are mapped from the cache file.
+     */
+    bool is_shared () const
+    { return _mapping != 0; }
+
+private:
+    void build ();
+    void borrow (const float* data);
+    bool map (const std::string& file);
+    bool write (const std::string& file) const;
+
+    std::unique_ptr<band_limited_table> _tables [num_standard_waves];
+    void* _mapping;
+};
+
+/**
+ * Builds the tables used by the oscillators, exactly once no matter
+ * how many threads call it at the same time. Call it at startup, out
+ * of the real-time threads; later calls just return, ignoring their
+ * @a cache_file.
+ */
+void initialize_wave_tables (const std::string& cache_file = "");
+
+/**
+ * Returns the table of the wave @a w used by the oscillators,
+ * initializing them without cache if nobody did it before.
+ */
+const band_limited_table& standard_table (standard_wave w);
+
+} /* namespace synth */
+} /* namespace psynth */
+
+#endif /* PSYNTH_SYNTH_WAVE_TABLES_HPP_ */
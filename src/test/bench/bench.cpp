@@ -0,0 +1,236 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        bench.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Microbenchmark harness.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <psynth/version.hpp>
+#include <psynth/base/cpu.hpp>
+
+#include "bench.hpp"
+
+namespace psynth
+{
+namespace bench
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock clock;
+
+double elapsed_ns (clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano> (
+        clock::now () - start).count ();
+}
+
+double percentile (const std::vector<double>& sorted, double p)
+{
+    const auto index = std::size_t (std::ceil (p * sorted.size ())) - 1;
+    return sorted [std::min (index, sorted.size () - 1)];
+}
+
+std::string json_escape (const std::string& str)
+{
+    std::string res;
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            res += '\\';
+        res += c;
+    }
+    return res;
+}
+
+void write_text (std::ostream& os,
+                 const options& opts,
+                 const std::vector<result>& results)
+{
+    os << "psynth-bench " << PSYNTH_VERSION
+       << ", isa: " << base::isa_name (base::current_isa ())
+       << ", frames: " << opts.frames
+       << ", repetitions: " << opts.repetitions << std::endl
+       << std::endl
+       << std::left << std::setw (44) << "case"
+       << std::right
+       << std::setw (10) << "median"
+       << std::setw (10) << "p90"
+       << std::setw (10) << "p99"
+       << std::setw (10) << "min"
+       << std::setw (12) << "Mframes/s"
+       << std::endl;
+
+    os << std::fixed << std::setprecision (3);
+    for (const auto& r : results)
+        os << std::left << std::setw (44) << r.name
+           << std::right
+           << std::setw (10) << r.median
+           << std::setw (10) << r.p90
+           << std::setw (10) << r.p99
+           << std::setw (10) << r.min
+           << std::setw (12) << 1000.0 / r.median
+           << std::endl;
+    os << std::endl << "Times are in nanoseconds per frame." << std::endl;
+}
+
+void write_csv (std::ostream& os,
+                const options&,
+                const std::vector<result>& results)
+{
+    os << "name,frames,iterations,min,median,p90,p99,max" << std::endl;
+    os << std::setprecision (6);
+    for (const auto& r : results)
+        os << r.name << ','
+           << r.frames << ','
+           << r.iterations << ','
+           << r.min << ','
+           << r.median << ','
+           << r.p90 << ','
+           << r.p99 << ','
+           << r.max << std::endl;
+}
+
+void write_json (std::ostream& os,
+                 const options& opts,
+                 const std::vector<result>& results)
+{
+    os << std::setprecision (6);
+    os << "{" << std::endl
+       << "  \"version\": \"" << PSYNTH_VERSION << "\"," << std::endl
+       << "  \"isa\": \"" << base::isa_name (base::current_isa ())
+       << "\"," << std::endl
+       << "  \"cpu\": " << opts.cpu << "," << std::endl
+       << "  \"frames\": " << opts.frames << "," << std::endl
+       << "  \"repetitions\": " << opts.repetitions << "," << std::endl
+       << "  \"unit\": \"ns/frame\"," << std::endl
+       << "  \"results\": [";
+
+    bool first = true;
+    for (const auto& r : results)
+    {
+        os << (first ? "" : ",") << std::endl
+           << "    { \"name\": \"" << json_escape (r.name) << "\""
+           << ", \"frames\": " << r.frames
+           << ", \"iterations\": " << r.iterations
+           << ", \"min\": " << r.min
+           << ", \"median\": " << r.median
+           << ", \"p90\": " << r.p90
+           << ", \"p99\": " << r.p99
+           << ", \"max\": " << r.max << " }";
+        first = false;
+    }
+    os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+} /* anonymous namespace */
+
+std::vector<case_info>& cases ()
+{
+    static std::vector<case_info> all;
+    return all;
+}
+
+result run_case (const case_info& c, const options& opts)
+{
+    auto op = c.make (opts.frames);
+
+    std::size_t warmup_iterations = 0;
+    const auto warmup_start = clock::now ();
+    double warmup_elapsed = 0;
+    do
+    {
+        op ();
+        ++warmup_iterations;
+        warmup_elapsed = elapsed_ns (warmup_start);
+    }
+    while (warmup_elapsed < opts.warmup_ms * 1e6);
+
+    const auto iterations = std::max<std::size_t> (
+        1, std::size_t (warmup_iterations * opts.sample_ms * 1e6
+                        / warmup_elapsed));
+
+    std::vector<double> samples (std::max<std::size_t> (
+                                     opts.repetitions, 1));
+    for (auto& s : samples)
+    {
+        const auto start = clock::now ();
+        for (std::size_t i = 0; i < iterations; ++i)
+            op ();
+        s = elapsed_ns (start) / (iterations * std::max<std::size_t> (
+                                      opts.frames, 1));
+    }
+
+    std::sort (samples.begin (), samples.end ());
+    return result {
+        c.name,
+        opts.frames,
+        iterations,
+        samples.front (),
+        percentile (samples, 0.5),
+        percentile (samples, 0.9),
+        percentile (samples, 0.99),
+        samples.back ()
+    };
+}
+
+bool pin_to_cpu (int cpu)
+{
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO (&cpus);
+    CPU_SET (cpu, &cpus);
+    return sched_setaffinity (0, sizeof (cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+}
+
+void write_results (std::ostream& os,
+                    const options& opts,
+                    const std::vector<result>& results)
+{
+    if (opts.format == "csv")
+        write_csv (os, opts, results);
+    else if (opts.format == "json")
+        write_json (os, opts, results);
+    else
+        write_text (os, opts, results);
+}
+
+} /* namespace bench */
+} /* namespace psynth */
@@ -0,0 +1,144 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        bench.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Microbenchmark harness.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_TEST_BENCH_BENCH_HPP_
+#define PSYNTH_TEST_BENCH_BENCH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace psynth
+{
+namespace bench
+{
+
+/**
+ * The work that is measured. It must process the number of frames
+ * that were passed to the factory that created it.
+ */
+typedef std::function<void ()> operation;
+
+/**
+ * Prepares the buffers and state of a benchmark, out of the timed
+ * region, and returns the operation to be measured.
+ */
+typedef std::function<operation (std::size_t frames)> factory;
+
+struct case_info
+{
+    std::string name;
+    factory     make;
+};
+
+/**
+ * All the cases linked into the binary, in registration order.
+ */
+std::vector<case_info>& cases ();
+
+struct registrar
+{
+    registrar (const char* name, factory make)
+    { cases ().push_back (case_info { name, std::move (make) }); }
+};
+
+/**
+ * Forces the compiler to assume that the memory pointed by @a p is
+ * read, so the work writing it is not optimized away.
+ */
+inline void do_not_optimize (const void* p)
+{
+    asm volatile ("" : : "g" (p) : "memory");
+}
+
+struct options
+{
+    std::size_t frames      = 1024;
+    std::size_t repetitions = 101;
+    double      warmup_ms   = 50.0;
+    double      sample_ms   = 1.0;
+    int         cpu         = -1;
+    std::string format      = "text";
+};
+
+/**
+ * Timings of a case, in nanoseconds per frame.
+ */
+struct result
+{
+    std::string name;
+    std::size_t frames;
+    std::size_t iterations;
+    double      min;
+    double      median;
+    double      p90;
+    double      p99;
+    double      max;
+};
+
+/**
+ * Measures one case. The operation is run until the warmup time
+ * passes, which is also used to choose how many iterations form one
+ * sample, and then the requested number of samples are taken.
+ */
+result run_case (const case_info& c, const options& opts);
+
+/**
+ * Pins the calling thread to @a cpu.
+ * @return Whether it could be done.
+ */
+bool pin_to_cpu (int cpu);
+
+void write_results (std::ostream& os,
+                    const options& opts,
+                    const std::vector<result>& results);
+
+} /* namespace bench */
+} /* namespace psynth */
+
+#define PSYNTH_BENCH_CAT_(a, b) a ## b
+#define PSYNTH_BENCH_CAT(a, b)  PSYNTH_BENCH_CAT_ (a, b)
+
+/**
+ * Defines and registers a benchmark. The body receives the number of
+ * frames as @c frames and returns the operation to measure.
+ */
+#define PSYNTH_BENCH(name)                                              \
+    static ::psynth::bench::operation                                   \
+    PSYNTH_BENCH_CAT (psynth_bench_, __LINE__) (std::size_t frames);    \
+    static ::psynth::bench::registrar                                   \
+    PSYNTH_BENCH_CAT (psynth_bench_reg_, __LINE__) (                    \
+        name, PSYNTH_BENCH_CAT (psynth_bench_, __LINE__));              \
+    static ::psynth::bench::operation                                   \
+    PSYNTH_BENCH_CAT (psynth_bench_, __LINE__) (std::size_t frames)
+
+#endif /* PSYNTH_TEST_BENCH_BENCH_HPP_ */
@@ -0,0 +1,331 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        sound.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Benchmarks of the sound library algorithms and ring buffers.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/sound/ring_buffer.hpp>
+#include <psynth/sound/spsc_ring_buffer.hpp>
+#include <psynth/sound/mirrored_buffer.hpp>
+#include <psynth/sound/dynamic_algorithm.hpp>
+#include <psynth/sound/dynamic_buffer_range.hpp>
+#include <psynth/sound/bind_operation.hpp>
+
+#include "bench.hpp"
+
+using namespace psynth;
+using namespace psynth::sound;
+
+namespace
+{
+
+/**
+ * Ring buffers are made a non multiple of the block size so reads
+ * and writes wrap around the end.
+ */
+std::size_t ring_size (std::size_t frames)
+{
+    return frames * 5 / 2 + 1;
+}
+
+template <class Buffer>
+std::shared_ptr<Buffer> make_buffer (std::size_t frames)
+{
+    auto buf = std::make_shared<Buffer> (frames);
+    fill_frames (range (*buf), typename Buffer::value_type (0.5f));
+    return buf;
+}
+
+template <class Buffer>
+bench::operation fill_case (std::size_t frames)
+{
+    auto buf = make_buffer<Buffer> (frames);
+    return [=] {
+        fill_frames (range (*buf), typename Buffer::value_type (0.25f));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+template <class Buffer>
+bench::operation fill_generic_case (std::size_t frames)
+{
+    auto buf = make_buffer<Buffer> (frames);
+    return [=] {
+        detail::fill_frames_aux (range (*buf),
+                                 typename Buffer::value_type (0.25f),
+                                 detail::no_simd_tag ());
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+template <class Src, class Dst>
+bench::operation copy_case (std::size_t frames)
+{
+    auto src = make_buffer<Src> (frames);
+    auto dst = make_buffer<Dst> (frames);
+    return [=] {
+        copy_frames (const_range (*src), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <class Src, class Dst>
+bench::operation convert_case (std::size_t frames)
+{
+    auto src = make_buffer<Src> (frames);
+    auto dst = make_buffer<Dst> (frames);
+    return [=] {
+        copy_and_convert_frames (const_range (*src), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <class Buffer>
+bench::operation transform_case (std::size_t frames)
+{
+    auto src = make_buffer<Buffer> (frames);
+    auto dst = make_buffer<Buffer> (frames);
+    return [=] {
+        typedef typename Buffer::value_type frame_type;
+        transform_frames (const_range (*src), range (*dst),
+                          [] (const frame_type& f) {
+                              frame_type res;
+                              static_transform (f, res, [] (bits32sf x) {
+                                      return bits32sf (x * 0.5f);
+                                  });
+                              return res;
+                          });
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <class Ring>
+bench::operation ring_case (std::size_t frames)
+{
+    auto src  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto ring = std::make_shared<Ring> (ring_size (frames));
+    auto pos  = std::make_shared<typename Ring::range::position> (
+        range (*ring).begin_pos ());
+    return [=] {
+        range (*ring).write (const_range (*src));
+        range (*ring).read (*pos, range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <class Ring>
+bench::operation spsc_ring_case (std::size_t frames)
+{
+    auto src  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto ring = std::make_shared<Ring> (ring_size (frames));
+    return [=] {
+        range (*ring).write (const_range (*src));
+        range (*ring).read (range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+typedef dynamic_buffer_range<
+    boost::mpl::vector<mono32sf_range,
+                       stereo16s_range,
+                       stereo32sf_range,
+                       stereo32sf_planar_range> >
+any_range;
+
+/**
+ * Copies between the same kind of aligned buffers than
+ * sound/copy/stereo32sf_planar, so they only differ in the dispatch.
+ */
+struct dynamic_copy_state
+{
+    stereo32sf_planar_buffer src;
+    stereo32sf_planar_buffer dst;
+    any_range src_any;
+    any_range dst_any;
+
+    dynamic_copy_state (std::size_t frames)
+        : src (frames, 64)
+        , dst (frames, 64)
+        , src_any (range (src))
+        , dst_any (range (dst))
+    {}
+};
+
+bench::operation dynamic_copy_case (std::size_t frames)
+{
+    auto st = std::make_shared<dynamic_copy_state> (frames);
+    return [=] {
+        copy_frames (st->src_any, st->dst_any);
+        bench::do_not_optimize (st.get ());
+    };
+}
+
+typedef dynamic_buffer_range<
+    boost::mpl::vector<mono8_range,
+                       mono16s_range,
+                       mono32sf_range,
+                       stereo8_range,
+                       stereo16s_range,
+                       stereo32sf_range,
+                       stereo16s_planar_range,
+                       stereo32sf_planar_range> >
+many_range;
+
+/**
+ * The same size cases do one dispatch per frame on variants of eight
+ * types, so the nested switch of apply_operation can be compared with
+ * a bound_binary_operation.
+ */
+struct dynamic_dispatch_state
+{
+    stereo32sf_planar_buffer src;
+    stereo32sf_planar_buffer dst;
+    many_range src_any;
+    many_range dst_any;
+
+    dynamic_dispatch_state (std::size_t frames)
+        : src (frames, 64)
+        , dst (frames, 64)
+        , src_any (range (src))
+        , dst_any (range (dst))
+    {}
+};
+
+/**
+ * Checks whether two ranges have the same size, a binary operation
+ * whose cost is all in the dispatch.
+ */
+struct same_size_fn
+{
+    typedef bool result_type;
+
+    template <typename Range1, typename Range2>
+    result_type operator () (const Range1& a, const Range2& b) const
+    { return a.size () == b.size (); }
+};
+
+bench::operation dynamic_same_size_case (std::size_t frames)
+{
+    auto st = std::make_shared<dynamic_dispatch_state> (frames);
+    return [=] {
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            bool same = apply_operation (st->src_any, st->dst_any,
+                                         same_size_fn ());
+            bench::do_not_optimize (&same);
+        }
+    };
+}
+
+bench::operation dynamic_bound_same_size_case (std::size_t frames)
+{
+    auto st = std::make_shared<dynamic_dispatch_state> (frames);
+    auto same = std::make_shared<
+        bound_binary_operation<many_range::types_t,
+                               many_range::types_t,
+                               same_size_fn> > (
+        bind_operation (st->src_any, st->dst_any, same_size_fn ()));
+    return [=] {
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            bool result = (*same) (st->src_any, st->dst_any);
+            bench::do_not_optimize (&result);
+        }
+    };
+}
+
+typedef mirrored_buffer<stereo32sf_frame, true>
+stereo32sf_planar_mirrored_buffer;
+
+bench::registrar fill_cases [] = {
+    { "sound/fill/mono32sf",
+      fill_case<mono32sf_buffer> },
+    { "sound/fill/stereo32sf",
+      fill_case<stereo32sf_buffer> },
+    { "sound/fill/stereo32sf_planar",
+      fill_case<stereo32sf_planar_buffer> },
+    { "sound/fill/stereo16s",
+      fill_case<stereo16s_buffer> },
+    { "sound/fill_generic/mono32sf",
+      fill_generic_case<mono32sf_buffer> },
+    { "sound/fill_generic/stereo32sf_planar",
+      fill_generic_case<stereo32sf_planar_buffer> }
+};
+
+bench::registrar copy_cases [] = {
+    { "sound/copy/mono32sf",
+      copy_case<mono32sf_buffer, mono32sf_buffer> },
+    { "sound/copy/stereo32sf_planar",
+      copy_case<stereo32sf_planar_buffer, stereo32sf_planar_buffer> },
+    { "sound/copy/stereo32sf_to_planar",
+      copy_case<stereo32sf_buffer, stereo32sf_planar_buffer> },
+    { "sound/copy/stereo32sf_planar_to_interleaved",
+      copy_case<stereo32sf_planar_buffer, stereo32sf_buffer> }
+};
+
+bench::registrar dynamic_cases [] = {
+    { "sound/dynamic/copy",
+      dynamic_copy_case },
+    { "sound/dynamic/same_size",
+      dynamic_same_size_case },
+    { "sound/dynamic/bound_same_size",
+      dynamic_bound_same_size_case }
+};
+
+bench::registrar convert_cases [] = {
+    { "sound/convert/stereo32sf_planar_to_stereo16s",
+      convert_case<stereo32sf_planar_buffer, stereo16s_buffer> },
+    { "sound/convert/stereo16s_to_stereo32sf_planar",
+      convert_case<stereo16s_buffer, stereo32sf_planar_buffer> },
+    { "sound/convert/mono32sf_to_stereo32sf_planar",
+      convert_case<mono32sf_buffer, stereo32sf_planar_buffer> }
+};
+
+bench::registrar transform_cases [] = {
+    { "sound/transform/mono32sf",
+      transform_case<mono32sf_buffer> },
+    { "sound/transform/stereo32sf_planar",
+      transform_case<stereo32sf_planar_buffer> }
+};
+
+bench::registrar ring_cases [] = {
+    { "sound/ring/stereo32sf_planar",
+      ring_case<stereo32sf_planar_ring_buffer> },
+    { "sound/spsc_ring/stereo32sf_planar",
+      spsc_ring_case<stereo32sf_planar_spsc_ring_buffer> },
+    { "sound/spsc_ring/stereo32sf_planar_mirrored",
+      spsc_ring_case<spsc_ring_buffer<stereo32sf_planar_mirrored_buffer> > }
+};
+
+} /* anonymous namespace */
@@ -0,0 +1,668 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        synth.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Benchmarks of the synth library.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/sound/expression.hpp>
+#include <psynth/sound/simd.hpp>
+#include <psynth/synth/biquad_bank.hpp>
+#include <psynth/synth/convolver.hpp>
+#include <psynth/synth/delay_line.hpp>
+#include <psynth/synth/filter.hpp>
+#include <psynth/synth/multi_point_envelope.hpp>
+#include <psynth/synth/noise.hpp>
+#include <psynth/synth/oscillator.hpp>
+#include <psynth/synth/simple_envelope.hpp>
+#include <psynth/synth/state_variable_filter.hpp>
+#include <psynth/synth/util.hpp>
+
+#include "bench.hpp"
+
+using namespace psynth;
+using namespace psynth::sound;
+
+namespace
+{
+
+const std::size_t frame_rate = 44100;
+
+template <class Buffer>
+std::shared_ptr<Buffer> make_buffer (std::size_t frames, float value = 0.5f)
+{
+    auto buf = std::make_shared<Buffer> (frames);
+    fill_frames (range (*buf), typename Buffer::value_type (value));
+    return buf;
+}
+
+std::shared_ptr<mono32sf_buffer> make_signal (std::size_t frames)
+{
+    auto buf = std::make_shared<mono32sf_buffer> (frames);
+    synth::oscillator<synth::sawtooth_generator> osc (frame_rate, 440.0f);
+    osc.update (range (*buf));
+    return buf;
+}
+
+/*
+ *  Oscillators
+ */
+
+template <class Generator>
+bench::operation oscillator_case (std::size_t frames, bool wave_table)
+{
+    auto buf = make_buffer<mono32sf_buffer> (frames);
+    auto osc = std::make_shared<synth::oscillator<Generator> > (
+        frame_rate, 440.0f, 1.0f, 0.0f, wave_table);
+    return [=] {
+        osc->update (range (*buf));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+template <class Generator>
+bench::operation oscillator_table_case (std::size_t frames)
+{
+    return oscillator_case<Generator> (frames, true);
+}
+
+template <class Generator>
+bench::operation oscillator_direct_case (std::size_t frames)
+{
+    return oscillator_case<Generator> (frames, false);
+}
+
+bench::operation oscillator_fm_case (std::size_t frames)
+{
+    auto buf = make_buffer<mono32sf_buffer> (frames);
+    auto mod = make_signal (frames);
+    auto osc = std::make_shared<synth::oscillator<> > (frame_rate, 440.0f);
+    return [=] {
+        osc->update_fm (range (*buf), const_range (*mod));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+/**
+ * A bank of band-limited sawtooth voices spread over a few octaves.
+ * The time per frame divided by the number of voices is the cost of
+ * a voice.
+ */
+bench::operation oscillator_voices_case (std::size_t frames)
+{
+    const std::size_t voices = 16;
+    typedef synth::oscillator<synth::sawtooth_generator> voice;
+
+    auto buf  = make_buffer<mono32sf_buffer> (frames);
+    auto bank = std::make_shared<std::vector<voice> > ();
+    for (std::size_t i = 0; i < voices; ++i)
+        bank->emplace_back (frame_rate, 55.0f * (1.0f + i * 0.5f));
+    return [=] {
+        for (auto& osc : *bank)
+            osc.update (range (*buf));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+bench::registrar oscillator_cases [] = {
+    { "synth/oscillator/sine",
+      oscillator_table_case<synth::sine_generator> },
+    { "synth/oscillator/sine_direct",
+      oscillator_direct_case<synth::sine_generator> },
+    { "synth/oscillator/square",
+      oscillator_table_case<synth::square_generator> },
+    { "synth/oscillator/square_direct",
+      oscillator_direct_case<synth::square_generator> },
+    { "synth/oscillator/triangle",
+      oscillator_table_case<synth::triangle_generator> },
+    { "synth/oscillator/triangle_direct",
+      oscillator_direct_case<synth::triangle_generator> },
+    { "synth/oscillator/sawtooth",
+      oscillator_table_case<synth::sawtooth_generator> },
+    { "synth/oscillator/sawtooth_direct",
+      oscillator_direct_case<synth::sawtooth_generator> },
+    { "synth/oscillator/moogsaw",
+      oscillator_table_case<synth::moogsaw_generator> },
+    { "synth/oscillator/moogsaw_direct",
+      oscillator_direct_case<synth::moogsaw_generator> },
+    { "synth/oscillator/exp",
+      oscillator_table_case<synth::exp_generator> },
+    { "synth/oscillator/exp_direct",
+      oscillator_direct_case<synth::exp_generator> },
+    { "synth/oscillator/sine_fm",
+      oscillator_fm_case },
+    { "synth/oscillator/sawtooth_x16",
+      oscillator_voices_case }
+};
+
+/*
+ *  Arithmetic kernels
+ */
+
+bench::operation mix_case (std::size_t frames)
+{
+    auto a   = make_buffer<stereo32sf_planar_buffer> (frames, 0.25f);
+    auto b   = make_buffer<stereo32sf_planar_buffer> (frames, 0.5f);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        synth::mix (const_range (*a), const_range (*b), 0.5f, range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::operation modulate_case (std::size_t frames)
+{
+    auto a   = make_buffer<stereo32sf_planar_buffer> (frames, 0.25f);
+    auto b   = make_buffer<stereo32sf_planar_buffer> (frames, 0.5f);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        synth::modulate (const_range (*a), const_range (*b), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::operation blend_case (std::size_t frames)
+{
+    auto a   = make_buffer<stereo32sf_planar_buffer> (frames, 0.25f);
+    auto b   = make_buffer<stereo32sf_planar_buffer> (frames, 0.5f);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        synth::blend (const_range (*a), const_range (*b), 0.5f,
+                      range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+/**
+ * The same chain, out = (a + b * gain) * env, one kernel per step or
+ * fused in a single expression.
+ */
+bench::operation chain_passes_case (std::size_t frames)
+{
+    auto a   = make_buffer<stereo32sf_planar_buffer> (frames, 0.25f);
+    auto b   = make_buffer<stereo32sf_planar_buffer> (frames, 0.5f);
+    auto env = make_buffer<stereo32sf_planar_buffer> (frames, 0.75f);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        synth::mix (const_range (*a), const_range (*b), 0.5f, range (*dst));
+        synth::modulate (range (*dst), const_range (*env), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::operation chain_fused_case (std::size_t frames)
+{
+    auto a   = make_buffer<stereo32sf_planar_buffer> (frames, 0.25f);
+    auto b   = make_buffer<stereo32sf_planar_buffer> (frames, 0.5f);
+    auto env = make_buffer<mono32sf_buffer> (frames, 0.75f);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        lazy (range (*dst)) =
+            (lazy (const_range (*a)) + lazy (const_range (*b)) * 0.5f) *
+            lazy (const_range (*env));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::registrar arithmetic_cases [] = {
+    { "synth/mix/stereo32sf_planar",      mix_case },
+    { "synth/modulate/stereo32sf_planar", modulate_case },
+    { "synth/blend/stereo32sf_planar",    blend_case },
+    { "synth/chain/passes",               chain_passes_case },
+    { "synth/chain/fused",                chain_fused_case }
+};
+
+/*
+ *  Filters
+ */
+
+template <filter_values::type Type>
+bench::operation filter_case (std::size_t frames)
+{
+    auto src = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto flt = std::make_shared<filter> ();
+    flt->get_values ()->calculate (Type, 1000.0f, 0.5f, frame_rate);
+    return [=] {
+        transform_frames (const_range (*src), range (*dst),
+                          [&] (const mono32sf_frame& x) {
+                              return mono32sf_frame (flt->update (at_c<0> (x)));
+                          });
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+/**
+ * Eight channels filtered one after the other by scalar filters, or
+ * together by a biquad bank.
+ */
+bench::operation filter_channels_case (std::size_t frames)
+{
+    const std::size_t lanes = synth::biquad_bank::max_lanes;
+    auto src = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto values = std::make_shared<filter_values> (
+        filter_values::LOWPASS, 1000.0f, 0.5f, frame_rate);
+    auto flts = std::make_shared<std::vector<filter> > (
+        lanes, filter (values.get ()));
+    return [=] {
+        for (auto& flt : *flts)
+            transform_frames (const_range (*src), range (*dst),
+                              [&] (const mono32sf_frame& x) {
+                                  return mono32sf_frame (
+                                      flt.update (at_c<0> (x)));
+                              });
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <std::size_t Lanes>
+bench::operation biquad_bank_case (std::size_t frames)
+{
+    auto src = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto bank = std::make_shared<synth::biquad_bank> (Lanes);
+    bank->set_values (filter_values (filter_values::LOWPASS, 1000.0f, 0.5f,
+                                     frame_rate));
+    return [=] {
+        using sound::detail::simd_ptr;
+        const float* in = simd_ptr (const_range (*src).begin ());
+        float* out = simd_ptr (range (*dst).begin ());
+        const float* ins [Lanes];
+        float* outs [Lanes];
+        std::fill (ins, ins + Lanes, in);
+        std::fill (outs, outs + Lanes, out);
+        bank->update_planes (ins, outs, frames);
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+/**
+ * What node_filter does when its cutoff is connected and it can not
+ * use a biquad bank, recomputing the coefficients for every sample.
+ */
+bench::operation filter_modulated_case (std::size_t frames)
+{
+    auto src = make_signal (frames);
+    auto mod = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto flt = std::make_shared<filter> ();
+    flt->get_values ()->calculate (filter_values::LOWPASS, 1000.0f, 0.5f,
+                                   frame_rate);
+    return [=] {
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            const float m = at_c<0> (const_range (*mod) [i]);
+            flt->get_values ()->calculate (1000.0f + m * 1000.0f);
+            at_c<0> (range (*dst) [i]) =
+                flt->update (at_c<0> (const_range (*src) [i]));
+        }
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+/**
+ * What node_filter does when its cutoff is connected otherwise,
+ * recomputing the coefficients once every control period.
+ */
+bench::operation biquad_bank_modulated_case (std::size_t frames)
+{
+    auto src = make_signal (frames);
+    auto mod = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto bank = std::make_shared<synth::biquad_bank> (1);
+    auto values = std::make_shared<filter_values> (
+        filter_values::LOWPASS, 1000.0f, 0.5f, frame_rate);
+    return [=] {
+        using sound::detail::simd_ptr;
+        const std::size_t period = 16; // node_filter::CONTROL_PERIOD
+        const float* in = simd_ptr (const_range (*src).begin ());
+        float* out = simd_ptr (range (*dst).begin ());
+        for (std::size_t i = 0; i < frames; i += period)
+        {
+            const std::size_t len = std::min (frames - i, period);
+            const float m = at_c<0> (const_range (*mod) [i + len - 1]);
+            values->calculate (1000.0f + m * 1000.0f);
+            bank->set_values (*values);
+            const float* ins [1] = { in + i };
+            float* outs [1] = { out + i };
+            bank->update_planes (ins, outs, len);
+        }
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::operation svf_case (std::size_t frames, bool modulated)
+{
+    auto src = make_signal (frames);
+    auto mod = make_signal (frames);
+    auto dst = make_buffer<mono32sf_buffer> (frames);
+    auto flt = std::make_shared<synth::state_variable_filter> (
+        1, synth::state_variable_filter::mode::lowpass, 1000.0f, 0.5f,
+        frame_rate);
+    return [=] {
+        if (modulated)
+            flt->update (const_range (*src), range (*dst),
+                         const_range (*mod));
+        else
+            flt->update (const_range (*src), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::operation svf_static_case (std::size_t frames)
+{
+    return svf_case (frames, false);
+}
+
+bench::operation svf_modulated_case (std::size_t frames)
+{
+    return svf_case (frames, true);
+}
+
+bench::registrar filter_cases [] = {
+    { "synth/filter/lowpass",       filter_case<filter_values::LOWPASS> },
+    { "synth/filter/hipass",        filter_case<filter_values::HIPASS> },
+    { "synth/filter/bandpass_csg",
+      filter_case<filter_values::BANDPASS_CSG> },
+    { "synth/filter/bandpass_czpg",
+      filter_case<filter_values::BANDPASS_CZPG> },
+    { "synth/filter/notch",         filter_case<filter_values::NOTCH> },
+    { "synth/filter/moog",          filter_case<filter_values::MOOG> },
+    { "synth/filter/lowpass_x8",    filter_channels_case },
+    { "synth/filter/biquad_bank_x2", biquad_bank_case<2> },
+    { "synth/filter/biquad_bank_x8", biquad_bank_case<8> },
+    { "synth/filter/lowpass_modulated",
+      filter_modulated_case },
+    { "synth/filter/biquad_bank_modulated",
+      biquad_bank_modulated_case },
+    { "synth/filter/svf",           svf_static_case },
+    { "synth/filter/svf_modulated", svf_modulated_case }
+};
+
+/*
+ *  Envelopes
+ */
+
+bench::operation simple_envelope_case (std::size_t frames)
+{
+    auto buf = make_buffer<mono32sf_buffer> (frames);
+    auto env = std::make_shared<synth::simple_envelope<mono32sf_range> > (
+        0.001f, -0.001f);
+    auto up  = std::make_shared<bool> (true);
+    return [=] {
+        if (*up)
+            env->press ();
+        else
+            env->release ();
+        *up = !*up;
+        env->update (range (*buf));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+bench::operation multi_point_envelope_case (std::size_t frames)
+{
+    typedef synth::envelope_values<bits32sf>  values_type;
+    typedef values_type::point                point;
+    typedef synth::multi_point_envelope<mono32sf_range> envelope_type;
+
+    auto buf  = make_buffer<mono32sf_buffer> (frames);
+    auto vals = std::make_shared<values_type> ();
+    vals->set_adsr (point { 0.01f, 1.0f },
+                    point { 0.01f, 0.5f },
+                    point { 0.01f, 0.5f },
+                    point { 0.01f, 0.0f });
+    auto env  = std::make_shared<envelope_type> (vals.get ());
+    auto up   = std::make_shared<bool> (true);
+    return [=] {
+        if (*up)
+            env->press ();
+        else
+            env->release ();
+        *up = !*up;
+        env->update (range (*buf));
+        bench::do_not_optimize (buf.get ());
+        bench::do_not_optimize (vals.get ());
+    };
+}
+
+/**
+ * A soft port fading its stereo input, held at one or always
+ * ramping.
+ */
+template <bool Ramp>
+bench::operation blend_envelope_case (std::size_t frames)
+{
+    typedef synth::simple_envelope<mono32sf_range> envelope_type;
+    auto src = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto env = std::make_shared<envelope_type> (
+        Ramp ? 0.5f / frames : 1.0f, Ramp ? -0.5f / frames : -1.0f);
+    auto up  = std::make_shared<bool> (true);
+    env->set (Ramp ? 0.25f : 1.0f);
+    env->press ();
+    return [=] {
+        if (Ramp)
+        {
+            if (*up)
+                env->press ();
+            else
+                env->release ();
+            *up = !*up;
+        }
+        synth::blend_envelope (*env, const_range (*src), 0.0f, range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::registrar envelope_cases [] = {
+    { "synth/envelope/simple",      simple_envelope_case },
+    { "synth/envelope/multi_point", multi_point_envelope_case },
+    { "synth/envelope/blend_held",  blend_envelope_case<false> },
+    { "synth/envelope/blend_ramp",  blend_envelope_case<true> }
+};
+
+/*
+ *  Noise
+ */
+
+template <template <class> class Distribution,
+          class Generator = synth::default_noise_generator>
+bench::operation noise_case (std::size_t frames)
+{
+    auto buf   = make_buffer<mono32sf_buffer> (frames);
+    auto noise = std::make_shared<
+        synth::noise<Distribution<bits32sf>, Generator> > ();
+    return [=] {
+        noise->update (range (*buf));
+        bench::do_not_optimize (buf.get ());
+    };
+}
+
+bench::registrar noise_cases [] = {
+    { "synth/noise/white", noise_case<synth::white_noise_distribution> },
+    { "synth/noise/pink",  noise_case<synth::pink_noise_distribution> },
+    { "synth/noise/brown", noise_case<synth::brown_noise_distribution> },
+    { "synth/noise/white_mt19937",
+      noise_case<synth::white_noise_distribution, std::mt19937> },
+    { "synth/noise/pink_mt19937",
+      noise_case<synth::pink_noise_distribution, std::mt19937> }
+};
+
+/*
+ *  Convolution
+ */
+
+/**
+ * Stereo convolution with @a Millis milliseconds of noise as
+ * response, in blocks of 64 frames as the processor does by
+ * default. The frames past the last whole block are not processed.
+ */
+template <std::size_t Millis>
+bench::operation convolver_case (std::size_t frames)
+{
+    const std::size_t block = 64;
+    std::vector<float> ir (frame_rate * Millis / 1000);
+    synth::noise_engine engine;
+    engine.fill (&ir [0], ir.size ());
+
+    auto src  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst  = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto conv = std::make_shared<synth::convolver> (
+        &ir [0], ir.size (), block, 2);
+    return [=] {
+        const float* in [2];
+        float*       out [2];
+        synth::detail::range_planes (const_range (*src), in);
+        synth::detail::range_planes (range (*dst), out);
+        conv->update_planes (in, out, frames - frames % block);
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::registrar convolver_cases [] = {
+    { "synth/convolver/cabinet_20ms", convolver_case<20> },
+    { "synth/convolver/reverb_3s",    convolver_case<3000> }
+};
+
+/*
+ *  Delay lines
+ */
+
+/**
+ * Stereo delay line read with a delay sweeping between 1 and 10
+ * milliseconds, as in a flanger, in blocks of 64 frames.
+ */
+template <synth::delay_line::interpolation Mode>
+bench::operation delay_line_case (std::size_t frames)
+{
+    const std::size_t block = 64;
+    auto line = std::make_shared<synth::delay_line> (
+        2, frame_rate / 100, block);
+    auto times = std::make_shared<std::vector<float> > (frames);
+    for (std::size_t i = 0; i < frames; ++i)
+        (*times) [i] = frame_rate * (0.0055f + 0.0045f *
+                                     std::sin (i * 0.001f));
+
+    auto src = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto state = std::make_shared<std::vector<float> > (2, 0.0f);
+    return [=] {
+        const float* in [2];
+        float*       out [2];
+        synth::detail::range_planes (const_range (*src), in);
+        synth::detail::range_planes (range (*dst), out);
+        for (std::size_t i = 0; i < frames; i += block)
+        {
+            const std::size_t n = std::min (block, frames - i);
+            const float* in_block [] = { in [0] + i, in [1] + i };
+            float*       out_block [] = { out [0] + i, out [1] + i };
+            line->write_planes (in_block, n);
+            line->read_planes (out_block, &(*times) [i], n, Mode,
+                               &(*state) [0]);
+        }
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::registrar delay_line_cases [] = {
+    { "synth/delay_line/linear",
+      delay_line_case<synth::delay_line::interpolation::linear> },
+    { "synth/delay_line/cubic",
+      delay_line_case<synth::delay_line::interpolation::cubic> },
+    { "synth/delay_line/allpass",
+      delay_line_case<synth::delay_line::interpolation::allpass> }
+};
+
+/*
+ *  Converters
+ */
+
+template <class Dst>
+bench::operation to_int_case (std::size_t frames, bool dither)
+{
+    auto src = make_buffer<stereo32sf_planar_buffer> (frames);
+    auto dst = make_buffer<Dst> (frames);
+    auto dth = std::make_shared<synth::tpdf_dither> ();
+    return [=] {
+        synth::convert_frames (const_range (*src), range (*dst),
+                               dither ? dth.get () : 0);
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+template <class Dst>
+bench::operation to_int_plain_case (std::size_t frames)
+{
+    return to_int_case<Dst> (frames, false);
+}
+
+template <class Dst>
+bench::operation to_int_dither_case (std::size_t frames)
+{
+    return to_int_case<Dst> (frames, true);
+}
+
+template <class Src>
+bench::operation from_int_case (std::size_t frames)
+{
+    auto src = make_buffer<Src> (frames);
+    auto dst = make_buffer<stereo32sf_planar_buffer> (frames);
+    return [=] {
+        synth::convert_frames (const_range (*src), range (*dst));
+        bench::do_not_optimize (dst.get ());
+    };
+}
+
+bench::registrar convert_cases [] = {
+    { "synth/convert/to_stereo16s",
+      to_int_plain_case<stereo16s_buffer> },
+    { "synth/convert/to_stereo16s_dither",
+      to_int_dither_case<stereo16s_buffer> },
+    { "synth/convert/to_stereo24s",
+      to_int_plain_case<stereo24s_buffer> },
+    { "synth/convert/to_stereo24s_dither",
+      to_int_dither_case<stereo24s_buffer> },
+    { "synth/convert/to_stereo32s",
+      to_int_plain_case<stereo32s_buffer> },
+    { "synth/convert/from_stereo16s",
+      from_int_case<stereo16s_buffer> },
+    { "synth/convert/from_stereo24s",
+      from_int_case<stereo24s_buffer> },
+    { "synth/convert/from_stereo32s",
+      from_int_case<stereo32s_buffer> }
+};
+
+} /* anonymous namespace */
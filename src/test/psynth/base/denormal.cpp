@@ -0,0 +1,107 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        denormal.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Unit tests for the denormal protection.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/base/denormal.hpp>
+
+using namespace psynth::base;
+
+namespace
+{
+
+/**
+ * Computed at run-time so the compiler can not fold it.
+ */
+float tiny_product ()
+{
+    volatile float small = 1e-30f;
+    volatile float factor = 1e-10f;
+    return small * factor;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE(base_denormal_test_suite)
+
+BOOST_AUTO_TEST_CASE(denormal_is_subnormal)
+{
+    BOOST_CHECK (is_subnormal (tiny_product ()));
+    BOOST_CHECK (!is_subnormal (0.0f));
+    BOOST_CHECK (!is_subnormal (1e-30f));
+}
+
+#if PSYNTH_HAVE_MXCSR || PSYNTH_HAVE_FPCR
+
+BOOST_AUTO_TEST_CASE(denormal_guard_flushes)
+{
+    {
+        denormal_guard guard;
+        BOOST_CHECK_EQUAL (tiny_product (), 0.0f);
+        {
+            denormal_guard nested;
+            BOOST_CHECK_EQUAL (tiny_product (), 0.0f);
+        }
+        BOOST_CHECK_EQUAL (tiny_product (), 0.0f);
+    }
+    BOOST_CHECK (is_subnormal (tiny_product ()));
+}
+
+#endif
+
+#if PSYNTH_DEBUG
+
+BOOST_AUTO_TEST_CASE(denormal_guard_tracing)
+{
+    enable_subnormal_tracing (true);
+    {
+        denormal_guard guard;
+        BOOST_CHECK (is_subnormal (tiny_product ()));
+    }
+    enable_subnormal_tracing (false);
+
+    {
+        denormal_guard outer;
+        enable_subnormal_tracing (true);
+        {
+            denormal_guard inner;
+            BOOST_CHECK (is_subnormal (tiny_product ()));
+        }
+        enable_subnormal_tracing (false);
+#if PSYNTH_HAVE_MXCSR || PSYNTH_HAVE_FPCR
+        BOOST_CHECK_EQUAL (tiny_product (), 0.0f);
+#endif
+    }
+    BOOST_CHECK (!subnormal_tracing ());
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END ()
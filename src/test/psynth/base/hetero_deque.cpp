@@ -58,6 +58,7 @@ struct test_except : test_base
 };
 
 typedef psynth::base::hetero_deque<test_base> test_deque;
+typedef psynth::base::hetero_deque<test_base, true> movable_deque;
 
 BOOST_AUTO_TEST_CASE(hetero_deque_test_too_small)
 {
@@ -235,4 +236,31 @@ BOOST_AUTO_TEST_CASE(hetero_deque_move)
     BOOST_CHECK_EQUAL (q2.back ().count, -1);
 }
 
+BOOST_AUTO_TEST_CASE(hetero_deque_splice)
+{
+    movable_deque q (1024);
+    movable_deque other (1024);
+
+    BOOST_CHECK_EQUAL (q.push_back<test_count> (), true);
+    BOOST_CHECK_EQUAL (other.push_back<test_count_dec> (), true);
+    BOOST_CHECK_EQUAL (other.push_back<test_count> (), true);
+    other.front ().method ();
+
+    BOOST_CHECK_EQUAL (q.splice_back (other), true);
+    BOOST_CHECK_EQUAL (other.empty (), true);
+    BOOST_CHECK_EQUAL (std::distance (q.begin (), q.end ()), 3);
+
+    auto it = q.begin ();
+    BOOST_CHECK (dynamic_cast<test_count*> (&*it++));
+    BOOST_CHECK_EQUAL (dynamic_cast<test_count_dec&> (*it).dec_count, 1);
+    BOOST_CHECK_EQUAL ((it++)->count, -1);
+    BOOST_CHECK (dynamic_cast<test_count*> (&*it));
+
+    movable_deque small (128);
+    while (other.push_back<test_count> ());
+    BOOST_CHECK_EQUAL (small.splice_back (other), false);
+    BOOST_CHECK_EQUAL (small.empty (), false);
+    BOOST_CHECK_EQUAL (other.empty (), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
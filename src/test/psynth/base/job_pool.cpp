@@ -0,0 +1,77 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        job_pool.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Unit tests for the job pool.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <psynth/base/job_pool.hpp>
+
+using namespace psynth::base;
+
+BOOST_AUTO_TEST_SUITE(base_job_pool_test_suite)
+
+BOOST_AUTO_TEST_CASE(job_pool_runs_jobs)
+{
+    job_pool pool (4);
+    std::atomic<int> count (0);
+
+    pool.start ();
+    for (int i = 0; i < 100; ++i)
+        pool.post ([&] { ++count; });
+    pool.wait ();
+
+    BOOST_CHECK_EQUAL (count, 100);
+    BOOST_CHECK_EQUAL (pool.pending (), 0);
+    BOOST_CHECK_THROW (pool.start (), job_pool_error);
+}
+
+BOOST_AUTO_TEST_CASE(job_pool_priorities)
+{
+    job_pool pool (1);
+    std::vector<int> order;
+
+    pool.post ([&] { order.push_back (0); }, job_priority::low);
+    pool.post ([&] { order.push_back (1); }, job_priority::normal);
+    pool.post ([&] { order.push_back (2); }, job_priority::high);
+    pool.post ([&] { order.push_back (3); }, job_priority::high);
+    BOOST_CHECK_EQUAL (pool.pending (), 4);
+
+    pool.start ();
+    pool.wait ();
+    pool.stop ();
+
+    BOOST_CHECK_EQUAL (order.size (), 4);
+    BOOST_CHECK_EQUAL (order [0], 2);
+    BOOST_CHECK_EQUAL (order [1], 3);
+    BOOST_CHECK_EQUAL (order [2], 1);
+    BOOST_CHECK_EQUAL (order [3], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
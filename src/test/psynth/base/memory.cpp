@@ -0,0 +1,116 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        memory.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Unit tests for the memory utilities.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdint>
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/base/memory.hpp>
+#include <psynth/new_graph/buffers.hpp>
+
+using namespace psynth::base;
+
+namespace
+{
+
+bool is_aligned (const void* ptr)
+{
+    return reinterpret_cast<std::uintptr_t> (ptr) % cache_line_size == 0;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE(base_memory_test_suite)
+
+BOOST_AUTO_TEST_CASE(memory_arena_allocates)
+{
+    memory_arena arena (1 << 16, false, false);
+    const std::size_t size = arena.size ();
+    BOOST_CHECK (size >= (1 << 16));
+
+    void* a = arena.allocate (100);
+    void* b = arena.allocate (1000);
+    void* c = arena.allocate (10);
+    BOOST_CHECK (a && b && c);
+    BOOST_CHECK (is_aligned (a) && is_aligned (b) && is_aligned (c));
+    BOOST_CHECK (arena.owns (a) && arena.owns (b) && arena.owns (c));
+    BOOST_CHECK (!arena.owns (&arena));
+    BOOST_CHECK_EQUAL (arena.used (), 128 + 1024 + 64);
+    BOOST_CHECK (!arena.allocate (size));
+
+    arena.deallocate (a, 100);
+    arena.deallocate (c, 10);
+    arena.deallocate (b, 1000);
+    BOOST_CHECK_EQUAL (arena.used (), 0);
+
+    // freed blocks are merged back
+    void* all = arena.allocate (size);
+    BOOST_CHECK (all);
+    arena.deallocate (all, size);
+}
+
+BOOST_AUTO_TEST_CASE(memory_arena_allocator)
+{
+    auto arena = std::make_shared<memory_arena> (1 << 12, false, false);
+    arena_allocator<float> alloc (arena);
+    BOOST_CHECK (alloc == arena_allocator<unsigned char> (arena));
+    BOOST_CHECK (alloc != arena_allocator<float> ());
+
+    float* a = alloc.allocate (arena->size () / sizeof (float));
+    float* b = alloc.allocate (16);
+    BOOST_CHECK (arena->owns (a));
+    BOOST_CHECK (!arena->owns (b));
+    BOOST_CHECK (is_aligned (b));
+    alloc.deallocate (b, 16);
+    alloc.deallocate (a, arena->size () / sizeof (float));
+    BOOST_CHECK_EQUAL (arena->used (), 0);
+}
+
+BOOST_AUTO_TEST_CASE(memory_aligned_planes)
+{
+    using namespace psynth;
+    auto arena = std::make_shared<memory_arena> (1 << 16, false, false);
+
+    for (std::size_t size : { 1, 13, 64, 100 })
+    {
+        graph::audio_buffer buf (size, graph::buffer_alignment,
+                                 graph::buffer_allocator (arena));
+        auto first = range (buf).begin ();
+        BOOST_CHECK (arena->owns (sound::at_c<0> (first)));
+        BOOST_CHECK (is_aligned (sound::at_c<0> (first)));
+        BOOST_CHECK (is_aligned (sound::at_c<1> (first)));
+        // the last plane fits in the allocated memory
+        BOOST_CHECK (sound::at_c<1> (first) + size <=
+                     sound::at_c<0> (first) +
+                     arena->used () / sizeof (float));
+    }
+    BOOST_CHECK_EQUAL (arena->used (), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
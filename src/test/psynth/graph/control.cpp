@@ -98,6 +98,46 @@ BOOST_AUTO_TEST_CASE(test_out_control_non_fundamental_noattach)
 
 
 
+BOOST_AUTO_TEST_CASE(test_smoothed_in_control)
+{
+    const std::size_t block = 64;
+    full_process_context ctx (block, 1000);
+
+    for (auto mode : { smoothing::linear, smoothing::one_pole })
+    {
+        smoothed_in_control ctl ("test", 0, 1.0f, mode, 0.1f);
+        ctl.rt_context_update (ctx);
+        BOOST_CHECK (!ctl.rt_smooth ());
+        BOOST_CHECK_EQUAL (ctl.rt_get_smoothed (), 1.0f);
+
+        ctl.set (2.0f);
+        BOOST_CHECK_EQUAL (ctl.rt_get (), 2.0f);
+
+        float last = 1.0f;
+        std::size_t blocks = 0;
+        while (const float* ramp = ctl.rt_smooth ())
+        {
+            for (std::size_t i = 0; i < block; ++i)
+            {
+                BOOST_REQUIRE (ramp [i] > last || ramp [i] == 2.0f);
+                BOOST_REQUIRE (ramp [i] <= 2.0f);
+                last = ramp [i];
+            }
+            BOOST_REQUIRE (++blocks < 100);
+        }
+        BOOST_CHECK_EQUAL (ctl.rt_get_smoothed (), 2.0f);
+        BOOST_CHECK (!ctl.rt_smooth ());
+
+        // The linear ramp takes the 100 samples of the smoothing
+        // time, the exponential one gets within the threshold in
+        // about ln (1 / threshold) times that.
+        if (mode == smoothing::linear)
+            BOOST_CHECK_EQUAL (blocks, 2u);
+        else
+            BOOST_CHECK_EQUAL (blocks, 15u);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_in_control_fundamental_semiattach)
 {
     control_node<int> ctl (0);
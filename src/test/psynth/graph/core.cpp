@@ -28,7 +28,11 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/vector.hpp>
 
@@ -36,8 +40,346 @@
 #include <psynth/new_graph/sink_node.hpp>
 #include <psynth/new_graph/processor.hpp>
 #include <psynth/new_graph/core/patch.hpp>
+#include <psynth/new_graph/core/pipe.hpp>
+#include <psynth/new_graph/core/convolver.hpp>
+#include <psynth/new_graph/core/delay.hpp>
+#include <psynth/new_graph/core/chorus.hpp>
+#include <psynth/new_graph/core/oscillator.hpp>
+#include <psynth/new_graph/core/async_output.hpp>
+#include <psynth/io/output.hpp>
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/base/denormal.hpp>
+
+#include "nodes.hpp"
 
 using namespace psynth::graph;
+using psynth::test::counting_source;
+using psynth::test::capturing_sink;
+
+namespace
+{
+
+struct recording_sink : public sink_node
+{
+    audio_in_port      in;
+    std::vector<float> samples;
+
+    recording_sink ()
+        : in ("input", this)
+    {}
+
+    void rt_do_process (rt_process_context& ctx)
+    {
+        for (auto frame : in.rt_in_range ())
+            samples.push_back (psynth::sound::at_c<0> (frame));
+    }
+};
+
+/**
+ * Asynchronous device that records the left channel of what it is
+ * given, and whose periods are triggered by hand.
+ */
+struct recording_device : public psynth::io::async_output<audio_range>
+                        , public psynth::io::detail::async_base_impl
+{
+    std::size_t        period_size;
+    std::vector<float> samples;
+
+    recording_device (std::size_t period_size_)
+        : period_size (period_size_)
+    {}
+
+    std::size_t buffer_size () const
+    { return period_size; }
+
+    std::size_t put (const const_range& data)
+    {
+        for (auto frame : data)
+            samples.push_back (psynth::sound::at_c<0> (frame));
+        return data.size ();
+    }
+
+    void start ()
+    { set_state (psynth::io::async_state::running); }
+
+    void stop ()
+    { set_state (psynth::io::async_state::idle); }
+
+    void period ()
+    { process (period_size); }
+};
+
+/**
+ * Outputs subnormals unless they are flushed to zero.
+ */
+struct subnormal_source : public node
+{
+    audio_out_port out;
+    float          level;
+    float          factor;
+
+    subnormal_source ()
+        : out ("output", this)
+        , level (1e-30f)
+        , factor (1e-10f)
+    {}
+
+    void rt_do_process (rt_process_context& ctx)
+    {
+        psynth::sound::fill_frames (
+            out.rt_out_range (), audio_frame (level * factor));
+    }
+};
+
+void check_pipe (bool running)
+{
+    processor p (0, 64);
+    auto src  = std::make_shared<counting_source> ();
+    auto pipe = std::make_shared<core::audio_pipe> ();
+    auto sink = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (pipe);
+    p.root ()->add (sink);
+    pipe->in ("input").connect (src->out);
+    sink->in.connect (pipe->out ("output"));
+    BOOST_CHECK_EQUAL (p.latency (), 64u);
+
+    if (running)
+        p.start ();
+
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->count, 1);
+    BOOST_CHECK_EQUAL (sink->last, 0.0f);
+    p.rt_request_process (3);
+    BOOST_CHECK_EQUAL (src->count, 4);
+    BOOST_CHECK_EQUAL (sink->last, 3.0f);
+
+    if (running)
+        p.stop ();
+}
+
+/**
+ * Counting source that pushes a real-time and an asynchronous event
+ * every time it is processed.
+ */
+struct event_source : public counting_source
+{
+    int              rt_events;
+    std::atomic<int> async_events;
+
+    event_source ()
+        : rt_events (0)
+        , async_events (0)
+    {}
+
+    void rt_do_process (rt_process_context& ctx)
+    {
+        counting_source::rt_do_process (ctx);
+        ctx.push_rt_event (
+            make_rt_event ([this] (rt_process_context&) {
+                    ++ rt_events;
+                }));
+        ctx.push_async_event (
+            make_async_event ([this] (async_process_context&) {
+                    ++ async_events;
+                }));
+    }
+};
+
+/**
+ * Checks two chained pipes, where the first stage processes a node
+ * that pushes events from the worker thread.
+ */
+void check_pipe_chain (bool running)
+{
+    processor p (0, 64);
+    auto src   = std::make_shared<event_source> ();
+    auto pipe1 = std::make_shared<core::audio_pipe> ();
+    auto pipe2 = std::make_shared<core::audio_pipe> ();
+    auto sink  = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (pipe1);
+    p.root ()->add (pipe2);
+    p.root ()->add (sink);
+    pipe1->in ("input").connect (src->out);
+    pipe2->in ("input").connect (pipe1->out ("output"));
+    sink->in.connect (pipe2->out ("output"));
+    BOOST_CHECK_EQUAL (p.latency (), 128u);
+
+    if (running)
+        p.start ();
+
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->count, 1);
+    BOOST_CHECK_EQUAL (src->rt_events, 1);
+    BOOST_CHECK_EQUAL (sink->last, 0.0f);
+    for (int i = 2; i <= 64; ++i)
+    {
+        p.rt_request_process ();
+        BOOST_REQUIRE_EQUAL (src->count, i);
+        BOOST_REQUIRE_EQUAL (src->rt_events, i);
+        BOOST_REQUIRE_EQUAL (sink->last, float (i - 2));
+    }
+
+    if (running)
+    {
+        for (int i = 0; i < 1000 && src->async_events < 64; ++i)
+        {
+            p.rt_request_process ();
+            ::usleep (1 << 10);
+        }
+        BOOST_CHECK_GE (src->async_events, 64);
+        p.stop ();
+    }
+}
+
+void check_convolver (bool running)
+{
+    processor p (0, 64);
+    auto src  = std::make_shared<counting_source> ();
+    auto conv = std::make_shared<core::audio_convolver> ();
+    auto sink = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (conv);
+    p.root ()->add (sink);
+    conv->in ("input").connect (src->out);
+    sink->in.connect (conv->out ("output"));
+
+    // Let the soft input port fade in.
+    p.rt_request_process (4);
+    BOOST_CHECK_EQUAL (sink->last, 0.0f);
+
+    conv->set_impulse ({ 0.5f });
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (sink->last, 0.5f * src->count);
+
+    if (running)
+    {
+        p.start ();
+        conv->set_impulse ({ 2.0f });
+        for (int i = 0; i < 1000 && sink->last != 2.0f * src->count; ++i)
+        {
+            p.rt_request_process ();
+            ::usleep (1 << 10);
+        }
+        BOOST_CHECK_EQUAL (sink->last, 2.0f * src->count);
+        p.stop ();
+    }
+}
+
+/**
+ * Checks that a delay node configured with @a params, that should
+ * make it a pure delay of two blocks, outputs the block of the
+ * counting source from two blocks ago.
+ */
+template <class Node>
+void check_delay_node (
+    std::initializer_list<std::pair<const char*, float> > params)
+{
+    processor p (0, 64);
+    auto src   = std::make_shared<counting_source> ();
+    auto delay = std::make_shared<Node> ();
+    auto sink  = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (delay);
+    p.root ()->add (sink);
+    delay->in ("input").connect (src->out);
+    sink->in.connect (delay->out ("output"));
+
+    delay->param ("delay").set (
+        128.0f / p.context ().frame_rate ());
+    for (auto& param : params)
+        delay->param (param.first).set (param.second);
+
+    // Let the soft input port fade in.
+    p.rt_request_process (8);
+    BOOST_CHECK_CLOSE (sink->last, float (src->count - 2), 1e-3);
+}
+
+/**
+ * Checks that a change of the amplitude of an oscillator is smoothed,
+ * by comparing it with another one whose amplitude does not change.
+ */
+void check_oscillator_smoothing ()
+{
+    processor p (0, 64);
+    auto osc       = std::make_shared<core::audio_sine_oscillator> ();
+    auto reference = std::make_shared<core::audio_sine_oscillator> ();
+    auto sink      = std::make_shared<recording_sink> ();
+    auto ref_sink  = std::make_shared<recording_sink> ();
+
+    p.root ()->add (osc);
+    p.root ()->add (reference);
+    p.root ()->add (sink);
+    p.root ()->add (ref_sink);
+    sink->in.connect (osc->out ("output"));
+    ref_sink->in.connect (reference->out ("output"));
+
+    osc->param ("amplitude").set (0.5f);
+    reference->param ("amplitude").set (1.0f);
+    p.rt_request_process (32);
+    sink->samples.clear ();
+    ref_sink->samples.clear ();
+
+    p.rt_request_process (2);
+    for (std::size_t i = 0; i < sink->samples.size (); ++i)
+        BOOST_REQUIRE_SMALL (
+            sink->samples [i] - 0.5f * ref_sink->samples [i], 1e-6f);
+
+    const std::size_t start = sink->samples.size ();
+    const std::size_t length = std::size_t (
+        default_smoothing_time * p.context ().frame_rate ());
+    osc->param ("amplitude").set (1.0f);
+    p.rt_request_process (32);
+    for (std::size_t i = start; i < sink->samples.size (); ++i)
+    {
+        const float ampl = 0.5f + 0.5f *
+            std::min (i - start + 1, length) / length;
+        BOOST_REQUIRE_SMALL (
+            sink->samples [i] - ampl * ref_sink->samples [i], 1e-5f);
+    }
+}
+
+/**
+ * Checks that an output whose device period is not a multiple of the
+ * block size processes just the blocks it needs in every callback and
+ * hands out every frame once and in order.
+ */
+void check_async_output ()
+{
+    const std::size_t block_size = 64;
+    const std::size_t period_size = 100;
+
+    processor p (0, block_size);
+    auto device = std::make_shared<recording_device> (period_size);
+    auto src    = std::make_shared<counting_source> ();
+    auto out    = std::make_shared<core::async_output> (device);
+
+    p.root ()->add (src);
+    p.root ()->add (out);
+    out->in ("input").connect (src->out);
+
+    for (std::size_t i = 1; i <= 16; ++i)
+    {
+        const int before = src->count;
+        device->period ();
+        const int blocks =
+            (i * period_size + block_size - 1) / block_size -
+            ((i - 1) * period_size + block_size - 1) / block_size;
+        BOOST_CHECK_EQUAL (src->count - before, blocks);
+        BOOST_CHECK_EQUAL (device->samples.size (), i * period_size);
+    }
+
+    for (std::size_t i = 0; i < device->samples.size (); ++i)
+        BOOST_REQUIRE_EQUAL (device->samples [i],
+                             float (i / block_size + 1));
+}
+
+} /* anonymous namespace */
 
 BOOST_AUTO_TEST_SUITE(graph_core_test_suite);
 
@@ -46,4 +388,133 @@ BOOST_AUTO_TEST_CASE(test_port_todo)
     BOOST_CHECK (1);
 }
 
+BOOST_AUTO_TEST_CASE(test_core_pipe)
+{
+    check_pipe (false);
+    check_pipe (true);
+}
+
+BOOST_AUTO_TEST_CASE(test_core_pipe_stop)
+{
+    // Starting and stopping the worker while another thread keeps
+    // processing must not lose or repeat any block.
+    processor p (0, 64);
+    auto src  = std::make_shared<counting_source> ();
+    auto pipe = std::make_shared<core::audio_pipe> ();
+    auto sink = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (pipe);
+    p.root ()->add (sink);
+    pipe->in ("input").connect (src->out);
+    sink->in.connect (pipe->out ("output"));
+    pipe->param ("cpu").set (0);
+
+    std::atomic<bool> done (false);
+    std::thread rt ([&] {
+            while (!done)
+                p.rt_request_process ();
+        });
+    for (int i = 0; i < 100; ++i)
+    {
+        pipe->start ();
+        ::usleep (1 << 8);
+        pipe->stop ();
+    }
+    done = true;
+    rt.join ();
+
+    BOOST_CHECK_EQUAL (sink->last, float (src->count - 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_core_pipe_chain)
+{
+    check_pipe_chain (false);
+    check_pipe_chain (true);
+}
+
+BOOST_AUTO_TEST_CASE(test_core_convolver)
+{
+    check_convolver (false);
+    check_convolver (true);
+}
+
+BOOST_AUTO_TEST_CASE(test_core_convolver_removed)
+{
+    processor p (0, 64);
+    auto conv = std::make_shared<core::audio_convolver> ();
+    std::weak_ptr<node> weak_conv = conv;
+
+    p.root ()->add (conv);
+    p.start ();
+
+    // The response is still being prepared when the node goes away.
+    conv->set_impulse (std::vector<float> (1 << 16, 0.5f));
+    p.root ()->remove (conv);
+    conv.reset ();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        p.rt_request_process ();
+        ::usleep (1 << 10);
+    }
+    p.stop ();
+    BOOST_CHECK (weak_conv.expired ());
+}
+
+BOOST_AUTO_TEST_CASE(test_core_oscillator)
+{
+    check_oscillator_smoothing ();
+}
+
+BOOST_AUTO_TEST_CASE(test_core_async_output)
+{
+    check_async_output ();
+}
+
+BOOST_AUTO_TEST_CASE(test_core_delay)
+{
+    check_delay_node<core::audio_delay> ({ { "wet", 1.0f },
+                                           { "dry", 0.0f } });
+    check_delay_node<core::audio_echo> ({ { "feedback", 0.0f },
+                                          { "damping", 0.0f },
+                                          { "wet", 1.0f },
+                                          { "dry", 0.0f } });
+    check_delay_node<core::audio_chorus> ({ { "depth", 0.0f },
+                                            { "wet", 1.0f },
+                                            { "dry", 0.0f } });
+    check_delay_node<core::audio_flanger> ({ { "depth", 0.0f },
+                                             { "feedback", 0.0f },
+                                             { "wet", 1.0f },
+                                             { "dry", 0.0f } });
+}
+
+#if PSYNTH_DEBUG
+
+BOOST_AUTO_TEST_CASE(test_core_subnormal_tracing)
+{
+    processor p (0, 64);
+    auto src  = std::make_shared<subnormal_source> ();
+    auto sink = std::make_shared<capturing_sink> ();
+
+    p.root ()->add (src);
+    p.root ()->add (sink);
+    sink->in.connect (src->out);
+
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->subnormal_count (), 0u);
+
+    psynth::base::enable_subnormal_tracing (true);
+    p.rt_request_process ();
+    psynth::base::enable_subnormal_tracing (false);
+    BOOST_CHECK_EQUAL (src->subnormal_count (), 64u * 2);
+    BOOST_CHECK_EQUAL (sink->subnormal_count (), 0u);
+
+    src->reset_subnormal_count ();
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->subnormal_count (), 0u);
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END ();
@@ -0,0 +1,102 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        host.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Graph host unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/new_graph/sink_node.hpp>
+#include <psynth/new_graph/processor.hpp>
+#include <psynth/new_graph/host.hpp>
+#include <psynth/new_graph/core/patch.hpp>
+
+using namespace psynth::graph;
+
+namespace
+{
+
+struct counting_sink : public sink_node
+{
+    std::atomic<int> count;
+    counting_sink () : count (0) {}
+    void rt_do_process (rt_process_context& ctx)
+    { ++count; }
+};
+
+processor_ptr make_session (std::shared_ptr<counting_sink>& sink)
+{
+    auto p = std::make_shared<processor> ();
+    sink = std::make_shared<counting_sink> ();
+    p->root ()->add (sink);
+    return p;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE(graph_host_test_suite);
+
+BOOST_AUTO_TEST_CASE(test_host)
+{
+    host h (2, 1);
+    std::shared_ptr<counting_sink> sink1, sink2, sink3;
+
+    auto s1 = h.add (make_session (sink1));
+    auto s2 = h.add (make_session (sink2));
+    BOOST_CHECK_EQUAL (h.size (), 2u);
+    BOOST_CHECK (s1->proc ().job_pool () == h.job_pool ());
+    BOOST_CHECK (!s1->proc ().is_running ());
+
+    h.start ();
+    BOOST_CHECK_THROW (h.start (), host_error);
+    BOOST_CHECK (s1->proc ().is_running ());
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+
+    auto s3 = h.add (make_session (sink3));
+    BOOST_CHECK (s3->proc ().is_running ());
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+
+    h.remove (s1);
+    BOOST_CHECK_EQUAL (h.size (), 2u);
+    BOOST_CHECK (!s1->proc ().is_running ());
+    auto removed_count = sink1->count.load ();
+    std::this_thread::sleep_for (std::chrono::milliseconds (10));
+    BOOST_CHECK_EQUAL (sink1->count, removed_count);
+
+    h.stop ();
+    BOOST_CHECK (!s2->proc ().is_running ());
+
+    BOOST_CHECK (sink1->count > 0);
+    BOOST_CHECK (sink2->count >= sink3->count);
+    BOOST_CHECK (sink3->count > 0);
+    BOOST_CHECK_EQUAL (s2->stats ().blocks, std::size_t (sink2->count));
+    BOOST_CHECK (s2->load () >= 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
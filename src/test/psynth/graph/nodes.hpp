@@ -0,0 +1,89 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        nodes.hpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Nodes shared by the graph unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PSYNTH_TEST_GRAPH_NODES_H_
+#define PSYNTH_TEST_GRAPH_NODES_H_
+
+#include <psynth/new_graph/node.hpp>
+#include <psynth/new_graph/sink_node.hpp>
+#include <psynth/new_graph/buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+namespace psynth
+{
+namespace test
+{
+
+/**
+ * Fills its output with the number of blocks it has processed so
+ * far, counting the current one.
+ */
+struct counting_source : public graph::node
+{
+    graph::audio_out_port    out;
+    graph::in_control<float> gain;
+    int                      count;
+
+    counting_source ()
+        : out ("output", this)
+        , gain ("gain", this, 1.0f)
+        , count (0)
+    {}
+
+    void rt_do_process (graph::rt_process_context& ctx)
+    {
+        sound::fill_frames (
+            out.rt_out_range (), graph::audio_frame (float (++count)));
+    }
+};
+
+/**
+ * Keeps the left channel of the first frame of the last block.
+ */
+struct capturing_sink : public graph::sink_node
+{
+    graph::audio_in_port in;
+    float                last;
+
+    capturing_sink ()
+        : in ("input", this)
+        , last (-1)
+    {}
+
+    void rt_do_process (graph::rt_process_context& ctx)
+    {
+        last = sound::at_c<0> (in.rt_in_range () [0]);
+    }
+};
+
+} /* namespace test */
+} /* namespace psynth */
+
+#endif /* PSYNTH_TEST_GRAPH_NODES_H_ */
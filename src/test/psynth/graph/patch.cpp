@@ -37,8 +37,14 @@
 #include <psynth/new_graph/processor.hpp>
 #include <psynth/new_graph/core/patch.hpp>
 #include <psynth/new_graph/core/passive_output.hpp>
+#include <psynth/new_graph/buffer_port.hpp>
+#include <psynth/new_graph/control.hpp>
+
+#include "nodes.hpp"
 
 using namespace psynth::graph;
+using psynth::test::counting_source;
+using psynth::test::capturing_sink;
 
 BOOST_AUTO_TEST_SUITE(graph_patch_test_suite);
 
@@ -169,4 +175,89 @@ BOOST_AUTO_TEST_CASE (patch_out_port_attach)
     BOOST_CHECK_NO_THROW (patch->out ("mix-out-wtf"));
 }
 
+BOOST_AUTO_TEST_CASE (patch_freeze)
+{
+    using namespace psynth;
+
+    processor p (0, 64);
+    auto& factory = node_factory::self ();
+    auto patch = graph::core::new_patch ();
+    auto src   = std::make_shared<counting_source> ();
+    auto sink  = std::make_shared<capturing_sink> ();
+
+    patch->add (src);
+    auto out = patch->add (factory.create ("audio_patch_out_port"));
+    out->in ("input").connect (src->out);
+    p.root ()->add (patch);
+    p.root ()->add (sink);
+    sink->in.connect (patch->out ("output"));
+
+    patch->freeze (128);
+    BOOST_CHECK (patch->is_frozen ());
+
+    p.rt_request_process (4);
+    BOOST_CHECK_EQUAL (src->count, 2);
+    BOOST_CHECK_EQUAL (sink->last, 2.0f);
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->count, 2);
+    BOOST_CHECK_EQUAL (sink->last, 1.0f);
+
+    src->gain.set (0.5f);
+    BOOST_CHECK (!patch->is_frozen ());
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->count, 3);
+    BOOST_CHECK_EQUAL (sink->last, 3.0f);
+}
+
+BOOST_AUTO_TEST_CASE (patch_freeze_running)
+{
+    using namespace psynth;
+
+    processor p (0, 64);
+    auto& factory = node_factory::self ();
+    auto patch = graph::core::new_patch ();
+    auto src   = std::make_shared<counting_source> ();
+    auto sink  = std::make_shared<capturing_sink> ();
+
+    patch->add (src);
+    auto out = patch->add (factory.create ("audio_patch_out_port"));
+    out->in ("input").connect (src->out);
+    p.root ()->add (patch);
+    p.root ()->add (sink);
+    sink->in.connect (patch->out ("output"));
+    p.start ();
+
+    // Freezing again and unfreezing replace the loop from the
+    // real-time thread.
+    patch->freeze (128);
+    p.rt_request_process (4);
+    patch->freeze (64);
+    p.rt_request_process (4);
+    BOOST_CHECK_EQUAL (src->count, 3);
+    BOOST_CHECK_EQUAL (sink->last, 3.0f);
+
+    patch->unfreeze ();
+    p.rt_request_process ();
+    BOOST_CHECK_EQUAL (src->count, 4);
+    BOOST_CHECK_EQUAL (sink->last, 4.0f);
+    p.stop ();
+}
+
+BOOST_AUTO_TEST_CASE (patch_freeze_errors)
+{
+    using namespace psynth;
+
+    auto& factory = node_factory::self ();
+    auto patch = graph::core::new_patch ();
+
+    BOOST_CHECK_THROW (patch->freeze (0), core::patch_freeze_error);
+
+    patch->add (factory.create ("audio_patch_out_port"));
+    BOOST_CHECK_NO_THROW (patch->freeze (16));
+
+    patch->add (core::new_passive_output ());
+    BOOST_CHECK (!patch->is_frozen ());
+    BOOST_CHECK_THROW (patch->freeze (16), core::patch_freeze_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END ();
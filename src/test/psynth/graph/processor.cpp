@@ -108,6 +108,23 @@ BOOST_AUTO_TEST_CASE(test_processor_sink)
     BOOST_CHECK_EQUAL (n->count, 3);
 }
 
+BOOST_AUTO_TEST_CASE(test_processor_request_frames)
+{
+    processor p (0, 64);
+
+    std::shared_ptr<counting_sink> n = std::make_shared<counting_sink> ();
+    p.root ()->add (n);
+
+    BOOST_CHECK_EQUAL (p.rt_request_frames (100), 2);
+    BOOST_CHECK_EQUAL (n->count, 2);
+    BOOST_CHECK_EQUAL (p.rt_request_frames (28), 1);
+    BOOST_CHECK_EQUAL (n->count, 3);
+    BOOST_CHECK_EQUAL (p.rt_request_frames (0), 0);
+    BOOST_CHECK_EQUAL (p.rt_request_frames (64), 1);
+    BOOST_CHECK_EQUAL (p.rt_request_frames (200), 4);
+    BOOST_CHECK_EQUAL (n->count, 8);
+}
+
 BOOST_AUTO_TEST_CASE(test_processor_init)
 {
     processor p;
@@ -191,6 +208,29 @@ BOOST_AUTO_TEST_CASE(test_processor_async_event_two)
     BOOST_CHECK_EQUAL (var, 4);
 }
 
+BOOST_AUTO_TEST_CASE(test_processor_job)
+{
+    processor p;
+    int var = 0;
+
+    p.start ();
+    p.context ().push_job ([&] (async_process_context& ctx) {
+            ctx.push_rt_event (
+                make_rt_event ([&] (rt_process_context&) {
+                        var = 42;
+                    }));
+        });
+
+    for (int i = 0; i < 1000 && var == 0; ++i)
+    {
+        p.rt_request_process ();
+        ::usleep (1 << 10);
+    }
+    p.stop ();
+
+    BOOST_CHECK_EQUAL (var, 42);
+}
+
 BOOST_AUTO_TEST_CASE (test_processor_errors)
 {
     processor p;
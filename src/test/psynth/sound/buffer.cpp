@@ -53,6 +53,7 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <type_traits>
 
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/print.hpp>
@@ -76,6 +77,7 @@
 #include <psynth/sound/dynamic_buffer.hpp>
 #include <psynth/sound/dynamic_buffer_range.hpp>
 #include <psynth/sound/dynamic_buffer_range_factory.hpp>
+#include <psynth/sound/bind_operation.hpp>
 
 #include <psynth/sound/typedefs.hpp>
 #include <psynth/sound/output.hpp>
@@ -583,6 +585,73 @@ BOOST_AUTO_TEST_CASE (test_buffer_all)
     mgr.run ();
 }
 
+struct range_signature_fn
+{
+    typedef std::size_t result_type;
+    std::size_t calls = 0;
+
+    template <typename Range>
+    result_type operator () (const Range& r)
+    {
+        ++ calls;
+        return r.size () * 10 + num_samples<Range>::value;
+    }
+};
+
+/**
+ * An operation that can not be applied to const ranges.
+ */
+struct mutable_size_fn
+{
+    typedef std::size_t result_type;
+
+    template <typename Range>
+    typename std::enable_if<!std::is_const<Range>::value, result_type>::type
+    operator () (Range& r)
+    { return r.size (); }
+};
+
+BOOST_AUTO_TEST_CASE (test_buffer_bind_operation)
+{
+    typedef dynamic_buffer_range<
+        mpl::vector<mono32f_range, stereo16_range, stereo32sf_planar_range> >
+        test_range;
+
+    mono32f_buffer  mono_buf (16);
+    stereo16_buffer stereo_buf (32);
+
+    test_range rng (range (mono_buf));
+    auto sig = bind_operation (rng, range_signature_fn ());
+
+    BOOST_CHECK (sig.is_bound_to (rng));
+    BOOST_CHECK_EQUAL (sig (rng),
+                       apply_operation (rng, range_signature_fn ()));
+    BOOST_CHECK_EQUAL (sig (rng), 16u * 10 + 1);
+
+    rng = range (stereo_buf);
+    BOOST_CHECK (!sig.is_bound_to (rng));
+    BOOST_CHECK_EQUAL (sig (rng), 32u * 10 + 2);
+    BOOST_CHECK (sig.is_bound_to (rng));
+    BOOST_CHECK_EQUAL (sig.op ().calls, 3u);
+
+    const test_range crng (range (mono_buf));
+    BOOST_CHECK_EQUAL (sig (crng), 16u * 10 + 1);
+
+    auto size = bind_operation (rng, mutable_size_fn ());
+    BOOST_CHECK_EQUAL (size (rng), 32u);
+
+    stereo16_buffer src_buf (32);
+    fill_frames (range (src_buf), stereo16_frame (100, 200));
+    test_range src (range (src_buf));
+
+    auto copy = bind_operation (
+        src, rng, psynth::sound::detail::copy_frames_fn ());
+    BOOST_CHECK (copy.is_bound_to (src, rng));
+    copy (src, rng);
+    BOOST_CHECK (equal_frames (const_range (src_buf),
+                               const_range (stereo_buf)));
+}
+
 BOOST_AUTO_TEST_CASE (test_buffer_static_checks)
 {
     psynth::base::psynth_function_requires<BufferConcept<stereo32sf_buffer> >();
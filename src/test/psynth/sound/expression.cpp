@@ -0,0 +1,140 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        expression.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Tests for the lazy range expressions.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdlib>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/sound/expression.hpp>
+
+using namespace psynth::sound;
+
+namespace
+{
+
+const std::size_t test_size = 67;
+
+float random_sample ()
+{
+    return float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+}
+
+template <class Buffer>
+void randomize (Buffer& buf)
+{
+    generate_frames (range (buf), [] {
+            typename Buffer::value_type f;
+            static_generate (f, [] { return bits32sf (random_sample ()); });
+            return f;
+        });
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (sound_expression_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_expression_stereo)
+{
+    stereo32sf_planar_buffer a (test_size), b (test_size);
+    stereo32sf_planar_buffer expected (test_size), result (test_size);
+    randomize (a);
+    randomize (b);
+
+    const float gain = 0.3f;
+    transform_frames (
+        const_range (a), const_range (b), range (expected),
+        [&] (stereo32sf_frame x, stereo32sf_frame y) {
+            stereo32sf_frame r;
+            static_transform (x, y, r, [&] (bits32sf u, bits32sf v) {
+                    return bits32sf ((float (u) + float (v) * gain) / 2.0f
+                                     - float (v));
+                });
+            return r;
+        });
+
+    lazy (range (result)) =
+        (lazy (const_range (a)) + lazy (const_range (b)) * gain) / 2.0f
+        - lazy (const_range (b));
+    BOOST_CHECK (equal_frames (const_range (expected),
+                               const_range (result)));
+}
+
+BOOST_AUTO_TEST_CASE (test_expression_broadcast)
+{
+    stereo32sf_planar_buffer a (test_size);
+    mono32sf_buffer env (test_size);
+    stereo32sf_buffer expected (test_size), result (test_size);
+    randomize (a);
+    randomize (env);
+
+    copy_frames (const_range (a), range (expected));
+    for (std::size_t i = 0; i < test_size; ++i)
+    {
+        const float e = at_c<0> (const_range (env) [i]);
+        at_c<0> (range (expected) [i]) = -(at_c<0> (range (expected) [i]) * e);
+        at_c<1> (range (expected) [i]) = -(at_c<1> (range (expected) [i]) * e);
+    }
+
+    lazy (range (result)) =
+        -(lazy (const_range (a)) * lazy (const_range (env)));
+    BOOST_CHECK (equal_frames (const_range (expected),
+                               const_range (result)));
+}
+
+BOOST_AUTO_TEST_CASE (test_expression_in_place)
+{
+    mono32sf_buffer a (test_size), b (test_size), expected (test_size);
+    randomize (a);
+    randomize (b);
+
+    transform_frames (
+        const_range (a), const_range (b), range (expected),
+        [] (mono32sf_frame x, mono32sf_frame y) {
+            return mono32sf_frame ((float (at_c<0> (x)) + 1.0f) *
+                                   float (at_c<0> (y)) * 0.5f);
+        });
+
+    auto out = lazy (range (a));
+    out = out + 1.0f;
+    out *= lazy (const_range (b));
+    out *= 0.5f;
+    BOOST_CHECK (equal_frames (const_range (expected), const_range (a)));
+
+    out = 0.25f;
+    out -= lazy (const_range (b));
+    for (std::size_t i = 0; i < test_size; ++i)
+        BOOST_CHECK_EQUAL (float (at_c<0> (const_range (a) [i])),
+                           0.25f - float (at_c<0> (const_range (b) [i])));
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
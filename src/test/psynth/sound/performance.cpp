@@ -97,6 +97,9 @@ const std::size_t num_trials  = 1 << 10;
 #define STEREO_PLANAR_RANGE(T) \
     buffer_range<planar_frame_iterator<T*,stereo_space> >
 
+#define MONO_RANGE(T) \
+    buffer_range<frame<T,mono_layout>*>
+
 
 template <typename Range>
 void fill_range_max (const Range& v)
@@ -124,9 +127,40 @@ struct fill_psynth
     }
 };
 
+// fill_frames() without the vectorized kernels
+template <typename Range, typename P>
+struct fill_generic : public fill_psynth<Range, P>
+{
+    fill_generic (const Range& v_in, const P& p_in)
+	: fill_psynth<Range, P> (v_in, p_in) {}
+
+    void operator () () const
+    {
+	detail::fill_frames_aux (this->_v, this->_p, detail::no_simd_tag ());
+    }
+};
+
 template <typename Range, typename P>
 struct fill_nonpsynth;
 
+template <typename T1, typename T2>
+struct fill_nonpsynth<MONO_RANGE(T1), frame<T2,mono_layout> >
+{
+    typedef MONO_RANGE(T1) Range;
+    typedef frame<T2,mono_layout> P;
+    Range _v;
+    P _p;
+
+    fill_nonpsynth (const Range& v_in, const P& p_in)
+	: _v(v_in), _p(p_in) {}
+
+    void operator () () const
+    {
+        T1* first = (T1*) _v.begin ();
+        std::fill (first, first + _v.size (), psynth::sound::at_c<0> (_p));
+    }
+};
+
 template <typename T, typename P>
 struct fill_nonpsynth<STEREO_RANGE(T), P>
 {
@@ -234,6 +268,10 @@ void test_fill (std::size_t trials)
 	"psynth: " << measure_time (
 	    fill_psynth<Range,P> (range (bufp), P(0)), trials));
 
+    BOOST_TEST_MESSAGE (
+	"psynth generic: " << measure_time (
+	    fill_generic<Range,P> (range (bufp), P(0)), trials));
+
     BOOST_TEST_MESSAGE (
 	"non-psynth: "<< measure_time (
 	    fill_nonpsynth<Range,P> (range (bufn), P(0)), trials));
@@ -357,9 +395,41 @@ struct copy_psynth
     }
 };
 
+template <typename Range1, typename Range2>
+struct copy_generic : public copy_psynth<Range1, Range2>
+{
+    copy_generic (const Range1& v1_in, const Range2& v2_in)
+	: copy_psynth<Range1, Range2> (v1_in, v2_in) {}
+
+    void operator () () const
+    {
+	detail::copy_frames_aux (this->_v1, this->_v2, detail::no_simd_tag ());
+    }
+};
+
 template <typename Range1, typename Range2>
 struct copy_nonpsynth;
 
+template <typename T1, typename T2>
+struct copy_nonpsynth<MONO_RANGE(T1),MONO_RANGE(T2)>
+{
+    typedef MONO_RANGE(T1) Range1;
+    typedef MONO_RANGE(T2) Range2;
+    Range1 _v1;
+    Range2 _v2;
+
+    copy_nonpsynth (const Range1& v1_in, const Range2& v2_in)
+	: _v1 (v1_in)
+	, _v2 (v2_in) {}
+
+    void operator () () const
+    {
+        T1* first1 = (T1*) _v1.begin ();
+        T2* first2 = (T2*) _v2.begin ();
+        std::copy (first1, first1 + _v1.size (), first2);
+    }
+};
+
 template <typename T1, typename T2>
 struct copy_nonpsynth<STEREO_RANGE(T1),STEREO_RANGE(T2)>
 {
@@ -502,6 +572,10 @@ void test_copy (std::size_t trials)
 	"psynth: " << measure_time (
 	    copy_psynth<Range1,Range2> (range(bufp1), range (bufp2)), trials));
 
+    BOOST_TEST_MESSAGE (
+	"psynth generic: " << measure_time (
+	    copy_generic<Range1,Range2> (range(bufp1), range (bufp2)), trials));
+
     BOOST_TEST_MESSAGE (
 	"non-psynth: " << measure_time (
 	    copy_nonpsynth<Range1,Range2> (range (bufn1), range (bufn2)), trials));
@@ -540,7 +614,52 @@ struct transform_psynth
     }
 };
 
+template <typename T,typename Frame>
+struct mono_scale
+{
+    frame<T,mono_layout> operator() (const Frame& p) const
+    {
+        return frame<T,mono_layout> (T (psynth::sound::at_c<0> (p) * 0.1f));
+    }
+};
+
+template <typename Range1, typename Range2, typename F>
+struct transform_generic : public transform_psynth<Range1, Range2, F>
+{
+    transform_generic(const Range1& v1_in, const Range2& v2_in, const F& f_in)
+	: transform_psynth<Range1, Range2, F> (v1_in, v2_in, f_in) {}
+
+    void operator() () const
+    {
+        F f = this->_f;
+	detail::transform_frames_aux (this->_v1, this->_v2, f,
+                                      detail::no_simd_tag ());
+    }
+};
+
 template <typename Range1, typename Range2, typename F> struct transform_nonpsynth;
+
+template <typename T1, typename T2, typename F>
+struct transform_nonpsynth<MONO_RANGE(T1), MONO_RANGE(T2),F>
+{
+    typedef MONO_RANGE(T1) Range1;
+    typedef MONO_RANGE(T2) Range2;
+    Range1 _v1;
+    Range2 _v2;
+    F _f;
+
+    transform_nonpsynth (const Range1& v1_in, const Range2& v2_in, const F& f_in)
+	: _v1(v1_in), _v2(v2_in), _f(f_in) {}
+
+    void operator ()() const
+    {
+        T1* first1 = (T1*)_v1.begin ();
+        T2* first2 = (T2*)_v2.begin ();
+        T1* last1  = first1 + _v1.size ();
+        while (first1 != last1)
+            *first2++ = T2 (*first1++ * 0.1f);
+    }
+};
 template <typename T1, typename T2, typename F>
 struct transform_nonpsynth<STEREO_RANGE(T1), STEREO_RANGE(T2),F>
 {
@@ -665,6 +784,11 @@ void test_transform (std::size_t trials)
 	    transform_psynth<Range1, Range2, F>(
 		range (bufp1), range (bufp2), F()), trials));
 
+    BOOST_TEST_MESSAGE (
+	"psynth generic: " << measure_time (
+	    transform_generic<Range1, Range2, F>(
+		range (bufp1), range (bufp2), F()), trials));
+
     BOOST_TEST_MESSAGE (
 	"non-psynth: "<< measure_time (
 	    transform_nonpsynth<Range1,Range2,F>(
@@ -693,6 +817,14 @@ BOOST_AUTO_TEST_CASE (test_fill_frames_performance)
     BOOST_TEST_MESSAGE (
 	"Test fill_frames() on stereo8_planar_buffer with rlstereo8_frame");
     test_fill<stereo8_planar_range, rlstereo8_frame>(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test fill_frames() on stereo32sf_planar_buffer with stereo32sf_frame");
+    test_fill<stereo32sf_planar_range, stereo32sf_frame>(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test fill_frames() on mono32sf_buffer with mono32sf_frame");
+    test_fill<mono32sf_range, mono32sf_frame>(num_trials);
 }
 
 BOOST_AUTO_TEST_CASE (test_for_each_frame_performance)
@@ -726,6 +858,15 @@ BOOST_AUTO_TEST_CASE (test_copy_frames_performance)
     BOOST_TEST_MESSAGE (
 	"Test copy_frames() between stereo8_planar_buffer and stereo8_buffer");
     test_copy<stereo8_planar_range,stereo8_range>(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test copy_frames() between stereo32sf_planar_buffer and "
+	"stereo32sf_planar_buffer");
+    test_copy<stereo32sf_planar_range,stereo32sf_planar_range>(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test copy_frames() between mono32sf_buffer and mono32sf_buffer");
+    test_copy<mono32sf_range,mono32sf_range>(num_trials);
 }
 
 BOOST_AUTO_TEST_CASE (test_transform_frames_performance)
@@ -762,6 +903,21 @@ BOOST_AUTO_TEST_CASE (test_transform_frames_performance)
 	stereo8_range,
 	rlstereo_to_stereo<
 	    bits8,planar_frame_reference<bits8,stereo_space> > >(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test transform_frames() between stereo32sf_planar_buffer and "
+	"stereo32sf_planar_buffer");
+    test_transform<
+	stereo32sf_planar_range,
+	stereo32sf_planar_range,
+	rlstereo_to_stereo<bits32sf, stereo32sfc_planar_ref> >(num_trials);
+
+    BOOST_TEST_MESSAGE (
+	"Test transform_frames() between mono32sf_buffer and mono32sf_buffer");
+    test_transform<
+	mono32sf_range,
+	mono32sf_range,
+	mono_scale<bits32sf, mono32sf_frame> >(num_trials);
 }
 
 BOOST_AUTO_TEST_SUITE_END ();
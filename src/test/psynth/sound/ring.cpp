@@ -29,6 +29,7 @@
  */
 
 #include <iostream>
+#include <thread>
 
 #include <boost/test/unit_test.hpp>
 
@@ -37,6 +38,8 @@
 
 #include <psynth/sound/dynamic_ring_buffer.hpp>
 #include <psynth/sound/ring_buffer.hpp>
+#include <psynth/sound/spsc_ring_buffer.hpp>
+#include <psynth/sound/mirrored_buffer.hpp>
 
 using namespace psynth::sound;
 
@@ -146,4 +149,134 @@ BOOST_AUTO_TEST_CASE (test_dynamic_ring_buffer)
 				       sample_range))));
 }
 
+BOOST_AUTO_TEST_CASE (test_spsc_ring_buffer)
+{
+    stereo32sf_planar_buffer buf (buffer_size);
+    stereo32sf_planar_spsc_ring_buffer ring (buffer_size * 1.3);
+    auto& rng = range (ring);
+
+    BOOST_CHECK_EQUAL (rng.write (sample_range), buffer_size);
+    BOOST_CHECK_EQUAL (rng.available (), buffer_size);
+    BOOST_CHECK_EQUAL (rng.read (range (buf)), buffer_size);
+    BOOST_CHECK (equal_frames (range (buf), sample_range));
+    BOOST_CHECK (rng.error () == ring_buffer_error::none);
+
+    // Wraps around the end of the buffer.
+    BOOST_CHECK_EQUAL (rng.write (sample_range), buffer_size);
+    BOOST_CHECK_EQUAL (rng.sub_buffer_one (buffer_size).size () +
+                       rng.sub_buffer_two (buffer_size).size (),
+                       buffer_size);
+    BOOST_CHECK (rng.sub_buffer_two (buffer_size).size () > 0);
+    BOOST_CHECK_EQUAL (rng.read (range (buf)), buffer_size);
+    BOOST_CHECK (equal_frames (range (buf), sample_range));
+
+    // Does not overwrite the frames that were not read.
+    BOOST_CHECK_EQUAL (rng.write (sample_range), buffer_size);
+    BOOST_CHECK_EQUAL (rng.write (sample_range), rng.size () - buffer_size);
+    BOOST_CHECK (rng.error () == ring_buffer_error::underrun);
+    BOOST_CHECK_EQUAL (rng.space (), 0);
+    BOOST_CHECK_EQUAL (rng.read (range (buf)), buffer_size);
+    BOOST_CHECK (equal_frames (range (buf), sample_range));
+
+    rng.clear_error ();
+    BOOST_CHECK_EQUAL (rng.skip (buffer_size), rng.size () - buffer_size);
+    BOOST_CHECK_EQUAL (rng.read (range (buf)), 0);
+    BOOST_CHECK (rng.error () == ring_buffer_error::overrun);
+}
+
+BOOST_AUTO_TEST_CASE (test_spsc_ring_buffer_threads)
+{
+    const std::size_t total = 1 << 16;
+    const std::size_t block = 100;
+
+    mono32sf_spsc_ring_buffer ring (block * 3);
+    auto& rng = range (ring);
+
+    std::thread producer ([&] {
+            mono32sf_buffer buf (block);
+            std::size_t count = 0;
+            while (count < total)
+            {
+                const std::size_t n = std::min (block, total - count);
+                for (std::size_t i = 0; i < n; ++i)
+                    range (buf) [i] = mono32sf_frame (float (count + i));
+                auto written = rng.write (range (buf), n);
+                count += written;
+                if (!written)
+                    std::this_thread::yield ();
+            }
+        });
+
+    mono32sf_buffer buf (block / 3);
+    std::size_t count = 0;
+    bool ordered = true;
+    while (count < total)
+    {
+        auto nread = rng.read (range (buf), std::min<std::size_t> (
+                                   rng.available (), buf.size ()));
+        for (std::size_t i = 0; i < std::size_t (nread); ++i)
+            ordered = ordered &&
+                float (at_c<0> (range (buf) [i])) == float (count + i);
+        count += nread;
+        if (!nread)
+            std::this_thread::yield ();
+    }
+    producer.join ();
+
+    BOOST_CHECK (ordered);
+    BOOST_CHECK_EQUAL (rng.available (), 0);
+}
+
+BOOST_AUTO_TEST_CASE (test_mirrored_ring_buffer)
+{
+    typedef mirrored_buffer<stereo32sf_frame, true> buffer_type;
+
+    buffer_type mbuf (100);
+    auto left = at_c<0> (range (mbuf).begin ());
+    auto right = at_c<1> (range (mbuf).begin ());
+    left [0] = 0.5f;
+    right [1] = 0.25f;
+    if (mbuf.is_mirrored ())
+    {
+        BOOST_CHECK_EQUAL (float (left [mbuf.size ()]), 0.5f);
+        BOOST_CHECK_EQUAL (float (right [mbuf.size () + 1]), 0.25f);
+    }
+
+    stereo32sf_planar_buffer buf (buffer_size);
+    spsc_ring_buffer<buffer_type> ring (buffer_size);
+    auto& rng = range (ring);
+
+    BOOST_CHECK (std::size_t (rng.size ()) >= buffer_size);
+    if (!rng.is_mirrored ())
+    {
+        BOOST_TEST_MESSAGE ("Mirrored memory not supported.");
+        return;
+    }
+
+    BOOST_CHECK_EQUAL (rng.write (sample_range, 700), 700);
+    BOOST_CHECK_EQUAL (rng.skip (700), 700);
+    BOOST_CHECK_EQUAL (rng.write (sample_range), buffer_size);
+
+    // The window wraps around the end but it is contiguous.
+    auto window = rng.sub_buffer_one (buffer_size);
+    BOOST_CHECK_EQUAL (window.size (), buffer_size);
+    BOOST_CHECK_EQUAL (rng.sub_buffer_two (buffer_size).size (), 0);
+    BOOST_CHECK (equal_frames (window, sample_range));
+    BOOST_CHECK_EQUAL (rng.read (range (buf)), buffer_size);
+    BOOST_CHECK (equal_frames (range (buf), sample_range));
+
+    ring_buffer<buffer_type> rring (buffer_size);
+    auto& rrng = range (rring);
+    auto reader = rrng.begin_pos ();
+    BOOST_CHECK (rrng.is_mirrored ());
+    rrng.write (sample_range, 700);
+    rrng.read (reader, range (buf), 700);
+    for (int i = 0; i < 3; ++i)
+    {
+        rrng.write (sample_range);
+        BOOST_CHECK_EQUAL (rrng.read (reader, range (buf)), buffer_size);
+        BOOST_CHECK (equal_frames (range (buf), sample_range));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ();
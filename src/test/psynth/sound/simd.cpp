@@ -0,0 +1,212 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        simd.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Vectorized sound algorithms unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <cstdlib>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/algorithm.hpp>
+
+using namespace psynth::sound;
+
+namespace
+{
+
+const std::size_t max_size   = 67;
+const std::size_t max_offset = 5;
+
+float random_sample ()
+{
+    return float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+}
+
+const float* plane (const stereo32sf_planar_buffer& buf, std::size_t k)
+{
+    return reinterpret_cast<const float*> (
+        k == 0 ? at_c<0> (const_range (buf).begin ())
+               : at_c<1> (const_range (buf).begin ()));
+}
+
+float* plane (stereo32sf_planar_buffer& buf, std::size_t k)
+{
+    return reinterpret_cast<float*> (
+        k == 0 ? at_c<0> (range (buf).begin ())
+               : at_c<1> (range (buf).begin ()));
+}
+
+float* plane (mono32sf_buffer& buf)
+{
+    return reinterpret_cast<float*> (range (buf).begin ());
+}
+
+void randomize (stereo32sf_planar_buffer& buf)
+{
+    for (std::size_t i = 0; i < std::size_t (buf.size ()); ++i)
+    {
+        plane (buf, 0) [i] = random_sample ();
+        plane (buf, 1) [i] = random_sample ();
+    }
+}
+
+void randomize (mono32sf_buffer& buf)
+{
+    for (std::size_t i = 0; i < std::size_t (buf.size ()); ++i)
+        plane (buf) [i] = random_sample ();
+}
+
+bool bit_equal (const float* a, const float* b, std::size_t n)
+{
+    return std::memcmp (a, b, n * sizeof (float)) == 0;
+}
+
+struct scale_stereo
+{
+    stereo32sf_frame operator () (const stereo32sfc_planar_ref& f) const
+    {
+        return stereo32sf_frame (at_c<1> (f) * 0.5f, at_c<0> (f) * -0.25f);
+    }
+};
+
+struct scale_mono
+{
+    mono32sf_frame operator () (const mono32sf_frame& f) const
+    { return mono32sf_frame (at_c<0> (f) * 0.5f + 0.125f); }
+};
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (sound_simd_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_simd_fill_frames)
+{
+    BOOST_TEST_MESSAGE ("Using SIMD instruction set: " << simd::isa_name);
+
+    for (std::size_t off = 0; off < max_offset; ++off)
+        for (std::size_t n = 0; n <= max_size; ++n)
+        {
+            stereo32sf_planar_buffer sbuf (off + n);
+            randomize (sbuf);
+            fill_frames (sub_range (range (sbuf), off, n),
+                         rlstereo32sf_frame (0.75f, -0.5f));
+
+            mono32sf_buffer mbuf (off + n);
+            randomize (mbuf);
+            fill_frames (sub_range (range (mbuf), off, n),
+                         mono32sf_frame (0.3f));
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                BOOST_REQUIRE_EQUAL (plane (sbuf, 0) [off + i], -0.5f);
+                BOOST_REQUIRE_EQUAL (plane (sbuf, 1) [off + i], 0.75f);
+                BOOST_REQUIRE_EQUAL (plane (mbuf) [off + i], 0.3f);
+            }
+        }
+}
+
+BOOST_AUTO_TEST_CASE (test_simd_copy_frames)
+{
+    for (std::size_t off = 0; off < max_offset; ++off)
+        for (std::size_t n = 0; n <= max_size; ++n)
+        {
+            stereo32sf_planar_buffer ssrc (n), sdst (off + n);
+            randomize (ssrc);
+            randomize (sdst);
+            copy_frames (const_range (ssrc),
+                         sub_range (range (sdst), off, n));
+            BOOST_REQUIRE (bit_equal (plane (ssrc, 0),
+                                      plane (sdst, 0) + off, n));
+            BOOST_REQUIRE (bit_equal (plane (ssrc, 1),
+                                      plane (sdst, 1) + off, n));
+
+            mono32sf_buffer msrc (off + n), mdst (n);
+            randomize (msrc);
+            copy_frames (sub_range (const_range (msrc), off, n),
+                         range (mdst));
+            BOOST_REQUIRE (bit_equal (plane (msrc) + off, plane (mdst), n));
+        }
+}
+
+BOOST_AUTO_TEST_CASE (test_simd_copy_frames_overlap)
+{
+    mono32sf_buffer buf (max_size), ref (max_size);
+    randomize (buf);
+    std::memcpy (plane (ref), plane (buf), max_size * sizeof (float));
+
+    copy_frames (sub_range (const_range (buf), 0, max_size - 3),
+                 sub_range (range (buf), 3, max_size - 3));
+    BOOST_CHECK (bit_equal (plane (ref), plane (buf) + 3, max_size - 3));
+}
+
+BOOST_AUTO_TEST_CASE (test_simd_transform_frames)
+{
+    for (std::size_t n = 0; n <= max_size; ++n)
+    {
+        stereo32sf_planar_buffer ssrc (n), sdst (n);
+        randomize (ssrc);
+        transform_frames (const_range (ssrc), range (sdst), scale_stereo ());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            BOOST_REQUIRE_EQUAL (plane (sdst, 0) [i],
+                                 float (plane (ssrc, 1) [i] * 0.5f));
+            BOOST_REQUIRE_EQUAL (plane (sdst, 1) [i],
+                                 float (plane (ssrc, 0) [i] * -0.25f));
+        }
+
+        mono32sf_buffer msrc (n), mdst (n);
+        randomize (msrc);
+        transform_frames (const_range (msrc), range (mdst), scale_mono ());
+        for (std::size_t i = 0; i < n; ++i)
+            BOOST_REQUIRE_EQUAL (plane (mdst) [i],
+                                 float (plane (msrc) [i] * 0.5f + 0.125f));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_simd_generate_frames)
+{
+    for (std::size_t n = 0; n <= max_size; ++n)
+    {
+        float count = 0;
+        stereo32sf_planar_buffer sbuf (n);
+        generate_frames (range (sbuf), [&] {
+                count += 1.0f;
+                return rlstereo32sf_frame (count, -count);
+            });
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            BOOST_REQUIRE_EQUAL (plane (sbuf, 0) [i], -float (i + 1));
+            BOOST_REQUIRE_EQUAL (plane (sbuf, 1) [i], float (i + 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
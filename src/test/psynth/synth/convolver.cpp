@@ -0,0 +1,214 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        convolver.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Convolution unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/synth/fft.hpp>
+#include <psynth/synth/convolver.hpp>
+
+using namespace psynth;
+
+namespace
+{
+
+std::vector<float> noise (std::size_t n)
+{
+    std::vector<float> ret (n);
+    for (auto& x : ret)
+        x = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+    return ret;
+}
+
+/**
+ * Convolves @a in with @a ir directly, in double precision.
+ */
+std::vector<float> direct_convolution (const std::vector<float>& in,
+                                       const std::vector<float>& ir)
+{
+    std::vector<float> ret (in.size ());
+    for (std::size_t i = 0; i < in.size (); ++i)
+    {
+        double y = 0;
+        for (std::size_t j = 0; j < ir.size () && j <= i; ++j)
+            y += double (in [i - j]) * ir [j];
+        ret [i] = y;
+    }
+    return ret;
+}
+
+float max_difference (const std::vector<float>& a,
+                      const std::vector<float>& b)
+{
+    float ret = 0.0f;
+    for (std::size_t i = 0; i < a.size (); ++i)
+        ret = std::max (ret, std::abs (a [i] - b [i]));
+    return ret;
+}
+
+/**
+ * Convolves two channels of noise with @a ir in blocks of @a
+ * block_size samples, @a blocks at a time, and compares with the
+ * direct convolution.
+ */
+void check_convolver (std::size_t ir_size, std::size_t block_size,
+                      std::size_t blocks, std::size_t size)
+{
+    BOOST_TEST_MESSAGE ("Checking convolution with response of "
+                        << ir_size << " in blocks of " << block_size);
+
+    const auto ir = noise (ir_size);
+    const std::vector<float> in [] = { noise (size), noise (size) };
+    std::vector<float> out [] = { in [0], in [1] };
+
+    synth::convolver conv (ir.empty () ? 0 : &ir [0], ir.size (),
+                           block_size, 2);
+    const std::size_t step = block_size * blocks;
+    for (std::size_t i = 0; i + step <= size; i += step)
+    {
+        const float* src [] = { &in [0][i], &in [1][i] };
+        float* dst [] = { &out [0][i], &out [1][i] };
+        conv.update_planes (src, dst, step);
+    }
+
+    // The direct sums have terms up to sqrt (ir_size).
+    const float tolerance = 2e-6f * (std::sqrt (float (ir_size)) + 1) *
+        std::log2 (float (4 * block_size));
+    for (std::size_t c = 0; c < 2; ++c)
+    {
+        auto expected = direct_convolution (in [c], ir);
+        expected.resize (size / step * step);
+        out [c].resize (expected.size ());
+        BOOST_CHECK_SMALL (max_difference (expected, out [c]), tolerance);
+    }
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (synth_convolver_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_fft)
+{
+    for (std::size_t n = 4; n <= 1024; n *= 2)
+    {
+        synth::real_fft fft (n);
+        BOOST_REQUIRE_EQUAL (fft.bins (), n / 2 + 1);
+
+        const auto x = noise (n);
+        std::vector<float> re (fft.bins ()), im (fft.bins ()), y (n);
+        fft.forward (&x [0], &re [0], &im [0]);
+
+        float error = 0.0f;
+        for (std::size_t k = 0; k < fft.bins (); ++k)
+        {
+            double r = 0, i = 0;
+            for (std::size_t t = 0; t < n; ++t)
+            {
+                const double w = -2 * M_PI * k * t / n;
+                r += x [t] * std::cos (w);
+                i += x [t] * std::sin (w);
+            }
+            error = std::max (error, float (std::abs (r - re [k])));
+            error = std::max (error, float (std::abs (i - im [k])));
+        }
+        BOOST_CHECK_SMALL (error, 1e-6f * n);
+
+        fft.inverse (&re [0], &im [0], &y [0]);
+        for (auto& s : y)
+            s /= n;
+        BOOST_CHECK_SMALL (max_difference (x, y), 1e-6f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_fft_steps)
+{
+    const std::size_t n = 256;
+    synth::real_fft fft (n);
+    const auto x = noise (n);
+    std::vector<float> re (fft.bins ()), im (fft.bins ());
+    std::vector<float> expected_re (fft.bins ()), expected_im (fft.bins ());
+    std::vector<float> y (n), expected_y (n);
+
+    fft.forward (&x [0], &expected_re [0], &expected_im [0]);
+    for (std::size_t i = 0; i < fft.work (); i += 7)
+        fft.forward_steps (&x [0], &x [n / 2], &re [0], &im [0],
+                           i, std::min (i + 7, fft.work ()));
+    BOOST_CHECK (re == expected_re);
+    BOOST_CHECK (im == expected_im);
+
+    fft.inverse (&expected_re [0], &expected_im [0], &expected_y [0]);
+    for (std::size_t i = 0; i < fft.work (); i += 13)
+        fft.inverse_steps (&re [0], &im [0], &y [0],
+                           i, std::min (i + 13, fft.work ()));
+    BOOST_CHECK (y == expected_y);
+}
+
+BOOST_AUTO_TEST_CASE (test_convolver)
+{
+    check_convolver (0, 16, 1, 256);
+    check_convolver (1, 16, 1, 256);
+    check_convolver (37, 2, 1, 256);
+    check_convolver (37, 16, 3, 480);
+    check_convolver (300, 64, 1, 1024);
+    // Four stages.
+    check_convolver (5000, 8, 1, 8192);
+    check_convolver (5000, 8, 4, 8192);
+}
+
+BOOST_AUTO_TEST_CASE (test_convolver_in_place)
+{
+    const auto ir = noise (1000);
+    const auto in = noise (4096);
+    auto expected = in;
+    auto out = in;
+
+    synth::convolver a (&ir [0], ir.size (), 32);
+    synth::convolver b (&ir [0], ir.size (), 32);
+    const float* src [] = { &in [0] };
+    float* dst [] = { &expected [0] };
+    float* both [] = { &out [0] };
+    a.update_planes (src, dst, in.size ());
+    b.update_planes (both, both, out.size ());
+    BOOST_CHECK (out == expected);
+
+    // After a reset the same input gives the same output.
+    b.reset ();
+    std::copy (in.begin (), in.end (), out.begin ());
+    b.update_planes (both, both, out.size ());
+    BOOST_CHECK (out == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
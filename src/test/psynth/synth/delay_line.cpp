@@ -0,0 +1,203 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        delay_line.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Delay line unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/synth/delay_line.hpp>
+
+using namespace psynth;
+
+namespace
+{
+
+typedef synth::delay_line::interpolation interpolation;
+
+const interpolation all_modes [] = {
+    interpolation::linear,
+    interpolation::cubic,
+    interpolation::allpass
+};
+
+std::vector<float> noise (std::size_t n)
+{
+    std::vector<float> ret (n);
+    for (auto& x : ret)
+        x = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+    return ret;
+}
+
+/**
+ * Writes the mono signal @a in to a fresh delay line in blocks of @a
+ * block samples, reading after every block with @a read, and returns
+ * what was read.
+ */
+template <class Read>
+std::vector<float> run_delay (const std::vector<float>& in,
+                              std::size_t max_delay, std::size_t block,
+                              Read read)
+{
+    synth::delay_line line (1, max_delay, block);
+    std::vector<float> out (in.size ());
+    for (std::size_t i = 0; i < in.size (); i += block)
+    {
+        const std::size_t n = std::min (block, in.size () - i);
+        const float* src [] = { &in [i] };
+        float*       dst [] = { &out [i] };
+        line.write_planes (src, n);
+        read (line, dst, i, n);
+    }
+    return out;
+}
+
+float delayed (const std::vector<float>& in, std::ptrdiff_t t)
+{
+    return t < 0 ? 0.0f : in [t];
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (synth_delay_line_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_delay_line_integer)
+{
+    const auto in = noise (1000);
+
+    for (auto mode : all_modes)
+        for (std::size_t d : { 1, 2, 13, 16, 100 })
+        {
+            float state = 0.0f;
+            const auto out = run_delay (
+                in, 100, 13,
+                [&] (synth::delay_line& line, float* const* dst,
+                     std::size_t, std::size_t n) {
+                    line.read_planes (dst, d, d, n, mode, &state);
+                });
+            for (std::size_t t = 0; t < in.size (); ++t)
+                BOOST_REQUIRE_EQUAL (out [t], delayed (in, std::ptrdiff_t (t)
+                                                       - std::ptrdiff_t (d)));
+        }
+}
+
+BOOST_AUTO_TEST_CASE (test_delay_line_fractional)
+{
+    const auto in = noise (1000);
+    std::vector<float> delays (in.size ());
+    for (std::size_t t = 0; t < in.size (); ++t)
+        delays [t] = 1.0f + 40.0f * (1.0f + std::sin (t * 0.01f));
+
+    const auto linear = run_delay (
+        in, 100, 16,
+        [&] (synth::delay_line& line, float* const* dst,
+             std::size_t i, std::size_t n) {
+            line.read_planes (dst, &delays [i], n);
+        });
+    for (std::size_t t = 0; t < in.size (); ++t)
+    {
+        const std::ptrdiff_t k = delays [t];
+        const double f = delays [t] - k;
+        const std::ptrdiff_t at = std::ptrdiff_t (t) - k;
+        const double expected = (1 - f) * delayed (in, at) +
+            f * delayed (in, at - 1);
+        BOOST_REQUIRE_SMALL (linear [t] - expected, 1e-6);
+    }
+
+    // The cubic interpolation is exact on straight lines.
+    std::vector<float> line_in (in.size ());
+    for (std::size_t t = 0; t < in.size (); ++t)
+        line_in [t] = 0.001f * t;
+    const auto cubic = run_delay (
+        line_in, 100, 16,
+        [&] (synth::delay_line& line, float* const* dst,
+             std::size_t i, std::size_t n) {
+            line.read_planes (dst, &delays [i], n, interpolation::cubic);
+        });
+    for (std::size_t t = 100; t < in.size (); ++t)
+        BOOST_REQUIRE_SMALL (cubic [t] - 0.001f * (t - delays [t]), 1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE (test_delay_line_allpass)
+{
+    // A low frequency sine is delayed by the fractional delay.
+    const float w = 0.05f;
+    const float d = 10.3f;
+    std::vector<float> in (2000);
+    for (std::size_t t = 0; t < in.size (); ++t)
+        in [t] = std::sin (w * t);
+
+    float state = 0.0f;
+    const auto out = run_delay (
+        in, 100, 64,
+        [&] (synth::delay_line& line, float* const* dst,
+             std::size_t, std::size_t n) {
+            line.read_planes (dst, d, d, n, interpolation::allpass, &state);
+        });
+    for (std::size_t t = 1000; t < in.size (); ++t)
+        BOOST_REQUIRE_SMALL (out [t] - std::sin (w * (t - d)), 1e-3f);
+}
+
+BOOST_AUTO_TEST_CASE (test_delay_line_feedback)
+{
+    // A comb filter, y [t] = x [t] + 0.5 y [t - d], reading before
+    // writing every block.
+    const auto in = noise (1000);
+    const std::size_t d = 20;
+    synth::delay_line line (1, d, d);
+
+    std::vector<float> expected (in.size ());
+    for (std::size_t t = 0; t < in.size (); ++t)
+        expected [t] = in [t] + 0.5f * (t < d ? 0.0f : expected [t - d]);
+
+    std::vector<float> out (in.size ());
+    float tap [7];
+    float* taps [] = { tap };
+    for (std::size_t i = 0; i < in.size (); i += 7)
+    {
+        const std::size_t n = std::min<std::size_t> (7, in.size () - i);
+        line.read_planes (taps, d - n, d - n, n);
+        for (std::size_t j = 0; j < n; ++j)
+            out [i + j] = in [i + j] + 0.5f * tap [j];
+        const float* back [] = { &out [i] };
+        line.write_planes (back, n);
+    }
+
+    for (std::size_t t = 0; t < in.size (); ++t)
+        BOOST_REQUIRE_EQUAL (out [t], expected [t]);
+
+    line.reset ();
+    line.read_planes (taps, 13.0f, 13.0f, 7);
+    for (std::size_t j = 0; j < 7; ++j)
+        BOOST_REQUIRE_EQUAL (tap [j], 0.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
@@ -0,0 +1,150 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        fast_math.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Fast math unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/synth/fast_math.hpp>
+
+using namespace psynth;
+
+namespace
+{
+
+const int samples = 100000;
+
+/**
+ * Checks that @a approx deviates from @a exact, computed in double
+ * precision, less than @a abs_error (x) or @a rel_error (x) times the
+ * exact value, for samples of x in [a, b].
+ */
+template <class Approx, class Exact, class AbsError, class RelError>
+void check_error (Approx approx, Exact exact, double a, double b,
+                  AbsError abs_error, RelError rel_error)
+{
+    for (int i = 0; i <= samples; ++i)
+    {
+        const float x = float (a + (b - a) * i / samples);
+        const double e = exact (double (x));
+        const double error = std::abs (approx (x) - e);
+        if (error > abs_error (x))
+            BOOST_REQUIRE_SMALL (error / std::abs (e), rel_error (x));
+    }
+}
+
+double none (double)
+{
+    return 0.0;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (synth_fast_math_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_fast_math_trigonometric)
+{
+    auto sin_cycles = [] (double x) { return std::sin (2 * M_PI * x); };
+    auto cos_cycles = [] (double x) { return std::cos (2 * M_PI * x); };
+    auto bound = [] (double) { return 2e-7; };
+    check_error (synth::fast_sin_cycles, sin_cycles, -4.0, 4.0, bound, none);
+    check_error (synth::fast_cos_cycles, cos_cycles, -4.0, 4.0, bound, none);
+    check_error (synth::fast_sin_cycles, sin_cycles, -1e3, 1e3, bound, none);
+
+    auto radians = [] (double x) { return 2e-7 + 1e-7 * std::abs (x); };
+    check_error (synth::fast_sin, [] (double x) { return std::sin (x); },
+                 -4 * M_PI, 4 * M_PI, radians, none);
+    check_error (synth::fast_cos, [] (double x) { return std::cos (x); },
+                 -4 * M_PI, 4 * M_PI, radians, none);
+
+    check_error (synth::fast_tan, [] (double x) { return std::tan (x); },
+                 -1.57, 1.57, none, [] (double x) {
+                     return 4e-7 + 1.2e-7 / (M_PI / 2 - std::abs (x));
+                 });
+
+    BOOST_CHECK_EQUAL (synth::fast_sin_cycles (0.0f), 0.0f);
+    BOOST_CHECK_EQUAL (synth::fast_cos_cycles (0.0f), 1.0f);
+    BOOST_CHECK_EQUAL (synth::fast_sin_cycles (0.25f), 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE (test_fast_math_exponential)
+{
+    auto rel = [] (double bound) { return [=] (double) { return bound; }; };
+    check_error (synth::fast_exp2, [] (double x) { return std::exp2 (x); },
+                 -126.0, 127.9, none, rel (2e-7));
+    check_error (synth::fast_log2, [] (double x) { return std::log2 (x); },
+                 1e-3, 1e3, none, rel (2.5e-7));
+    check_error (synth::fast_log2, [] (double x) { return std::log2 (x); },
+                 0.5, 2.0, rel (1.2e-7), none);
+    check_error (synth::fast_exp, [] (double x) { return std::exp (x); },
+                 -80.0, 80.0, none,
+                 [] (double x) { return 2e-7 + 7e-8 * std::abs (x); });
+
+    for (float y = -3.0f; y <= 3.0f; y += 0.7f)
+        check_error (
+            [=] (float x) { return synth::fast_pow (x, y); },
+            [=] (double x) { return std::pow (x, double (y)); },
+            1e-3, 1e3, none, [=] (double x) {
+                return 3e-7 + 1.2e-7 * std::abs (y * std::log2 (x));
+            });
+
+    for (int i = -126; i < 128; ++i)
+        BOOST_REQUIRE_EQUAL (synth::fast_exp2 (float (i)),
+                             std::ldexp (1.0f, i));
+    BOOST_CHECK_EQUAL (synth::fast_log2 (1.0f), 0.0f);
+    BOOST_CHECK_EQUAL (synth::fast_exp2 (-1000.0f), std::ldexp (1.0f, -126));
+    BOOST_CHECK (std::isfinite (synth::fast_exp2 (1000.0f)));
+}
+
+BOOST_AUTO_TEST_CASE (test_fast_math_tanh)
+{
+    check_error (synth::fast_tanh, [] (double x) { return std::tanh (x); },
+                 -12.0, 12.0, [] (double) { return 2e-7; }, none);
+    check_error (synth::fast_tanh, [] (double x) { return std::tanh (x); },
+                 -12.0, 12.0, none, [] (double) { return 6e-7; });
+    BOOST_CHECK_EQUAL (synth::fast_tanh (0.0f), 0.0f);
+    BOOST_CHECK_EQUAL (synth::fast_tanh (-1e30f), -1.0f);
+}
+
+BOOST_AUTO_TEST_CASE (test_fast_math_decibels)
+{
+    check_error (synth::db_to_gain,
+                 [] (double x) { return std::pow (10.0, x / 20); },
+                 -120.0, 24.0, none,
+                 [] (double x) { return 2e-7 + 8e-9 * std::abs (x); });
+    check_error (synth::gain_to_db,
+                 [] (double x) { return 20 * std::log10 (x); },
+                 1e-6, 16.0, none, [] (double) { return 3e-7; });
+    BOOST_CHECK_EQUAL (synth::db_to_gain (0.0f), 1.0f);
+    BOOST_CHECK_EQUAL (synth::gain_to_db (1.0f), 0.0f);
+    BOOST_CHECK_CLOSE (synth::gain_to_db (0.0f), -764.6f, 0.1f);
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
@@ -0,0 +1,264 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        filter.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Filter unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/base/cpu.hpp>
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/synth/biquad_bank.hpp>
+#include <psynth/synth/filter.hpp>
+#include <psynth/synth/kernels.hpp>
+#include <psynth/synth/state_variable_filter.hpp>
+
+using namespace psynth;
+using namespace psynth::sound;
+
+namespace
+{
+
+typedef synth::state_variable_filter::mode svf_mode;
+
+const float frame_rate = 44100.0f;
+
+/**
+ * Filters @a n samples of @a in with @a filter and returns the
+ * maximum absolute value of the second half of the output.
+ */
+float settled_peak (synth::state_variable_filter& filter,
+                    const std::vector<float>& in)
+{
+    std::vector<float> out (in.size ());
+    const float* src [] = { &in [0] };
+    float* dst [] = { &out [0] };
+    filter.update_planes (src, dst, in.size ());
+
+    float peak = 0.0f;
+    for (std::size_t i = in.size () / 2; i < in.size (); ++i)
+        peak = std::max (peak, std::abs (out [i]));
+    return peak;
+}
+
+std::vector<float> noise (std::size_t n)
+{
+    std::vector<float> ret (n);
+    for (auto& x : ret)
+        x = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+    return ret;
+}
+
+std::vector<float> sine (float freq, std::size_t n)
+{
+    std::vector<float> ret (n);
+    for (std::size_t i = 0; i < n; ++i)
+        ret [i] = std::sin (2 * M_PI * freq * i / frame_rate);
+    return ret;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (synth_filter_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_svf_response)
+{
+    const std::vector<float> dc (8192, 1.0f);
+    const float expected_dc [] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    for (int m = 0; m < 4; ++m)
+    {
+        synth::state_variable_filter f (1, svf_mode (m), 1000.0f, 0.7071f,
+                                        frame_rate);
+        BOOST_CHECK_SMALL (settled_peak (f, dc) - expected_dc [m], 1e-3f);
+    }
+
+    synth::state_variable_filter lp (1, svf_mode::lowpass, 1000.0f, 2.0f,
+                                     frame_rate);
+    BOOST_CHECK_CLOSE (settled_peak (lp, sine (1000.0f, 8192)), 2.0f, 1.0f);
+    lp.reset ();
+    BOOST_CHECK_SMALL (settled_peak (lp, sine (15000.0f, 8192)), 0.01f);
+
+    synth::state_variable_filter bp (1, svf_mode::bandpass, 1000.0f, 2.0f,
+                                     frame_rate);
+    BOOST_CHECK_CLOSE (settled_peak (bp, sine (1000.0f, 8192)), 1.0f, 1.0f);
+
+    synth::state_variable_filter notch (1, svf_mode::notch, 1000.0f, 2.0f,
+                                        frame_rate);
+    BOOST_CHECK_SMALL (settled_peak (notch, sine (1000.0f, 8192)), 0.01f);
+}
+
+BOOST_AUTO_TEST_CASE (test_svf_modulated)
+{
+    const std::size_t n = 44100;
+    std::vector<float> in (n), mod (n), out (n);
+    std::srand (42);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        in [i]  = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+        mod [i] = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    const float* src [] = { &in [0] };
+    float* dst [] = { &out [0] };
+    for (int m = 0; m < 4; ++m)
+    {
+        synth::state_variable_filter f (1, svf_mode (m), 10000.0f, 20.0f,
+                                        frame_rate);
+        f.update_planes (src, dst, &mod [0], n);
+        for (std::size_t i = 0; i < n; ++i)
+            BOOST_REQUIRE (std::abs (out [i]) < 100.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_svf_ranges)
+{
+    const std::size_t n = 300;
+    stereo32sf_planar_buffer in (n), out (n);
+    mono32sf_buffer mod (n);
+    std::vector<float> left (n), right (n), expected (n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        left [i]  = std::sin (i * 0.1f);
+        right [i] = std::cos (i * 0.3f);
+        range (in) [i] = stereo32sf_frame (left [i], right [i]);
+        range (mod) [i] = mono32sf_frame (std::sin (i * 0.01f));
+    }
+
+    synth::state_variable_filter stereo (2, svf_mode::highpass, 500.0f);
+    stereo.update (const_range (in), range (out), const_range (mod));
+    stereo.set_frequency (2000.0f);
+    stereo.update (const_range (in), range (out));
+
+    synth::state_variable_filter mono (1, svf_mode::highpass, 500.0f);
+    const float* src [] = { &right [0] };
+    float* dst [] = { &expected [0] };
+    mono.update_planes (src, dst,
+                        reinterpret_cast<const float*> (&range (mod) [0]), n);
+    mono.set_frequency (2000.0f);
+    mono.update_planes (src, dst, n);
+
+    for (std::size_t i = 0; i < n; ++i)
+        BOOST_REQUIRE_EQUAL (float (at_c<1> (range (out) [i])),
+                             expected [i]);
+}
+
+BOOST_AUTO_TEST_CASE (test_biquad_bank)
+{
+    const std::size_t n = 1000;
+    const std::size_t lanes = synth::biquad_bank::max_lanes - 1;
+    const filter_values::type types [] = {
+        filter_values::LOWPASS, filter_values::HIPASS,
+        filter_values::BANDPASS_CSG, filter_values::BANDPASS_CZPG,
+        filter_values::NOTCH
+    };
+
+    for (auto type : types)
+    {
+        std::vector<filter_values> values;
+        std::vector<std::vector<float> > in, out, expected;
+        synth::biquad_bank bank (lanes);
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            values.emplace_back (type, 100.0f * (l + 1) * (l + 1), 0.5f,
+                                 frame_rate);
+            bank.set_values (l, values.back ());
+            in.push_back (noise (n));
+            out.push_back (std::vector<float> (n));
+            expected.push_back (std::vector<float> (n));
+
+            filter scalar (&values.back ());
+            for (std::size_t i = 0; i < n; ++i)
+                expected [l][i] = scalar.update (in [l][i]);
+        }
+
+        std::vector<const float*> src;
+        std::vector<float*> dst;
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            src.push_back (&in [l][0]);
+            dst.push_back (&out [l][0]);
+        }
+        bank.update_planes (&src [0], &dst [0], n / 3);
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            src [l] += n / 3;
+            dst [l] += n / 3;
+        }
+        bank.update_planes (&src [0], &dst [0], n - n / 3);
+
+        for (std::size_t l = 0; l < lanes; ++l)
+            for (std::size_t i = 0; i < n; ++i)
+                BOOST_REQUIRE_SMALL (out [l][i] - expected [l][i], 1e-5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_biquad_kernels)
+{
+    const std::size_t n = 131;
+    const std::size_t w = synth::biquad_lanes;
+    std::vector<float> coef (5 * w), in (n * 3);
+    const float scalars [] = { 0.1f, 0.2f, 0.1f, -1.5f, 0.6f };
+    for (std::size_t l = 0; l < w; ++l)
+        for (std::size_t k = 0; k < 5; ++k)
+            coef [k * w + l] = scalars [k] / (l + 1);
+    for (auto& x : in)
+        x = float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+
+    const float* src [] = { &in [0], &in [n], &in [2 * n] };
+    std::vector<float> expected (3 * n), result (3 * n);
+    std::vector<float> expected_state (4 * w, 0.0f), state (4 * w);
+    float* expected_dst [] = { &expected [0], &expected [n],
+                               &expected [2 * n] };
+    float* result_dst [] = { &result [0], &result [n], &result [2 * n] };
+    synth::kernels_for (base::cpu_isa::generic).biquad (
+        &coef [0], &expected_state [0], src, expected_dst, 3, n);
+
+    const base::cpu_isa isas [] = {
+        base::cpu_isa::sse2, base::cpu_isa::avx2, base::cpu_isa::avx512
+    };
+    for (auto isa : isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        std::fill (state.begin (), state.end (), 0.0f);
+        synth::kernels_for (isa).biquad (&coef [0], &state [0],
+                                         src, result_dst, 3, n);
+        BOOST_CHECK (std::memcmp (&expected [0], &result [0],
+                                  3 * n * sizeof (float)) == 0);
+        BOOST_CHECK (std::memcmp (&expected_state [0], &state [0],
+                                  4 * w * sizeof (float)) == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
@@ -0,0 +1,820 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        kernels.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief DSP kernels unit tests.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <psynth/base/cpu.hpp>
+#include <psynth/base/scope_guard.hpp>
+#include <psynth/sound/typedefs.hpp>
+#include <psynth/sound/buffer.hpp>
+#include <psynth/sound/algorithm.hpp>
+#include <psynth/synth/kernels.hpp>
+#include <psynth/synth/band_limited_table.hpp>
+#include <psynth/synth/wave_tables.hpp>
+#include <psynth/synth/oscillator.hpp>
+#include <psynth/synth/noise.hpp>
+#include <psynth/synth/simple_envelope.hpp>
+#include <psynth/synth/multi_point_envelope.hpp>
+#include <psynth/synth/util.hpp>
+
+using namespace psynth;
+using namespace psynth::sound;
+
+namespace
+{
+
+const std::size_t max_size = 67;
+
+const base::cpu_isa all_isas [] = {
+    base::cpu_isa::generic,
+    base::cpu_isa::sse2,
+    base::cpu_isa::avx2,
+    base::cpu_isa::avx512
+};
+
+float random_sample ()
+{
+    return float (std::rand ()) / RAND_MAX * 2.0f - 1.0f;
+}
+
+float* plane (mono32sf_buffer& buf)
+{
+    return reinterpret_cast<float*> (range (buf).begin ());
+}
+
+void randomize (mono32sf_buffer& buf)
+{
+    for (std::size_t i = 0; i < std::size_t (buf.size ()); ++i)
+        plane (buf) [i] = random_sample ();
+}
+
+bool bit_equal (const float* a, const float* b, std::size_t n)
+{
+    return std::memcmp (a, b, n * sizeof (float)) == 0;
+}
+
+template <class IntBuffer, class Raw, class ToInt, class ToFloat>
+void check_convert (ToInt to_int, ToFloat to_float)
+{
+    typedef typename IntBuffer::value_type int_frame;
+
+    for (std::size_t n = 0; n <= max_size; ++n)
+    {
+        mono32sf_buffer src [2] = { mono32sf_buffer (n),
+                                    mono32sf_buffer (n) };
+        mono32sf_buffer back [2] = { mono32sf_buffer (n),
+                                     mono32sf_buffer (n) };
+        mono32sf_buffer expected_back (n);
+        IntBuffer expected (n), result (n);
+        randomize (src [0]);
+        randomize (src [1]);
+        plane (src [0]) [0] = n ? 1.0f : 0.0f;
+        plane (src [1]) [0] = n ? -1.0f : 0.0f;
+
+        fill_frames (range (result), int_frame (0, 0));
+        copy_and_convert_frames (const_range (src [0]),
+                                 nth_sample_range (range (expected), 0));
+        copy_and_convert_frames (const_range (src [1]),
+                                 nth_sample_range (range (expected), 1));
+
+        const float* src_planes [] = { plane (src [0]), plane (src [1]) };
+        to_int (src_planes, 2,
+                reinterpret_cast<Raw*> (range (result).begin ()), n, 0);
+        BOOST_REQUIRE (std::memcmp (range (expected).begin (),
+                                    range (result).begin (),
+                                    n * sizeof (int_frame)) == 0);
+
+        float* back_planes [] = { plane (back [0]), plane (back [1]) };
+        to_float (reinterpret_cast<const Raw*> (
+                      const_range (result).begin ()),
+                  2, back_planes, n);
+        for (std::size_t c = 0; c < 2; ++c)
+        {
+            copy_and_convert_frames (
+                nth_sample_range (const_range (expected), c),
+                range (expected_back));
+            BOOST_REQUIRE (bit_equal (plane (expected_back),
+                                      plane (back [c]), n));
+        }
+    }
+}
+
+template <class Generator, class Kernel>
+void check_oscillator (Kernel kernel)
+{
+    for (std::size_t n = 0; n <= max_size; ++n)
+    {
+        std::vector<float> expected (n), result (n);
+        Generator gen;
+        float x = -0.3f;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            expected [i] = gen (x) * 0.75f;
+            x += 0.0123f;
+        }
+
+        const float y = kernel (&result [0], n, -0.3f, 0.0123f, 0.75f);
+        BOOST_REQUIRE_EQUAL (x, y);
+        BOOST_REQUIRE (bit_equal (&expected [0], &result [0], n));
+    }
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_SUITE (synth_kernels_test_suite);
+
+BOOST_AUTO_TEST_CASE (test_kernels_force_isa)
+{
+    const auto detected = base::detected_isa ();
+    BOOST_TEST_MESSAGE ("Detected instruction set: "
+                        << base::isa_name (detected));
+
+    base::force_isa (base::cpu_isa::generic);
+    BOOST_CHECK (base::current_isa () == base::cpu_isa::generic);
+    BOOST_CHECK (synth::resolve_kernels ().isa == base::cpu_isa::generic);
+    BOOST_CHECK (synth::kernels ().isa == base::cpu_isa::generic);
+
+    if (detected != base::cpu_isa::avx512)
+        BOOST_CHECK_THROW (base::force_isa (base::cpu_isa::avx512),
+                           base::cpu_isa_error);
+    BOOST_CHECK (base::isa_from_name ("sse2") == base::cpu_isa::sse2);
+    BOOST_CHECK_THROW (base::isa_from_name ("mmx"), base::cpu_isa_error);
+
+    base::unforce_isa ();
+    synth::resolve_kernels ();
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_arithmetic)
+{
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        BOOST_TEST_MESSAGE ("Checking kernels: " << base::isa_name (k.isa));
+
+        for (std::size_t n = 0; n <= max_size; ++n)
+        {
+            mono32sf_buffer a (n), b (n), expected (n), result (n);
+            randomize (a);
+            randomize (b);
+            const sound::detail::no_simd_tag generic;
+
+            synth::detail::mix_aux (const_range (a), const_range (b),
+                                    range (expected), generic);
+            k.mix (plane (a), plane (b), plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            synth::detail::mix_aux (const_range (a), const_range (b), 0.3f,
+                                    range (expected), generic);
+            k.mix_gain (plane (a), plane (b), 0.3f, plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            synth::detail::modulate_aux (const_range (a), const_range (b),
+                                         range (expected), generic);
+            k.modulate (plane (a), plane (b), plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            synth::detail::modulate_aux (const_range (a), const_range (b),
+                                         0.3f, range (expected), generic);
+            k.modulate_gain (plane (a), plane (b), 0.3f, plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            synth::detail::blend_aux (const_range (a), const_range (b),
+                                      0.5f, range (expected), generic);
+            k.blend (plane (a), plane (b), 0.5f, plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            synth::detail::mix_aux (const_range (a), const_range (b),
+                                    range (expected), generic);
+            k.mix (plane (a), plane (b), plane (a), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (a), n));
+
+            for (std::size_t i = 0; i < n; ++i)
+                plane (expected) [i] = 0.25f + float (i) * -0.01f;
+            k.ramp (plane (result), n, 0.25f, -0.01f);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            mono32sf_buffer c (n), d (n), expected_im (n), result_im (n);
+            randomize (c);
+            randomize (d);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const float r = plane (a) [i] * plane (c) [i] -
+                    plane (b) [i] * plane (d) [i];
+                const float m = plane (a) [i] * plane (d) [i] +
+                    plane (b) [i] * plane (c) [i];
+                plane (expected) [i]    = plane (c) [i] + r;
+                plane (expected_im) [i] = plane (d) [i] + m;
+            }
+            std::copy (plane (c), plane (c) + n, plane (result));
+            std::copy (plane (d), plane (d) + n, plane (result_im));
+            k.complex_mac (plane (a), plane (b), plane (c), plane (d),
+                           plane (result), plane (result_im), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+            BOOST_REQUIRE (bit_equal (plane (expected_im),
+                                      plane (result_im), n));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_convert)
+{
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        check_convert<stereo16s_buffer, std::int16_t> (
+            k.float_to_int16, k.int16_to_float);
+        check_convert<stereo24s_buffer, std::uint8_t> (
+            k.float_to_int24, k.int24_to_float);
+        check_convert<stereo32s_buffer, std::int32_t> (
+            k.float_to_int32, k.int32_to_float);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_dither)
+{
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+
+        const std::size_t n = max_size;
+        mono32sf_buffer src (n);
+        randomize (src);
+        const float* planes [] = { plane (src) };
+        std::vector<std::int16_t> plain (n), first (n), second (n);
+
+        std::uint32_t state = 42;
+        k.float_to_int16 (planes, 1, &plain [0], n, 0);
+        k.float_to_int16 (planes, 1, &first [0], n, &state);
+        BOOST_REQUIRE_EQUAL (state, 42 + n);
+
+        state = 42;
+        k.float_to_int16 (planes, 1, &second [0], n, &state);
+        BOOST_REQUIRE (first == second);
+        BOOST_REQUIRE (first != plain);
+        for (std::size_t i = 0; i < n; ++i)
+            BOOST_REQUIRE (std::abs (first [i] - plain [i]) <= 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_oscillators)
+{
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        check_oscillator<synth::sawtooth_generator> (k.sawtooth);
+        check_oscillator<synth::square_generator> (k.square);
+        check_oscillator<synth::triangle_generator> (k.triangle);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_wave_table)
+{
+    const synth::band_limited_table table (synth::sawtooth_generator (),
+                                           256);
+    const float* level = table.level (1);
+    const auto& generic = synth::kernels_for (base::cpu_isa::generic);
+
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        for (std::size_t n = 0; n <= max_size; ++n)
+        {
+            std::vector<float> expected (n), result (n);
+            const float y0 = generic.wave_table (level, table.size (),
+                                                 &expected [0], n,
+                                                 -0.3f, 0.0123f, 0.75f);
+            const float y1 = k.wave_table (level, table.size (),
+                                           &result [0], n,
+                                           -0.3f, 0.0123f, 0.75f);
+            BOOST_REQUIRE_EQUAL (y0, y1);
+            BOOST_REQUIRE (bit_equal (&expected [0], &result [0], n));
+
+            float x = -0.3f;
+            for (std::size_t i = 0; i < n; ++i, x += 0.0123f)
+                BOOST_REQUIRE_SMALL (
+                    result [i] - table.get (level, x) * 0.75f, 1e-6f);
+
+            std::vector<float> phases (n);
+            for (std::size_t i = 0; i < n; ++i)
+                phases [i] = std::sin (0.37f * i) * 2.5f;
+            generic.wave_table_phases (level, table.size (), &phases [0],
+                                       &expected [0], n, 0.75f);
+            k.wave_table_phases (level, table.size (), &phases [0],
+                                 &result [0], n, 0.75f);
+            BOOST_REQUIRE (bit_equal (&expected [0], &result [0], n));
+            for (std::size_t i = 0; i < n; ++i)
+                BOOST_REQUIRE_SMALL (
+                    result [i] - table.get (level, phases [i]) * 0.75f,
+                    1e-6f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_fft_pass)
+{
+    const std::size_t size = 128;
+    const auto& generic = synth::kernels_for (base::cpu_isa::generic);
+
+    mono32sf_buffer re (size), im (size), wr (size / 2), wi (size / 2);
+    randomize (re);
+    randomize (im);
+    randomize (wr);
+    randomize (wi);
+
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        for (std::size_t half = 1; half < size; half *= 2)
+            for (auto pass : { &synth::kernel_table::fft_dit_pass,
+                               &synth::kernel_table::fft_dif_pass })
+            {
+                mono32sf_buffer expected_re (re), expected_im (im);
+                mono32sf_buffer result_re (re), result_im (im);
+                (generic.*pass) (plane (expected_re), plane (expected_im),
+                                 plane (wr), plane (wi), half,
+                                 0, size / 2);
+                for (std::size_t i = 0; i < size / 2; i += 13)
+                    (k.*pass) (plane (result_re), plane (result_im),
+                               plane (wr), plane (wi), half,
+                               i, std::min (i + 13, size / 2));
+                BOOST_REQUIRE (bit_equal (plane (expected_re),
+                                          plane (result_re), size));
+                BOOST_REQUIRE (bit_equal (plane (expected_im),
+                                          plane (result_im), size));
+            }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_delay)
+{
+    const std::size_t size = 256;
+    const auto& generic = synth::kernels_for (base::cpu_isa::generic);
+
+    mono32sf_buffer buf (size), delay (max_size);
+    randomize (buf);
+    for (std::size_t i = 0; i < max_size; ++i)
+        plane (delay) [i] = 1.0f + (random_sample () + 1.0f) * 100.0f;
+
+    for (auto isa : all_isas)
+    {
+        if (isa > base::detected_isa ())
+            break;
+        const auto& k = synth::kernels_for (isa);
+        for (std::size_t n = 0; n <= max_size; ++n)
+        {
+            mono32sf_buffer expected (n), result (n);
+
+            generic.delay_linear (plane (buf), size - 1, 37,
+                                  plane (delay), plane (expected), n);
+            k.delay_linear (plane (buf), size - 1, 37,
+                            plane (delay), plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            generic.delay_cubic (plane (buf), size - 1, 37,
+                                 plane (delay), plane (expected), n);
+            k.delay_cubic (plane (buf), size - 1, 37,
+                           plane (delay), plane (result), n);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+
+            const float y0 = generic.delay_allpass (
+                plane (buf), size - 1, 37, plane (delay),
+                plane (expected), n, 0.25f);
+            const float y1 = k.delay_allpass (
+                plane (buf), size - 1, 37, plane (delay),
+                plane (result), n, 0.25f);
+            BOOST_REQUIRE_EQUAL (y0, y1);
+            BOOST_REQUIRE (bit_equal (plane (expected), plane (result), n));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_band_limited_table)
+{
+    const synth::band_limited_table sine ((synth::sine_generator ()));
+    BOOST_CHECK_EQUAL (sine.size (), synth::band_limited_table::default_size);
+    BOOST_CHECK_EQUAL (sine.max_harmonic (sine.levels () - 1), 1u);
+    for (float x = -1.0f; x < 1.0f; x += 0.0173f)
+        BOOST_REQUIRE_SMALL (sine.get (sine.level (0), x) -
+                             std::sin (2 * M_PI * x), 1e-5);
+
+    const synth::band_limited_table saw ((synth::sawtooth_generator ()));
+    const float* top = saw.level (saw.levels () - 1);
+    for (float x = 0.0f; x < 1.0f; x += 0.0173f)
+        BOOST_REQUIRE_SMALL (saw.get (top, x) +
+                             2 / M_PI * std::sin (2 * M_PI * x), 1e-2);
+
+    for (float speed = 1e-4f; speed < 0.5f; speed *= 1.5f)
+    {
+        const auto level = saw.level_for (speed);
+        BOOST_CHECK (saw.max_harmonic (level) * speed <= 0.5f ||
+                     level == saw.levels () - 1);
+        BOOST_CHECK (level == 0 ||
+                     saw.max_harmonic (level - 1) * speed > 0.5f);
+    }
+
+    mono32sf_buffer fast (max_size);
+    stereo32sf_buffer slow (max_size);
+    synth::oscillator<synth::sawtooth_generator> osc_fast (44100, 3000.0f);
+    synth::oscillator<synth::sawtooth_generator> osc_slow (44100, 3000.0f);
+    osc_fast.update (range (fast));
+    osc_slow.update (range (slow));
+    for (std::size_t i = 0; i < max_size; ++i)
+        BOOST_REQUIRE_SMALL (plane (fast) [i] -
+                             float (at_c<0> (range (slow) [i])), 1e-5f);
+}
+
+namespace
+{
+
+enum class modulation { fm, pm, am };
+
+template <class Range1, class Range2>
+void modulated_update (synth::oscillator<>& osc, modulation mode,
+                       const Range1& out, const Range2& mod)
+{
+    switch (mode)
+    {
+    case modulation::fm: osc.update_fm (out, mod); break;
+    case modulation::pm: osc.update_pm (out, mod); break;
+    case modulation::am: osc.update_am (out, mod); break;
+    }
+}
+
+/**
+ * Checks that the modulated updates of an oscillator, that use the
+ * kernels on mono ranges, match the generic code on interleaved ones.
+ */
+void check_modulated_oscillator (modulation mode)
+{
+    mono32sf_buffer mod (max_size);
+    for (std::size_t i = 0; i < max_size; ++i)
+        plane (mod) [i] = 0.5f * std::sin (0.1f * i);
+
+    mono32sf_buffer fast (max_size);
+    stereo32sf_buffer slow (max_size);
+    synth::oscillator<> osc_fast (44100, 880.0f, 0.5f);
+    synth::oscillator<> osc_slow (44100, 880.0f, 0.5f);
+    for (int block = 0; block < 3; ++block)
+    {
+        modulated_update (osc_fast, mode, range (fast), const_range (mod));
+        modulated_update (osc_slow, mode, range (slow), const_range (mod));
+        for (std::size_t i = 0; i < max_size; ++i)
+            BOOST_REQUIRE_SMALL (plane (fast) [i] -
+                                 float (at_c<0> (range (slow) [i])), 1e-4f);
+    }
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_CASE (test_oscillator_modulated)
+{
+    check_modulated_oscillator (modulation::fm);
+    check_modulated_oscillator (modulation::pm);
+    check_modulated_oscillator (modulation::am);
+}
+
+BOOST_AUTO_TEST_CASE (test_wave_tables)
+{
+    const synth::band_limited_table* seen [4];
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i)
+        threads.emplace_back ([&seen, i] {
+                seen [i] = &synth::standard_table (
+                    synth::standard_wave::triangle);
+            });
+    for (auto& t : threads)
+        t.join ();
+    for (auto table : seen)
+        BOOST_CHECK_EQUAL (
+            table, &synth::oscillator<synth::triangle_generator>::table ());
+
+    const std::string filename = std::tmpnam (0);
+    PSYNTH_ON_BLOCK_EXIT ([&] { std::remove (filename.c_str ()); });
+
+    const synth::band_limited_table saw ((synth::sawtooth_generator ()));
+    const std::size_t n = synth::band_limited_table::data_size (saw.size ());
+    const synth::wave_tables built (filename);
+    const synth::wave_tables mapped (filename);
+    for (auto tables : { &built, &mapped })
+        BOOST_CHECK (bit_equal (
+                         tables->get (synth::standard_wave::sawtooth).data (),
+                         saw.data (), n));
+
+    // The sine table is sampled with libm, not with the approximation
+    // used by the direct sine oscillator.
+    const synth::band_limited_table sine ([] (float x) {
+            return float (std::sin (2.0 * M_PI * x));
+        });
+    BOOST_CHECK (bit_equal (built.get (synth::standard_wave::sine).data (),
+                            sine.data (), n));
+
+    std::remove (filename.c_str ());
+    std::ofstream (filename.c_str ()) << "garbage";
+    const synth::wave_tables rebuilt (filename);
+    BOOST_CHECK (bit_equal (
+                     rebuilt.get (synth::standard_wave::sawtooth).data (),
+                     saw.data (), n));
+#ifdef __linux__
+    BOOST_CHECK (built.is_shared ());
+    BOOST_CHECK (mapped.is_shared ());
+    BOOST_CHECK (rebuilt.is_shared ());
+#endif
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_dispatch)
+{
+    stereo32sf_planar_buffer a (max_size), b (max_size);
+    stereo32sf_planar_buffer expected (max_size), result (max_size);
+    fill_frames (range (a), stereo32sf_frame (0.25f, -0.5f));
+    fill_frames (range (b), stereo32sf_frame (0.5f, 0.125f));
+
+    synth::detail::mix_aux (const_range (a), const_range (b), 0.5f,
+                            range (expected),
+                            sound::detail::no_simd_tag ());
+    synth::mix (const_range (a), const_range (b), 0.5f, range (result));
+    BOOST_CHECK (equal_frames (const_range (expected),
+                               const_range (result)));
+
+    mono32sf_buffer osc_result (max_size);
+    synth::oscillator<synth::sawtooth_generator> osc (
+        44100, 440.0f, 1.0f, 0.0f, false);
+    osc.update (range (osc_result));
+    BOOST_CHECK_EQUAL (plane (osc_result) [0], -1.0f);
+    BOOST_CHECK (plane (osc_result) [1] > -1.0f);
+
+    stereo16s_buffer int_expected (max_size), int_result (max_size);
+    copy_and_convert_frames (const_range (a), range (int_expected));
+    synth::convert_frames (const_range (a), range (int_result));
+    BOOST_CHECK (equal_frames (const_range (int_expected),
+                               const_range (int_result)));
+
+    synth::tpdf_dither dither (7);
+    synth::convert_frames (const_range (a), range (int_result), &dither);
+    BOOST_CHECK_EQUAL (dither.state, 7 + 2 * max_size);
+}
+
+BOOST_AUTO_TEST_CASE (test_kernels_noise)
+{
+    for (std::size_t n = 0; n <= max_size; ++n)
+    {
+        std::vector<std::uint32_t> seed (synth::noise_lanes);
+        for (std::size_t l = 0; l < synth::noise_lanes; ++l)
+            seed [l] = 0x12345u * (l + 1);
+
+        std::vector<std::uint32_t> lanes (seed);
+        std::vector<float> expected (n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint32_t& x = lanes [i % synth::noise_lanes];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            const std::uint32_t bits = (x >> 9) | 0x40000000u;
+            std::memcpy (&expected [i], &bits, sizeof (float));
+            expected [i] -= 3.0f;
+        }
+
+        synth::noise_engine words (42), block (42);
+        std::vector<float> filled (n);
+        block.fill (&filled [0], n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::uint32_t bits = (words () >> 9) | 0x40000000u;
+            float x;
+            std::memcpy (&x, &bits, sizeof (float));
+            BOOST_REQUIRE_EQUAL (x - 3.0f, filled [i]);
+        }
+
+        for (auto isa : all_isas)
+        {
+            if (isa > base::detected_isa ())
+                break;
+            const auto& k = synth::kernels_for (isa);
+
+            std::vector<std::uint32_t> state (seed);
+            std::vector<float> result (n + 1, 2.0f);
+            k.white_noise (&state [0], &result [0], n);
+            BOOST_REQUIRE (bit_equal (&expected [0], &result [0], n));
+            BOOST_REQUIRE_EQUAL (result [n], 2.0f);
+            BOOST_REQUIRE (state == lanes);
+
+            float pink [7] = {}, brown = 0.0f;
+            std::vector<float> colored (expected);
+            k.pink_filter (pink, &result [0], n);
+            k.brown_filter (&brown, &colored [0], n);
+
+            const auto& g = synth::kernels_for (base::cpu_isa::generic);
+            float g_pink [7] = {}, g_brown = 0.0f;
+            std::vector<float> g_result (expected), g_colored (expected);
+            g.pink_filter (g_pink, &g_result [0], n);
+            g.brown_filter (&g_brown, &g_colored [0], n);
+            BOOST_REQUIRE (bit_equal (&g_result [0], &result [0], n));
+            BOOST_REQUIRE (bit_equal (&g_colored [0], &colored [0], n));
+            BOOST_REQUIRE (bit_equal (g_pink, pink, 7));
+            BOOST_REQUIRE_EQUAL (g_brown, brown);
+        }
+    }
+}
+
+namespace
+{
+
+/**
+ * Ratio of the power of the first difference of the signal to its
+ * power, which is 2 for white noise and smaller the more the power is
+ * in the low frequencies.
+ */
+float difference_ratio (const float* x, std::size_t n)
+{
+    double power = 0, diff = 0;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        power += x [i] * x [i];
+        diff  += (x [i] - x [i - 1]) * (x [i] - x [i - 1]);
+    }
+    return diff / power;
+}
+
+} /* anonymous namespace */
+
+BOOST_AUTO_TEST_CASE (test_noise)
+{
+    const std::size_t n = 1 << 16;
+    const std::size_t block = 100;
+
+    mono32sf_buffer white (n), pink (n), brown (n);
+    synth::noise<synth::white_noise_distribution<bits32sf> > white_gen;
+    synth::noise<synth::pink_noise_distribution<bits32sf> > pink_gen;
+    synth::noise<synth::brown_noise_distribution<bits32sf> > brown_gen;
+    for (std::size_t i = 0; i < n; i += block)
+    {
+        const std::size_t m = std::min (block, n - i);
+        white_gen.update (sub_range (range (white), i, m));
+        pink_gen.update (sub_range (range (pink), i, m));
+        brown_gen.update (sub_range (range (brown), i, m));
+    }
+
+    double sum = 0, power = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float x = plane (white) [i];
+        BOOST_REQUIRE (x >= -1.0f && x < 1.0f);
+        sum += x;
+        power += x * x;
+    }
+    BOOST_CHECK_SMALL (sum / n, 0.01);
+    BOOST_CHECK_CLOSE (power / n, 1.0 / 3.0, 2.0);
+
+    const float w = difference_ratio (plane (white), n);
+    const float p = difference_ratio (plane (pink), n);
+    const float b = difference_ratio (plane (brown), n);
+    BOOST_CHECK_CLOSE (w, 2.0f, 2.0f);
+    BOOST_CHECK (p < 0.25f * w);
+    BOOST_CHECK (b < 0.25f * p);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        BOOST_REQUIRE (std::abs (plane (pink) [i]) < 1.5f);
+        BOOST_REQUIRE (std::abs (plane (brown) [i]) < 1.5f);
+    }
+
+    /* Every channel gets its own noise. */
+    stereo32sf_planar_buffer stereo (block);
+    pink_gen.update (range (stereo));
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < block; ++i)
+        equal += range (stereo) [i][0] == range (stereo) [i][1];
+    BOOST_CHECK_EQUAL (equal, 0u);
+
+    /* Interleaved buffers draw one sample at a time. */
+    stereo32sf_buffer interleaved (block);
+    synth::noise<synth::brown_noise_distribution<bits32sf> > generic_gen;
+    generic_gen.update (range (interleaved));
+    for (std::size_t i = 0; i < block; ++i)
+        BOOST_REQUIRE (std::abs (float (range (interleaved) [i][0])) < 1.5f);
+}
+
+BOOST_AUTO_TEST_CASE (test_envelope_segments)
+{
+    typedef synth::simple_envelope<mono32sf_range> simple;
+    const std::size_t n = 1000;
+
+    for (std::size_t block : { 1, 7, 64, 100 })
+    {
+        simple per_sample (0.003f, -0.002f), blocked (per_sample);
+        mono32sf_buffer buf (block);
+        std::vector<float> src (block), applied (block), blended (block);
+        for (std::size_t i = 0; i < block; ++i)
+            src [i] = random_sample ();
+
+        for (std::size_t i = 0; i < n; i += block)
+        {
+            if (i % 600 == 0)
+                per_sample.press (), blocked.press ();
+            else if (i % 600 >= 400 && i % 600 < 400 + block)
+                per_sample.release (), blocked.release ();
+
+            simple apply_env (blocked), blend_env (blocked);
+            synth::apply_envelope (apply_env, &src [0], &applied [0], block);
+            synth::blend_envelope (blend_env, &src [0], 0.5f,
+                                   &blended [0], block);
+            blocked.update (range (buf));
+
+            for (std::size_t j = 0; j < block; ++j)
+            {
+                const float e = float (per_sample.update () [0]);
+                BOOST_REQUIRE_SMALL (float (range (buf) [j][0]) - e, 1e-4f);
+                BOOST_REQUIRE_SMALL (applied [j] - src [j] * e, 1e-4f);
+                BOOST_REQUIRE_SMALL (
+                    blended [j] - (src [j] * e + 0.5f * (1.0f - e)), 1e-4f);
+            }
+            const std::size_t none = 0;
+            BOOST_REQUIRE_SMALL (float (blocked.update (none) [0]) -
+                                 float (per_sample.update (none) [0]), 1e-4f);
+        }
+    }
+
+    /* Constant segments. */
+    simple held (0.1f, -0.1f);
+    held.set (1.0f);
+    held.press ();
+    auto seg = held.next_segment (100);
+    BOOST_CHECK_EQUAL (seg.size, 100u);
+    BOOST_CHECK (seg.is_constant ());
+    BOOST_CHECK_EQUAL (seg.start, 1.0f);
+    held.release ();
+    seg = held.next_segment (100);
+    BOOST_CHECK_EQUAL (seg.size, 11u);
+    BOOST_CHECK (!seg.is_constant ());
+    seg = held.next_segment (100);
+    BOOST_CHECK (seg.is_constant ());
+    BOOST_CHECK_EQUAL (seg.start, 0.0f);
+
+    /* Multi point envelopes, also per segment. */
+    typedef synth::envelope_values<bits32sf> values_type;
+    typedef values_type::point point;
+    values_type vals;
+    vals.set_adsr (point { 10.0f, 1.0f }, point { 30.0f, 0.5f },
+                   point { 80.0f, 0.5f }, point { 100.0f, 0.0f });
+    synth::multi_point_envelope<mono32sf_range>
+        mp_per_sample (&vals), mp_blocked (&vals);
+    mp_per_sample.press ();
+    mp_blocked.press ();
+    mono32sf_buffer mp_buf (16);
+    for (std::size_t i = 0; i < 128; i += 16)
+    {
+        mp_blocked.update (range (mp_buf));
+        for (std::size_t j = 0; j < 16; ++j)
+            BOOST_REQUIRE_SMALL (float (range (mp_buf) [j][0]) -
+                                 float (mp_per_sample.update () [0]), 1e-4f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ();
@@ -0,0 +1,149 @@
+/**
+ *  Time-stamp:  <2026-10-18 12:00:00 raskolnikov>
+ *
+ *  @file        psynth_bench.cpp
+ *  @author      Juan Pedro Bolívar Puente <raskolnikov@es.gnu.org>
+ *  @date        Sun Oct 18 12:00:00 2026
+ *
+ *  @brief Microbenchmarks for the sound and synth libraries.
+ */
+
+/*
+ *  Copyright (C) 2026 Juan Pedro Bolívar Puente
+ *
+ *  This file is part of Psychosynth.
+ *
+ *  Psychosynth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Psychosynth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include <psynth/base/arg_parser.hpp>
+#include <psynth/base/cpu.hpp>
+#include <psynth/base/exception.hpp>
+
+#include "bench/bench.hpp"
+
+using namespace psynth;
+
+namespace
+{
+
+const char* usage =
+    "Usage: psynth-bench [options] [filter...]\n"
+    "\n"
+    "Runs the cases whose name contains any of the filters.\n"
+    "\n"
+    "  -l, --list             List the cases and exit.\n"
+    "  -f, --frames N         Frames processed per iteration (1024).\n"
+    "  -r, --repetitions N    Samples taken per case (101).\n"
+    "  -w, --warmup MS        Warmup time per case (50).\n"
+    "  -s, --sample-time MS   Time of each sample (1).\n"
+    "  -c, --cpu N            Pin the benchmark to a CPU.\n"
+    "  -i, --isa NAME         Force the kernels instruction set.\n"
+    "  -o, --format FORMAT    One of text, csv or json (text).\n"
+    "  -h, --help             Show this help.\n";
+
+bool matches (const char* name, const base::arg_parser& args)
+{
+    if (!args.has_free_args ())
+        return true;
+    for (auto filter : args)
+        if (std::strstr (name, filter))
+            return true;
+    return false;
+}
+
+} /* anonymous namespace */
+
+int main (int argc, const char* argv [])
+{
+    bench::options opts;
+    bool  list   = false;
+    bool  help   = false;
+    int   frames = opts.frames;
+    int   reps   = opts.repetitions;
+    float warmup = opts.warmup_ms;
+    float sample = opts.sample_ms;
+    std::string isa;
+
+    base::arg_parser args;
+    args.add ('l', "list", &list);
+    args.add ('h', "help", &help);
+    args.add ('f', "frames", &frames);
+    args.add ('r', "repetitions", &reps);
+    args.add ('w', "warmup", &warmup);
+    args.add ('s', "sample-time", &sample);
+    args.add ('c', "cpu", &opts.cpu);
+    args.add ('i', "isa", &isa);
+    args.add ('o', "format", &opts.format);
+
+    try
+    {
+        args.parse (argc, argv);
+        if (!isa.empty ())
+            base::force_isa (base::isa_from_name (isa));
+    }
+    catch (const base::exception& err)
+    {
+        std::cerr << err.what () << std::endl << usage;
+        return 1;
+    }
+
+    if (help)
+    {
+        std::cout << usage;
+        return 0;
+    }
+
+    if (list)
+    {
+        for (const auto& c : bench::cases ())
+            if (matches (c.name.c_str (), args))
+                std::cout << c.name << std::endl;
+        return 0;
+    }
+
+    if (frames <= 0 || reps <= 0 || warmup < 0 || sample <= 0 ||
+        (opts.format != "text" &&
+         opts.format != "csv" &&
+         opts.format != "json"))
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    opts.frames      = frames;
+    opts.repetitions = reps;
+    opts.warmup_ms   = warmup;
+    opts.sample_ms   = sample;
+
+    if (opts.cpu >= 0 && !bench::pin_to_cpu (opts.cpu))
+        std::cerr << "Could not pin to CPU " << opts.cpu << std::endl;
+
+    std::vector<bench::result> results;
+    for (const auto& c : bench::cases ())
+    {
+        if (!matches (c.name.c_str (), args))
+            continue;
+        if (opts.format == "text")
+            std::cerr << "Running: " << c.name << std::endl;
+        results.push_back (bench::run_case (c, opts));
+    }
+
+    bench::write_results (std::cout, opts, results);
+    return 0;
+}